@@ -302,6 +302,21 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
     }
 #endif
 
+    if (mContext.GetGlobalConfig().mEnableOrderedProcessing) {
+        if (IsFlushingThroughGoPipeline()) {
+            PARAM_WARNING_IGNORE(mContext.GetLogger(),
+                                 mContext.GetAlarm(),
+                                 "param EnableOrderedProcessing is not supported when flushing through go pipeline",
+                                 noModule,
+                                 mName,
+                                 mContext.GetProjectName(),
+                                 mContext.GetLogstoreName(),
+                                 mContext.GetRegion());
+        } else {
+            mIsOrderedProcessing = true;
+        }
+    }
+
     // Process queue, not generated when exactly once is enabled
     if (!inputFile || inputFile->mExactlyOnceConcurrency == 0) {
         if (mContext.GetProcessQueueKey() == -1) {
@@ -465,6 +480,22 @@ bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
     return allSucceeded;
 }
 
+bool CollectionPipeline::SendInOrder(vector<PipelineEventGroup>&& groupList, uint64_t seqNo) {
+    if (seqNo == 0) {
+        return Send(std::move(groupList));
+    }
+    if (!mReorderBuffer.Push(seqNo, std::move(groupList))) {
+        return true;
+    }
+    bool allSucceeded = true;
+    vector<PipelineEventGroup> readyGroupList;
+    while (mReorderBuffer.PopReady(readyGroupList)) {
+        allSucceeded = Send(std::move(readyGroupList)) && allSucceeded;
+        readyGroupList.clear();
+    }
+    return allSucceeded;
+}
+
 bool CollectionPipeline::FlushBatch() {
     bool allSucceeded = true;
     for (auto& flusher : mFlushers) {
@@ -25,6 +25,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/ProcessReorderBuffer.h"
 #include "collection_pipeline/plugin/instance/FlusherInstance.h"
 #include "collection_pipeline/plugin/instance/InputInstance.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
@@ -48,10 +49,14 @@ public:
     void Stop(bool isRemoving);
     void Process(std::vector<PipelineEventGroup>& logGroupList, size_t inputIndex);
     bool Send(std::vector<PipelineEventGroup>&& groupList);
+    // same as Send, but results of items processed concurrently are sent in the order they were popped
+    bool SendInOrder(std::vector<PipelineEventGroup>&& groupList, uint64_t seqNo);
     bool FlushBatch();
     void RemoveProcessQueue() const;
     // Should add before or when item pop from ProcessorQueue, must be called in the lock of ProcessorQueue
     void AddInProcessCnt() { mInProcessCnt.fetch_add(1); }
+    // Should be called when item pop from ProcessorQueue, 0 means the item need not be sent in order
+    uint64_t GetNextProcessSeqNo() { return mIsOrderedProcessing ? mReorderBuffer.NextSeqNo() : 0; }
     // Should sub when or after item push to SenderQueue
     void SubInProcessCnt() {
         if (mInProcessCnt.load() == 0) {
@@ -111,6 +116,8 @@ private:
     std::optional<std::string> mSingletonInput;
     std::atomic_uint16_t mPluginID;
     std::atomic_int16_t mInProcessCnt;
+    bool mIsOrderedProcessing = false;
+    ProcessReorderBuffer mReorderBuffer;
 
     mutable MetricsRecordRef mMetricsRecordRef;
     IntGaugePtr mStartTime;
@@ -16,24 +16,38 @@
 
 #include "collection_pipeline/CollectionPipelineManager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
+#include "common/Flags.h"
 #include "common/http/AsynCurlRunner.h"
 #include "common/timer/Timer.h"
 #include "config/feedbacker/ConfigFeedbackReceiver.h"
 #include "file_server/FileServer.h"
 #include "file_server/StaticFileServer.h"
 #include "go_pipeline/LogtailPlugin.h"
+#include "monitor/Monitor.h"
 #include "runner/ProcessorRunner.h"
 #if defined(__ENTERPRISE__) && defined(__linux__) && !defined(__ANDROID__)
 #include "app_config/AppConfig.h"
 #include "shennong/ShennongManager.h"
 #endif
 
+DEFINE_FLAG_INT32(pipeline_build_thread_num,
+                  "number of threads building pipelines during config update, 0 or 1 means building one by one",
+                  4);
+DEFINE_FLAG_BOOL(enable_file_server_partial_reload,
+                 "only release readers of updated file configs during config update, other readers keep running",
+                 true);
+
 using namespace std;
 
 namespace logtail {
@@ -43,7 +57,11 @@ static shared_ptr<CollectionPipeline> sEmptyPipeline;
 void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& diff) {
     // 过渡使用
     static bool isFileServerStarted = false;
-    bool isFileServerInputChanged = CheckIfFileServerUpdated(diff);
+    auto applyStart = chrono::steady_clock::now();
+    unordered_set<string> fileServerConfigs;
+    bool isFileServerInputChanged = CheckIfFileServerUpdated(diff, fileServerConfigs);
+    bool isPartialReload
+        = isFileServerStarted && isFileServerInputChanged && BOOL_FLAG(enable_file_server_partial_reload);
 
 #ifndef APSARA_UNIT_TEST_MAIN
 #if defined(__ENTERPRISE__) && defined(__linux__) && !defined(__ANDROID__)
@@ -52,14 +70,36 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
     }
 #endif
 #endif
-    if (isFileServerStarted && isFileServerInputChanged) {
+    if (isPartialReload) {
+        // only readers of the updated configs are handed off, other configs go on reading until ResumeConfigs
+        FileServer::GetInstance()->PauseConfigs(fileServerConfigs);
+    } else if (isFileServerStarted && isFileServerInputChanged) {
         FileServer::GetInstance()->Pause();
     }
+
+    // build new pipelines after the readers of the updated configs are released, since queues of reused keys are
+    // updated during building. With partial reload, other configs still go on reading while building.
+    vector<CollectionConfig*> configsToBuild;
+    for (auto& config : diff.mModified) {
+        configsToBuild.push_back(&config);
+    }
+    for (auto& config : diff.mAdded) {
+        configsToBuild.push_back(&config);
+    }
+    // new pipelines of modified configs auto reuse old pipeline's process queue and sender queue
+    auto builtPipelines = BuildPipelines(configsToBuild);
+
+    // LogInput is not held during partial reload and may still use options of the old pipelines it found before they
+    // were stopped, so the old pipelines are released after ResumeConfigs
+    vector<shared_ptr<CollectionPipeline>> retiredPipelines;
     // other threads only read mPipelineNameEntityMap, so we don't need to lock read here
     for (const auto& name : diff.mRemoved) {
         auto iter = mPipelineNameEntityMap.find(name);
         iter->second->Stop(true);
         iter->second->RemoveProcessQueue();
+        if (isPartialReload) {
+            retiredPipelines.push_back(iter->second);
+        }
         {
             unique_lock<shared_mutex> lock(mPipelineNameEntityMapMutex);
             mPipelineNameEntityMap.erase(name);
@@ -67,8 +107,9 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
         ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(name,
                                                                                      ConfigFeedbackStatus::DELETED);
     }
-    for (auto& config : diff.mModified) {
-        auto p = BuildPipeline(std::move(config)); // auto reuse old pipeline's process queue and sender queue
+    for (size_t i = 0; i < diff.mModified.size(); ++i) {
+        auto& config = diff.mModified[i];
+        auto& p = builtPipelines[i];
         if (!p) {
             LOG_WARNING(sLogger,
                         ("failed to build pipeline for existing config",
@@ -109,6 +150,9 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
         }
 
         iter->second->Stop(shouldCompletelyStop);
+        if (isPartialReload) {
+            retiredPipelines.push_back(iter->second);
+        }
         {
             unique_lock<shared_mutex> lock(mPipelineNameEntityMapMutex);
             mPipelineNameEntityMap[config.mName] = p;
@@ -117,8 +161,9 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
         ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(config.mName,
                                                                                      ConfigFeedbackStatus::APPLIED);
     }
-    for (auto& config : diff.mAdded) {
-        auto p = BuildPipeline(std::move(config));
+    for (size_t i = 0; i < diff.mAdded.size(); ++i) {
+        auto& config = diff.mAdded[i];
+        auto& p = builtPipelines[diff.mModified.size() + i];
         if (!p) {
             LOG_WARNING(sLogger,
                         ("failed to build pipeline for new config", "skip current object")("config", config.mName));
@@ -148,7 +193,9 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
     // Sender::CleanUnusedAk();
 
     if (isFileServerInputChanged) {
-        if (isFileServerStarted) {
+        if (isPartialReload) {
+            FileServer::GetInstance()->ResumeConfigs(fileServerConfigs);
+        } else if (isFileServerStarted) {
             FileServer::GetInstance()->Resume(true, false);
         } else {
             FileServer::GetInstance()->Start();
@@ -169,6 +216,12 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
             item->Stop();
         }
     }
+
+    auto applyCost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - applyStart).count();
+    LoongCollectorMonitor::GetInstance()->SetAgentConfigApplyTimeMs(applyCost);
+    LOG_INFO(sLogger,
+             ("pipeline config update", "applied")("removed", diff.mRemoved.size())("modified", diff.mModified.size())(
+                 "added", diff.mAdded.size())("cost", ToString(applyCost) + "ms"));
 }
 
 const shared_ptr<CollectionPipeline>& CollectionPipelineManager::FindConfigByName(const string& configName) const {
@@ -230,6 +283,36 @@ shared_ptr<CollectionPipeline> CollectionPipelineManager::BuildPipeline(Collecti
     return p;
 }
 
+vector<shared_ptr<CollectionPipeline>>
+CollectionPipelineManager::BuildPipelines(const vector<CollectionConfig*>& configs) {
+    vector<shared_ptr<CollectionPipeline>> pipelines(configs.size());
+    size_t threadNum = min(static_cast<size_t>(max(INT32_FLAG(pipeline_build_thread_num), 1)), configs.size());
+    if (threadNum <= 1) {
+        for (size_t i = 0; i < configs.size(); ++i) {
+            pipelines[i] = BuildPipeline(std::move(*configs[i]));
+        }
+        return pipelines;
+    }
+
+    // only building is done concurrently, registering into mPipelineNameEntityMap and starting are still serialized by
+    // the caller in config order
+    atomic_size_t next(0);
+    auto build = [&]() {
+        for (size_t i = next++; i < configs.size(); i = next++) {
+            pipelines[i] = BuildPipeline(std::move(*configs[i]));
+        }
+    };
+    vector<future<void>> workers;
+    for (size_t i = 1; i < threadNum; ++i) {
+        workers.emplace_back(async(launch::async, build));
+    }
+    build();
+    for (auto& worker : workers) {
+        worker.get();
+    }
+    return pipelines;
+}
+
 void CollectionPipelineManager::FlushAllBatch() {
     shared_lock<shared_mutex> lock(mPipelineNameEntityMapMutex);
     for (const auto& item : mPipelineNameEntityMap) {
@@ -237,27 +320,32 @@ void CollectionPipelineManager::FlushAllBatch() {
     }
 }
 
-bool CollectionPipelineManager::CheckIfFileServerUpdated(CollectionConfigDiff& diff) {
+bool CollectionPipelineManager::CheckIfFileServerUpdated(CollectionConfigDiff& diff,
+                                                         unordered_set<string>& configNames) {
     // private method, no need to lock mPipelineNameEntityMapMutex
+    auto isFileServerInput = [](const string& inputType) {
+        return inputType == "input_file" || inputType == "input_container_stdio";
+    };
     for (const auto& name : diff.mRemoved) {
-        string inputType = mPipelineNameEntityMap[name]->GetConfig()["inputs"][0]["Type"].asString();
-        if (inputType == "input_file" || inputType == "input_container_stdio") {
-            return true;
+        if (isFileServerInput(mPipelineNameEntityMap[name]->GetConfig()["inputs"][0]["Type"].asString())) {
+            configNames.insert(name);
         }
     }
     for (const auto& config : diff.mModified) {
-        string inputType = (*config.mInputs[0])["Type"].asString();
-        if (inputType == "input_file" || inputType == "input_container_stdio") {
-            return true;
+        // readers of the old pipeline must be released as well, even if the new one no longer reads files
+        auto iter = mPipelineNameEntityMap.find(config.mName);
+        if (isFileServerInput((*config.mInputs[0])["Type"].asString())
+            || (iter != mPipelineNameEntityMap.end()
+                && isFileServerInput(iter->second->GetConfig()["inputs"][0]["Type"].asString()))) {
+            configNames.insert(config.mName);
         }
     }
     for (const auto& config : diff.mAdded) {
-        string inputType = (*config.mInputs[0])["Type"].asString();
-        if (inputType == "input_file" || inputType == "input_container_stdio") {
-            return true;
+        if (isFileServerInput((*config.mInputs[0])["Type"].asString())) {
+            configNames.insert(config.mName);
         }
     }
-    return false;
+    return !configNames.empty();
 }
 
 } // namespace logtail
@@ -22,6 +22,7 @@
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "collection_pipeline/CollectionPipeline.h"
@@ -63,9 +64,12 @@ private:
     ~CollectionPipelineManager() = default;
 
     virtual std::shared_ptr<CollectionPipeline> BuildPipeline(CollectionConfig&& config); // virtual for ut
+    // pipelines of different configs are independent, so they are built concurrently, the i-th result corresponds to
+    // configs[i] and is nullptr if building fails
+    std::vector<std::shared_ptr<CollectionPipeline>> BuildPipelines(const std::vector<CollectionConfig*>& configs);
     void FlushAllBatch();
     // TODO: 长期过渡使用
-    bool CheckIfFileServerUpdated(CollectionConfigDiff& diff);
+    bool CheckIfFileServerUpdated(CollectionConfigDiff& diff, std::unordered_set<std::string>& configNames);
 
     mutable std::shared_mutex mPipelineNameEntityMapMutex;
     std::unordered_map<std::string, std::shared_ptr<CollectionPipeline>> mPipelineNameEntityMap;
@@ -83,6 +87,7 @@ private:
     friend class FlusherUnittest;
     friend class PipelineUnittest;
     friend class PipelineUpdateUnittest;
+    friend class PipelineBuildBenchmark;
     friend class PollingPreservedDirDepthUnittest;
 #endif
 };
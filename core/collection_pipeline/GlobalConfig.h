@@ -39,6 +39,8 @@ struct GlobalConfig {
     uint32_t mPriority = 1U; // highest priority is 0, lowest priority is 2, default is 1
     bool mEnableTimestampNanosecond = false;
     bool mUsingOldContentTag = false;
+    // keep the order of items from the process queue when they are processed by multiple threads
+    bool mEnableOrderedProcessing = false;
 };
 
 } // namespace logtail
@@ -0,0 +1,51 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/ProcessReorderBuffer.h"
+
+using namespace std;
+
+namespace logtail {
+
+bool ProcessReorderBuffer::Push(uint64_t seqNo, vector<PipelineEventGroup>&& groupList) {
+    lock_guard<mutex> lock(mMux);
+    mPendingResults.emplace(seqNo, std::move(groupList));
+    if (mIsSending || mPendingResults.begin()->first != mNextSendSeqNo) {
+        // either another thread is sending and will pick this result up, or the preceding items are still being
+        // processed, whose owner will send this result later
+        return false;
+    }
+    mIsSending = true;
+    return true;
+}
+
+bool ProcessReorderBuffer::PopReady(vector<PipelineEventGroup>& groupList) {
+    lock_guard<mutex> lock(mMux);
+    auto iter = mPendingResults.begin();
+    if (iter == mPendingResults.end() || iter->first != mNextSendSeqNo) {
+        mIsSending = false;
+        return false;
+    }
+    groupList = std::move(iter->second);
+    mPendingResults.erase(iter);
+    ++mNextSendSeqNo;
+    return true;
+}
+
+size_t ProcessReorderBuffer::PendingCnt() const {
+    lock_guard<mutex> lock(mMux);
+    return mPendingResults.size();
+}
+
+} // namespace logtail
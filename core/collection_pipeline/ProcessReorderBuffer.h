@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "models/PipelineEventGroup.h"
+
+namespace logtail {
+
+// Restores the pop order of process queue items which are processed concurrently by several processor runner
+// threads. Each popped item is stamped with a sequence number, and processed results are released strictly in that
+// order. The thread which finds the next expected result becomes the only sender until a gap is met, so that results
+// are sent outside the lock while other threads keep depositing.
+class ProcessReorderBuffer {
+public:
+    // should be called when item is popped from the process queue, i.e. in the lock of the process queue
+    uint64_t NextSeqNo() { return mNextAssignedSeqNo.fetch_add(1); }
+
+    // Returns true if the caller should send results returned by PopReady until it returns false.
+    bool Push(uint64_t seqNo, std::vector<PipelineEventGroup>&& groupList);
+    bool PopReady(std::vector<PipelineEventGroup>& groupList);
+
+    size_t PendingCnt() const;
+
+private:
+    std::atomic_uint64_t mNextAssignedSeqNo = 1;
+
+    mutable std::mutex mMux;
+    uint64_t mNextSendSeqNo = 1;
+    std::map<uint64_t, std::vector<PipelineEventGroup>> mPendingResults;
+    bool mIsSending = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessReorderBufferUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -32,12 +32,33 @@ BoundedProcessQueue::BoundedProcessQueue(
 }
 
 bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
-    if (!IsValidToPush()) {
+    if (!IsValidToPush() || !ReserveItem()) {
         return false;
     }
     item->mEnqueTime = chrono::system_clock::now();
+    Enqueue(std::move(item));
+    return true;
+}
+
+bool BoundedProcessQueue::HandOff(unique_ptr<ProcessQueueItem>& item, bool& accepted) {
+    accepted = false;
+    if (!IsValidToPush() || !ReserveItem()) {
+        return true;
+    }
+    item->mEnqueTime = chrono::system_clock::now();
+    if (!mInbox.TryPush(item)) {
+        // should not happen, since the inbox is as large as the queue
+        mItemCnt.fetch_sub(1, memory_order_relaxed);
+        return false;
+    }
+    accepted = true;
+    return true;
+}
+
+void BoundedProcessQueue::Enqueue(unique_ptr<ProcessQueueItem>&& item) {
     auto size = item->mEventGroup.DataSize();
     mQueue.push_back(std::move(item));
+    AddDataSize(size);
     ChangeStateIfNeededAfterPush();
 
     ADD_COUNTER(mInItemsTotal, 1);
@@ -45,7 +66,6 @@ bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_COUNTER(mQueueDataSizeByte, size);
     SET_GAUGE(mValidToPushFlag, IsValidToPush());
-    return true;
 }
 
 bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
@@ -59,7 +79,10 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     }
     item = std::move(mQueue.front());
     mQueue.pop_front();
+    mItemCnt.fetch_sub(1, memory_order_relaxed);
     item->AddPipelineInProcessCnt(GetConfigName());
+    auto size = item->mEventGroup.DataSize();
+    SubDataSize(size);
     if (ChangeStateIfNeededAfterPop()) {
         GiveFeedback();
     }
@@ -67,7 +90,7 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     ADD_COUNTER(mOutItemsTotal, 1);
     ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - item->mEnqueTime);
     SET_GAUGE(mQueueSizeTotal, Size());
-    SUB_GAUGE(mQueueDataSizeByte, item->mEventGroup.DataSize());
+    SUB_GAUGE(mQueueDataSizeByte, size);
     SET_GAUGE(mValidToPushFlag, IsValidToPush());
     return true;
 }
@@ -83,6 +106,16 @@ void BoundedProcessQueue::SetUpStreamFeedbacks(vector<FeedbackInterface*>&& feed
     }
 }
 
+bool BoundedProcessQueue::ReserveItem() {
+    size_t cnt = mItemCnt.load(memory_order_relaxed);
+    do {
+        if (cnt >= mCapacity) {
+            return false;
+        }
+    } while (!mItemCnt.compare_exchange_weak(cnt, cnt + 1, memory_order_relaxed));
+    return true;
+}
+
 void BoundedProcessQueue::GiveFeedback() const {
     for (auto& item : mUpStreamFeedbacks) {
         item->Feedback(mKey);
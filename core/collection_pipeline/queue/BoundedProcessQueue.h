@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -45,8 +46,14 @@ private:
 
     void GiveFeedback() const override;
 
+    bool HandOff(std::unique_ptr<ProcessQueueItem>& item, bool& accepted) override;
+    void Enqueue(std::unique_ptr<ProcessQueueItem>&& item) override;
+    bool ReserveItem();
+
     std::deque<std::unique_ptr<ProcessQueueItem>> mQueue;
     std::vector<FeedbackInterface*> mUpStreamFeedbacks;
+    // items in the queue and in the inbox, so that items handed off never take the queue beyond its capacity
+    std::atomic_size_t mItemCnt = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BoundedProcessQueueUnittest;
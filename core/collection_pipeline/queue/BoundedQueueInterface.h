@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+
 #include "collection_pipeline/queue/QueueInterface.h"
+#include "collection_pipeline/queue/QueueMemoryBudget.h"
 
 namespace logtail {
 
@@ -27,8 +31,12 @@ public:
         : QueueInterface<T>(key, cap, ctx), mLowWatermark(low), mHighWatermark(high) {
         this->mMetricsRecordRef.AddLabels({{METRIC_LABEL_KEY_QUEUE_TYPE, "bounded"}});
         mValidToPushFlag = this->mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG);
+        QueueMemoryBudget::GetInstance()->AddQueue();
+    }
+    virtual ~BoundedQueueInterface() {
+        QueueMemoryBudget::GetInstance()->Sub(mDataSize);
+        QueueMemoryBudget::GetInstance()->RemoveQueue();
     }
-    virtual ~BoundedQueueInterface() = default;
 
     BoundedQueueInterface(const BoundedQueueInterface& que) = delete;
     BoundedQueueInterface& operator=(const BoundedQueueInterface&) = delete;
@@ -40,6 +48,13 @@ protected:
 
     bool ChangeStateIfNeededAfterPush() {
         if (this->Size() == mHighWatermark) {
+            mFullByCount = true;
+        }
+        auto* budget = QueueMemoryBudget::GetInstance();
+        if (!mFullByBytes && budget->IsOverHighWatermark() && mDataSize >= budget->GetQueueShare()) {
+            mFullByBytes = true;
+        }
+        if (mValidToPush && (mFullByCount || mFullByBytes)) {
             mValidToPush = false;
             return true;
         }
@@ -47,17 +62,42 @@ protected:
     }
 
     bool ChangeStateIfNeededAfterPop() {
-        if (!mValidToPush && this->Size() == mLowWatermark) {
+        if (mFullByCount && this->Size() == mLowWatermark) {
+            mFullByCount = false;
+        }
+        if (mFullByBytes) {
+            auto* budget = QueueMemoryBudget::GetInstance();
+            if (budget->IsBelowLowWatermark() || mDataSize <= budget->GetQueueLowShare()) {
+                mFullByBytes = false;
+            }
+        }
+        if (!mValidToPush && !mFullByCount && !mFullByBytes) {
             mValidToPush = true;
             return true;
         }
         return false;
     }
 
+    // should be called before ChangeStateIfNeededAfterPush/Pop
+    void AddDataSize(size_t size) {
+        mDataSize += size;
+        QueueMemoryBudget::GetInstance()->Add(size);
+    }
+
+    void SubDataSize(size_t size) {
+        size = std::min(size, mDataSize);
+        mDataSize -= size;
+        QueueMemoryBudget::GetInstance()->Sub(size);
+    }
+
+    size_t GetDataSize() const { return mDataSize; }
+
     void Reset(size_t low, size_t high) {
         mLowWatermark = low;
         mHighWatermark = high;
         mValidToPush = true;
+        mFullByCount = false;
+        mFullByBytes = false;
     }
 
     IntGaugePtr mValidToPushFlag;
@@ -69,7 +109,12 @@ private:
     size_t mLowWatermark = 0;
     size_t mHighWatermark = 0;
 
-    bool mValidToPush = true;
+    // atomic, since it is checked by producers without the lock of the queue held
+    std::atomic_bool mValidToPush = true;
+    bool mFullByCount = false;
+    bool mFullByBytes = false;
+    // bytes of the items held by the queue, including those in the extra buffer of sender queues
+    size_t mDataSize = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BoundedProcessQueueUnittest;
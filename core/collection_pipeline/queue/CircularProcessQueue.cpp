@@ -34,19 +34,31 @@ CircularProcessQueue::CircularProcessQueue(size_t cap,
 
 bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     size_t newCnt = item->mEventGroup.GetEvents().size();
-    while (!mQueue.empty() && mEventCnt + newCnt > mCapacity) {
-        auto cnt = mQueue.front()->mEventGroup.GetEvents().size();
-        auto size = mQueue.front()->mEventGroup.DataSize();
-        mEventCnt -= cnt;
-        mQueue.pop_front();
-        SET_GAUGE(mQueueSizeTotal, Size());
-        SUB_GAUGE(mQueueDataSizeByte, size);
-        ADD_COUNTER(mDiscardedEventsTotal, cnt);
-    }
+    DiscardOldItems(newCnt);
     if (mEventCnt + newCnt > mCapacity) {
         return false;
     }
     item->mEnqueTime = chrono::system_clock::now();
+    Enqueue(std::move(item));
+    return true;
+}
+
+bool CircularProcessQueue::HandOff(unique_ptr<ProcessQueueItem>& item, bool& accepted) {
+    // an item too large for the queue is left to Push, which discards old items all the same
+    if (item->mEventGroup.GetEvents().size() > mCapacity) {
+        return false;
+    }
+    item->mEnqueTime = chrono::system_clock::now();
+    if (!mInbox.TryPush(item)) {
+        return false;
+    }
+    accepted = true;
+    return true;
+}
+
+void CircularProcessQueue::Enqueue(unique_ptr<ProcessQueueItem>&& item) {
+    size_t newCnt = item->mEventGroup.GetEvents().size();
+    DiscardOldItems(newCnt);
     auto size = item->mEventGroup.DataSize();
     mQueue.push_back(std::move(item));
     mEventCnt += newCnt;
@@ -55,7 +67,18 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     ADD_COUNTER(mInItemDataSizeBytes, size);
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_GAUGE(mQueueDataSizeByte, size);
-    return true;
+}
+
+void CircularProcessQueue::DiscardOldItems(size_t newCnt) {
+    while (!mQueue.empty() && mEventCnt + newCnt > mCapacity) {
+        auto cnt = mQueue.front()->mEventGroup.GetEvents().size();
+        auto size = mQueue.front()->mEventGroup.DataSize();
+        mEventCnt -= cnt;
+        mQueue.pop_front();
+        SET_GAUGE(mQueueSizeTotal, Size());
+        SUB_GAUGE(mQueueDataSizeByte, size);
+        ADD_COUNTER(mDiscardedEventsTotal, cnt);
+    }
 }
 
 bool CircularProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
@@ -80,6 +103,7 @@ bool CircularProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
 }
 
 void CircularProcessQueue::Reset(size_t cap) {
+    DrainInbox();
     // it seems more reasonable to retain extra items and process them immediately, however this contray to current
     // framework design so we simply discard extra items, considering that it is a rare case to change capacity
     uint32_t cnt = 0;
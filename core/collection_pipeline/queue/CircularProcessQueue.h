@@ -40,6 +40,10 @@ public:
 private:
     size_t Size() const override { return mEventCnt; }
 
+    bool HandOff(std::unique_ptr<ProcessQueueItem>& item, bool& accepted) override;
+    void Enqueue(std::unique_ptr<ProcessQueueItem>&& item) override;
+    void DiscardOldItems(size_t newCnt);
+
     std::deque<std::unique_ptr<ProcessQueueItem>> mQueue;
     size_t mEventCnt = 0;
 
@@ -60,6 +60,7 @@ bool ExactlyOnceSenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
 
     auto ptr = static_cast<SLSSenderQueueItem*>(item.get());
     auto& eo = ptr->mExactlyOnceCheckpoint;
+    auto size = item->mData.size();
     if (eo->IsComplete()) {
         if (mQueue[eo->index] != nullptr) {
             // should not happen
@@ -86,11 +87,13 @@ bool ExactlyOnceSenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
         if (!eo->IsComplete()) {
             item->mFirstEnqueTime = chrono::system_clock::now();
             mExtraBuffer.push_back(std::move(item));
+            AddDataSize(size);
             return true;
         }
     }
     eo->Prepare();
     ++mSize;
+    AddDataSize(size);
     ChangeStateIfNeededAfterPush();
     return true;
 }
@@ -104,6 +107,7 @@ bool ExactlyOnceSenderQueue::Remove(SenderQueueItem* item) {
         // should not happen
         return false;
     }
+    SubDataSize(mQueue[eo->index]->mData.size());
     mQueue[eo->index].reset();
     --mSize;
 
@@ -167,6 +171,7 @@ void ExactlyOnceSenderQueue::GetAvailableItems(vector<SenderQueueItem*>& items,
 }
 
 void ExactlyOnceSenderQueue::Reset(const vector<RangeCheckpointPtr>& checkpoints) {
+    SubDataSize(GetDataSize());
     BoundedSenderQueueInterface::Reset(checkpoints.size(), checkpoints.size() - 1, checkpoints.size());
     mQueue.resize(checkpoints.size());
     mQueue.clear();
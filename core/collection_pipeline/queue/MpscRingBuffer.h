@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+
+namespace logtail {
+
+// Bounded lock-free ring for multiple producers and a single consumer. Each slot carries a sequence number telling
+// whether it is free for the producer of a given round or filled for the consumer, so that producers only contend on
+// the tail and never wait for each other.
+// TryPush is thread-safe, while TryPop should only be called by one thread at a time.
+template <typename T>
+class MpscRingBuffer {
+public:
+    explicit MpscRingBuffer(size_t cap) {
+        size_t size = 2;
+        while (size < cap) {
+            size <<= 1;
+        }
+        mMask = size - 1;
+        mSlots.reset(new Slot[size]);
+        for (size_t i = 0; i < size; ++i) {
+            mSlots[i].mSeq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    // @item is moved only when true is returned
+    bool TryPush(T& item) {
+        size_t pos = mTail.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = mSlots[pos & mMask];
+            size_t seq = slot.mSeq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.mItem = std::move(item);
+                    slot.mSeq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // the slot has not been consumed since the last round, i.e. the ring is full
+                return false;
+            } else {
+                pos = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // an item whose slot has been claimed but not yet filled is not visible, nor are the ones behind it
+    bool TryPop(T& item) {
+        size_t pos = mHead.load(std::memory_order_relaxed);
+        Slot& slot = mSlots[pos & mMask];
+        if (slot.mSeq.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        item = std::move(slot.mItem);
+        slot.mSeq.store(pos + mMask + 1, std::memory_order_release);
+        mHead.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // not exact when called concurrently with push or pop
+    bool Empty() const { return mHead.load(std::memory_order_relaxed) == mTail.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic_size_t mSeq{0};
+        T mItem{};
+    };
+
+    std::unique_ptr<Slot[]> mSlots;
+    size_t mMask = 0;
+    alignas(64) std::atomic_size_t mTail{0};
+    alignas(64) std::atomic_size_t mHead{0};
+};
+
+} // namespace logtail
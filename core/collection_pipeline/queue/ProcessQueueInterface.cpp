@@ -24,7 +24,7 @@ ProcessQueueInterface::ProcessQueueInterface(int64_t key,
                                              size_t cap,
                                              uint32_t priority,
                                              const CollectionPipelineContext& ctx)
-    : QueueInterface(key, cap, ctx), mPriority(priority), mConfigName(ctx.GetConfigName()) {
+    : QueueInterface(key, cap, ctx), mInbox(cap), mPriority(priority), mConfigName(ctx.GetConfigName()) {
     mMetricsRecordRef.AddLabels({{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE}});
     mFetchTimesCnt = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_FETCH_TIMES_TOTAL);
     mValidFetchTimesCnt = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_VALID_FETCH_TIMES_TOTAL);
@@ -41,6 +41,37 @@ void ProcessQueueInterface::SetDownStreamQueues(vector<BoundedSenderQueueInterfa
     }
 }
 
+bool ProcessQueueInterface::PushConcurrently(unique_ptr<ProcessQueueItem>&& item) {
+    unique_lock<mutex> lock(mMux, try_to_lock);
+    if (!lock.owns_lock()) {
+        bool accepted = false;
+        if (HandOff(item, accepted)) {
+            return accepted;
+        }
+        lock.lock();
+    }
+    DrainInbox();
+    return Push(std::move(item));
+}
+
+bool ProcessQueueInterface::PopConcurrently(unique_ptr<ProcessQueueItem>& item) {
+    lock_guard<mutex> lock(mMux);
+    DrainInbox();
+    return Pop(item);
+}
+
+bool ProcessQueueInterface::EmptyConcurrently() {
+    lock_guard<mutex> lock(mMux);
+    return Empty() && mInbox.Empty();
+}
+
+void ProcessQueueInterface::DrainInbox() {
+    unique_ptr<ProcessQueueItem> item;
+    while (mInbox.TryPop(item)) {
+        Enqueue(std::move(item));
+    }
+}
+
 bool ProcessQueueInterface::IsValidToPop() const {
     return mValidToPop && IsDownStreamQueuesValidToPush();
 }
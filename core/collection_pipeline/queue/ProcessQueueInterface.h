@@ -19,9 +19,11 @@
 #include <cstdint>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "collection_pipeline/queue/MpscRingBuffer.h"
 #include "collection_pipeline/queue/ProcessQueueItem.h"
 #include "collection_pipeline/queue/QueueInterface.h"
 
@@ -29,12 +31,20 @@ namespace logtail {
 
 class BoundedSenderQueueInterface;
 
-// not thread-safe, should be protected explicitly by queue manager
+// not thread-safe, should be protected explicitly by queue manager, except for the *Concurrently methods
 class ProcessQueueInterface : virtual public QueueInterface<std::unique_ptr<ProcessQueueItem>> {
 public:
     ProcessQueueInterface(int64_t key, size_t cap, uint32_t priority, const CollectionPipelineContext& ctx);
     virtual ~ProcessQueueInterface() = default;
 
+    // The following methods can be called by multiple producers and consumers at the same time, as long as the queue
+    // is not modified otherwise. A producer pushes the item directly if no one else is using the queue. Otherwise,
+    // instead of waiting, it hands the item off to a lock-free inbox, which is moved to the queue by whoever gets
+    // the queue next.
+    bool PushConcurrently(std::unique_ptr<ProcessQueueItem>&& item);
+    bool PopConcurrently(std::unique_ptr<ProcessQueueItem>& item);
+    bool EmptyConcurrently();
+
     void SetPriority(uint32_t priority) { mPriority = priority; }
     uint32_t GetPriority() const { return mPriority; }
 
@@ -50,10 +60,21 @@ public:
 
 protected:
     bool IsValidToPop() const;
+    // should be called before the queue is accessed, so that items handed off come before the new ones
+    void DrainInbox();
 
     CounterPtr mFetchTimesCnt;
     CounterPtr mValidFetchTimesCnt;
 
+    MpscRingBuffer<std::unique_ptr<ProcessQueueItem>> mInbox;
+
+private:
+    // Called without mMux held. Returns false if the item should be pushed with mMux held instead, e.g. when the
+    // inbox is full. Otherwise, @accepted tells whether the item is taken by the queue, just like Push.
+    virtual bool HandOff(std::unique_ptr<ProcessQueueItem>& item, bool& accepted) = 0;
+    // called with mMux held for the items in the inbox, which have been accepted by HandOff already
+    virtual void Enqueue(std::unique_ptr<ProcessQueueItem>&& item) = 0;
+
 private:
     bool IsDownStreamQueuesValidToPush() const;
 
@@ -63,6 +84,8 @@ private:
     std::vector<BoundedSenderQueueInterface*> mDownStreamQueues;
     bool mValidToPop = false;
 
+    std::mutex mMux;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BoundedProcessQueueUnittest;
     friend class CircularProcessQueueUnittest;
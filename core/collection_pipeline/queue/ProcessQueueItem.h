@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <chrono>
 #include <memory>
 
@@ -29,6 +31,7 @@ class CollectionPipeline;
 struct ProcessQueueItem {
     PipelineEventGroup mEventGroup;
     size_t mInputIndex = 0; // index of the input in the pipeline
+    uint64_t mSeqNo = 0; // order of the item popped from the queue, 0 if the pipeline is not processed in order
     std::chrono::system_clock::time_point mEnqueTime;
 
     ProcessQueueItem(PipelineEventGroup&& group, size_t index) : mEventGroup(std::move(group)), mInputIndex(index) {}
@@ -37,6 +40,7 @@ struct ProcessQueueItem {
         const auto& p = CollectionPipelineManager::GetInstance()->FindConfigByName(configName);
         if (p) {
             p->AddInProcessCnt();
+            mSeqNo = p->GetNextProcessSeqNo();
         }
     }
 };
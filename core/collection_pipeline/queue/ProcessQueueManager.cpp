@@ -35,7 +35,7 @@ ProcessQueueManager::ProcessQueueManager() : mBoundedQueueParam(INT32_FLAG(bound
 bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key,
                                                      uint32_t priority,
                                                      const CollectionPipelineContext& ctx) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::BOUNDED) {
@@ -62,7 +62,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
                                                       uint32_t priority,
                                                       size_t capacity,
                                                       const CollectionPipelineContext& ctx) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::CIRCULAR) {
@@ -87,7 +87,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
 }
 
 bool ProcessQueueManager::DeleteQueue(QueueKey key) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -99,7 +99,7 @@ bool ProcessQueueManager::DeleteQueue(QueueKey key) {
 }
 
 bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
-    lock_guard<mutex> lock(mQueueMux);
+    shared_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second == QueueType::BOUNDED) {
@@ -113,10 +113,10 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
 
 QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
     {
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
-            if (!(*iter->second.first)->Push(std::move(item))) {
+            if (!(*iter->second.first)->PushConcurrently(std::move(item))) {
                 return QueueStatus::QUEUE_FULL;
             }
         } else {
@@ -132,12 +132,13 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
 
 bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
     configName.clear();
-    lock_guard<mutex> lock(mQueueMux);
+    shared_lock<shared_mutex> lock(mQueueMux);
+    lock_guard<mutex> popLock(mPopMux);
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         ProcessQueueIterator iter;
         if (mCurrentQueueIndex.first == i) {
             for (iter = mCurrentQueueIndex.second; iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
+                if (!(*iter)->PopConcurrently(item)) {
                     continue;
                 }
                 configName = (*iter)->GetConfigName();
@@ -145,7 +146,7 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             }
             if (configName.empty()) {
                 for (iter = mPriorityQueue[i].begin(); iter != mCurrentQueueIndex.second; ++iter) {
-                    if (!(*iter)->Pop(item)) {
+                    if (!(*iter)->PopConcurrently(item)) {
                         continue;
                     }
                     configName = (*iter)->GetConfigName();
@@ -154,7 +155,7 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             }
         } else {
             for (iter = mPriorityQueue[i].begin(); iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
+                if (!(*iter)->PopConcurrently(item)) {
                     continue;
                 }
                 configName = (*iter)->GetConfigName();
@@ -189,18 +190,14 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
         }
     }
     ResetCurrentQueueIndex();
-    {
-        unique_lock<mutex> lock(mStateMux);
-        mValidToPop = false;
-    }
     return false;
 }
 
 bool ProcessQueueManager::IsAllQueueEmpty() const {
     {
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         for (const auto& q : mQueues) {
-            if (!(*q.second.first)->Empty()) {
+            if (!(*q.second.first)->EmptyConcurrently()) {
                 return false;
             }
         }
@@ -209,7 +206,7 @@ bool ProcessQueueManager::IsAllQueueEmpty() const {
 }
 
 bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSenderQueueInterface*>&& ques) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -219,7 +216,7 @@ bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSender
 }
 
 bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInterface*>&& feedback) {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -234,7 +231,7 @@ bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInte
 void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRemoving) {
     if (QueueKeyManager::GetInstance()->HasKey(configName)) {
         auto key = QueueKeyManager::GetInstance()->GetKey(configName);
-        lock_guard<mutex> lock(mQueueMux);
+        lock_guard<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
             (*iter->second.first)->DisablePop();
@@ -247,7 +244,7 @@ void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRe
 void ProcessQueueManager::EnablePop(const string& configName) {
     if (QueueKeyManager::GetInstance()->HasKey(configName)) {
         auto key = QueueKeyManager::GetInstance()->GetKey(configName);
-        lock_guard<mutex> lock(mQueueMux);
+        lock_guard<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
             (*iter->second.first)->EnablePop();
@@ -260,18 +257,19 @@ void ProcessQueueManager::EnablePop(const string& configName) {
 bool ProcessQueueManager::Wait(uint64_t ms) {
     // TODO: use semaphore instead
     unique_lock<mutex> lock(mStateMux);
-    mCond.wait_for(lock, chrono::milliseconds(ms), [this] { return mValidToPop; });
-    if (mValidToPop) {
-        mValidToPop = false;
-        return true;
-    }
-    return false;
+    mCond.wait_for(lock, chrono::milliseconds(ms), [this] { return mValidToPop.load(); });
+    return mValidToPop.exchange(false);
 }
 
 void ProcessQueueManager::Trigger() {
+    // a pending notification is only consumed by Wait, after which the consumer scans the queues again and finds the
+    // new items as well, so there is no need to notify again
+    if (mValidToPop.exchange(true)) {
+        return;
+    }
     {
+        // make sure the consumer is either waiting or has not checked mValidToPop yet
         lock_guard<mutex> lock(mStateMux);
-        mValidToPop = true;
     }
     mCond.notify_one();
 }
@@ -327,7 +325,7 @@ void ProcessQueueManager::ResetCurrentQueueIndex() {
 
 #ifdef APSARA_UNIT_TEST_MAIN
 void ProcessQueueManager::Clear() {
-    lock_guard<mutex> lock(mQueueMux);
+    lock_guard<shared_mutex> lock(mQueueMux);
     mQueues.clear();
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         mPriorityQueue[i].clear();
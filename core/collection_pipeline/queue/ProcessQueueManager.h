@@ -18,10 +18,12 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -84,14 +86,20 @@ private:
 
     BoundedQueueParam mBoundedQueueParam;
 
-    mutable std::mutex mQueueMux;
+    // shared by producers and consumers, which only synchronize on the queue they access, and exclusive for changing
+    // the queues
+    mutable std::shared_mutex mQueueMux;
     std::unordered_map<QueueKey, std::pair<ProcessQueueIterator, QueueType>> mQueues;
     std::list<std::unique_ptr<ProcessQueueInterface>> mPriorityQueue[sMaxPriority + 1];
+    // protects mCurrentQueueIndex among consumers holding mQueueMux shared
+    std::mutex mPopMux;
     std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
 
     mutable std::mutex mStateMux;
     mutable std::condition_variable mCond;
-    bool mValidToPop = false;
+    // set without mStateMux, so that pushes before a consumer wakes up share the same notification. Only Wait clears
+    // it, since a push may happen behind a scan of PopItem that is about to fail.
+    std::atomic_bool mValidToPop = false;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
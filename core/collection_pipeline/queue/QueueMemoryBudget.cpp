@@ -0,0 +1,61 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/queue/QueueMemoryBudget.h"
+
+#include <algorithm>
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT64(queue_memory_budget_bytes,
+                  "bytes held by all bounded queues, 0 means half of the memory limit of the agent",
+                  0);
+
+using namespace std;
+
+namespace logtail {
+
+// same as the default ratio of BoundedQueueParam
+static constexpr double kLowWatermarkRatio = 2.0 / 3;
+
+size_t QueueMemoryBudget::GetLimit() const {
+    if (INT64_FLAG(queue_memory_budget_bytes) > 0) {
+        return static_cast<size_t>(INT64_FLAG(queue_memory_budget_bytes));
+    }
+    // memory limit is in MB
+    return static_cast<size_t>(max<int64_t>(AppConfig::GetInstance()->GetMemUsageUpLimit(), 0)) * 1024 * 1024 / 2;
+}
+
+bool QueueMemoryBudget::IsOverHighWatermark() const {
+    auto limit = GetLimit();
+    if (limit == 0) {
+        return false;
+    }
+    return mMemoryPressure.load(memory_order_relaxed) || GetUsedBytes() >= limit;
+}
+
+bool QueueMemoryBudget::IsBelowLowWatermark() const {
+    return !mMemoryPressure.load(memory_order_relaxed) && GetUsedBytes() <= GetLimit() * kLowWatermarkRatio;
+}
+
+size_t QueueMemoryBudget::GetQueueShare() const {
+    return GetLimit() / max<size_t>(mQueueCnt.load(memory_order_relaxed), 1);
+}
+
+size_t QueueMemoryBudget::GetQueueLowShare() const {
+    return GetQueueShare() * kLowWatermarkRatio;
+}
+
+} // namespace logtail
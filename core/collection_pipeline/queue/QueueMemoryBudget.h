@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace logtail {
+
+// Bytes held by all bounded process and sender queues. When the budget goes over its high watermark, queues holding
+// more than their share of the budget stop accepting data, so that the inputs are slowed down by the existing
+// feedback mechanism. Such a queue accepts data again once it drops below its low share or the budget drops below
+// its low watermark.
+// thread-safe, since process queues and sender queues are protected by different locks
+class QueueMemoryBudget {
+public:
+    QueueMemoryBudget(const QueueMemoryBudget&) = delete;
+    QueueMemoryBudget& operator=(const QueueMemoryBudget&) = delete;
+
+    static QueueMemoryBudget* GetInstance() {
+        static QueueMemoryBudget sInstance;
+        return &sInstance;
+    }
+
+    void AddQueue() { mQueueCnt.fetch_add(1, std::memory_order_relaxed); }
+    void RemoveQueue() { mQueueCnt.fetch_sub(1, std::memory_order_relaxed); }
+    void Add(size_t bytes) { mUsedBytes.fetch_add(bytes, std::memory_order_relaxed); }
+    void Sub(size_t bytes) { mUsedBytes.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    bool IsOverHighWatermark() const;
+    bool IsBelowLowWatermark() const;
+    size_t GetQueueShare() const;
+    size_t GetQueueLowShare() const;
+
+    size_t GetUsedBytes() const { return mUsedBytes.load(std::memory_order_relaxed); }
+    size_t GetLimit() const;
+
+    // set by the monitor when the rss of the agent exceeds the memory limit, queues over their share are blocked
+    // regardless of the budget then
+    void SetMemoryPressure(bool pressure) { mMemoryPressure.store(pressure, std::memory_order_relaxed); }
+
+private:
+    QueueMemoryBudget() = default;
+    ~QueueMemoryBudget() = default;
+
+    std::atomic_size_t mUsedBytes = 0;
+    std::atomic_size_t mQueueCnt = 0;
+    std::atomic_bool mMemoryPressure = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class QueueMemoryBudgetUnittest;
+#endif
+};
+
+} // namespace logtail
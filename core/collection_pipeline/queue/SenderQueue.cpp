@@ -36,6 +36,7 @@ bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
 
     ADD_COUNTER(mInItemsTotal, 1);
     ADD_COUNTER(mInItemDataSizeBytes, size);
+    AddDataSize(size);
 
     if (Full()) {
         mExtraBuffer.push_back(std::move(item));
@@ -87,6 +88,7 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
         ++mRead;
     }
     --mSize;
+    SubDataSize(size);
 
     ADD_COUNTER(mOutItemsTotal, 1);
     ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - enQueuTime);
@@ -14,8 +14,14 @@
 
 #include "collection_pipeline/serializer/JsonSerializer.h"
 
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cmath>
+
+#include "rapidjson/internal/dtoa.h"
+#include "rapidjson/internal/itoa.h"
 
 #include "constants/Constants.h"
 #include "constants/SpanConstants.h"
@@ -25,17 +31,128 @@ using namespace std;
 
 namespace logtail {
 
-// Helper function to serialize common fields (tags and time)
-template <typename WriterType>
-void SerializeCommonFields(const SizedMap& tags, uint64_t timestamp, WriterType& writer) {
-    // Serialize tags
+// The output is byte-for-byte the same as rapidjson::Writer with default flags, but strings are escaped directly
+// from StringView into the result, so no temporary std::string or json buffer is needed for each field.
+
+static const char kHexDigits[] = "0123456789ABCDEF";
+
+// Returns the offset of the first char which must be escaped in json string, i.e. '"', '\\' or control chars.
+static size_t FindCharToEscape(const char* data, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i maxCtrl = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        // unsigned chunk <= 0x1F iff max(chunk, 0x1F) == 0x1F
+        __m128i ctrl = _mm_cmpeq_epi8(_mm_max_epu8(chunk, maxCtrl), maxCtrl);
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                       ctrl);
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c == '"' || c == '\\' || c < 0x20) {
+            return i;
+        }
+    }
+    return size;
+}
+
+static void AppendString(string& res, StringView str) {
+    res.push_back('"');
+    const char* data = str.data();
+    size_t size = str.size();
+    size_t pos = 0;
+    while (pos < size) {
+        size_t next = pos + FindCharToEscape(data + pos, size - pos);
+        res.append(data + pos, next - pos);
+        if (next == size) {
+            break;
+        }
+        unsigned char c = static_cast<unsigned char>(data[next]);
+        switch (c) {
+            case '"':
+                res.append("\\\"", 2);
+                break;
+            case '\\':
+                res.append("\\\\", 2);
+                break;
+            case '\b':
+                res.append("\\b", 2);
+                break;
+            case '\f':
+                res.append("\\f", 2);
+                break;
+            case '\n':
+                res.append("\\n", 2);
+                break;
+            case '\r':
+                res.append("\\r", 2);
+                break;
+            case '\t':
+                res.append("\\t", 2);
+                break;
+            default: {
+                char buf[6] = {'\\', 'u', '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0xF]};
+                res.append(buf, sizeof(buf));
+                break;
+            }
+        }
+        pos = next + 1;
+    }
+    res.push_back('"');
+}
+
+static void AppendKey(string& res, StringView key) {
+    AppendString(res, key);
+    res.push_back(':');
+}
+
+static void AppendUint64(string& res, uint64_t value) {
+    char buf[24];
+    char* end = rapidjson::internal::u64toa(value, buf);
+    res.append(buf, end - buf);
+}
+
+static void AppendDouble(string& res, double value) {
+    if (!std::isfinite(value)) {
+        // not representable in json
+        res.append("null");
+        return;
+    }
+    char buf[32];
+    char* end = rapidjson::internal::dtoa(value, buf);
+    res.append(buf, end - buf);
+}
+
+// Renders `{"tag1":"value1",...,"__time__":`, which is shared by all events in the group.
+static void RenderCommonPrefix(const SizedMap& tags, string& prefix) {
+    prefix.push_back('{');
     for (const auto& tag : tags.mInner) {
-        writer.Key(tag.first.to_string().c_str());
-        writer.String(tag.second.to_string().c_str());
+        AppendKey(prefix, tag.first);
+        AppendString(prefix, tag.second);
+        prefix.push_back(',');
     }
-    // Serialize time
-    writer.Key("__time__");
-    writer.Uint64(timestamp);
+    AppendKey(prefix, "__time__");
+}
+
+template <typename Iterator>
+static void AppendStringMap(string& res, Iterator begin, Iterator end) {
+    res.push_back('{');
+    for (auto it = begin; it != end; ++it) {
+        if (it != begin) {
+            res.push_back(',');
+        }
+        AppendKey(res, it->first);
+        AppendString(res, it->second);
+    }
+    res.push_back('}');
 }
 
 bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
@@ -51,13 +168,10 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
         return false;
     }
 
-    // Create reusable StringBuffer and Writer
-    rapidjson::StringBuffer jsonBuffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(jsonBuffer);
-    auto resetBuffer = [&jsonBuffer, &writer]() {
-        jsonBuffer.Clear(); // Clear the buffer for reuse
-        writer.Reset(jsonBuffer);
-    };
+    string prefix;
+    RenderCommonPrefix(group.mTags, prefix);
+    // escaping seldom enlarges the data much, so the raw size plus the repeated prefix is a close estimation
+    res.reserve(res.size() + group.mSizeBytes + group.mEvents.size() * (prefix.size() + 32));
 
     // TODO: should support nano second
     switch (eventType) {
@@ -67,18 +181,15 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 if (e.Empty()) {
                     continue;
                 }
-                resetBuffer();
-
-                writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                res.append(prefix);
+                AppendUint64(res, e.GetTimestamp());
                 // contents
                 for (const auto& kv : e) {
-                    writer.Key(kv.first.to_string().c_str());
-                    writer.String(kv.second.to_string().c_str());
+                    res.push_back(',');
+                    AppendKey(res, kv.first);
+                    AppendString(res, kv.second);
                 }
-                writer.EndObject();
-                res.append(jsonBuffer.GetString());
-                res.append("\n");
+                res.append("}\n");
             }
             break;
         case PipelineEvent::Type::METRIC:
@@ -88,38 +199,34 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 if (e.Is<std::monostate>()) {
                     continue;
                 }
-                resetBuffer();
-
-                writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                res.append(prefix);
+                AppendUint64(res, e.GetTimestamp());
                 // __labels__
-                writer.Key(METRIC_RESERVED_KEY_LABELS.c_str());
-                writer.StartObject();
-                for (auto tag = e.TagsBegin(); tag != e.TagsEnd(); tag++) {
-                    writer.Key(tag->first.to_string().c_str());
-                    writer.String(tag->second.to_string().c_str());
-                }
-                writer.EndObject();
+                res.push_back(',');
+                AppendKey(res, METRIC_RESERVED_KEY_LABELS);
+                AppendStringMap(res, e.TagsBegin(), e.TagsEnd());
                 // __name__
-                writer.Key(METRIC_RESERVED_KEY_NAME.c_str());
-                writer.String(e.GetName().to_string().c_str());
+                res.push_back(',');
+                AppendKey(res, METRIC_RESERVED_KEY_NAME);
+                AppendString(res, e.GetName());
                 // __value__
-                writer.Key(METRIC_RESERVED_KEY_VALUE.c_str());
+                res.push_back(',');
+                AppendKey(res, METRIC_RESERVED_KEY_VALUE);
                 if (e.Is<UntypedSingleValue>()) {
-                    writer.Double(e.GetValue<UntypedSingleValue>()->mValue);
+                    AppendDouble(res, e.GetValue<UntypedSingleValue>()->mValue);
                 } else if (e.Is<UntypedMultiDoubleValues>()) {
-                    writer.StartObject();
-                    for (auto value = e.GetValue<UntypedMultiDoubleValues>()->ValuesBegin();
-                         value != e.GetValue<UntypedMultiDoubleValues>()->ValuesEnd();
-                         value++) {
-                        writer.Key(value->first.to_string().c_str());
-                        writer.Double(value->second.Value);
+                    const auto* values = e.GetValue<UntypedMultiDoubleValues>();
+                    res.push_back('{');
+                    for (auto value = values->ValuesBegin(); value != values->ValuesEnd(); value++) {
+                        if (value != values->ValuesBegin()) {
+                            res.push_back(',');
+                        }
+                        AppendKey(res, value->first);
+                        AppendDouble(res, value->second.Value);
                     }
-                    writer.EndObject();
+                    res.push_back('}');
                 }
-                writer.EndObject();
-                res.append(jsonBuffer.GetString());
-                res.append("\n");
+                res.append("}\n");
             }
             break;
         case PipelineEvent::Type::RAW:
@@ -128,62 +235,54 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 if (e.GetContent().empty()) {
                     continue;
                 }
-                resetBuffer();
-
-                writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                res.append(prefix);
+                AppendUint64(res, e.GetTimestamp());
                 // content
-                writer.Key(DEFAULT_CONTENT_KEY.c_str());
-                writer.String(e.GetContent().to_string().c_str());
-                writer.EndObject();
-                res.append(jsonBuffer.GetString());
-                res.append("\n");
+                res.push_back(',');
+                AppendKey(res, DEFAULT_CONTENT_KEY);
+                AppendString(res, e.GetContent());
+                res.append("}\n");
             }
             break;
         case PipelineEvent::Type::SPAN:
             for (const auto& item : group.mEvents) {
                 const auto& e = item.Cast<SpanEvent>();
 
-                resetBuffer();
-
-                writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
-
-                writer.Key(DEFAULT_TRACE_TAG_TRACE_ID.data(), DEFAULT_TRACE_TAG_TRACE_ID.size());
-                writer.String(e.GetTraceId().data(), e.GetTraceId().size());
-                writer.Key(DEFAULT_TRACE_TAG_SPAN_ID.data(), DEFAULT_TRACE_TAG_SPAN_ID.size());
-                writer.String(e.GetSpanId().data(), e.GetSpanId().size());
-                writer.Key(DEFAULT_TRACE_TAG_PARENT_ID.data(), DEFAULT_TRACE_TAG_PARENT_ID.size());
-                writer.String(e.GetParentSpanId().data(), e.GetParentSpanId().size());
-                writer.Key(DEFAULT_TRACE_TAG_SPAN_NAME.data(), DEFAULT_TRACE_TAG_SPAN_NAME.size());
-                writer.String(e.GetName().data(), e.GetName().size());
-
-                writer.Key(DEFAULT_TRACE_TAG_START_TIME_NANO.data(), DEFAULT_TRACE_TAG_START_TIME_NANO.size());
-                writer.Uint64(e.GetStartTimeNs());
-                writer.Key(DEFAULT_TRACE_TAG_END_TIME_NANO.data(), DEFAULT_TRACE_TAG_END_TIME_NANO.size());
-                writer.Uint64(e.GetEndTimeNs());
-                writer.Key(DEFAULT_TRACE_TAG_DURATION.data(), DEFAULT_TRACE_TAG_DURATION.size());
-                writer.Uint64(e.GetEndTimeNs() - e.GetStartTimeNs());
-
-                writer.Key(DEFAULT_TRACE_TAG_ATTRIBUTES.data(), DEFAULT_TRACE_TAG_ATTRIBUTES.size());
-                writer.StartObject();
-                for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
-                    writer.Key(it->first.data(), it->first.size());
-                    writer.String(it->second.data(), it->second.size());
-                }
-                writer.EndObject();
+                res.append(prefix);
+                AppendUint64(res, e.GetTimestamp());
 
-                writer.Key(DEFAULT_TRACE_TAG_SCOPE.data(), DEFAULT_TRACE_TAG_SCOPE.size());
-                writer.StartObject();
-                for (auto it = e.ScopeTagsBegin(); it != e.ScopeTagsEnd(); ++it) {
-                    writer.Key(it->first.data(), it->first.size());
-                    writer.String(it->second.data(), it->second.size());
-                }
-                writer.EndObject();
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_TRACE_ID);
+                AppendString(res, e.GetTraceId());
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_SPAN_ID);
+                AppendString(res, e.GetSpanId());
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_PARENT_ID);
+                AppendString(res, e.GetParentSpanId());
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_SPAN_NAME);
+                AppendString(res, e.GetName());
+
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_START_TIME_NANO);
+                AppendUint64(res, e.GetStartTimeNs());
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_END_TIME_NANO);
+                AppendUint64(res, e.GetEndTimeNs());
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_DURATION);
+                AppendUint64(res, e.GetEndTimeNs() - e.GetStartTimeNs());
+
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_ATTRIBUTES);
+                AppendStringMap(res, e.TagsBegin(), e.TagsEnd());
+
+                res.push_back(',');
+                AppendKey(res, DEFAULT_TRACE_TAG_SCOPE);
+                AppendStringMap(res, e.ScopeTagsBegin(), e.ScopeTagsEnd());
 
-                writer.EndObject();
-                res.append(jsonBuffer.GetString());
-                res.append("\n");
+                res.append("}\n");
             }
             break;
         default:
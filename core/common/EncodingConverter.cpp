@@ -14,10 +14,17 @@
 
 #include "EncodingConverter.h"
 
+#include <cstring>
+
 #include "AlarmManager.h"
 #include "logger/Logger.h"
 #if defined(__linux__)
 #include <iconv.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #elif defined(_MSC_VER)
 #include <Windows.h>
 #endif
@@ -25,32 +32,152 @@
 namespace logtail {
 
 #if defined(__linux__)
-static iconv_t mGbk2Utf8Cd = (iconv_t)-1;
+static constexpr size_t kGbkSingleByteCount = 0x80;
+static constexpr uint8_t kGbkLeadMin = 0x81;
+static constexpr uint8_t kGbkLeadMax = 0xFE;
+static constexpr uint8_t kGbkTrailMin = 0x40;
+static constexpr uint8_t kGbkTrailMax = 0xFE;
+static constexpr size_t kGbkTrailCount = kGbkTrailMax - kGbkTrailMin + 1;
+static constexpr long kGbkInvalidSequence = -1;
+static constexpr long kGbkOutputOverflow = -2;
 #endif
 
 EncodingConverter::EncodingConverter() {
 #if defined(__linux__)
-    mGbk2Utf8Cd = iconv_open("UTF-8", "GBK");
-    if (mGbk2Utf8Cd == (iconv_t)(-1))
-        LOG_ERROR(sLogger, ("create Gbk2Utf8 iconv descriptor fail, errno", strerror(errno)));
-    else
-        iconv(mGbk2Utf8Cd, NULL, NULL, NULL, NULL);
+    InitGbk2UnicodeTable();
 #endif
 }
 
 EncodingConverter::~EncodingConverter() {
+}
+
 #if defined(__linux__)
-    if (mGbk2Utf8Cd != (iconv_t)(-1))
-        iconv_close(mGbk2Utf8Cd);
+void EncodingConverter::InitGbk2UnicodeTable() {
+    iconv_t cd = iconv_open("UTF-16LE", "GBK");
+    if (cd == (iconv_t)(-1)) {
+        LOG_ERROR(sLogger, ("create Gbk2Utf8 iconv descriptor fail, errno", strerror(errno)));
+        return;
+    }
+    auto lookup = [&cd](const char* gbk, size_t len) -> uint16_t {
+        char* in = const_cast<char*>(gbk);
+        size_t inLeft = len;
+        char out[4];
+        char* outPtr = out;
+        size_t outLeft = sizeof(out);
+        iconv(cd, NULL, NULL, NULL, NULL);
+        // only one BMP code point is expected, anything else is treated as invalid
+        if (iconv(cd, &in, &inLeft, &outPtr, &outLeft) == (size_t)(-1) || inLeft != 0 || outPtr - out != 2) {
+            return 0;
+        }
+        return static_cast<uint16_t>(static_cast<uint8_t>(out[0]) | (static_cast<uint8_t>(out[1]) << 8));
+    };
+
+    mGbk2UnicodeTable.assign(kGbkSingleByteCount + (kGbkLeadMax - kGbkLeadMin + 1) * kGbkTrailCount, 0);
+    for (size_t b = 0x80; b <= 0xFF; ++b) {
+        char gbk = static_cast<char>(b);
+        mGbk2UnicodeTable[b - 0x80] = lookup(&gbk, 1);
+    }
+    for (size_t lead = kGbkLeadMin; lead <= kGbkLeadMax; ++lead) {
+        for (size_t trail = kGbkTrailMin; trail <= kGbkTrailMax; ++trail) {
+            char gbk[2] = {static_cast<char>(lead), static_cast<char>(trail)};
+            mGbk2UnicodeTable[kGbkSingleByteCount + (lead - kGbkLeadMin) * kGbkTrailCount + trail - kGbkTrailMin]
+                = lookup(gbk, 2);
+        }
+    }
+    iconv_close(cd);
+}
+
+long EncodingConverter::ConvertGbkLine(const char* src, size_t srcLength, char* des, size_t slack) const {
+    const auto* in = reinterpret_cast<const uint8_t*>(src);
+    const uint16_t* table = mGbk2UnicodeTable.data();
+    char* out = des;
+    size_t pos = 0;
+    while (pos < srcLength) {
+        // copy ASCII runs directly
+#if defined(__AVX2__)
+        while (pos + 32 <= srcLength) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + pos));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(chunk));
+            if (mask != 0) {
+                int asciiCnt = __builtin_ctz(mask);
+                memcpy(out, in + pos, asciiCnt);
+                out += asciiCnt;
+                pos += asciiCnt;
+                break;
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chunk);
+            out += 32;
+            pos += 32;
+        }
+#endif
+#if defined(__SSE2__)
+        while (pos + 16 <= srcLength) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pos));
+            int mask = _mm_movemask_epi8(chunk);
+            if (mask != 0) {
+                int asciiCnt = __builtin_ctz(mask);
+                memcpy(out, in + pos, asciiCnt);
+                out += asciiCnt;
+                pos += asciiCnt;
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chunk);
+            out += 16;
+            pos += 16;
+        }
 #endif
+        while (pos < srcLength && in[pos] < 0x80) {
+            *out++ = static_cast<char>(in[pos++]);
+        }
+        if (pos == srcLength) {
+            break;
+        }
+
+        uint16_t code = 0;
+        uint8_t lead = in[pos];
+        if (lead >= kGbkLeadMin && lead <= kGbkLeadMax) {
+            if (pos + 1 == srcLength) {
+                return kGbkInvalidSequence;
+            }
+            uint8_t trail = in[pos + 1];
+            if (trail < kGbkTrailMin || trail > kGbkTrailMax) {
+                return kGbkInvalidSequence;
+            }
+            code = table[kGbkSingleByteCount + (lead - kGbkLeadMin) * kGbkTrailCount + trail - kGbkTrailMin];
+            pos += 2;
+        } else {
+            code = table[lead - 0x80];
+            pos += 1;
+            // the single byte euro sign takes 3 bytes in UTF-8, keep the output within 2x of the input plus the space
+            // saved by previous lines
+            if (code >= 0x800 && static_cast<size_t>(out - des) + 3 > pos * 2 + slack) {
+                return kGbkOutputOverflow;
+            }
+        }
+        if (code == 0) {
+            return kGbkInvalidSequence;
+        }
+        if (code < 0x80) {
+            *out++ = static_cast<char>(code);
+        } else if (code < 0x800) {
+            *out++ = static_cast<char>(0xC0 | (code >> 6));
+            *out++ = static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            *out++ = static_cast<char>(0xE0 | (code >> 12));
+            *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+    return out - des;
 }
+#endif
 
 // TODO: Refactor it, do not use the output params to do calculations, set them before return.
 size_t EncodingConverter::ConvertGbk2Utf8(
     const char* src, size_t* srcLength, char* desOut, size_t desLength, const std::vector<long>& linePosVec) const {
 #if defined(__linux__)
-    if (src == NULL || *srcLength == 0 || mGbk2Utf8Cd == (iconv_t)(-1)) {
-        LOG_ERROR(sLogger, ("invalid iconv descriptor fail or invalid buffer pointer, cd", mGbk2Utf8Cd));
+    if (src == NULL || *srcLength == 0 || mGbk2UnicodeTable.empty()) {
+        LOG_ERROR(sLogger, ("invalid iconv descriptor fail or invalid buffer pointer, src", (void*)src));
         return 0;
     }
     size_t maxRequire = *srcLength * 2;
@@ -60,33 +187,28 @@ size_t EncodingConverter::ConvertGbk2Utf8(
     if (desLength < maxRequire + 1) {
         return 0;
     }
-    char* des = desOut;
-    des[*srcLength * 2] = '\0';
-    const char* originSrc = src;
-    char* originDes = des;
+    desOut[*srcLength * 2] = '\0';
     size_t beginIndex = 0;
-    size_t endIndex = *srcLength;
     size_t destIndex = 0;
-    size_t maxDestSize = desLength;
     for (size_t i = 0; i < linePosVec.size(); ++i) {
-        endIndex = linePosVec[i];
-        src = originSrc + beginIndex;
-        des = originDes + destIndex;
-        // include '\n'
-        *srcLength = endIndex - beginIndex + 1;
-        desLength = maxDestSize - destIndex;
-        size_t ret = iconv(mGbk2Utf8Cd, const_cast<char**>(&src), srcLength, &des, &desLength);
-        if (ret == (size_t)(-1)) {
-            LOG_ERROR(sLogger, ("convert GBK to UTF8 fail, errno", strerror(errno)));
-            iconv(mGbk2Utf8Cd, NULL, NULL, NULL, NULL); // Clear status.
-            AlarmManager::GetInstance()->SendAlarmWarning(ENCODING_CONVERT_ALARM, "convert GBK to UTF8 fail");
+        size_t endIndex = linePosVec[i] + 1; // include '\n'
+        if (endIndex <= beginIndex) {
+            continue;
+        }
+        size_t lineLength = endIndex - beginIndex;
+        long ret = ConvertGbkLine(src + beginIndex, lineLength, desOut + destIndex, beginIndex * 2 - destIndex);
+        if (ret < 0) {
+            if (ret == kGbkInvalidSequence) {
+                LOG_ERROR(sLogger, ("convert GBK to UTF8 fail, invalid GBK sequence, line offset", beginIndex));
+                AlarmManager::GetInstance()->SendAlarmWarning(ENCODING_CONVERT_ALARM, "convert GBK to UTF8 fail");
+            }
             // use memcpy
-            memcpy(originDes + destIndex, originSrc + beginIndex, endIndex - beginIndex + 1);
-            destIndex += endIndex - beginIndex + 1;
+            memcpy(desOut + destIndex, src + beginIndex, lineLength);
+            destIndex += lineLength;
         } else {
-            destIndex = des - originDes;
+            destIndex += ret;
         }
-        beginIndex = endIndex + 1;
+        beginIndex = endIndex;
     }
     return destIndex;
 
@@ -18,6 +18,7 @@
 #define __SLS_ILOGTAIL_ENCODING_CONVERTER_H__
 
 #include <cstddef>
+#include <cstdint>
 
 #include <string>
 #include <vector>
@@ -32,6 +33,17 @@ private:
     EncodingConverter();
     ~EncodingConverter();
 
+#if defined(__linux__)
+    // GBK -> Unicode (BMP) lookup table, generated by iconv once at startup, 0 means invalid sequence.
+    // [0, 128) for single byte 0x80 ~ 0xFF, followed by double bytes with lead 0x81 ~ 0xFE and trail 0x40 ~ 0xFE.
+    std::vector<uint16_t> mGbk2UnicodeTable;
+
+    void InitGbk2UnicodeTable();
+    // returns the number of bytes written to @des (never more than 2x of @srcLength plus @slack), or a negative value if
+    // the line contains invalid GBK sequence or cannot be converted within that space
+    long ConvertGbkLine(const char* src, size_t srcLength, char* des, size_t slack) const;
+#endif
+
 public:
     // notice: this is not thread-safe !
     static EncodingConverter* GetInstance() {
@@ -48,9 +60,9 @@ public:
     //          This API design mimics snprintf.
     //
     // Different platforms have different implementations:
-    // - For Linux, ConvertGbk2Utf8 converts line by line according to @linePosVec.
-    //   If there is error happened during converting, corresponding line will be copied
-    //   to @des without converting.
+    // - For Linux, ConvertGbk2Utf8 converts the whole buffer in one pass with a lookup table, ASCII runs are copied
+    //   directly. Lines are delimited by @linePosVec, if there is error happened during converting, corresponding
+    //   line will be copied to @des without converting.
     // - For Windows, ConvertGbk2Utf8 converts whole @src, if any errors happened,
     //   0 will be returned (ignore @linePosVec).
     size_t ConvertGbk2Utf8(
@@ -26,6 +26,8 @@ namespace logtail {
 // TODO: Same implementation in sdk module, merge them.
 void DoMd5(const uint8_t* poolIn, const uint64_t inputBytesNum, uint8_t md5[16]);
 std::string CalcMD5(const std::string& message);
+// Same as CalcMD5, but writes the 32 hex chars to @md5Hex directly.
+void CalcMD5(const char* message, size_t len, char md5Hex[32]);
 
 bool SignatureToHash(const std::string& signature, uint64_t& sigHash, uint32_t& sigSize);
 bool CheckAndUpdateSignature(const std::string& signature, uint64_t& sigHash, uint32_t& sigSize);
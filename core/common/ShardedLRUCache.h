@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "common/LRUCache.h"
+
+namespace logtail {
+
+// A thread-safe LRU cache split into independent shards by key hash, each guarded by its own lock. Readers on
+// different keys rarely contend, which matters when many threads hit the cache on every event. LRU order and
+// capacity are maintained per shard, so eviction is approximate with respect to the whole cache.
+template <class Key, class Value, size_t ShardNum = 16, class Hash = std::hash<Key>>
+class ShardedLRUCache {
+public:
+    static_assert(ShardNum > 0 && (ShardNum & (ShardNum - 1)) == 0, "ShardNum must be a power of 2");
+
+    explicit ShardedLRUCache(size_t maxSize = 64, size_t elasticity = 10) {
+        size_t shardSize = (maxSize + ShardNum - 1) / ShardNum;
+        size_t shardElasticity = (elasticity + ShardNum - 1) / ShardNum;
+        for (auto& shard : mShards) {
+            shard = std::make_unique<Shard>(shardSize, shardElasticity);
+        }
+    }
+
+    void insert(const Key& k, Value v) { GetShard(k).insert(k, std::move(v)); }
+    bool tryGetCopy(const Key& k, Value& v) { return GetShard(k).tryGetCopy(k, v); }
+    bool contains(const Key& k) const { return GetShard(k).contains(k); }
+    bool remove(const Key& k) { return GetShard(k).remove(k); }
+
+    size_t size() const {
+        size_t res = 0;
+        for (const auto& shard : mShards) {
+            res += shard->size();
+        }
+        return res;
+    }
+
+    void clear() {
+        for (auto& shard : mShards) {
+            shard->clear();
+        }
+    }
+
+private:
+    using Shard = lru11::Cache<Key, Value, std::mutex>;
+
+    Shard& GetShard(const Key& k) const { return *mShards[Hash()(k) & (ShardNum - 1)]; }
+
+    std::array<std::unique_ptr<Shard>, ShardNum> mShards;
+};
+
+} // namespace logtail
@@ -25,6 +25,9 @@
 
 namespace logtail {
 
+// changes older than this are dropped, configs which have not checked since then are fully re-evaluated
+static const size_t kMaxContainerChangeLogSize = 10000;
+
 // Forward declarations for helpers used across this file
 static Json::Value SerializeRawContainerInfo(const std::shared_ptr<RawContainerInfo>& info);
 static std::shared_ptr<RawContainerInfo> DeserializeRawContainerInfo(const Json::Value& v);
@@ -261,19 +264,32 @@ bool ContainerManager::checkContainerDiffForOneConfig(FileDiscoveryOptions* opti
             containerInfoMap[info.mRawContainerInfo->mID] = info.mRawContainerInfo;
         }
     }
-    std::vector<std::string> removedList;
-    std::vector<std::string> matchAddedList;
     ContainerDiff diff;
-    computeMatchedContainersDiff(*(options->GetFullContainerList()),
-                                 containerInfoMap,
-                                 options->GetContainerDiscoveryOptions().mContainerFilters,
-                                 options->GetContainerDiscoveryOptions().mIsStdio,
-                                 diff);
+    const auto& discoveryOptions = options->GetContainerDiscoveryOptions();
+    {
+        std::lock_guard<std::mutex> lock(mContainerMapMutex);
+        std::unordered_set<std::string> changedContainerIDs;
+        if (getChangedContainerIDsSince(options->GetLastContainerChangeSeq(), changedContainerIDs)) {
+            computeChangedContainersDiff(*(options->GetFullContainerList()),
+                                         containerInfoMap,
+                                         discoveryOptions.mContainerFilters,
+                                         discoveryOptions.mIsStdio,
+                                         changedContainerIDs,
+                                         diff);
+        } else {
+            computeMatchedContainersDiff(*(options->GetFullContainerList()),
+                                         containerInfoMap,
+                                         discoveryOptions.mContainerFilters,
+                                         discoveryOptions.mIsStdio,
+                                         diff);
+        }
+        options->SetLastContainerChangeSeq(mContainerChangeSeq);
+    }
 
     LOG_DEBUG(
         sLogger,
         ("diff", diff.ToString())("configName", ctx->GetConfigName())(
-            "containerFilters", options->GetContainerDiscoveryOptions().mContainerFilters.ToString())(
+            "containerFilters", discoveryOptions.mContainerFilters.ToString())(
             "fullContainerList", options->GetFullContainerList()->size())("containerInfos", containerInfos->size())(
             "lastConfigContainerUpdateTime", options->GetLastContainerUpdateTime())("mLastUpdateTime",
                                                                                     mLastUpdateTime));
@@ -315,6 +331,7 @@ void ContainerManager::incrementallyUpdateContainersSnapshot() {
             {
                 std::lock_guard<std::mutex> lock(mContainerMapMutex);
                 mContainerMap[containerInfo->mID] = containerInfo;
+                recordContainerChange(containerInfo->mID);
             }
             updatedContainerIDs.push_back(containerInfo->mID);
             hasChanges = true;
@@ -326,6 +343,7 @@ void ContainerManager::incrementallyUpdateContainersSnapshot() {
         {
             std::lock_guard<std::mutex> lock(mContainerMapMutex);
             if (mContainerMap.erase(containerId) > 0) {
+                recordContainerChange(containerId);
                 hasChanges = true;
             }
         }
@@ -376,6 +394,18 @@ void ContainerManager::refreshAllContainersSnapshot() {
     }
     {
         std::lock_guard<std::mutex> lock(mContainerMapMutex);
+        // only containers which really changed are recorded, so that configs don't re-evaluate the whole snapshot
+        for (const auto& pair : tmpContainerMap) {
+            auto it = mContainerMap.find(pair.first);
+            if (it == mContainerMap.end() || *it->second != *pair.second) {
+                recordContainerChange(pair.first);
+            }
+        }
+        for (const auto& pair : mContainerMap) {
+            if (tmpContainerMap.find(pair.first) == tmpContainerMap.end()) {
+                recordContainerChange(pair.first);
+            }
+        }
         mContainerMap.swap(tmpContainerMap);
     }
     mLastUpdateTime = time(nullptr);
@@ -576,8 +606,8 @@ void ContainerManager::computeMatchedContainersDiff(
     // 更新匹配的容器状态
     for (auto& pair : matchList) {
         if (auto it = mContainerMap.find(pair.first); it != mContainerMap.end()) {
-            // 更新为最新的 info
-            if (*pair.second != *it->second) {
+            // 更新为最新的 info，指针相同时无需逐字段比较
+            if (pair.second != it->second && *pair.second != *it->second) {
                 diff.mModified.push_back(it->second);
             }
         }
@@ -588,31 +618,82 @@ void ContainerManager::computeMatchedContainersDiff(
         // 如果 fullContainerIDList 中不存在该 id
         if (fullContainerIDList.find(pair.first) == fullContainerIDList.end()) {
             fullContainerIDList.insert(pair.first); // 加入到 fullContainerIDList
-
-            if (!isStdio && pair.second->mStatus != "running") {
-                continue;
+            if (isMatchedContainer(*pair.second, filters, isStdio)) {
+                diff.mAdded.push_back(pair.second); // 添加到变换列表
             }
+        }
+    }
+}
 
-            bool isContainerLabelMatch = IsMapLabelsMatch(filters.mContainerLabelFilter, pair.second->mContainerLabels);
-            if (!isContainerLabelMatch) {
-                continue;
-            }
-            bool isEnvMatch = IsMapLabelsMatch(filters.mEnvFilter, pair.second->mEnv);
-            if (!isEnvMatch) {
-                continue;
-            }
-            bool isK8sMatch = IsK8sFilterMatch(filters.mK8SFilter, pair.second->mK8sInfo);
-            if (!isK8sMatch) {
-                continue;
+void ContainerManager::computeChangedContainersDiff(
+    std::set<std::string>& fullContainerIDList,
+    const std::unordered_map<std::string, std::shared_ptr<RawContainerInfo>>& matchList,
+    const ContainerFilters& filters,
+    bool isStdio,
+    const std::unordered_set<std::string>& changedContainerIDs,
+    ContainerDiff& diff) {
+    // containers not changed since last check can't produce any diff, so only changed ones are evaluated with the
+    // same rules as computeMatchedContainersDiff
+    for (const auto& id : changedContainerIDs) {
+        auto it = mContainerMap.find(id);
+        auto matchIt = matchList.find(id);
+        if (it == mContainerMap.end()) {
+            fullContainerIDList.erase(id);
+            if (matchIt != matchList.end()) {
+                diff.mRemoved.push_back(id);
             }
-            // 检查标签和环境匹配
-            if (isContainerLabelMatch && isEnvMatch && isK8sMatch) {
-                diff.mAdded.push_back(pair.second); // 添加到变换列表
+            continue;
+        }
+        if (matchIt != matchList.end()) {
+            if (matchIt->second != it->second && *matchIt->second != *it->second) {
+                diff.mModified.push_back(it->second);
             }
+            continue;
+        }
+        if (fullContainerIDList.insert(id).second && isMatchedContainer(*it->second, filters, isStdio)) {
+            diff.mAdded.push_back(it->second);
         }
     }
 }
 
+bool ContainerManager::isMatchedContainer(const RawContainerInfo& info,
+                                          const ContainerFilters& filters,
+                                          bool isStdio) const {
+    if (!isStdio && info.mStatus != "running") {
+        return false;
+    }
+    // 检查标签和环境匹配
+    return IsMapLabelsMatch(filters.mContainerLabelFilter, info.mContainerLabels)
+        && IsMapLabelsMatch(filters.mEnvFilter, info.mEnv) && IsK8sFilterMatch(filters.mK8SFilter, info.mK8sInfo);
+}
+
+void ContainerManager::recordContainerChange(const std::string& containerID) {
+    mContainerChangeLog.emplace_back(++mContainerChangeSeq, containerID);
+    if (mContainerChangeLog.size() > kMaxContainerChangeLogSize) {
+        mContainerChangeLogBaseSeq = mContainerChangeLog.front().first;
+        mContainerChangeLog.pop_front();
+    }
+}
+
+void ContainerManager::resetContainerChangeLog() {
+    mContainerChangeLog.clear();
+    mContainerChangeLogBaseSeq = ++mContainerChangeSeq;
+}
+
+bool ContainerManager::getChangedContainerIDsSince(uint64_t seq, std::unordered_set<std::string>& containerIDs) const {
+    if (seq == 0 || seq < mContainerChangeLogBaseSeq) {
+        return false;
+    }
+    auto it = std::upper_bound(mContainerChangeLog.begin(),
+                               mContainerChangeLog.end(),
+                               seq,
+                               [](uint64_t s, const std::pair<uint64_t, std::string>& item) { return s < item.first; });
+    for (; it != mContainerChangeLog.end(); ++it) {
+        containerIDs.insert(it->second);
+    }
+    return true;
+}
+
 // Serialize RawContainerInfo (complete fields)
 static Json::Value SerializeRawContainerInfo(const std::shared_ptr<RawContainerInfo>& info) {
     Json::Value v(Json::objectValue);
@@ -928,6 +1009,7 @@ void ContainerManager::loadContainerInfoFromDetailFormat(const Json::Value& root
         {
             std::lock_guard<std::mutex> lock(mContainerMapMutex);
             mContainerMap.swap(tmpContainerMap);
+            resetContainerChangeLog();
         }
 
         // Update config container diffs for each config
@@ -969,6 +1051,7 @@ void ContainerManager::loadContainerInfoFromContainersFormat(const Json::Value&
         {
             std::lock_guard<std::mutex> lock(mContainerMapMutex);
             mContainerMap.swap(tmp);
+            resetContainerChangeLog();
         }
         // Apply containers to all existing configs
         auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
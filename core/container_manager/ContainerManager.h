@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <deque>
 #include <future>
 #include <string>
 #include <unordered_map>
@@ -75,6 +76,20 @@ private:
                                  const ContainerFilters& filters,
                                  bool isStdio,
                                  ContainerDiff& diff);
+    // same as computeMatchedContainersDiff, but only containers in changedContainerIDs are evaluated
+    void
+    computeChangedContainersDiff(std::set<std::string>& fullContainerIDList,
+                                 const std::unordered_map<std::string, std::shared_ptr<RawContainerInfo>>& matchList,
+                                 const ContainerFilters& filters,
+                                 bool isStdio,
+                                 const std::unordered_set<std::string>& changedContainerIDs,
+                                 ContainerDiff& diff);
+    bool isMatchedContainer(const RawContainerInfo& info, const ContainerFilters& filters, bool isStdio) const;
+
+    // must be called with mContainerMapMutex held
+    void recordContainerChange(const std::string& containerID);
+    void resetContainerChangeLog();
+    bool getChangedContainerIDsSince(uint64_t seq, std::unordered_set<std::string>& containerIDs) const;
 
     void loadContainerInfoFromDetailFormat(const Json::Value& root, const std::string& configPath);
     void loadContainerInfoFromContainersFormat(const Json::Value& root, const std::string& configPath);
@@ -89,6 +104,12 @@ private:
     std::unordered_map<std::string, std::shared_ptr<ContainerDiff>> mConfigContainerDiffMap;
     std::unordered_map<std::string, std::shared_ptr<MatchedContainerInfo>> mConfigContainerResultMap;
     std::mutex mContainerMapMutex;
+    // ids of containers added, modified or removed, ordered by sequence number, so that each config only
+    // re-evaluates containers changed since its last check. The log covers all changes with sequence number in
+    // (mContainerChangeLogBaseSeq, mContainerChangeSeq], configs checked before that need a full evaluation.
+    std::deque<std::pair<uint64_t, std::string>> mContainerChangeLog;
+    uint64_t mContainerChangeSeq = 0;
+    uint64_t mContainerChangeLogBaseSeq = 0;
     std::vector<std::string> mStoppedContainerIDs;
     std::mutex mStoppedContainerIDsMutex;
 
@@ -97,6 +118,7 @@ private:
 
     std::atomic<bool> mIsRunning{false};
     friend class ContainerManagerUnittest;
+    friend class ContainerDiffBenchmark;
 
     mutable ReadWriteLock mMatchedContainerInfoPipelineMux;
     CollectionPipelineContext* mMatchedContainerInfoPipelineCtx = nullptr;
@@ -119,6 +119,18 @@ bool InitObserverNetworkOptionInner(const Json::Value& probeConfig,
                              mContext->GetLogstoreName(),
                              mContext->GetRegion());
     }
+    // HttpHeaders (Optional)
+    if (!GetOptionalListParam<std::string>(
+            l7Config, "HttpHeaders", thisObserverNetworkOption.mL7Config.mHttpHeaders, errorMsg)) {
+        PARAM_WARNING_IGNORE(mContext->GetLogger(),
+                             mContext->GetAlarm(),
+                             errorMsg,
+                             sName,
+                             mContext->GetConfigName(),
+                             mContext->GetProjectName(),
+                             mContext->GetLogstoreName(),
+                             mContext->GetRegion());
+    }
 
     // ==== l4 config
     if (!IsValidMap(probeConfig, "L4Config", errorMsg)) {
@@ -34,6 +34,8 @@ struct L7Config {
     bool mEnableMetric = false;
     bool mEnableLog = false;
     double mSampleRate = 0.01;
+    // http headers copied into sampled records, matched case-insensitively
+    std::vector<std::string> mHttpHeaders;
 };
 
 struct L4Config {
@@ -56,7 +56,7 @@ public:
     Connection(Connection&&) = delete;
     Connection& operator=(const Connection&) = delete;
     Connection& operator=(Connection&&) = delete;
-    explicit Connection(const ConnId& connId) : mConnId(connId) {}
+    explicit Connection(const ConnId& connId, uint64_t generation = 0) : mConnId(connId), mGeneration(generation) {}
     void UpdateConnStats(struct conn_stats_event_t* event);
     void UpdateConnState(struct conn_ctrl_event_t* event, bool& isClose);
 
@@ -65,6 +65,7 @@ public:
     const StaticDataRow<&kConnTrackerTable>& GetConnTrackerAttrs() { return mTags; }
 
     [[nodiscard]] ConnId GetConnId() const { return mConnId; };
+    [[nodiscard]] uint64_t GetGeneration() const { return mGeneration; }
 
     bool IsServer();
 
@@ -201,6 +202,8 @@ private:
     void RecordLastUpdateTs(uint64_t ts) { mLastUpdateTs = ts; }
 
     ConnId mConnId;
+    // assigned by ConnectionManager, distinguishes connections reusing the same id
+    uint64_t mGeneration = 0;
 
     support_proto_e mProtocol = support_proto_e::ProtoUnknown;
     support_role_e mRole = support_role_e::IsUnknown;
@@ -14,6 +14,8 @@
 
 #include "ebpf/plugin/network_observer/ConnectionManager.h"
 
+#include <algorithm>
+
 #include "TimeKeeper.h"
 #include "logger/Logger.h"
 
@@ -24,36 +26,41 @@ extern "C" {
 namespace logtail::ebpf {
 
 std::shared_ptr<Connection> ConnectionManager::getOrCreateConnection(const ConnId& connId) {
-    if (mConnections.size() >= static_cast<size_t>(mMaxConnections.load())) {
+    auto& shard = getShard(connId);
+    auto it = shard.find(connId);
+    if (it != shard.end()) {
+        return it->second;
+    }
+
+    if (mConnectionTotal.load() >= mMaxConnections.load()) {
         // max connections exceeded ...
         LOG_DEBUG(sLogger, ("max connection limit exceeded!", ""));
         return nullptr;
     }
 
-    auto it = mConnections.find(connId);
-    if (it != mConnections.end()) {
-        return it->second;
-    }
-
     mConnectionTotal.fetch_add(1);
 
-    std::shared_ptr<Connection> conn = std::make_shared<Connection>(connId);
+    std::shared_ptr<Connection> conn = std::make_shared<Connection>(connId, ++mConnectionGeneration);
     conn->RecordActive();
-    mConnections.insert({connId, conn});
+    shard.insert({connId, conn});
+    // the slot visited last will be visited again after a whole gc interval
+    mTimingWheel[(mWheelCursor + kWheelSlotCount - 1) % kWheelSlotCount].push_back({connId, conn->GetGeneration()});
     return conn;
 }
 
 std::shared_ptr<Connection> ConnectionManager::getConnection(const ConnId& connId) {
-    auto it = mConnections.find(connId);
-    if (it != mConnections.end()) {
+    auto& shard = getShard(connId);
+    auto it = shard.find(connId);
+    if (it != shard.end()) {
         return it->second;
     }
     return nullptr;
 }
 
 void ConnectionManager::deleteConnection(const ConnId& connId) {
-    mConnections.erase(connId);
-    mConnectionTotal.fetch_add(-1);
+    if (getShard(connId).erase(connId) > 0) {
+        mConnectionTotal.fetch_add(-1);
+    }
 }
 
 void ConnectionManager::AcceptNetCtrlEvent(struct conn_ctrl_event_t* event) {
@@ -108,12 +115,14 @@ void ConnectionManager::AcceptNetStatsEvent(struct conn_stats_event_t* event) {
 
 void ConnectionManager::cleanClosedConnections() {
     for (const auto& connId : mClosedConnections[kConnectionEpoch - 1]) {
-        const auto& it = mConnections.find(connId);
-        if (it == mConnections.end()) {
+        auto& shard = getShard(connId);
+        const auto& it = shard.find(connId);
+        if (it == shard.end()) {
             // connection is already removed
             continue;
         }
-        deleteConnection(connId);
+        shard.erase(it);
+        mConnectionTotal.fetch_add(-1);
         LOG_DEBUG(sLogger,
                   ("delete connections caused by close, pid", connId.tgid)("fd", connId.fd)("start", connId.start));
     }
@@ -125,51 +134,77 @@ void ConnectionManager::cleanClosedConnections() {
     mClosedConnections[0].clear();
 }
 
-void ConnectionManager::Iterations() {
-    cleanClosedConnections();
-    auto nowMs = TimeKeeper::GetInstance()->NowMs();
-    if (nowMs - mLastGcTimeMs < mGcIntervalMs) {
-        return;
-    }
-    mLastGcTimeMs = nowMs;
-
+void ConnectionManager::visitConnections(std::vector<WheelEntry>& entries, std::vector<WheelEntry>& slot) {
     std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
-    LOG_DEBUG(sLogger,
-              ("[Iterations] conn tracker map size", mConnections.size())("total count", mConnectionTotal.load()));
     int n = 0;
-    std::vector<ConnId> deleteQueue;
-    for (const auto& it : mConnections) {
-        auto connId = it.first;
-        auto connection = it.second;
+    for (const auto& entry : entries) {
+        const auto& connId = entry.mConnId;
+        auto& shard = getShard(connId);
+        auto it = shard.find(connId);
+        if (it == shard.end()) {
+            // connection is already removed
+            continue;
+        }
+        auto& connection = it->second;
         if (!connection) {
             // should not happen ...
             LOG_WARNING(sLogger, ("no conn tracker??? pid", connId.tgid)("fd", connId.fd)("start", connId.start));
-            deleteQueue.push_back(it.first);
+            shard.erase(it);
+            mConnectionTotal.fetch_add(-1);
+            continue;
+        }
+        if (connection->GetGeneration() != entry.mGeneration) {
+            // connection is already removed, and the id is reused by a new one with its own entry
             continue;
         }
 
         connection->TryAttachPeerMeta();
         connection->TryAttachSelfMeta();
 
-        if (connection && connection->ReadyToDestroy(now)) {
+        if (connection->ReadyToDestroy(now)) {
             // push conn stats ...
-            deleteQueue.push_back(it.first);
             connection->MarkConnDeleted();
+            shard.erase(it);
+            mConnectionTotal.fetch_add(-1);
             n++;
+            LOG_DEBUG(sLogger, ("delete conntrackers pid", connId.tgid)("fd", connId.fd)("start", connId.start));
             continue;
         }
 
         // when we query for conn tracker, we record active
         connection->CountDown();
+        slot.push_back(entry);
+    }
+    if (n > 0) {
+        LOG_DEBUG(sLogger, ("[Iterations] remove conntrackers", n)("total conntrackers", mConnectionTotal.load()));
     }
+}
 
-    // clean conn trackers ...
-    for (const auto& connId : deleteQueue) {
-        deleteConnection(connId);
-        LOG_DEBUG(sLogger, ("delete conntrackers pid", connId.tgid)("fd", connId.fd)("start", connId.start));
+void ConnectionManager::advanceTimingWheel(int64_t nowMs) {
+    int64_t tickMs = std::max<int64_t>(mGcIntervalMs / static_cast<int64_t>(kWheelSlotCount), 1);
+    if (mWheelTimeMs == 0) {
+        mWheelTimeMs = nowMs;
     }
+    // at most one round is visited, even if the poller has been blocked for a long time
+    int64_t ticks = std::min<int64_t>((nowMs - mWheelTimeMs) / tickMs, kWheelSlotCount);
+    if (ticks <= 0) {
+        return;
+    }
+    mWheelTimeMs = ticks == static_cast<int64_t>(kWheelSlotCount) ? nowMs : mWheelTimeMs + ticks * tickMs;
+
+    for (int64_t i = 0; i < ticks; ++i) {
+        auto& slot = mTimingWheel[mWheelCursor];
+        mWheelCursor = (mWheelCursor + 1) % kWheelSlotCount;
+        // alive connections are put back to the same slot, which is visited again after a whole round
+        mDueEntries.swap(slot);
+        visitConnections(mDueEntries, slot);
+        mDueEntries.clear();
+    }
+}
 
-    LOG_DEBUG(sLogger, ("[Iterations] remove conntrackers", n)("total conntrackers", mConnectionTotal.load()));
+void ConnectionManager::Iterations() {
+    cleanClosedConnections();
+    advanceTimingWheel(TimeKeeper::GetInstance()->NowMs());
 }
 
 } // namespace logtail::ebpf
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <memory>
@@ -23,6 +24,7 @@
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "common/Lock.h"
 #include "ebpf/plugin/ProcessCacheManager.h"
@@ -34,6 +36,11 @@ extern "C" {
 namespace logtail::ebpf {
 
 // used in poller thread
+//
+// Connections are kept in shards, so that rehashing a shard only touches a small part of the connections. Each
+// connection is registered in a timing wheel, which visits it once per gc interval to attach metadata and check whether
+// it should be destroyed. Since connections are spread over the slots, the gc work is amortized across poll iterations
+// instead of scanning all connections at once.
 class ConnectionManager {
 public:
     static std::unique_ptr<ConnectionManager> Create(int maxConnections = 5000) {
@@ -54,9 +61,30 @@ public:
     void UpdateMaxConnectionThreshold(int max) { mMaxConnections = max; }
 
 private:
+    static constexpr size_t kShardBits = 4;
+    static constexpr size_t kShardCount = 1 << kShardBits;
+    static constexpr size_t kWheelSlotCount = 50;
+
+    struct WheelEntry {
+        ConnId mConnId;
+        // used to skip entries of deleted connections whose id has been reused, a new connection may be allocated at
+        // the address of the deleted one, so the address cannot tell them apart
+        uint64_t mGeneration;
+    };
+
+    using ConnectionMap = std::unordered_map<ConnId, std::shared_ptr<Connection>>;
+
     explicit ConnectionManager(int maxConnections) : mMaxConnections(maxConnections), mConnectionTotal(0) {}
 
     void cleanClosedConnections();
+    void advanceTimingWheel(int64_t nowMs);
+    void visitConnections(std::vector<WheelEntry>& entries, std::vector<WheelEntry>& slot);
+
+    ConnectionMap& getShard(const ConnId& connId) {
+        // fibonacci hashing, since low bits of std::hash<ConnId> are mostly decided by fd
+        uint64_t h = static_cast<uint64_t>(std::hash<ConnId>()(connId)) * 0x9E3779B97F4A7C15ULL;
+        return mConnections[h >> (64 - kShardBits)];
+    }
 
     std::shared_ptr<Connection> getOrCreateConnection(const ConnId&);
     void deleteConnection(const ConnId&);
@@ -66,21 +94,25 @@ private:
 
     std::atomic_bool mEnableConnStats = false;
 
-    int mLastGcTimeMs = INT_MIN; // frequency control ...
-    int mGcIntervalMs = 5000; // 5s
+    int mGcIntervalMs = 5000; // 5s, every connection is visited once per interval
 
     std::array<std::vector<ConnId>, kConnectionEpoch> mClosedConnections;
 
+    // each slot covers mGcIntervalMs / kWheelSlotCount, slots are visited in turn by Iterations
+    std::array<std::vector<WheelEntry>, kWheelSlotCount> mTimingWheel;
+    std::vector<WheelEntry> mDueEntries;
+    size_t mWheelCursor = 0;
+    int64_t mWheelTimeMs = 0;
+
     std::atomic_int64_t mConnectionTotal;
-    // object pool, used for cache some conn_tracker objects
-    // lock used to protect conn_trackers map
-    // mutable ReadWriteLock mReadWriteLock;
-    std::unordered_map<ConnId, std::shared_ptr<Connection>> mConnections;
+    uint64_t mConnectionGeneration = 0;
+    std::array<ConnectionMap, kShardCount> mConnections;
 
     friend class NetworkObserverManager;
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConnectionUnittest;
     friend class ConnectionManagerUnittest;
+    friend class ConnectionManagerBenchmark;
     friend class HttpRetryableEventUnittest;
     friend class NetworkObserverConfigUpdateUnittest;
 #endif
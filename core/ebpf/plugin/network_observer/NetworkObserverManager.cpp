@@ -53,6 +53,9 @@ DEFINE_FLAG_INT32(ebpf_networkobserver_max_connections, "maximum connections", 5
 DEFINE_FLAG_STRING(ebpf_networkobserver_enable_protocols, "enable application protocols, split by comma", "HTTP");
 DEFINE_FLAG_DOUBLE(ebpf_networkobserver_default_sample_rate, "ebpf network observer default sample rate", 1.0);
 DEFINE_FLAG_STRING(ebpf_networkobserver_agent_env, "deploy env: ACSK8S,Serverless,ECS_AUTO", "ACSK8S");
+DEFINE_FLAG_BOOL(ebpf_networkobserver_enable_latency_sketch,
+                 "whether to track latency distribution of app metrics and export histogram and quantiles",
+                 false);
 
 namespace logtail::ebpf {
 
@@ -86,6 +89,16 @@ const static std::string kMetricNameRequestDurationSum = "arms_rpc_requests_seco
 const static std::string kMetricNameRequestErrorTotal = "arms_rpc_requests_error_count";
 const static std::string kMetricNameRequestSlowTotal = "arms_rpc_requests_slow_count";
 const static std::string kMetricNameRequestByStatusTotal = "arms_rpc_requests_by_status_count";
+const static std::string kMetricNameRequestDurationBucket = "arms_rpc_requests_seconds_bucket";
+const static std::string kMetricNameRequestDurationQuantile = "arms_rpc_requests_seconds_quantile";
+
+// upper bounds in seconds of latency histogram buckets, the last one is +Inf
+static constexpr std::array<double, 11> kLatencyBucketBounds
+    = {0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+static const std::array<StringView, 12> kLatencyBucketKeys
+    = {"0.005", "0.01", "0.025", "0.05", "0.1", "0.25", "0.5", "1", "2.5", "5", "10", "+Inf"};
+static constexpr std::array<double, 4> kLatencyQuantiles = {0.5, 0.9, 0.95, 0.99};
+static const std::array<StringView, 4> kLatencyQuantileKeys = {"0.5", "0.9", "0.95", "0.99"};
 
 static const StringView kStatus2xxKey = "2xx";
 static const StringView kStatus3xxKey = "3xx";
@@ -159,92 +172,98 @@ GetAppDetail(const std::unordered_map<size_t, std::shared_ptr<AppDetail>>& curre
     return nullptr;
 }
 
-NetworkObserverManager::NetworkObserverManager(const std::shared_ptr<ProcessCacheManager>& processCacheManager,
-                                               const std::shared_ptr<EBPFAdapter>& eBPFAdapter,
-                                               moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& queue,
-                                               EventPool* pool)
-    : AbstractManager(processCacheManager, eBPFAdapter, queue, pool),
-      mAppAggregator(
-          10240,
-          [](std::unique_ptr<AppMetricData>& base, L7Record* other) {
-              if (base == nullptr) {
-                  return;
-              }
-              int statusCode = other->GetStatusCode();
-              if (statusCode >= 500) {
-                  base->m5xxCount += 1;
-              } else if (statusCode >= 400) {
-                  base->m4xxCount += 1;
-              } else if (statusCode >= 300) {
-                  base->m3xxCount += 1;
-              } else {
-                  base->m2xxCount += 1;
-              }
-              base->mCount++;
-              base->mErrCount += other->IsError();
-              base->mSlowCount += other->IsSlow();
-              base->mSum += other->GetLatencySeconds();
-          },
-          [this](L7Record* in, std::shared_ptr<SourceBuffer>& sourceBuffer) -> std::unique_ptr<AppMetricData> {
-              auto spanName = sourceBuffer->CopyString(in->GetConvSpanName());
-              auto connection = in->GetConnection();
-              if (!connection) {
-                  LOG_WARNING(sLogger, ("connection is null", ""));
-                  return nullptr;
-              }
-              auto data
-                  = std::make_unique<AppMetricData>(connection, sourceBuffer, StringView(spanName.data, spanName.size));
+void NetworkObserverManager::AppMetricAggregateFunc::operator()(std::unique_ptr<AppMetricData>& base,
+                                                                L7Record* other) const {
+    if (base == nullptr) {
+        return;
+    }
+    int statusCode = other->GetStatusCode();
+    if (statusCode >= 500) {
+        base->m5xxCount += 1;
+    } else if (statusCode >= 400) {
+        base->m4xxCount += 1;
+    } else if (statusCode >= 300) {
+        base->m3xxCount += 1;
+    } else {
+        base->m2xxCount += 1;
+    }
+    base->mCount++;
+    base->mErrCount += other->IsError();
+    base->mSlowCount += other->IsSlow();
+    base->mSum += other->GetLatencySeconds();
+    if (BOOL_FLAG(ebpf_networkobserver_enable_latency_sketch)) {
+        base->mLatencySketch.Add(other->GetLatencyNs());
+    }
+}
 
-              const auto& ctAttrs = connection->GetConnTrackerAttrs();
-              {
-                  auto appConfig = getAppConfigFromReplica(connection); // build func is called by poller thread ...
-                  if (appConfig == nullptr) {
-                      return nullptr;
-                  }
-                  auto host = sourceBuffer->CopyString(ctAttrs.Get<kHostNameIndex>());
-                  data->mTags.SetNoCopy<kHostName>(StringView(host.data, host.size));
+std::unique_ptr<AppMetricData>
+NetworkObserverManager::AppMetricBuildFunc::operator()(L7Record* in,
+                                                       std::shared_ptr<SourceBuffer>& sourceBuffer) const {
+    auto spanName = sourceBuffer->CopyString(in->GetConvSpanName());
+    auto connection = in->GetConnection();
+    if (!connection) {
+        LOG_WARNING(sLogger, ("connection is null", ""));
+        return nullptr;
+    }
+    auto data = std::make_unique<AppMetricData>(connection, sourceBuffer, StringView(spanName.data, spanName.size));
 
-                  auto ip = sourceBuffer->CopyString(ctAttrs.Get<kIp>());
-                  data->mTags.SetNoCopy<kIp>(StringView(ip.data, ip.size));
+    const auto& ctAttrs = connection->GetConnTrackerAttrs();
+    {
+        auto appConfig = mManager->getAppConfigFromReplica(connection); // build func is called by poller thread ...
+        if (appConfig == nullptr) {
+            return nullptr;
+        }
+        auto host = sourceBuffer->CopyString(ctAttrs.Get<kHostNameIndex>());
+        data->mTags.SetNoCopy<kHostName>(StringView(host.data, host.size));
 
-                  auto appId = sourceBuffer->CopyString(appConfig->mAppId);
-                  data->mTags.SetNoCopy<kAppId>(StringView(appId.data, appId.size));
+        auto ip = sourceBuffer->CopyString(ctAttrs.Get<kIp>());
+        data->mTags.SetNoCopy<kIp>(StringView(ip.data, ip.size));
 
-                  auto appName = sourceBuffer->CopyString(appConfig->mAppName);
-                  data->mTags.SetNoCopy<kAppName>(StringView(appName.data, appName.size));
+        auto appId = sourceBuffer->CopyString(appConfig->mAppId);
+        data->mTags.SetNoCopy<kAppId>(StringView(appId.data, appId.size));
 
-                  auto workspace = sourceBuffer->CopyString(appConfig->mWorkspace);
-                  data->mTags.SetNoCopy<kAppName>(StringView(workspace.data, workspace.size));
+        auto appName = sourceBuffer->CopyString(appConfig->mAppName);
+        data->mTags.SetNoCopy<kAppName>(StringView(appName.data, appName.size));
 
-                  auto serviceId = sourceBuffer->CopyString(appConfig->mServiceId);
-                  data->mTags.SetNoCopy<kArmsServiceId>(StringView(serviceId.data, serviceId.size));
+        auto workspace = sourceBuffer->CopyString(appConfig->mWorkspace);
+        data->mTags.SetNoCopy<kAppName>(StringView(workspace.data, workspace.size));
 
-                  auto language = sourceBuffer->CopyString(appConfig->mLanguage);
-                  data->mTags.SetNoCopy<kLanguage>(StringView(language.data, language.size));
-              }
+        auto serviceId = sourceBuffer->CopyString(appConfig->mServiceId);
+        data->mTags.SetNoCopy<kArmsServiceId>(StringView(serviceId.data, serviceId.size));
 
-              auto workloadKind = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadKind>());
-              data->mTags.SetNoCopy<kWorkloadKind>(StringView(workloadKind.data, workloadKind.size));
+        auto language = sourceBuffer->CopyString(appConfig->mLanguage);
+        data->mTags.SetNoCopy<kLanguage>(StringView(language.data, language.size));
+    }
 
-              auto workloadName = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadName>());
-              data->mTags.SetNoCopy<kWorkloadName>(StringView(workloadName.data, workloadName.size));
+    auto workloadKind = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadKind>());
+    data->mTags.SetNoCopy<kWorkloadKind>(StringView(workloadKind.data, workloadKind.size));
 
-              auto mRpcType = sourceBuffer->CopyString(ctAttrs.Get<kRpcType>());
-              data->mTags.SetNoCopy<kRpcType>(StringView(mRpcType.data, mRpcType.size));
+    auto workloadName = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadName>());
+    data->mTags.SetNoCopy<kWorkloadName>(StringView(workloadName.data, workloadName.size));
 
-              auto mCallType = sourceBuffer->CopyString(ctAttrs.Get<kCallType>());
-              data->mTags.SetNoCopy<kCallType>(StringView(mCallType.data, mCallType.size));
+    auto mRpcType = sourceBuffer->CopyString(ctAttrs.Get<kRpcType>());
+    data->mTags.SetNoCopy<kRpcType>(StringView(mRpcType.data, mRpcType.size));
 
-              auto mCallKind = sourceBuffer->CopyString(ctAttrs.Get<kCallKind>());
-              data->mTags.SetNoCopy<kCallKind>(StringView(mCallKind.data, mCallKind.size));
+    auto mCallType = sourceBuffer->CopyString(ctAttrs.Get<kCallType>());
+    data->mTags.SetNoCopy<kCallType>(StringView(mCallType.data, mCallType.size));
 
-              auto mDestId = sourceBuffer->CopyString(ctAttrs.Get<kDestId>());
-              data->mTags.SetNoCopy<kDestId>(StringView(mDestId.data, mDestId.size));
+    auto mCallKind = sourceBuffer->CopyString(ctAttrs.Get<kCallKind>());
+    data->mTags.SetNoCopy<kCallKind>(StringView(mCallKind.data, mCallKind.size));
 
-              auto ns = sourceBuffer->CopyString(ctAttrs.Get<kNamespace>());
-              data->mTags.SetNoCopy<kNamespace>(StringView(ns.data, ns.size));
-              return data;
-          }),
+    auto mDestId = sourceBuffer->CopyString(ctAttrs.Get<kDestId>());
+    data->mTags.SetNoCopy<kDestId>(StringView(mDestId.data, mDestId.size));
+
+    auto ns = sourceBuffer->CopyString(ctAttrs.Get<kNamespace>());
+    data->mTags.SetNoCopy<kNamespace>(StringView(ns.data, ns.size));
+    return data;
+}
+
+NetworkObserverManager::NetworkObserverManager(const std::shared_ptr<ProcessCacheManager>& processCacheManager,
+                                               const std::shared_ptr<EBPFAdapter>& eBPFAdapter,
+                                               moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& queue,
+                                               EventPool* pool)
+    : AbstractManager(processCacheManager, eBPFAdapter, queue, pool),
+      mAppAggregator(10240, AppMetricAggregateFunc(), AppMetricBuildFunc{this}),
       mNetAggregator(
           10240,
           [](std::unique_ptr<NetMetricData>& base, ConnStatsRecord* other) {
@@ -795,12 +814,9 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
 
     LOG_DEBUG(sLogger, ("enter aggregator ...", mAppAggregator.NodeCount()));
 
-    auto aggTree = this->mAppAggregator.GetAndReset();
-
-    auto nodes = aggTree.GetNodesWithAggDepth(1);
-    LOG_DEBUG(sLogger, ("enter aggregator ...", nodes.size())("node size", aggTree.NodeCount()));
-    if (nodes.empty()) {
+    if (mAppAggregator.GroupCount() == 0) {
         LOG_DEBUG(sLogger, ("empty nodes...", ""));
+        mAppAggregator.Reset();
         return true;
     }
 
@@ -808,12 +824,12 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
     auto duration = now.time_since_epoch();
     auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
 
-    for (auto& node : nodes) {
-        LOG_DEBUG(sLogger, ("node child size", node->mChild.size()));
+    // every group is exported in place, and the table is reset afterwards so that its memory is reused
+    mAppAggregator.ForEachGroup([&](auto& node) {
         // convert to a item and push to process queue
         // every node represent an instance of an arms app ...
         // auto sourceBuffer = std::make_shared<SourceBuffer>();
-        std::shared_ptr<SourceBuffer>& sourceBuffer = node->mSourceBuffer;
+        std::shared_ptr<SourceBuffer>& sourceBuffer = node.mSourceBuffer;
         PipelineEventGroup eventGroup(sourceBuffer); // per node represent an APP ...
         eventGroup.SetTagNoCopy(kAppType.MetricKey(), kAPMValue);
         eventGroup.SetTagNoCopy(kTagTechnology, kEBPFValue);
@@ -825,7 +841,7 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
         StringView configName;
         CounterPtr pushMetricsTotal = nullptr;
         CounterPtr pushMetricGroupTotal = nullptr;
-        aggTree.ForEach(node, [&](const AppMetricData* group) {
+        mAppAggregator.ForEach(node, [&](const AppMetricData* group) {
             LOG_DEBUG(sLogger,
                       ("dump group attrs", group->ToString())("ct attrs", group->mConnection->DumpConnection()));
             // instance dim
@@ -876,7 +892,7 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
 
             LOG_DEBUG(sLogger,
                       ("node app", group->mTags.Get<kAppName>())("group span", group->mTags.Get<kRpc>())(
-                          "node size", nodes.size())("rpcType", group->mTags.Get<kRpcType>())(
+                          "node size", mAppAggregator.GroupCount())("rpcType", group->mTags.Get<kRpcType>())(
                           "callType", group->mTags.Get<kCallType>())("callKind", group->mTags.Get<kCallKind>())(
                           "appName", group->mTags.Get<kAppName>())("appId", group->mTags.Get<kAppId>())(
                           "host", group->mTags.Get<kHostName>())("ip", group->mTags.Get<kIp>())(
@@ -909,6 +925,35 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
                 metrics.push_back(slowMetric);
             }
 
+            if (!group->mLatencySketch.Empty()) {
+                const auto& sketch = group->mLatencySketch;
+                auto* bucketMetric = eventGroup.AddMetricEvent();
+                bucketMetric->SetName(kMetricNameRequestDurationBucket);
+                bucketMetric->SetValue<UntypedMultiDoubleValues>(bucketMetric);
+                auto* buckets = bucketMetric->MutableValue<UntypedMultiDoubleValues>();
+                for (size_t i = 0; i < kLatencyBucketBounds.size(); ++i) {
+                    buckets->SetValueNoCopy(
+                        kLatencyBucketKeys[i],
+                        UntypedMultiDoubleValue{UntypedValueMetricType::MetricTypeCounter,
+                                                double(sketch.CountNoLargerThan(kLatencyBucketBounds[i] * 1e9))});
+                }
+                buckets->SetValueNoCopy(
+                    kLatencyBucketKeys.back(),
+                    UntypedMultiDoubleValue{UntypedValueMetricType::MetricTypeCounter, double(sketch.Count())});
+                metrics.push_back(bucketMetric);
+
+                auto* quantileMetric = eventGroup.AddMetricEvent();
+                quantileMetric->SetName(kMetricNameRequestDurationQuantile);
+                quantileMetric->SetValue<UntypedMultiDoubleValues>(quantileMetric);
+                auto* quantiles = quantileMetric->MutableValue<UntypedMultiDoubleValues>();
+                for (size_t i = 0; i < kLatencyQuantiles.size(); ++i) {
+                    quantiles->SetValueNoCopy(kLatencyQuantileKeys[i],
+                                              UntypedMultiDoubleValue{UntypedValueMetricType::MetricTypeGauge,
+                                                                      sketch.Quantile(kLatencyQuantiles[i]) / 1e9});
+                }
+                metrics.push_back(quantileMetric);
+            }
+
             if (group->m2xxCount) {
                 auto* statusMetric = eventGroup.AddMetricEvent();
                 statusMetric->SetValue(UntypedSingleValue{double(group->m2xxCount)});
@@ -972,7 +1017,8 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
             LOG_DEBUG(sLogger, ("appid is empty, no need to push", ""));
         }
 #endif
-    }
+    });
+    mAppAggregator.Reset();
     return true;
 }
 
@@ -27,6 +27,7 @@
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/util/AggregateTree.h"
 #include "ebpf/util/Converger.h"
+#include "ebpf/util/FlatAggregateTree.h"
 #include "ebpf/util/FrequencyManager.h"
 #include "ebpf/util/sampler/Sampler.h"
 
@@ -170,6 +171,14 @@ private:
 
     bool updateParsers(const std::vector<std::string>& protocols, const std::vector<std::string>& prevProtocols);
 
+    struct AppMetricAggregateFunc {
+        void operator()(std::unique_ptr<AppMetricData>& base, L7Record* other) const;
+    };
+    struct AppMetricBuildFunc {
+        std::unique_ptr<AppMetricData> operator()(L7Record* in, std::shared_ptr<SourceBuffer>& sourceBuffer) const;
+        NetworkObserverManager* mManager = nullptr;
+    };
+
     enum class EventDataType {
         AGENT_INFO,
         APP_METRIC,
@@ -201,7 +210,8 @@ private:
     int mCidOffset = -1;
 
     // handler thread ...
-    SIZETAggTreeWithSourceBuffer<AppMetricData, L7Record*> mAppAggregator;
+    // l7 records are aggregated at a much higher rate than the others, so a flat table is used
+    FlatAggTree<AppMetricData, L7Record*, 2, AppMetricAggregateFunc, AppMetricBuildFunc, true> mAppAggregator;
     SIZETAggTreeWithSourceBuffer<NetMetricData, ConnStatsRecord*> mNetAggregator;
     SIZETAggTree<AppSpanGroup, std::shared_ptr<CommonEvent>> mSpanAggregator;
     SIZETAggTree<AppLogGroup, std::shared_ptr<CommonEvent>> mLogAggregator;
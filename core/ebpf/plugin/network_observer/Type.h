@@ -54,6 +54,7 @@ public:
           mEnableMetric(opt->mL7Config.mEnableMetric),
           mEnableL4(opt->mL4Config.mEnable),
           mSampleRate(opt->mL7Config.mSampleRate),
+          mHttpHeaders(opt->mL7Config.mHttpHeaders),
           mMetricMgr(metricMgr) {
         // init mSampler
         if (mSampleRate < 0) {
@@ -155,6 +156,9 @@ public:
         if (std::abs(mSampleRate - other.mSampleRate) > 1e-9) {
             return false;
         }
+        if (mHttpHeaders != other.mHttpHeaders) {
+            return false;
+        }
         return true;
     }
 
@@ -173,6 +177,8 @@ public:
     // sampler ...
     double mSampleRate;
     std::shared_ptr<Sampler> mSampler;
+    // only these headers are copied into sampled http records
+    std::vector<std::string> mHttpHeaders;
     // plugin queue key ...
     std::string mConfigName;
     QueueKey mQueueKey = 0;
@@ -278,10 +284,11 @@ namespace std {
 template <>
 struct hash<logtail::ebpf::ConnId> {
     std::size_t operator()(const logtail::ebpf::ConnId& k) const {
-        std::size_t h1 = std::hash<int32_t>{}(k.fd);
-        std::size_t h2 = std::hash<uint32_t>{}(k.tgid);
-        std::size_t h3 = std::hash<uint64_t>{}(k.start);
-        return h1 ^ (h2 << 1) ^ (h3 << 2);
+        // fds and pids are small integers, so they are combined rather than xor-ed to avoid massive collisions
+        std::size_t res = std::hash<int32_t>{}(k.fd);
+        logtail::AttrHashCombine(res, std::hash<uint32_t>{}(k.tgid));
+        logtail::AttrHashCombine(res, std::hash<uint64_t>{}(k.start));
+        return res;
     }
 };
 } // namespace std
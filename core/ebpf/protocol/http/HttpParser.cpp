@@ -14,10 +14,14 @@
 
 #include "HttpParser.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <map>
 
 #include "common/StringTools.h"
 #include "ebpf/type/NetworkObserverEvent.h"
+#include "ebpf/util/RecordPool.h"
 #include "ebpf/util/TraceId.h"
 #include "logger/Logger.h"
 
@@ -27,12 +31,20 @@ inline constexpr char kContentLength[] = "Content-Length";
 inline constexpr char kTransferEncoding[] = "Transfer-Encoding";
 inline constexpr char kUpgrade[] = "Upgrade";
 
+RecordPool<HttpRecord>& HTTPProtocolParser::GetRecordPool() {
+    // records may still be referenced by queues during exit, so the pool is never destroyed
+    static auto* sPool = new RecordPool<HttpRecord>();
+    return *sPool;
+}
+
 std::vector<std::shared_ptr<L7Record>>
 HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
                           const std::shared_ptr<Connection>& conn,
                           const std::shared_ptr<AppDetail>& appDetail,
                           const std::shared_ptr<AppConvergerManager>& converger) {
-    auto record = std::make_shared<HttpRecord>(conn, appDetail);
+    auto record = GetRecordPool().Acquire();
+    record->SetConnection(conn);
+    record->SetAppDetail(appDetail);
     record->SetEndTsNs(dataEvent->end_ts);
     record->SetStartTsNs(dataEvent->start_ts);
     auto spanId = GenerateSpanID();
@@ -44,7 +56,7 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
     // ParseResponse may set SAMPLE flag, depending on HTTP status code ...
     if (dataEvent->response_len > 0) {
         std::string_view buf(dataEvent->msg + dataEvent->request_len, dataEvent->response_len);
-        ParseState state = http::ParseResponse(buf, record, true, false);
+        ParseState state = http::ParseResponse(buf, record, true, false, &appDetail->mHttpHeaders);
         if (state != ParseState::kSuccess) {
             LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP response failed", int(state)));
             return {};
@@ -53,7 +65,7 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
 
     if (dataEvent->request_len > 0) {
         std::string_view buf(dataEvent->msg, dataEvent->request_len);
-        ParseState state = http::ParseRequest(buf, record, false);
+        ParseState state = http::ParseRequest(buf, record, false, &appDetail->mHttpHeaders);
         if (state != ParseState::kSuccess) {
             LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP request failed", int(state)));
             return {};
@@ -72,14 +84,43 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
 }
 
 namespace http {
-HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders) {
-    HeadersMap result;
+static bool EqualsIgnoreCase(std::string_view s1, std::string_view s2) {
+    if (s1.size() != s2.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < s1.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(s1[i])) != std::tolower(static_cast<unsigned char>(s2[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FindHTTPHeader(const phr_header* headers, size_t numHeaders, std::string_view name, std::string_view& value) {
+    for (size_t i = 0; i < numHeaders; i++) {
+        if (EqualsIgnoreCase(std::string_view(headers[i].name, headers[i].name_len), name)) {
+            value = std::string_view(headers[i].value, headers[i].value_len);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GetHTTPHeadersMap(const phr_header* headers,
+                       size_t numHeaders,
+                       const std::vector<std::string>* selectedHeaders,
+                       HeadersMap& result) {
+    result.clear();
     for (size_t i = 0; i < numHeaders; i++) {
-        std::string name(headers[i].name, headers[i].name_len);
-        std::string value(headers[i].value, headers[i].value_len);
-        result.emplace(std::move(name), std::move(value));
+        std::string_view name(headers[i].name, headers[i].name_len);
+        if (selectedHeaders != nullptr
+            && std::none_of(selectedHeaders->begin(), selectedHeaders->end(), [&name](const std::string& selected) {
+                   return EqualsIgnoreCase(selected, name);
+               })) {
+            continue;
+        }
+        result.emplace(std::string(name), std::string(headers[i].value, headers[i].value_len));
     }
-    return result;
 }
 
 int ParseHttpRequest(std::string_view& buf, HTTPRequest& result) {
@@ -99,14 +140,22 @@ const std::string kRootPath = "/";
 const char kQuestionMark = '?';
 const std::string kHttP1Prefix = "http1.";
 
-ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool forceSample) {
+ParseState ParseRequest(std::string_view& buf,
+                        std::shared_ptr<HttpRecord>& result,
+                        bool forceSample,
+                        const std::vector<std::string>* selectedHeaders) {
     HTTPRequest req;
     int retval = http::ParseHttpRequest(buf, req);
     if (retval >= 0) {
         buf.remove_prefix(retval);
 
-        auto orginPath = std::string(req.mPath, req.mPathLen);
-        auto trimPath = TrimString(orginPath);
+        std::string_view trimPath(req.mPath, req.mPathLen);
+        while (!trimPath.empty() && trimPath.front() == ' ') {
+            trimPath.remove_prefix(1);
+        }
+        while (!trimPath.empty() && trimPath.back() == ' ') {
+            trimPath.remove_suffix(1);
+        }
         std::size_t pos = trimPath.find(kQuestionMark);
 
         if (trimPath.empty() || (pos != std::string::npos && pos == 0)) {
@@ -122,9 +171,9 @@ ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& resu
 
         if (result->ShouldSample() || forceSample) {
             result->SetProtocolVersion(kHttP1Prefix + std::to_string(req.mMinorVersion));
-            result->SetMethod(std::string(req.mMethod, req.mMethodLen));
-            result->SetReqHeaderMap(http::GetHTTPHeadersMap(req.mHeaders, req.mNumHeaders));
-            return ParseRequestBody(buf, result);
+            result->SetMethod(std::string_view(req.mMethod, req.mMethodLen));
+            http::GetHTTPHeadersMap(req.mHeaders, req.mNumHeaders, selectedHeaders, result->mReqHeaderMap);
+            return ParseRequestBody(buf, req, result);
         }
         return ParseState::kSuccess;
     }
@@ -179,18 +228,19 @@ ParseState ParseChunked(std::string_view& data, size_t bodySizeLimitBytes, std::
     return PicoParseChunked(data, bodySizeLimitBytes, result, bodySize);
 }
 
-ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result) {
+ParseState ParseRequestBody(std::string_view& buf, const HTTPRequest& req, std::shared_ptr<HttpRecord>& result) {
+    // headers are looked up in the parsed buffer, since they may not be copied into the record
     // Case 1: Content-Length
-    const auto contentLengthIter = result->GetReqHeaderMap().find(kContentLength);
-    if (contentLengthIter != result->GetReqHeaderMap().end()) {
-        std::string_view contentLenStr = contentLengthIter->second;
+    std::string_view contentLenStr;
+    if (FindHTTPHeader(req.mHeaders, req.mNumHeaders, kContentLength, contentLenStr)) {
         auto r = ParseContent(contentLenStr, buf, 256, result->mReqBody, result->mReqBodySize);
         return r;
     }
 
     // Case 2: Chunked transfer.
-    const auto transferEncodingIter = result->GetReqHeaderMap().find(kTransferEncoding);
-    if (transferEncodingIter != result->GetReqHeaderMap().end() && transferEncodingIter->second == "chunked") {
+    std::string_view transferEncoding;
+    if (FindHTTPHeader(req.mHeaders, req.mNumHeaders, kTransferEncoding, transferEncoding)
+        && transferEncoding == "chunked") {
         auto s = ParseChunked(buf, 256, result->mReqBody, result->mReqBodySize);
 
         return s;
@@ -225,18 +275,9 @@ bool ParseContentLength(const std::string_view& contentLenStr, size_t* len) {
         return false;
     }
 
-    try {
-        size_t pos;
-        std::stoull(contentLenStr.data());
-        *len = std::stoull(std::string(contentLenStr), &pos);
-        if (pos != contentLenStr.size()) {
-            return false;
-        }
-    } catch (const std::exception& e) {
-        return false;
-    }
-
-    return true;
+    const char* end = contentLenStr.data() + contentLenStr.size();
+    auto [ptr, ec] = std::from_chars(contentLenStr.data(), end, *len);
+    return ec == std::errc() && ptr == end;
 }
 
 ParseState ParseContent(std::string_view& contentLenStr,
@@ -268,7 +309,8 @@ bool StartsWithHttp(const std::string_view& buf) {
     return buf.size() >= kPrefix.size() && buf.substr(0, kPrefix.size()) == kPrefix;
 }
 
-ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool closed) {
+ParseState
+ParseResponseBody(std::string_view& buf, const HTTPResponse& resp, std::shared_ptr<HttpRecord>& result, bool closed) {
     HTTPResponse r;
     bool adjacentResp = StartsWithHttp(buf) && (ParseHttpResponse(buf, &r) > 0);
 
@@ -277,17 +319,17 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
     }
 
     // Case 1: Content-Length
-    const auto contentLengthIter = result->GetRespHeaderMap().find(kContentLength);
-    if (contentLengthIter != result->GetRespHeaderMap().end()) {
-        std::string_view contentLenStr = contentLengthIter->second;
+    std::string_view contentLenStr;
+    if (FindHTTPHeader(resp.mHeaders, resp.mNumHeaders, kContentLength, contentLenStr)) {
         auto s = ParseContent(contentLenStr, buf, 256, result->mRespBody, result->mRespBodySize);
         // CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
         return s;
     }
 
     // Case 2: Chunked transfer.
-    const auto transferEncodingIter = result->GetRespHeaderMap().find(kTransferEncoding);
-    if (transferEncodingIter != result->GetRespHeaderMap().end() && transferEncodingIter->second == "chunked") {
+    std::string_view transferEncoding;
+    if (FindHTTPHeader(resp.mHeaders, resp.mNumHeaders, kTransferEncoding, transferEncoding)
+        && transferEncoding == "chunked") {
         auto s = ParseChunked(buf, 256, result->mRespBody, result->mRespBodySize);
         // CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
         return s;
@@ -301,8 +343,8 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
 
         // Status 101 is an even more special case.
         if (result->mCode == 101) {
-            const auto upgradeIter = result->GetRespHeaderMap().find(kUpgrade);
-            if (upgradeIter == result->GetRespHeaderMap().end()) {
+            std::string_view upgrade;
+            if (!FindHTTPHeader(resp.mHeaders, resp.mNumHeaders, kUpgrade, upgrade)) {
             }
 
             return ParseState::kEOS;
@@ -324,7 +366,11 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
     return ParseState::kSuccess;
 }
 
-ParseState ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool closed, bool forceSample) {
+ParseState ParseResponse(std::string_view& buf,
+                         std::shared_ptr<HttpRecord>& result,
+                         bool closed,
+                         bool forceSample,
+                         const std::vector<std::string>* selectedHeaders) {
     HTTPResponse resp;
     int retval = ParseHttpResponse(buf, &resp);
 
@@ -337,9 +383,9 @@ ParseState ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& res
         }
 
         if (result->ShouldSample() || forceSample) {
-            result->SetRespHeaderMap(http::GetHTTPHeadersMap(resp.mHeaders, resp.mNumHeaders));
+            http::GetHTTPHeadersMap(resp.mHeaders, resp.mNumHeaders, selectedHeaders, result->mRespHeaderMap);
             result->SetRespMsg(std::string(resp.mMsg, resp.mMsgLen));
-            return ParseResponseBody(buf, result, closed);
+            return ParseResponseBody(buf, resp, result, closed);
         }
         return ParseState::kSuccess;
     }
@@ -7,12 +7,14 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "ebpf/protocol/AbstractParser.h"
 #include "ebpf/protocol/ParserRegistry.h"
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/util/Converger.h"
+#include "ebpf/util/RecordPool.h"
 #include "ebpf/util/sampler/Sampler.h"
 #include "picohttpparser.h"
 
@@ -71,11 +73,20 @@ enum class ParseState {
 
 namespace http {
 
-ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool forceSample = false);
+// selectedHeaders are the headers copied into the record when it is sampled, nullptr means all headers
+ParseState ParseRequest(std::string_view& buf,
+                        std::shared_ptr<HttpRecord>& result,
+                        bool forceSample = false,
+                        const std::vector<std::string>* selectedHeaders = nullptr);
 
-ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result);
+ParseState ParseRequestBody(std::string_view& buf, const HTTPRequest& req, std::shared_ptr<HttpRecord>& result);
 
-HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders);
+bool FindHTTPHeader(const phr_header* headers, size_t numHeaders, std::string_view name, std::string_view& value);
+
+void GetHTTPHeadersMap(const phr_header* headers,
+                       size_t numHeaders,
+                       const std::vector<std::string>* selectedHeaders,
+                       HeadersMap& result);
 
 ParseState ParseContent(std::string_view& contentLenStr,
                         std::string_view& data,
@@ -83,8 +94,11 @@ ParseState ParseContent(std::string_view& contentLenStr,
                         std::string& result,
                         size_t& bodySize);
 
-ParseState
-ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool closed, bool forceSample = false);
+ParseState ParseResponse(std::string_view& buf,
+                         std::shared_ptr<HttpRecord>& result,
+                         bool closed,
+                         bool forceSample = false,
+                         const std::vector<std::string>* selectedHeaders = nullptr);
 
 int ParseHttpRequest(std::string_view& buf, HTTPRequest& result);
 } // namespace http
@@ -98,6 +112,9 @@ public:
                                                  const std::shared_ptr<Connection>& conn,
                                                  const std::shared_ptr<AppDetail>& appDetail,
                                                  const std::shared_ptr<AppConvergerManager>& converger) override;
+
+    // records are recycled once all the references are dropped
+    static RecordPool<HttpRecord>& GetRecordPool();
 };
 
 REGISTER_PROTOCOL_PARSER(support_proto_e::ProtoHTTP, HTTPProtocolParser)
@@ -16,6 +16,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ebpf/plugin/network_observer/Connection.h"
@@ -26,6 +27,7 @@
 #include "ebpf/type/table/HttpTable.h"
 #include "ebpf/type/table/NetTable.h"
 #include "ebpf/type/table/StaticDataRow.h"
+#include "ebpf/util/DDSketch.h"
 #include "logger/Logger.h"
 
 namespace logtail::ebpf {
@@ -69,11 +71,22 @@ public:
     void SetTraceId(std::array<uint64_t, 4>&& traceId) { mTraceId = traceId; }
     void SetSpanId(std::array<uint64_t, 2>&& spanId) { mSpanId = spanId; }
 
+    // make the record reusable by RecordPool, references to connection and app are released
+    virtual void Reset() {
+        mConnection.reset();
+        mAppDetail.reset();
+        mStartTs = 0;
+        mEndTs = 0;
+        mSample = false;
+        mTraceId = {};
+        mSpanId = {};
+    }
+
 private:
     std::shared_ptr<Connection> mConnection;
     std::shared_ptr<AppDetail> mAppDetail;
-    uint64_t mStartTs;
-    uint64_t mEndTs;
+    uint64_t mStartTs = 0;
+    uint64_t mEndTs = 0;
     bool mSample = false;
     mutable std::array<uint64_t, 4> mTraceId{};
     mutable std::array<uint64_t, 2> mSpanId{};
@@ -81,6 +94,7 @@ private:
 
 class HttpRecord : public L7Record {
 public:
+    HttpRecord() : L7Record(nullptr, nullptr) {}
     HttpRecord(const std::shared_ptr<Connection>& conn, const std::shared_ptr<AppDetail>& appDetail)
         : L7Record(conn, appDetail) {}
     [[nodiscard]] virtual bool IsError() const override { return mCode >= 400; }
@@ -107,13 +121,30 @@ public:
     const std::string& GetProtocolVersion() const { return mProtocolVersion; }
     const std::string& GetPath() const { return mPath; }
     const std::string& GetRealPath() const { return mRealPath; }
-    void SetPath(const std::string& path) { mPath = path; }
-    void SetRealPath(const std::string& path) { mRealPath = path; }
+    void SetPath(std::string_view path) { mPath.assign(path.data(), path.size()); }
+    void SetRealPath(std::string_view path) { mRealPath.assign(path.data(), path.size()); }
 
     void SetReqBody(const std::string& body) { mReqBody = body; }
     void SetRespBody(const std::string& body) { mRespBody = body; }
     void SetRespMsg(std::string&& msg) { mRespMsg = std::move(msg); }
-    void SetMethod(const std::string& method) { mHttpMethod = method; }
+    void SetMethod(std::string_view method) { mHttpMethod.assign(method.data(), method.size()); }
+
+    // strings are cleared rather than released, so that their capacity is reused by the next record
+    void Reset() override {
+        L7Record::Reset();
+        mCode = 0;
+        mReqBodySize = 0;
+        mRespBodySize = 0;
+        mPath.clear();
+        mRealPath.clear();
+        mReqBody.clear();
+        mRespBody.clear();
+        mHttpMethod.clear();
+        mProtocolVersion.clear();
+        mRespMsg.clear();
+        mReqHeaderMap.clear();
+        mRespHeaderMap.clear();
+    }
 
     // private:
     int mCode = 0;
@@ -183,6 +214,8 @@ public:
     uint64_t m3xxCount = 0;
     uint64_t m4xxCount = 0;
     uint64_t m5xxCount = 0;
+    // latency distribution in nanoseconds
+    DDSketch mLatencySketch;
 
     StaticDataRow<&kAppMetricsTable> mTags;
 };
@@ -0,0 +1,175 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/util/DDSketch.h"
+
+#include <cmath>
+
+#include <algorithm>
+
+namespace logtail::ebpf {
+
+DDSketch::DDSketch(double relativeAccuracy, size_t maxBins)
+    : mRelativeAccuracy(relativeAccuracy),
+      mGamma((1 + relativeAccuracy) / (1 - relativeAccuracy)),
+      mMultiplier(1 / std::log(mGamma)),
+      mMaxBins(std::max<size_t>(maxBins, 1)) {
+}
+
+int32_t DDSketch::Index(double value) const {
+    return static_cast<int32_t>(std::ceil(std::log(value) * mMultiplier));
+}
+
+double DDSketch::LowerBound(int32_t index) const {
+    return std::pow(mGamma, index - 1);
+}
+
+double DDSketch::Value(int32_t index) const {
+    // the value with the same relative error to both bounds of the bin
+    return LowerBound(index) * 2 * mGamma / (1 + mGamma);
+}
+
+int32_t DDSketch::ExtendRange(int32_t minIndex, int32_t maxIndex) {
+    if (mBins.empty()) {
+        minIndex = std::max<int64_t>(minIndex, int64_t(maxIndex) - int64_t(mMaxBins) + 1);
+        mBins.assign(maxIndex - minIndex + 1, 0);
+        mOffset = minIndex;
+        return minIndex;
+    }
+    int32_t curMax = mOffset + static_cast<int32_t>(mBins.size()) - 1;
+    int32_t newMax = std::max(maxIndex, curMax);
+    int32_t newMin = std::max<int64_t>(std::min(minIndex, mOffset), int64_t(newMax) - int64_t(mMaxBins) + 1);
+    if (newMin == mOffset && newMax == curMax) {
+        return newMin;
+    }
+    if (newMin <= mOffset) {
+        mBins.insert(mBins.begin(), mOffset - newMin, 0);
+        mBins.resize(newMax - newMin + 1, 0);
+    } else {
+        // collapse the lowest bins into the lowest kept one
+        uint64_t collapsed = 0;
+        size_t collapsedCnt = std::min<size_t>(newMin - mOffset, mBins.size());
+        for (size_t i = 0; i < collapsedCnt; ++i) {
+            collapsed += mBins[i];
+        }
+        mBins.erase(mBins.begin(), mBins.begin() + collapsedCnt);
+        mBins.resize(newMax - newMin + 1, 0);
+        mBins[0] += static_cast<uint32_t>(collapsed);
+    }
+    mOffset = newMin;
+    return newMin;
+}
+
+void DDSketch::Add(double value, uint32_t count) {
+    if (count == 0 || std::isnan(value)) {
+        return;
+    }
+    mCount += count;
+    mSum += value * count;
+    mMin = std::min(mMin, value);
+    mMax = std::max(mMax, value);
+    if (value <= kMinIndexableValue) {
+        mZeroCount += count;
+        return;
+    }
+    int32_t index = Index(value);
+    int32_t curMax = mOffset + static_cast<int32_t>(mBins.size()) - 1;
+    if (mBins.empty() || index < mOffset || index > curMax) {
+        index = std::max(index, ExtendRange(index, index));
+    }
+    mBins[index - mOffset] += count;
+}
+
+bool DDSketch::Merge(const DDSketch& other) {
+    if (other.mRelativeAccuracy != mRelativeAccuracy) {
+        return false;
+    }
+    if (other.Empty()) {
+        return true;
+    }
+    mCount += other.mCount;
+    mSum += other.mSum;
+    mMin = std::min(mMin, other.mMin);
+    mMax = std::max(mMax, other.mMax);
+    mZeroCount += other.mZeroCount;
+    if (other.mBins.empty()) {
+        return true;
+    }
+    int32_t otherMax = other.mOffset + static_cast<int32_t>(other.mBins.size()) - 1;
+    int32_t minIndex = ExtendRange(other.mOffset, otherMax);
+    for (size_t i = 0; i < other.mBins.size(); ++i) {
+        int32_t index = std::max(other.mOffset + static_cast<int32_t>(i), minIndex);
+        mBins[index - mOffset] += other.mBins[i];
+    }
+    return true;
+}
+
+void DDSketch::Clear() {
+    mBins.clear();
+    mOffset = 0;
+    mZeroCount = 0;
+    mCount = 0;
+    mSum = 0;
+    mMin = std::numeric_limits<double>::max();
+    mMax = std::numeric_limits<double>::lowest();
+}
+
+double DDSketch::Quantile(double q) const {
+    if (Empty() || q < 0 || q > 1) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    // min and max are tracked exactly
+    if (q == 0) {
+        return mMin;
+    }
+    if (q == 1) {
+        return mMax;
+    }
+    double rank = q * (mCount - 1);
+    if (rank < mZeroCount) {
+        return std::max(mMin, 0.0);
+    }
+    uint64_t cum = mZeroCount;
+    for (size_t i = 0; i < mBins.size(); ++i) {
+        cum += mBins[i];
+        if (cum > rank) {
+            return std::clamp(Value(mOffset + static_cast<int32_t>(i)), mMin, mMax);
+        }
+    }
+    return mMax;
+}
+
+uint64_t DDSketch::CountNoLargerThan(double bound) const {
+    if (bound >= mMax) {
+        return mCount;
+    }
+    if (bound < mMin) {
+        return 0;
+    }
+    uint64_t res = mZeroCount;
+    if (bound <= kMinIndexableValue) {
+        return res;
+    }
+    int32_t index = Index(bound);
+    for (size_t i = 0; i < mBins.size() && mOffset + static_cast<int32_t>(i) <= index; ++i) {
+        // the bin containing the bound is counted only if its representative value is no larger than the bound
+        if (mOffset + static_cast<int32_t>(i) == index && Value(index) > bound) {
+            break;
+        }
+        res += mBins[i];
+    }
+    return res;
+}
+
+} // namespace logtail::ebpf
@@ -0,0 +1,85 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <vector>
+
+namespace logtail::ebpf {
+
+// DDSketch is a mergeable quantile sketch with relative error guarantee. Positive values are mapped into logarithmic
+// bins, so that any quantile returned is within mRelativeAccuracy of the exact one. Bins are kept in a dense array
+// covering only the range seen, and the number of bins is capped at mMaxBins by collapsing the lowest ones, which
+// keeps the memory bounded while preserving the accuracy of high quantiles, e.g. p99 of latency.
+class DDSketch {
+public:
+    static constexpr double kDefaultRelativeAccuracy = 0.02;
+    // with the default accuracy, 512 bins (2KB) cover values from 1 to 7e8 without collapsing
+    static constexpr size_t kDefaultMaxBins = 512;
+
+    explicit DDSketch(double relativeAccuracy = kDefaultRelativeAccuracy, size_t maxBins = kDefaultMaxBins);
+
+    // values no larger than kMinIndexableValue are counted as zero
+    void Add(double value, uint32_t count = 1);
+    // both sketches must be created with the same relative accuracy, otherwise false is returned
+    bool Merge(const DDSketch& other);
+    void Clear();
+
+    // q should be within [0, 1], NaN is returned when the sketch is empty
+    [[nodiscard]] double Quantile(double q) const;
+    // approximate number of values no larger than bound
+    [[nodiscard]] uint64_t CountNoLargerThan(double bound) const;
+
+    [[nodiscard]] bool Empty() const { return mCount == 0; }
+    [[nodiscard]] uint64_t Count() const { return mCount; }
+    [[nodiscard]] double Sum() const { return mSum; }
+    [[nodiscard]] double Min() const { return mMin; }
+    [[nodiscard]] double Max() const { return mMax; }
+    [[nodiscard]] size_t BinCount() const { return mBins.size(); }
+    [[nodiscard]] double RelativeAccuracy() const { return mRelativeAccuracy; }
+
+    static constexpr double kMinIndexableValue = 1e-9;
+
+private:
+    int32_t Index(double value) const;
+    double LowerBound(int32_t index) const;
+    double Value(int32_t index) const;
+    // make bins cover [minIndex, maxIndex] with lowest bins collapsed if necessary, returns the actual min index
+    int32_t ExtendRange(int32_t minIndex, int32_t maxIndex);
+
+    double mRelativeAccuracy;
+    double mGamma;
+    double mMultiplier;
+    size_t mMaxBins;
+
+    // mBins[i] holds the count of bin with index mOffset + i
+    std::vector<uint32_t> mBins;
+    int32_t mOffset = 0;
+    uint64_t mZeroCount = 0;
+
+    uint64_t mCount = 0;
+    double mSum = 0;
+    double mMin = std::numeric_limits<double>::max();
+    double mMax = std::numeric_limits<double>::lowest();
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class DDSketchUnittest;
+#endif
+};
+
+} // namespace logtail::ebpf
@@ -0,0 +1,255 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/memory/SourceBuffer.h"
+#include "logger/Logger.h"
+
+namespace logtail {
+
+// FlatAggTree is a drop-in alternative of AggTree for hot aggregation paths. Instead of a tree of hash maps, all leaves
+// live in one open-addressing table keyed by the combination of all agg keys, and the first level of the hierarchy is
+// kept as groups, each of which chains its leaves, so that the data can still be exported group by group.
+//
+// Leaves and groups are stored in vectors whose capacity survives Reset, so that no node is allocated in steady state.
+// Aggregate and build functions are template parameters and are inlined, rather than invoked through std::function.
+//
+// Node count includes both groups and leaves, which equals the node count of AggTree when KeyDepth is 2.
+template <class Data, class Value, size_t KeyDepth, class AggregateFunc, class BuildFunc, bool NeedSourceBuffer>
+class FlatAggTree {
+public:
+    static_assert(KeyDepth > 0, "KeyDepth must be positive");
+
+    using KeyType = std::array<size_t, KeyDepth>;
+
+    struct Group {
+        size_t mKey = 0;
+        uint32_t mFirstLeaf = kInvalidIdx;
+        uint32_t mLastLeaf = kInvalidIdx;
+        std::shared_ptr<SourceBuffer> mSourceBuffer;
+    };
+
+    FlatAggTree(size_t maxNodes, AggregateFunc aggregateFunc, BuildFunc buildFunc)
+        : mMaxNodes(maxNodes), mAggregateFunc(std::move(aggregateFunc)), mBuildFunc(std::move(buildFunc)) {
+        mLeafSlots.resize(kInitialSlotCount);
+        mGroupSlots.resize(kInitialSlotCount);
+    }
+
+    bool Aggregate(const Value& d, const KeyType& aggKeys) {
+        size_t hash = HashKeys(aggKeys);
+        Slot* slot = FindLeafSlot(hash, aggKeys);
+        if (slot->mIdx == kInvalidIdx) {
+            slot = AddLeaf(hash, aggKeys);
+            if (slot == nullptr) {
+                return false;
+            }
+        }
+        auto& leaf = mLeaves[slot->mIdx];
+        if (!leaf.mData) {
+            // generate new node ...
+            leaf.mData = mBuildFunc(d, mGroups[leaf.mGroupIdx].mSourceBuffer);
+        }
+        mAggregateFunc(leaf.mData, d);
+        mEventCount++;
+        return true;
+    }
+
+    // call(Group&) is invoked once for each first level key, in the order of their first appearance
+    template <class Func>
+    void ForEachGroup(Func&& call) {
+        for (auto& group : mGroups) {
+            call(group);
+        }
+    }
+
+    // call(const Data*) is invoked for each leaf of the group which has been built successfully
+    template <class Func>
+    void ForEach(const Group& group, Func&& call) const {
+        for (uint32_t idx = group.mFirstLeaf; idx != kInvalidIdx; idx = mLeaves[idx].mNext) {
+            if (mLeaves[idx].mData != nullptr) {
+                call(mLeaves[idx].mData.get());
+            }
+        }
+    }
+
+    template <class Func>
+    void ForEach(Func&& call) const {
+        for (const auto& leaf : mLeaves) {
+            if (leaf.mData != nullptr) {
+                call(leaf.mData.get());
+            }
+        }
+    }
+
+    // all data is released, while the memory of nodes and slots is kept for the next period
+    void Reset() {
+        mLeaves.clear();
+        mGroups.clear();
+        std::fill(mLeafSlots.begin(), mLeafSlots.end(), Slot());
+        std::fill(mGroupSlots.begin(), mGroupSlots.end(), Slot());
+        mEventCount = 0;
+    }
+
+    [[nodiscard]] size_t NodeCount() const { return mLeaves.size() + mGroups.size(); }
+
+    [[nodiscard]] size_t GroupCount() const { return mGroups.size(); }
+
+    [[nodiscard]] size_t EventCount() const { return mEventCount; }
+
+    // bytes reserved by the nodes and slots, excluding the data
+    [[nodiscard]] size_t ReservedBytes() const {
+        return mLeaves.capacity() * sizeof(Leaf) + mGroups.capacity() * sizeof(Group)
+            + (mLeafSlots.capacity() + mGroupSlots.capacity()) * sizeof(Slot);
+    }
+
+private:
+    static constexpr uint32_t kInvalidIdx = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t kInitialSlotCount = 64;
+
+    struct Slot {
+        size_t mHash = 0;
+        uint32_t mIdx = kInvalidIdx;
+    };
+
+    struct Leaf {
+        KeyType mKeys;
+        uint32_t mGroupIdx = kInvalidIdx;
+        // next leaf of the same group
+        uint32_t mNext = kInvalidIdx;
+        std::unique_ptr<Data> mData;
+    };
+
+    // agg keys may be poorly distributed in low bits (e.g. std::hash of integers), so they are mixed before probing
+    static size_t Mix(size_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static size_t HashKeys(const KeyType& keys) {
+        size_t seed = 0UL;
+        for (auto key : keys) {
+            seed ^= key + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return Mix(seed);
+    }
+
+    Slot* FindLeafSlot(size_t hash, const KeyType& keys) {
+        size_t mask = mLeafSlots.size() - 1;
+        for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+            auto& slot = mLeafSlots[pos];
+            if (slot.mIdx == kInvalidIdx || (slot.mHash == hash && mLeaves[slot.mIdx].mKeys == keys)) {
+                return &slot;
+            }
+        }
+    }
+
+    Slot* FindGroupSlot(size_t hash, size_t key) {
+        size_t mask = mGroupSlots.size() - 1;
+        for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+            auto& slot = mGroupSlots[pos];
+            if (slot.mIdx == kInvalidIdx || (slot.mHash == hash && mGroups[slot.mIdx].mKey == key)) {
+                return &slot;
+            }
+        }
+    }
+
+    Slot* AddLeaf(size_t hash, const KeyType& keys) {
+        size_t groupHash = Mix(keys[0]);
+        Slot* groupSlot = FindGroupSlot(groupHash, keys[0]);
+        bool isNewGroup = groupSlot->mIdx == kInvalidIdx;
+        if (NodeCount() + (isNewGroup ? 2 : 1) > mMaxNodes) {
+            // when we exceed the maximum limit, we will drop new metrics
+            LOG_ERROR(sLogger, ("maximum limit exceeded", mMaxNodes));
+            return nullptr;
+        }
+
+        if (isNewGroup) {
+            groupSlot->mHash = groupHash;
+            groupSlot->mIdx = static_cast<uint32_t>(mGroups.size());
+            auto& group = mGroups.emplace_back();
+            group.mKey = keys[0];
+            if (NeedSourceBuffer) {
+                // groups will setup new sourcebuffer, and leaves will hold the ref of their group's
+                group.mSourceBuffer = std::make_shared<SourceBuffer>(kDefaultNodeSourceBufferSize);
+            }
+        }
+        uint32_t groupIdx = groupSlot->mIdx;
+        uint32_t leafIdx = static_cast<uint32_t>(mLeaves.size());
+        auto& leaf = mLeaves.emplace_back();
+        leaf.mKeys = keys;
+        leaf.mGroupIdx = groupIdx;
+        auto& group = mGroups[groupIdx];
+        if (group.mLastLeaf == kInvalidIdx) {
+            group.mFirstLeaf = leafIdx;
+        } else {
+            mLeaves[group.mLastLeaf].mNext = leafIdx;
+        }
+        group.mLastLeaf = leafIdx;
+
+        // keep load factor no more than 1/2, both tables only grow so that rehashing stops after warming up
+        if (mGroups.size() * 2 > mGroupSlots.size()) {
+            Rehash(mGroupSlots);
+        }
+        if (mLeaves.size() * 2 > mLeafSlots.size()) {
+            Rehash(mLeafSlots);
+        }
+        Slot* slot = FindLeafSlot(hash, keys);
+        slot->mHash = hash;
+        slot->mIdx = leafIdx;
+        return slot;
+    }
+
+    static void Rehash(std::vector<Slot>& slots) {
+        std::vector<Slot> newSlots(slots.size() * 2);
+        size_t mask = newSlots.size() - 1;
+        for (const auto& slot : slots) {
+            if (slot.mIdx == kInvalidIdx) {
+                continue;
+            }
+            size_t pos = slot.mHash & mask;
+            while (newSlots[pos].mIdx != kInvalidIdx) {
+                pos = (pos + 1) & mask;
+            }
+            newSlots[pos] = slot;
+        }
+        slots.swap(newSlots);
+    }
+
+    size_t mMaxNodes = 0UL;
+    size_t mEventCount = 0UL;
+
+    std::vector<Leaf> mLeaves;
+    std::vector<Group> mGroups;
+    std::vector<Slot> mLeafSlots;
+    std::vector<Slot> mGroupSlots;
+
+    AggregateFunc mAggregateFunc;
+    BuildFunc mBuildFunc;
+};
+
+} // namespace logtail
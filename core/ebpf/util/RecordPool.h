@@ -0,0 +1,151 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common/Lock.h"
+
+namespace logtail::ebpf {
+
+// RecordPool recycles records which are handed out as std::shared_ptr, so that records can still flow through the
+// existing queues of std::shared_ptr<CommonEvent>. Both the record and the control block of the shared_ptr are taken
+// from free lists, so that no allocation happens in steady state, and strings inside a record keep their capacity.
+//
+// T must provide Reset(), which is called when the last reference is dropped and should release everything the record
+// refers to (e.g. connections). Records are acquired by the poller thread and released by the handler thread, so the
+// free lists are guarded by a spin lock.
+//
+// The pool must outlive all records acquired from it.
+template <class T>
+class RecordPool {
+public:
+    static constexpr size_t kDefaultMaxCachedCount = 4096;
+
+    explicit RecordPool(size_t maxCachedCount = kDefaultMaxCachedCount) : mMaxCachedCount(maxCachedCount) {}
+
+    ~RecordPool() {
+        for (auto* obj : mFreeObjects) {
+            delete obj;
+        }
+        for (auto* block : mFreeBlocks) {
+            ::operator delete(block);
+        }
+    }
+
+    RecordPool(const RecordPool&) = delete;
+    RecordPool& operator=(const RecordPool&) = delete;
+
+    std::shared_ptr<T> Acquire() {
+        T* obj = nullptr;
+        {
+            std::lock_guard<SpinLock> lock(mLock);
+            if (!mFreeObjects.empty()) {
+                obj = mFreeObjects.back();
+                mFreeObjects.pop_back();
+            }
+        }
+        if (obj == nullptr) {
+            obj = new T();
+        }
+        return std::shared_ptr<T>(obj, Recycler{this}, BlockAllocator<T>(this));
+    }
+
+    [[nodiscard]] size_t CachedCount() const {
+        std::lock_guard<SpinLock> lock(mLock);
+        return mFreeObjects.size();
+    }
+
+private:
+    struct Recycler {
+        void operator()(T* obj) const { mPool->Release(obj); }
+        RecordPool* mPool;
+    };
+
+    // allocator for the control block of shared_ptr, whose size is fixed for a given T
+    template <class U>
+    struct BlockAllocator {
+        using value_type = U;
+
+        explicit BlockAllocator(RecordPool* pool) : mPool(pool) {}
+        template <class V>
+        BlockAllocator(const BlockAllocator<V>& other) : mPool(other.mPool) {}
+
+        U* allocate(size_t n) { return static_cast<U*>(mPool->AllocateBlock(n * sizeof(U))); }
+        void deallocate(U* p, size_t n) { mPool->DeallocateBlock(p, n * sizeof(U)); }
+
+        template <class V>
+        bool operator==(const BlockAllocator<V>& other) const {
+            return mPool == other.mPool;
+        }
+        template <class V>
+        bool operator!=(const BlockAllocator<V>& other) const {
+            return mPool != other.mPool;
+        }
+
+        RecordPool* mPool;
+    };
+
+    void Release(T* obj) {
+        obj->Reset();
+        {
+            std::lock_guard<SpinLock> lock(mLock);
+            if (mFreeObjects.size() < mMaxCachedCount) {
+                mFreeObjects.push_back(obj);
+                return;
+            }
+        }
+        delete obj;
+    }
+
+    void* AllocateBlock(size_t size) {
+        {
+            std::lock_guard<SpinLock> lock(mLock);
+            if (size == mBlockSize && !mFreeBlocks.empty()) {
+                void* block = mFreeBlocks.back();
+                mFreeBlocks.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void DeallocateBlock(void* block, size_t size) {
+        {
+            std::lock_guard<SpinLock> lock(mLock);
+            if (mBlockSize == 0) {
+                mBlockSize = size;
+            }
+            if (size == mBlockSize && mFreeBlocks.size() < mMaxCachedCount) {
+                mFreeBlocks.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    size_t mMaxCachedCount;
+    size_t mBlockSize = 0;
+    mutable SpinLock mLock;
+    std::vector<T*> mFreeObjects;
+    std::vector<void*> mFreeBlocks;
+};
+
+} // namespace logtail::ebpf
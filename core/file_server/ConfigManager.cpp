@@ -237,6 +237,14 @@ void ConfigManager::RemoveHandler(const string& dir, bool delete_flag) {
 
 // this functions should only be called when register base dir
 bool ConfigManager::RegisterHandlers() {
+    return RegisterHandlersOfConfigs(nullptr);
+}
+
+bool ConfigManager::RegisterHandlers(const unordered_set<string>& configNames) {
+    return RegisterHandlersOfConfigs(&configNames);
+}
+
+bool ConfigManager::RegisterHandlersOfConfigs(const unordered_set<string>* configNames) {
     if (mSharedHandler == NULL) {
         mSharedHandler = new NormalEventHandler();
     }
@@ -244,6 +252,9 @@ bool ConfigManager::RegisterHandlers() {
     vector<FileDiscoveryConfig> wildcardConfigs;
     auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
     for (auto itr = nameConfigMap.begin(); itr != nameConfigMap.end(); ++itr) {
+        if (configNames != nullptr && configNames->find(itr->first) == configNames->end()) {
+            continue;
+        }
         if (itr->second.first->GetWildcardPaths().empty())
             sortedConfigs.push_back(itr->second);
         else
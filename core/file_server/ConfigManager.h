@@ -20,6 +20,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -254,6 +255,8 @@ public:
     void RegisterWildcardPath(const FileDiscoveryConfig& config, const std::string& path, int32_t depth);
     bool RegisterHandlers(const std::string& basePath, const FileDiscoveryConfig& config);
     bool RegisterHandlers();
+    // register base dirs of the given configs only, used when only part of the configs are updated
+    bool RegisterHandlers(const std::unordered_set<std::string>& configNames);
     bool RegisterHandlersRecursively(const std::string& dir, const FileDiscoveryConfig& config, bool checkTimeout);
     // 废弃，蚂蚁
     // /**
@@ -493,6 +496,8 @@ private:
     ConfigManager& operator=(const ConfigManager&);
 
     // void ClearRegions();
+    // configNames == nullptr means all configs
+    bool RegisterHandlersOfConfigs(const std::unordered_set<std::string>* configNames);
     /** XXX: path is not registered in this method
      * @param path is the current dir that being registered
      * @depth is the num of sub dir layers that should be registered
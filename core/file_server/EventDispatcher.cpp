@@ -28,6 +28,7 @@
 #include <limits.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "app_config/AppConfig.h"
@@ -226,7 +227,18 @@ bool EventDispatcher::RegisterEventHandler(const string& path,
     }
 
     wd = -1;
-    if (mInotifyWatchNum >= INT32_FLAG(default_max_inotify_watch_num)) {
+    if (mEventListener->IsInit() && !AppConfig::GetInstance()->IsInInotifyBlackList(path)) {
+        // dirs on a filesystem marked by fanotify consume no inotify watch
+        wd = mEventListener->AddMountWideWatch(path.c_str());
+    }
+    if (EventListener::IsMountWideID(wd)) {
+        if (mWdDirInfoMap.find(wd) != mWdDirInfoMap.end()) {
+            LOG_DEBUG(sLogger,
+                      ("can not register fanotify monitor", path)("inode", inode)("wd", wd)(
+                          "reason", "there is already a dir in fanotify watch list shard the same inode"));
+            wd = -1;
+        }
+    } else if (mInotifyWatchNum >= INT32_FLAG(default_max_inotify_watch_num)) {
         LOG_INFO(sLogger,
                  ("failed to add inotify watcher for dir", path)("max allowed inotify watchers",
                                                                  INT32_FLAG(default_max_inotify_watch_num)));
@@ -614,6 +626,14 @@ EventDispatcher::ValidateCheckpointResult EventDispatcher::validateCheckpoint(
 }
 
 void EventDispatcher::AddExistedCheckPointFileEvents() {
+    addExistedCheckPointFileEvents(nullptr);
+}
+
+void EventDispatcher::AddExistedCheckPointFileEvents(const unordered_set<string>& configNames) {
+    addExistedCheckPointFileEvents(&configNames);
+}
+
+void EventDispatcher::addExistedCheckPointFileEvents(const unordered_set<string>* configNames) {
     // All checkpoint will be add into event queue or be deleted
     // This operation will delete not existed file's check point
     map<DevInode, SplitedFilePath> cachePathDevInodeMap;
@@ -622,6 +642,10 @@ void EventDispatcher::AddExistedCheckPointFileEvents() {
     vector<CheckPointManager::CheckPointKey> deleteKeyVec;
     vector<Event*> eventVec;
     for (auto iter = checkPointMap.begin(); iter != checkPointMap.end(); ++iter) {
+        // readers of other configs are still alive, their checkpoints must not generate events
+        if (configNames != nullptr && configNames->find(iter->second->mConfigName) == configNames->end()) {
+            continue;
+        }
         auto const result = validateCheckpoint(iter->second, cachePathDevInodeMap, eventVec);
         if (!(result == ValidateCheckpointResult::kNormal || result == ValidateCheckpointResult::kRotate)) {
             deleteKeyVec.push_back(iter->first);
@@ -638,6 +662,12 @@ void EventDispatcher::AddExistedCheckPointFileEvents() {
     // Load exactly once checkpoints and create events from them.
     // Because they are not in v1 checkpoint manager, no need to delete them.
     auto exactlyOnceConfigs = FileServer::GetInstance()->GetExactlyOnceConfigs();
+    if (configNames != nullptr) {
+        exactlyOnceConfigs.erase(remove_if(exactlyOnceConfigs.begin(),
+                                           exactlyOnceConfigs.end(),
+                                           [&](const string& name) { return configNames->count(name) == 0; }),
+                                 exactlyOnceConfigs.end());
+    }
     if (!exactlyOnceConfigs.empty()) {
         static auto* sCptMV2 = CheckpointManagerV2::GetInstance();
         auto exactlyOnceCpts = sCptMV2->ScanCheckpoints(exactlyOnceConfigs);
@@ -853,7 +883,9 @@ void EventDispatcher::UnregisterEventHandler(const string& path) {
     mWdUpdateTimeMap.erase(wd);
     if (EventListener::IsValidID(wd) && mEventListener->IsInit()) {
         mEventListener->RemoveWatch(wd);
-        mInotifyWatchNum--;
+        if (!EventListener::IsMountWideID(wd)) {
+            mInotifyWatchNum--;
+        }
     }
     mWatchNum--;
     LOG_INFO(sLogger, ("remove the watcher for dir", path)("wd", wd));
@@ -992,6 +1024,105 @@ void EventDispatcher::DumpAllHandlersMeta(bool remove) {
     LOG_INFO(sLogger, ("save log reader status", "succeeded"));
 }
 
+void EventDispatcher::DumpConfigHandlersMeta(const unordered_set<string>& configNames) {
+    // same order as DumpAllHandlersMeta: rotator readers first
+    for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
+        it->second->mHandler->DumpConfigReaderMeta(true, configNames);
+    }
+    for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
+        it->second->mHandler->DumpConfigReaderMeta(false, configNames);
+        it->second->mHandler->RemoveConfigReaders(configNames);
+    }
+    // remember dirs matched by the old options, which may be no longer needed after the update
+    for (const auto& configName : configNames) {
+        FileDiscoveryConfig config = FileServer::GetInstance()->GetFileDiscoveryConfig(configName);
+        if (config.first == nullptr) {
+            continue;
+        }
+        for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
+            if (config.first->IsMatch(it->second->mPath, "")) {
+                mPausedConfigDirs.insert(it->second->mPath);
+            }
+        }
+    }
+    mPausedConfigs.insert(configNames.begin(), configNames.end());
+    LOG_INFO(sLogger, ("save log reader status", "succeeded")("config count", configNames.size()));
+}
+
+void EventDispatcher::ResumeConfigHandlers(const unordered_set<string>& configNames) {
+    for (const auto& configName : configNames) {
+        mPausedConfigs.erase(configName);
+    }
+    // the kept events are handed back only if the config still exists and still matches the file
+    vector<Event*> eventVec;
+    vector<FileDiscoveryConfig> configs;
+    for (auto* ev : mPausedConfigEvents) {
+        configs.clear();
+        if (AppConfig::GetInstance()->IsAcceptMultiConfig()) {
+            ConfigManager::GetInstance()->FindAllMatch(configs, ev->GetSource(), ev->GetEventObject());
+        } else {
+            ConfigManager::GetInstance()->FindMatchWithForceFlag(configs, ev->GetSource(), ev->GetEventObject());
+        }
+        if (any_of(configs.begin(), configs.end(), [&](const FileDiscoveryConfig& config) {
+                return config.second->GetConfigName() == ev->GetConfigName();
+            })) {
+            eventVec.push_back(ev);
+        } else {
+            delete ev;
+        }
+    }
+    mPausedConfigEvents.clear();
+    mPausedConfigModifyEvents.clear();
+    if (!eventVec.empty()) {
+        LogInput::GetInstance()->PushEventQueue(eventVec);
+    }
+    UnregisterUnmatchedDirs(mPausedConfigDirs);
+    mPausedConfigDirs.clear();
+    LOG_INFO(sLogger,
+             ("resume log readers", "succeeded")("config count", configNames.size())("event count", eventVec.size()));
+}
+
+bool EventDispatcher::DeferEventOfPausedConfig(const Event& event, const string& configName) {
+    if (mPausedConfigs.find(configName) == mPausedConfigs.end()) {
+        return false;
+    }
+    if (event.GetType() == EVENT_MODIFY) {
+        // one modify event is enough for the reader to read to the end of the file
+        string key = event.GetSource() + ">" + event.GetEventObject() + ">" + ToString(event.GetDev()) + ">"
+            + ToString(event.GetInode()) + ">" + configName;
+        if (!mPausedConfigModifyEvents.insert(key).second) {
+            return true;
+        }
+    }
+    auto* ev = new Event(event);
+    ev->SetConfigName(configName);
+    mPausedConfigEvents.push_back(ev);
+    return true;
+}
+
+void EventDispatcher::UnregisterUnmatchedDirs(const unordered_set<string>& dirs) {
+    // dirs registered for removed or changed configs are not watched any more, same as DumpAllHandlersMeta
+    vector<string> unmatchedDirs;
+    for (const auto& path : dirs) {
+        if (mPathWdMap.find(path) != mPathWdMap.end()
+            && ConfigManager::GetInstance()->FindBestMatch(path).first == NULL) {
+            unmatchedDirs.push_back(path);
+        }
+    }
+    for (const auto& path : unmatchedDirs) {
+        auto pos = mPathWdMap.find(path);
+        EventHandler* handler = mWdDirInfoMap[pos->second]->mHandler;
+        handler->DumpReaderMeta(true, true);
+        handler->DumpReaderMeta(false, true);
+        ConfigManager::GetInstance()->AddHandlerToDelete(handler);
+        UnregisterEventHandler(path);
+        ConfigManager::GetInstance()->RemoveHandler(path, false);
+    }
+    if (!unmatchedDirs.empty()) {
+        LOG_INFO(sLogger, ("unregister dirs no config matches", "succeeded")("dir count", unmatchedDirs.size()));
+    }
+}
+
 void EventDispatcher::ProcessHandlerTimeOut() {
     MapType<int, DirInfo*>::Type::iterator mapIter = mWdDirInfoMap.begin();
     for (; mapIter != mWdDirInfoMap.end(); ++mapIter) {
@@ -30,6 +30,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/checkpoint/CheckPointManager.h"
@@ -198,6 +199,15 @@ public:
     // virtual void ExtraWork() = 0;
 
     void DumpAllHandlersMeta(bool);
+    // dump and release readers of the given configs only, dir registrations and readers of other configs are kept.
+    // Events of these configs are kept aside until ResumeConfigHandlers, so that LogInput can go on with other configs
+    // without creating readers on the options of the pipelines being replaced.
+    void DumpConfigHandlersMeta(const std::unordered_set<std::string>& configNames);
+    // hand the kept events of the given configs back to LogInput, and unregister dirs of these configs which no config
+    // matches any more
+    void ResumeConfigHandlers(const std::unordered_set<std::string>& configNames);
+    // return true if the event is kept for a config released by DumpConfigHandlersMeta
+    bool DeferEventOfPausedConfig(const Event& event, const std::string& configName);
     std::vector<std::pair<std::string, EventHandler*> > FindAllSubDirAndHandler(const std::string& baseDir);
     void UnregisterAllDir(const std::string& basePath);
     bool IsRegistered(int wd, std::string& path);
@@ -214,6 +224,7 @@ public:
 
     void ProcessHandlerTimeOut();
     void AddExistedCheckPointFileEvents();
+    void AddExistedCheckPointFileEvents(const std::unordered_set<std::string>& configNames);
 
     void DumpInotifyWatcherDirs();
 
@@ -251,6 +262,9 @@ protected:
     ValidateCheckpointResult validateCheckpoint(CheckPointPtr& checkpoint,
                                                 std::map<DevInode, SplitedFilePath>& cachePathDevInodeMap,
                                                 std::vector<Event*>& eventVec);
+    // configNames == nullptr means all configs
+    void addExistedCheckPointFileEvents(const std::unordered_set<std::string>* configNames);
+    void UnregisterUnmatchedDirs(const std::unordered_set<std::string>& dirs);
 
     // int mListenFd;
     int mWatchNum;
@@ -271,6 +285,11 @@ protected:
     std::set<std::string> mBrokenLinkSet;
     // for timeout issue
     MapType<int, time_t>::Type mWdUpdateTimeMap;
+    // configs being updated, only accessed by LogInput thread or when LogInput is held
+    std::unordered_set<std::string> mPausedConfigs;
+    std::vector<Event*> mPausedConfigEvents;
+    std::unordered_set<std::string> mPausedConfigModifyEvents;
+    std::unordered_set<std::string> mPausedConfigDirs;
     // std::unordered_map<int64_t, SingleDSPacket*> mPacketBuffer;
     // void* mStreamLogManagerPtr;
     // volatile bool mMainThreadRunning;
@@ -289,6 +308,8 @@ protected:
     friend class EventDispatcherDirUnittest;
     friend class ModifyHandlerUnittest;
     friend class PipelineUpdateUnittest;
+    friend class LogInputUnittest;
+    friend class EventListenerBenchmark;
 
     void CleanEnviroments();
     int32_t GetInotifyWatcherCount();
@@ -81,6 +81,8 @@ public:
 
     uint32_t GetLastContainerUpdateTime() const { return mLastContainerUpdateTime; }
     void SetLastContainerUpdateTime(uint32_t time) { mLastContainerUpdateTime = time; }
+    uint64_t GetLastContainerChangeSeq() const { return mLastContainerChangeSeq; }
+    void SetLastContainerChangeSeq(uint64_t seq) { mLastContainerChangeSeq = seq; }
 
 
     std::vector<std::string> mFilePaths;
@@ -140,6 +142,8 @@ private:
     bool mTailingAllMatchedFiles = false;
 
     uint32_t mLastContainerUpdateTime = 0;
+    // sequence number of the last container change evaluated by this config, 0 means never evaluated
+    uint64_t mLastContainerChangeSeq = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FileDiscoveryOptionsUnittest;
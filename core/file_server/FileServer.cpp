@@ -80,6 +80,15 @@ void FileServer::Pause(bool isConfigUpdate) {
     }
 }
 
+// 暂停指定配置的文件采集，只转储并释放这些配置的 reader
+// 仅在交接期间短暂暂停 LogInput，其他配置在配置更新期间继续采集，这些配置的事件被暂存直至 ResumeConfigs
+void FileServer::PauseConfigs(const unordered_set<string>& configNames) {
+    PauseInner();
+    // 其他配置的 reader 未转储，此时不能将内存中的检查点写入本地，否则会覆盖它们的检查点
+    EventDispatcher::GetInstance()->DumpConfigHandlersMeta(configNames);
+    ResumeInner();
+}
+
 // 暂停文件服务的内部实现，记录日志并处理暂停逻辑
 void FileServer::PauseInner() {
     LOG_INFO(sLogger, ("file server pause", "starts"));
@@ -119,12 +128,37 @@ void FileServer::Resume(bool isConfigUpdate, bool isContainerUpdate) {
     if (isConfigUpdate) {
         EventDispatcher::GetInstance()->AddExistedCheckPointFileEvents();
     }
+    ResumeInner();
+    LOG_INFO(sLogger, ("file server resume", "succeeded"));
+}
+
+// 恢复指定配置的文件采集，仅为这些配置注册目录并从检查点恢复 reader，同时注销已无配置匹配的目录
+void FileServer::ResumeConfigs(const unordered_set<string>& configNames) {
+    PauseInner();
+    if (ContainerManager::GetInstance()->CheckContainerDiffForAllConfig()) {
+        ContainerManager::GetInstance()->ApplyContainerDiffs();
+        ContainerManager::GetInstance()->SaveContainerInfo();
+    }
+    LOG_INFO(sLogger, ("file server resume", "starts")("config count", configNames.size()));
+    // 匹配缓存中可能仍有旧配置，需在注册目录前清理
+    EventDispatcher::GetInstance()->ClearBrokenLinkSet();
+    PollingDirFile::GetInstance()->ClearCache();
+    ConfigManager::GetInstance()->ClearFilePipelineMatchCache();
+    ConfigManager::GetInstance()->RegisterHandlers(configNames);
+    LOG_INFO(sLogger, ("watch dirs", "succeeded"));
+    EventDispatcher::GetInstance()->AddExistedCheckPointFileEvents(configNames);
+    EventDispatcher::GetInstance()->ResumeConfigHandlers(configNames);
+    ResumeInner();
+    LOG_INFO(sLogger, ("file server resume", "succeeded"));
+}
+
+// 恢复文件服务的内部实现，与 PauseInner 对应
+void FileServer::ResumeInner() {
     LogInput::GetInstance()->Resume();
     if (BOOL_FLAG(enable_polling_discovery)) {
         PollingModify::GetInstance()->Resume();
         PollingDirFile::GetInstance()->Resume();
     }
-    LOG_INFO(sLogger, ("file server resume", "succeeded"));
 }
 
 // 停止文件服务，将事件处理程序的元数据以及检查点数据保存到本地
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "collection_pipeline/CollectionPipelineContext.h"
@@ -44,10 +45,14 @@ public:
 
     void Start();
     void Pause(bool isConfigUpdate = true);
+    // 仅释放指定配置的 reader 并在恢复时为其重新注册目录，其他配置的 reader 与目录注册保持不变，且在此期间继续采集
+    void PauseConfigs(const std::unordered_set<std::string>& configNames);
 
     // for plugin
     FileDiscoveryConfig GetFileDiscoveryConfig(const std::string& name) const;
-    const std::unordered_map<std::string, FileDiscoveryConfig>& GetAllFileDiscoveryConfigs() const {
+    // LogInput may go on matching files while other configs are being updated, so a copy is returned under lock
+    std::unordered_map<std::string, FileDiscoveryConfig> GetAllFileDiscoveryConfigs() const {
+        ReadLock lock(mReadWriteLock);
         return mPipelineNameFileDiscoveryConfigsMap;
     }
     void
@@ -91,6 +96,7 @@ public:
 
     // 过渡使用
     void Resume(bool isConfigUpdate = true, bool isContainerUpdate = false);
+    void ResumeConfigs(const std::unordered_set<std::string>& configNames);
     void Stop();
     uint32_t GetExactlyOnceConcurrency(const std::string& name) const;
     std::vector<std::string> GetExactlyOnceConfigs() const;
@@ -102,6 +108,7 @@ private:
     ~FileServer() = default;
 
     void PauseInner();
+    void ResumeInner();
 
     mutable ReadWriteLock mReadWriteLock;
 
@@ -14,6 +14,9 @@
 
 #include "file_server/StaticFileServer.h"
 
+#include <cstring>
+#include <fstream>
+
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "common/LogtailCommonFlags.h"
 #include "file_server/checkpoint/InputStaticFileCheckpointManager.h"
@@ -21,6 +24,13 @@
 
 
 DEFINE_FLAG_INT32(input_static_file_checkpoint_dump_interval_sec, "", 5);
+DEFINE_FLAG_INT32(static_file_read_thread_num,
+                  "number of threads reading ranges of large static files, 0 means files are read one by one",
+                  0);
+DEFINE_FLAG_INT64(static_file_range_split_min_bytes,
+                  "static files not smaller than this are read by ranges",
+                  256 * 1024 * 1024);
+DEFINE_FLAG_INT64(static_file_range_bytes, "approximate size of each range of a static file", 64 * 1024 * 1024);
 
 using namespace std;
 
@@ -29,6 +39,13 @@ namespace logtail {
 void StaticFileServer::Init() {
     InputStaticFileCheckpointManager::GetInstance()->GetAllCheckpointFileNames();
     mThreadRes = async(launch::async, &StaticFileServer::Run, this);
+    {
+        lock_guard<mutex> lock(mRangeMux);
+        mIsRangeWorkerRunning = true;
+    }
+    for (int32_t i = 0; i < INT32_FLAG(static_file_read_thread_num); ++i) {
+        mRangeWorkerRes.emplace_back(async(launch::async, &StaticFileServer::RunRangeWorker, this));
+    }
     mStartTime = time(nullptr);
 }
 
@@ -41,8 +58,26 @@ void StaticFileServer::Stop() {
         mIsThreadRunning = false;
     }
     mStopCV.notify_all();
+    {
+        lock_guard<mutex> lock(mRangeMux);
+        mIsRangeWorkerRunning = false;
+        // queued ranges are read again from the checkpoint on restart
+        for (const auto& task : mRangeTasks) {
+            auto it = mRangeTaskCnt.find(make_pair(task.mConfigName, task.mInputIdx));
+            if (it != mRangeTaskCnt.end() && --it->second == 0) {
+                mRangeTaskCnt.erase(it);
+            }
+        }
+        mRangeTasks.clear();
+    }
+    mRangeCV.notify_all();
 
     future_status s = mThreadRes.wait_for(chrono::seconds(1));
+    for (auto& res : mRangeWorkerRes) {
+        if (s == future_status::ready) {
+            s = res.wait_for(chrono::seconds(1));
+        }
+    }
     if (s == future_status::ready) {
         LOG_INFO(sLogger, ("static file server", "stopped successfully"));
     } else {
@@ -72,6 +107,26 @@ void StaticFileServer::RemoveInput(const string& configName, size_t idx) {
         mInputFileTagConfigsMap.erase(make_pair(configName, idx));
         mDeletedInputs.emplace(configName, idx);
     }
+    {
+        // the options used by range readers are released once the input is removed
+        auto input = make_pair(configName, idx);
+        unique_lock<mutex> lock(mRangeMux);
+        mStoppedRangeInputs.insert(input);
+        for (auto it = mRangeTasks.begin(); it != mRangeTasks.end();) {
+            if (it->mConfigName == configName && it->mInputIdx == idx) {
+                --mRangeTaskCnt[input];
+                it = mRangeTasks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        mRangeCV.wait(lock, [&]() {
+            auto it = mRangeTaskCnt.find(input);
+            return it == mRangeTaskCnt.end() || it->second == 0;
+        });
+        mRangeTaskCnt.erase(input);
+        mStoppedRangeInputs.erase(input);
+    }
     InputStaticFileCheckpointManager::GetInstance()->DeleteCheckpoint(configName, idx);
 }
 
@@ -139,6 +194,10 @@ void StaticFileServer::ReadFiles() {
             if (mDeletedInputs.find(make_pair(configName, inputIdx)) != mDeletedInputs.end()) {
                 continue;
             }
+            if (HasRangeTasks(configName, inputIdx)) {
+                // the current file is being read by ranges
+                continue;
+            }
 
             auto& reader = item.second.second;
             auto cur = chrono::system_clock::now();
@@ -148,6 +207,17 @@ void StaticFileServer::ReadFiles() {
                     if (!reader) {
                         break;
                     }
+                    if (TryReadByRanges(configName, inputIdx, reader)) {
+                        reader = nullptr;
+                        break;
+                    }
+                    uint64_t offset = 0;
+                    if (InputStaticFileCheckpointManager::GetInstance()->ClearCurrentFileRanges(
+                            configName, inputIdx, offset)) {
+                        // ranges left by the last run are not read any more, e.g. range reading is disabled now, so
+                        // the file is read from the position before which all bytes have been read
+                        reader->SetLastFilePos(static_cast<int64_t>(offset));
+                    }
                 }
 
                 bool skip = false;
@@ -223,6 +293,209 @@ LogFileReaderPtr StaticFileServer::GetNextAvailableReader(const string& configNa
     return LogFileReaderPtr();
 }
 
+bool StaticFileServer::TryReadByRanges(const string& configName, size_t idx, const LogFileReaderPtr& reader) {
+    if (mRangeWorkerRes.empty()) {
+        return false;
+    }
+    auto multilineConfig = GetMultilineConfig(configName, idx);
+    if (multilineConfig.first && multilineConfig.first->IsMultiline()) {
+        // a multiline event may cross the boundary of ranges
+        return false;
+    }
+
+    size_t fileIdx = 0;
+    vector<FileRangeCheckpoint> ranges;
+    if (!InputStaticFileCheckpointManager::GetInstance()->GetCurrentFileRanges(configName, idx, fileIdx, ranges)) {
+        return false;
+    }
+    if (ranges.empty()) {
+        // ranges may already exist if the checkpoint is loaded from file
+        auto size = static_cast<uint64_t>(reader->GetFileSize());
+        if (size < static_cast<uint64_t>(INT64_FLAG(static_file_range_split_min_bytes))) {
+            return false;
+        }
+        SplitFileByLines(reader->GetHostLogPath(), size, INT64_FLAG(static_file_range_bytes), ranges);
+        if (ranges.size() <= 1) {
+            return false;
+        }
+        if (!InputStaticFileCheckpointManager::GetInstance()->SetCurrentFileRanges(
+                configName, idx, size, vector<FileRangeCheckpoint>(ranges))) {
+            return false;
+        }
+    }
+
+    FileFingerprint fingerprint;
+    if (!InputStaticFileCheckpointManager::GetInstance()->GetCurrentFileFingerprint(configName, idx, &fingerprint)) {
+        return false;
+    }
+    size_t cnt = 0;
+    {
+        lock_guard<mutex> lock(mRangeMux);
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (ranges[i].mOffset >= ranges[i].mEnd) {
+                continue;
+            }
+            RangeTask task;
+            task.mConfigName = configName;
+            task.mInputIdx = idx;
+            task.mFileIdx = fileIdx;
+            task.mRangeIdx = i;
+            task.mRange = ranges[i];
+            task.mFingerprint = fingerprint;
+            task.mDiscoveryConfig = GetFileDiscoveryConfig(configName, idx);
+            task.mReaderConfig = GetFileReaderConfig(configName, idx);
+            task.mMultilineConfig = multilineConfig;
+            task.mTagConfig = GetFileTagConfig(configName, idx);
+            mRangeTasks.emplace_back(std::move(task));
+            ++cnt;
+        }
+        if (cnt > 0) {
+            mRangeTaskCnt[make_pair(configName, idx)] += cnt;
+        }
+    }
+    if (cnt == 0) {
+        // should not happen, the ranges are cleared once all of them are read
+        return false;
+    }
+    mRangeCV.notify_all();
+    LOG_INFO(sLogger,
+             ("read file by ranges, config", configName)("input idx", idx)("filepath", reader->GetHostLogPath())(
+                 "file size", reader->GetFileSize())("range count", ranges.size())("pending range count", cnt));
+    return true;
+}
+
+bool StaticFileServer::HasRangeTasks(const string& configName, size_t idx) const {
+    lock_guard<mutex> lock(mRangeMux);
+    return mRangeTaskCnt.find(make_pair(configName, idx)) != mRangeTaskCnt.end();
+}
+
+bool StaticFileServer::IsRangeReadingAllowed(const pair<string, size_t>& input) const {
+    lock_guard<mutex> lock(mRangeMux);
+    return mIsRangeWorkerRunning && mStoppedRangeInputs.find(input) == mStoppedRangeInputs.end();
+}
+
+void StaticFileServer::RunRangeWorker() {
+    while (true) {
+        RangeTask task;
+        {
+            unique_lock<mutex> lock(mRangeMux);
+            mRangeCV.wait(lock, [this]() { return !mIsRangeWorkerRunning || !mRangeTasks.empty(); });
+            if (!mIsRangeWorkerRunning) {
+                return;
+            }
+            task = std::move(mRangeTasks.front());
+            mRangeTasks.pop_front();
+        }
+        ReadRange(task);
+        {
+            lock_guard<mutex> lock(mRangeMux);
+            auto it = mRangeTaskCnt.find(make_pair(task.mConfigName, task.mInputIdx));
+            if (it != mRangeTaskCnt.end() && --it->second == 0) {
+                mRangeTaskCnt.erase(it);
+            }
+        }
+        mRangeCV.notify_all();
+    }
+}
+
+void StaticFileServer::ReadRange(const RangeTask& task) {
+    const auto& configName = task.mConfigName;
+    auto inputIdx = task.mInputIdx;
+    const auto& filepath = task.mFingerprint.mFilePath;
+    LogFileReaderPtr reader(LogFileReader::CreateLogFileReader(filepath.parent_path().string(),
+                                                               filepath.filename().string(),
+                                                               task.mFingerprint.mDevInode,
+                                                               task.mReaderConfig,
+                                                               task.mMultilineConfig,
+                                                               task.mDiscoveryConfig,
+                                                               task.mTagConfig,
+                                                               0,
+                                                               true));
+    string errMsg;
+    if (!reader) {
+        errMsg = "failed to create reader";
+    } else if (!reader->UpdateFilePtr()) {
+        errMsg = "failed to open file";
+    } else if (!reader->CheckFileSignatureAndOffset(false)
+               || reader->GetSignature()
+                   != make_pair(task.mFingerprint.mSignatureHash, task.mFingerprint.mSignatureSize)) {
+        errMsg = "file signature check failed";
+    }
+    if (!errMsg.empty()) {
+        LOG_WARNING(sLogger,
+                    ("failed to get range reader", errMsg)("config", configName)("input idx", inputIdx)(
+                        "filepath", filepath.string())("range begin", task.mRange.mBegin));
+        InputStaticFileCheckpointManager::GetInstance()->InvalidateCurrentFileRangeCheckpoint(
+            configName, inputIdx, task.mFileIdx);
+        return;
+    }
+    reader->SetReadRange(task.mRange.mOffset, task.mRange.mEnd);
+
+    auto input = make_pair(configName, inputIdx);
+    while (IsRangeReadingAllowed(input)) {
+        if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            continue;
+        }
+        auto logBuffer = make_unique<LogBuffer>();
+        bool moreData = reader->ReadLog(*logBuffer, nullptr);
+        auto group = LogFileReader::GenerateEventGroup(reader, logBuffer.get());
+        // other ranges push to the same queue, so the queue may become full after the check above
+        while (!ProcessorRunner::GetInstance()->PushQueue(reader->GetQueueKey(), inputIdx, std::move(group), 10)) {
+            if (!IsRangeReadingAllowed(input)) {
+                return;
+            }
+        }
+        uint64_t offset = moreData ? reader->GetLastFilePos() : task.mRange.mEnd;
+        if (!InputStaticFileCheckpointManager::GetInstance()->UpdateCurrentFileRangeCheckpoint(
+                configName, inputIdx, task.mFileIdx, task.mRangeIdx, offset)) {
+            // the file has been invalidated by another range
+            return;
+        }
+        if (!moreData) {
+            return;
+        }
+    }
+}
+
+void StaticFileServer::SplitFileByLines(const string& filepath,
+                                        uint64_t size,
+                                        uint64_t rangeBytes,
+                                        vector<FileRangeCheckpoint>& ranges) {
+    ranges.clear();
+    ifstream is(filepath, ios::binary);
+    if (!is || rangeBytes == 0) {
+        return;
+    }
+    string buf(4096, '\0');
+    uint64_t begin = 0;
+    while (size - begin > rangeBytes) {
+        // each range ends right after a line feed, so that no line is split
+        uint64_t pos = begin + rangeBytes;
+        uint64_t end = size;
+        is.clear();
+        is.seekg(static_cast<streamoff>(pos));
+        while (pos < size && end == size) {
+            is.read(&buf[0], static_cast<streamsize>(min<uint64_t>(buf.size(), size - pos)));
+            auto n = static_cast<size_t>(is.gcount());
+            if (n == 0) {
+                break;
+            }
+            auto* lf = static_cast<const char*>(memchr(buf.data(), '\n', n));
+            if (lf != nullptr) {
+                end = pos + (lf - buf.data()) + 1;
+            }
+            pos += n;
+        }
+        ranges.emplace_back(begin, end);
+        begin = end;
+        if (end == size) {
+            return;
+        }
+    }
+    ranges.emplace_back(begin, size);
+}
+
 void StaticFileServer::UpdateInputs() {
     unique_lock<mutex> lock(mUpdateMux);
     for (const auto& item : mDeletedInputs) {
@@ -275,6 +548,13 @@ FileTagConfig StaticFileServer::GetFileTagConfig(const std::string& name, size_t
 #ifdef APSARA_UNIT_TEST_MAIN
 void StaticFileServer::Clear() {
     Stop();
+    // the server is started again by the next input
+    mThreadRes = future<void>();
+    mRangeWorkerRes.clear();
+    {
+        lock_guard<mutex> lock(mThreadRunningMux);
+        mIsThreadRunning = true;
+    }
     lock_guard<mutex> lock(mUpdateMux);
     mInputFileDiscoveryConfigsMap.clear();
     mInputFileReaderConfigsMap.clear();
@@ -283,6 +563,10 @@ void StaticFileServer::Clear() {
     mPipelineNameReadersMap.clear();
     mAddedInputs.clear();
     mDeletedInputs.clear();
+    lock_guard<mutex> rangeLock(mRangeMux);
+    mRangeTasks.clear();
+    mRangeTaskCnt.clear();
+    mStoppedRangeInputs.clear();
 }
 #endif
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <future>
 #include <map>
@@ -30,6 +31,7 @@
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/FileTagOptions.h"
 #include "file_server/MultilineOptions.h"
+#include "file_server/checkpoint/FileCheckpoint.h"
 #include "file_server/reader/FileReaderOptions.h"
 #include "file_server/reader/LogFileReader.h"
 #include "runner/InputRunner.h"
@@ -66,6 +68,19 @@ public:
 #endif
 
 private:
+    struct RangeTask {
+        std::string mConfigName;
+        size_t mInputIdx = 0;
+        size_t mFileIdx = 0;
+        size_t mRangeIdx = 0;
+        FileRangeCheckpoint mRange;
+        FileFingerprint mFingerprint;
+        FileDiscoveryConfig mDiscoveryConfig;
+        FileReaderConfig mReaderConfig;
+        MultilineConfig mMultilineConfig;
+        FileTagConfig mTagConfig;
+    };
+
     StaticFileServer() = default;
     ~StaticFileServer() = default;
 
@@ -74,6 +89,16 @@ private:
     void UpdateInputs();
     LogFileReaderPtr GetNextAvailableReader(const std::string& configName, size_t idx);
 
+    bool TryReadByRanges(const std::string& configName, size_t idx, const LogFileReaderPtr& reader);
+    bool HasRangeTasks(const std::string& configName, size_t idx) const;
+    bool IsRangeReadingAllowed(const std::pair<std::string, size_t>& input) const;
+    void RunRangeWorker();
+    void ReadRange(const RangeTask& task);
+    static void SplitFileByLines(const std::string& filepath,
+                                 uint64_t size,
+                                 uint64_t rangeBytes,
+                                 std::vector<FileRangeCheckpoint>& ranges);
+
     FileDiscoveryConfig GetFileDiscoveryConfig(const std::string& name, size_t idx) const;
     FileReaderConfig GetFileReaderConfig(const std::string& name, size_t idx) const;
     MultilineConfig GetMultilineConfig(const std::string& name, size_t idx) const;
@@ -98,8 +123,19 @@ private:
     std::multimap<std::string, size_t> mAddedInputs;
     std::set<std::pair<std::string, size_t>> mDeletedInputs;
 
+    // large files are split into line-aligned ranges and read by the workers
+    std::vector<std::future<void>> mRangeWorkerRes;
+    mutable std::mutex mRangeMux;
+    std::condition_variable mRangeCV;
+    bool mIsRangeWorkerRunning = false;
+    std::deque<RangeTask> mRangeTasks;
+    // number of queued and running range tasks of each input
+    std::map<std::pair<std::string, size_t>, size_t> mRangeTaskCnt;
+    std::set<std::pair<std::string, size_t>> mStoppedRangeInputs;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class StaticFileServerUnittest;
+    friend class StaticFileServerBenchmark;
     friend class InputStaticFileUnittest;
 #endif
 };
@@ -20,6 +20,7 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include "common/DevInode.h"
 
@@ -36,6 +37,16 @@ enum class FileStatus {
 const std::string& FileStatusToString(FileStatus status);
 FileStatus GetFileStatusFromString(const std::string& status);
 
+// progress of one line-aligned range, when a large file is read by several ranges in parallel
+struct FileRangeCheckpoint {
+    uint64_t mBegin = 0;
+    uint64_t mEnd = 0;
+    uint64_t mOffset = 0; // next position to read, the range is done when it reaches mEnd
+
+    FileRangeCheckpoint() = default;
+    FileRangeCheckpoint(uint64_t begin, uint64_t end) : mBegin(begin), mEnd(end), mOffset(begin) {}
+};
+
 struct FileCheckpoint {
     std::filesystem::path mFilePath;
     // std::string mRealFileName;
@@ -47,6 +58,8 @@ struct FileCheckpoint {
     FileStatus mStatus = FileStatus::WAITING;
     int32_t mStartTime = 0;
     int32_t mLastUpdateTime = 0;
+    // not empty only when the file is being read by ranges
+    std::vector<FileRangeCheckpoint> mRanges;
 
     FileCheckpoint() = default;
     FileCheckpoint(const std::filesystem::path& filename,
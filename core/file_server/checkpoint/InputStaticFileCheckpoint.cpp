@@ -171,6 +171,84 @@ void InputStaticFileCheckpoint::SetAbort() {
     }
 }
 
+bool InputStaticFileCheckpoint::SetCurrentFileRanges(uint64_t size,
+                                                     vector<FileRangeCheckpoint>&& ranges,
+                                                     bool& needDump) {
+    needDump = false;
+    if (mCurrentFileIndex >= mFileCheckpoints.size() || ranges.empty()) {
+        // should not happen
+        return false;
+    }
+    auto& fileCpt = mFileCheckpoints[mCurrentFileIndex];
+    if (!fileCpt.mRanges.empty()) {
+        return true;
+    }
+    fileCpt.mRanges = std::move(ranges);
+    return UpdateCurrentFileCheckpoint(0, size, needDump);
+}
+
+bool InputStaticFileCheckpoint::GetCurrentFileRanges(size_t& fileIdx, vector<FileRangeCheckpoint>& ranges) const {
+    if (mStatus != StaticFileReadingStatus::RUNNING || mCurrentFileIndex >= mFileCheckpoints.size()) {
+        return false;
+    }
+    fileIdx = mCurrentFileIndex;
+    ranges = mFileCheckpoints[mCurrentFileIndex].mRanges;
+    return true;
+}
+
+bool InputStaticFileCheckpoint::UpdateCurrentFileRangeCheckpoint(size_t fileIdx,
+                                                                 size_t rangeIdx,
+                                                                 uint64_t offset,
+                                                                 bool& needDump) {
+    needDump = false;
+    if (fileIdx != mCurrentFileIndex || fileIdx >= mFileCheckpoints.size()) {
+        // the file has been finished or aborted
+        return false;
+    }
+    auto& fileCpt = mFileCheckpoints[fileIdx];
+    if (fileCpt.mStatus != FileStatus::READING || rangeIdx >= fileCpt.mRanges.size()) {
+        return false;
+    }
+    auto& range = fileCpt.mRanges[rangeIdx];
+    range.mOffset = min(max(offset, range.mBegin), range.mEnd);
+
+    // ranges are contiguous and in order, so the offset of the file is kept as the position before which all bytes
+    // are read, which is still valid when the file is read sequentially later
+    for (const auto& item : fileCpt.mRanges) {
+        if (item.mOffset < item.mEnd) {
+            fileCpt.mOffset = item.mOffset;
+            fileCpt.mLastUpdateTime = time(nullptr);
+            return true;
+        }
+    }
+    fileCpt.mRanges.clear();
+    return UpdateCurrentFileCheckpoint(fileCpt.mSize, fileCpt.mSize, needDump);
+}
+
+bool InputStaticFileCheckpoint::ClearCurrentFileRanges(uint64_t& offset) {
+    if (mStatus != StaticFileReadingStatus::RUNNING || mCurrentFileIndex >= mFileCheckpoints.size()) {
+        return false;
+    }
+    auto& fileCpt = mFileCheckpoints[mCurrentFileIndex];
+    if (fileCpt.mRanges.empty()) {
+        return false;
+    }
+    fileCpt.mRanges.clear();
+    offset = fileCpt.mOffset;
+    return true;
+}
+
+bool InputStaticFileCheckpoint::InvalidateCurrentFileRangeCheckpoint(size_t fileIdx) {
+    if (fileIdx != mCurrentFileIndex) {
+        // the file has been invalidated by another range
+        return false;
+    }
+    if (fileIdx < mFileCheckpoints.size()) {
+        mFileCheckpoints[fileIdx].mRanges.clear();
+    }
+    return InvalidateCurrentFileCheckpoint();
+}
+
 bool InputStaticFileCheckpoint::Serialize(string* res) const {
     if (!res) {
         // should not happen
@@ -212,6 +290,17 @@ bool InputStaticFileCheckpoint::Serialize(string* res) const {
                 file["offset"] = cpt.mOffset;
                 file["start_time"] = cpt.mStartTime;
                 file["last_read_time"] = cpt.mLastUpdateTime;
+                if (!cpt.mRanges.empty()) {
+                    file["ranges"] = Json::arrayValue;
+                    auto& ranges = file["ranges"];
+                    for (const auto& range : cpt.mRanges) {
+                        Json::Value item;
+                        item["begin"] = range.mBegin;
+                        item["end"] = range.mEnd;
+                        item["offset"] = range.mOffset;
+                        ranges.append(std::move(item));
+                    }
+                }
                 break;
             case FileStatus::FINISHED:
                 file["size"] = cpt.mSize;
@@ -350,6 +439,27 @@ bool InputStaticFileCheckpoint::Deserialize(const string& str, string* errMsg) {
                 if (!GetMandatoryIntParam(fileCpt, outerKey + ".last_read_time", cpt.mLastUpdateTime, *errMsg)) {
                     return false;
                 }
+                if (fileCpt.isMember("ranges")) {
+                    const Json::Value& ranges = fileCpt["ranges"];
+                    if (!ranges.isArray()) {
+                        *errMsg = "optional param " + outerKey + ".ranges is not of type array";
+                        return false;
+                    }
+                    for (Json::Value::ArrayIndex j = 0; j < ranges.size(); ++j) {
+                        string rangeKey = outerKey + ".ranges[" + ToString(j) + "]";
+                        FileRangeCheckpoint range;
+                        if (!GetMandatoryUInt64Param(ranges[j], rangeKey + ".begin", range.mBegin, *errMsg)) {
+                            return false;
+                        }
+                        if (!GetMandatoryUInt64Param(ranges[j], rangeKey + ".end", range.mEnd, *errMsg)) {
+                            return false;
+                        }
+                        if (!GetMandatoryUInt64Param(ranges[j], rangeKey + ".offset", range.mOffset, *errMsg)) {
+                            return false;
+                        }
+                        cpt.mRanges.push_back(range);
+                    }
+                }
                 break;
             case FileStatus::FINISHED:
                 if (!GetMandatoryUInt64Param(fileCpt, outerKey + ".size", cpt.mSize, *errMsg)) {
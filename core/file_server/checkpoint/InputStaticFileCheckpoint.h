@@ -48,6 +48,15 @@ public:
     bool GetCurrentFileFingerprint(FileFingerprint* cpt);
     void SetAbort();
 
+    // 当前文件按区间并行读取。若当前文件已有区间（如从 checkpoint 文件恢复），则保留原有区间
+    bool SetCurrentFileRanges(uint64_t size, std::vector<FileRangeCheckpoint>&& ranges, bool& needDump);
+    bool GetCurrentFileRanges(size_t& fileIdx, std::vector<FileRangeCheckpoint>& ranges) const;
+    // fileIdx 与当前文件不一致时（文件已结束或被放弃）返回 false，所有区间读完后当前文件结束
+    bool UpdateCurrentFileRangeCheckpoint(size_t fileIdx, size_t rangeIdx, uint64_t offset, bool& needDump);
+    bool InvalidateCurrentFileRangeCheckpoint(size_t fileIdx);
+    // 当前文件改为顺序读取时清除区间，offset 为此前已连续读完的位置
+    bool ClearCurrentFileRanges(uint64_t& offset);
+
     bool Serialize(std::string* res) const;
     bool Deserialize(const std::string& str, std::string* errMsg);
     bool SerializeToLogEvents() const;
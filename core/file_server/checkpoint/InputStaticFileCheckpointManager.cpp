@@ -234,6 +234,107 @@ bool InputStaticFileCheckpointManager::GetCurrentFileFingerprint(const string& c
     return it->second.GetCurrentFileFingerprint(cpt);
 }
 
+bool InputStaticFileCheckpointManager::SetCurrentFileRanges(const string& configName,
+                                                            size_t idx,
+                                                            uint64_t size,
+                                                            vector<FileRangeCheckpoint>&& ranges) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // should not happen
+        return false;
+    }
+    bool needDump = false;
+    if (!it->second.SetCurrentFileRanges(size, std::move(ranges), needDump)) {
+        // should not happen
+        return false;
+    }
+    if (needDump) {
+        if (!DumpCheckpointFile(it->second)) {
+            LOG_WARNING(sLogger,
+                        ("failed to set file ranges",
+                         "failed to dump checkpoint file")("config", configName)("input idx", idx));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InputStaticFileCheckpointManager::GetCurrentFileRanges(const string& configName,
+                                                            size_t idx,
+                                                            size_t& fileIdx,
+                                                            vector<FileRangeCheckpoint>& ranges) const {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // should not happen
+        return false;
+    }
+    return it->second.GetCurrentFileRanges(fileIdx, ranges);
+}
+
+bool InputStaticFileCheckpointManager::UpdateCurrentFileRangeCheckpoint(
+    const string& configName, size_t idx, size_t fileIdx, size_t rangeIdx, uint64_t offset) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // input has been removed
+        return false;
+    }
+    bool needDump = false;
+    if (!it->second.UpdateCurrentFileRangeCheckpoint(fileIdx, rangeIdx, offset, needDump)) {
+        // the file has been finished or invalidated by another range
+        return false;
+    }
+    if (needDump) {
+        if (!DumpCheckpointFile(it->second)) {
+            LOG_WARNING(sLogger,
+                        ("failed to update file range checkpoint",
+                         "failed to dump checkpoint file")("config", configName)("input idx", idx));
+        }
+    }
+    return true;
+}
+
+bool InputStaticFileCheckpointManager::InvalidateCurrentFileRangeCheckpoint(const string& configName,
+                                                                            size_t idx,
+                                                                            size_t fileIdx) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // input has been removed
+        return false;
+    }
+    if (!it->second.InvalidateCurrentFileRangeCheckpoint(fileIdx)) {
+        return false;
+    }
+    if (!DumpCheckpointFile(it->second)) {
+        LOG_WARNING(sLogger,
+                    ("failed to invalidate file range checkpoint",
+                     "failed to dump checkpoint file")("config", configName)("input idx", idx));
+        return false;
+    }
+    return true;
+}
+
+bool InputStaticFileCheckpointManager::ClearCurrentFileRanges(const string& configName, size_t idx, uint64_t& offset) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // should not happen
+        return false;
+    }
+    if (!it->second.ClearCurrentFileRanges(offset)) {
+        return false;
+    }
+    if (!DumpCheckpointFile(it->second)) {
+        LOG_WARNING(sLogger,
+                    ("failed to clear file ranges", "failed to dump checkpoint file")("config", configName)("input idx",
+                                                                                                         idx));
+    }
+    return true;
+}
+
 void InputStaticFileCheckpointManager::DumpAllCheckpointFiles() const {
     lock_guard<mutex> lock(mUpdateMux);
     for (const auto& item : mInputCheckpointMap) {
@@ -51,6 +51,18 @@ public:
     bool UpdateCurrentFileCheckpoint(const std::string& configName, size_t idx, uint64_t offset, uint64_t size);
     bool InvalidateCurrentFileCheckpoint(const std::string& configName, size_t idx);
     bool GetCurrentFileFingerprint(const std::string& configName, size_t idx, FileFingerprint* cpt);
+    bool SetCurrentFileRanges(const std::string& configName,
+                              size_t idx,
+                              uint64_t size,
+                              std::vector<FileRangeCheckpoint>&& ranges);
+    bool GetCurrentFileRanges(const std::string& configName,
+                              size_t idx,
+                              size_t& fileIdx,
+                              std::vector<FileRangeCheckpoint>& ranges) const;
+    bool UpdateCurrentFileRangeCheckpoint(
+        const std::string& configName, size_t idx, size_t fileIdx, size_t rangeIdx, uint64_t offset);
+    bool InvalidateCurrentFileRangeCheckpoint(const std::string& configName, size_t idx, size_t fileIdx);
+    bool ClearCurrentFileRanges(const std::string& configName, size_t idx, uint64_t& offset);
 
     void DumpAllCheckpointFiles() const;
     void GetAllCheckpointFileNames();
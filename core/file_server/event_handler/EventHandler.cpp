@@ -192,6 +192,28 @@ bool CreateModifyHandler::DumpReaderMeta(bool isRotatorReader, bool checkConfigF
     return true;
 }
 
+void CreateModifyHandler::DumpConfigReaderMeta(bool isRotatorReader,
+                                               const std::unordered_set<std::string>& configNames) {
+    for (const auto& configName : configNames) {
+        auto iter = mModifyHandlerPtrMap.find(configName);
+        if (iter != mModifyHandlerPtrMap.end()) {
+            iter->second->DumpReaderMeta(isRotatorReader, true);
+        }
+    }
+}
+
+void CreateModifyHandler::RemoveConfigReaders(const std::unordered_set<std::string>& configNames) {
+    // readers hold pointers to the options of the old pipeline, so they must be released before the old pipeline is
+    // destroyed. They are recreated from checkpoints with the new options afterwards.
+    for (const auto& configName : configNames) {
+        auto iter = mModifyHandlerPtrMap.find(configName);
+        if (iter != mModifyHandlerPtrMap.end()) {
+            delete iter->second;
+            mModifyHandlerPtrMap.erase(iter);
+        }
+    }
+}
+
 bool CreateModifyHandler::IsAllFileRead() {
     for (ModifyHandlerMap::iterator iter = mModifyHandlerPtrMap.begin(); iter != mModifyHandlerPtrMap.end(); ++iter) {
         if (!iter->second->IsAllFileRead()) {
@@ -251,6 +273,10 @@ void CreateModifyHandler::Handle(const Event& event) {
         }
     } else if (event.IsCreate() || event.IsModify() || event.IsMoveFrom() || event.IsMoveTo() || event.IsDeleted()) {
         if (!event.GetConfigName().empty()) {
+            // config being updated, the event is handled after the update
+            if (EventDispatcher::GetInstance()->DeferEventOfPausedConfig(event, event.GetConfigName())) {
+                return;
+            }
             FileDiscoveryConfig pConfig = FileServer::GetInstance()->GetFileDiscoveryConfig(event.GetConfigName());
             if (pConfig.first) {
                 LOG_DEBUG(sLogger,
@@ -271,6 +297,10 @@ void CreateModifyHandler::Handle(const Event& event) {
             }
 
             for (auto configIter = pConfigVec.begin(); configIter != pConfigVec.end(); ++configIter) {
+                if (EventDispatcher::GetInstance()->DeferEventOfPausedConfig(event,
+                                                                            configIter->second->GetConfigName())) {
+                    continue;
+                }
                 LOG_DEBUG(
                     sLogger,
                     ("Process event with multi config", pConfigVec.size())(event.GetSource(), event.GetEventObject()));
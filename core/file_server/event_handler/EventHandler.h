@@ -20,6 +20,7 @@
 #include <deque>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "file_server/reader/LogFileReader.h"
 
@@ -39,6 +40,9 @@ public:
     virtual void Handle(const Event& event) = 0;
     virtual void HandleTimeOut() = 0;
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) = 0;
+    // only readers belonging to the given configs are dumped / released, used by per config reload
+    virtual void DumpConfigReaderMeta(bool isRotatorReader, const std::unordered_set<std::string>& configNames) {}
+    virtual void RemoveConfigReaders(const std::unordered_set<std::string>& configNames) {}
     virtual bool IsAllFileRead() { return true; }
     virtual ~EventHandler() {}
 };
@@ -169,6 +173,8 @@ public:
     virtual void Handle(const Event& event);
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
+    void DumpConfigReaderMeta(bool isRotatorReader, const std::unordered_set<std::string>& configNames) override;
+    void RemoveConfigReaders(const std::unordered_set<std::string>& configNames) override;
     bool IsAllFileRead() override;
 
     ModifyHandler* GetOrCreateModifyHandler(const std::string& configName, const FileDiscoveryConfig& pConfig);
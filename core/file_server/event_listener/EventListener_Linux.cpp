@@ -14,11 +14,22 @@
 
 #include "EventListener_Linux.h"
 
+#include <fcntl.h>
+#include <sys/fanotify.h>
 #include <sys/inotify.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
 #include <unistd.h>
 
+#include <climits>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string_view>
+
 #include "common/ErrorUtil.h"
+#include "common/FileSystemUtil.h"
 #include "common/Flags.h"
 #include "file_server/EventDispatcher.h"
 #include "file_server/event_handler/LogInput.h"
@@ -26,18 +37,52 @@
 #include "monitor/AlarmManager.h"
 
 DEFINE_FLAG_BOOL(fs_events_inotify_enable, "", true);
+DEFINE_FLAG_BOOL(fs_events_fanotify_enable,
+                 "watch dirs by one fanotify mark per filesystem instead of one inotify watch per dir, dirs whose "
+                 "filesystem can not be marked are still watched by inotify. Events of the whole filesystem are "
+                 "queued in kernel without limit and read by the event thread, so writes to files not collected "
+                 "cost kernel memory and cpu as well, and all watched dirs are listed again if events are lost",
+                 false);
 
 namespace logtail {
 
 const uint32_t EventListener::mWatchEventMask
     = IN_CREATE | IN_MODIFY | IN_MASK_ADD | IN_DELETE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE;
 
+#ifdef FAN_REPORT_DFID_NAME
+const uint64_t EventListener::mMountWideEventMask
+    = FAN_CREATE | FAN_MODIFY | FAN_DELETE_SELF | FAN_MOVED_FROM | FAN_MOVED_TO | FAN_DELETE | FAN_ONDIR;
+#else
+const uint64_t EventListener::mMountWideEventMask = 0;
+#endif
+
+// fanotify reports a dir by the fsid of its filesystem and its file handle
+static void GetHandleKey(const fsid_t& fsid, const struct file_handle& handle, std::string& key) {
+    key.assign(reinterpret_cast<const char*>(&fsid), sizeof(fsid));
+    key.append(reinterpret_cast<const char*>(&handle.handle_type), sizeof(handle.handle_type));
+    key.append(reinterpret_cast<const char*>(handle.f_handle), handle.handle_bytes);
+}
+
 logtail::EventListener::~EventListener() {
     Destroy();
 }
 
 bool logtail::EventListener::Init() {
     mInotifyFd = inotify_init();
+    if (BOOL_FLAG(fs_events_fanotify_enable)) {
+#ifdef FAN_REPORT_DFID_NAME
+        // the mark covers the whole filesystem, whose events may easily exceed the default queue size of 16384
+        mFanotifyFd = fanotify_init(
+            FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_NONBLOCK | FAN_CLOEXEC | FAN_UNLIMITED_QUEUE, O_RDONLY);
+#endif
+        if (mFanotifyFd == -1) {
+            LOG_WARNING(sLogger,
+                        ("failed to init fanotify fd, use inotify instead", ErrnoToString(GetErrno()))(
+                            "required", "linux 5.9+ and CAP_SYS_ADMIN"));
+        } else {
+            LOG_INFO(sLogger, ("fanotify fd inited", "dirs are watched by fanotify marks on filesystems"));
+        }
+    }
     return mInotifyFd != -1;
 }
 
@@ -45,83 +90,303 @@ int logtail::EventListener::AddWatch(const char* dir) {
     return inotify_add_watch(mInotifyFd, dir, mWatchEventMask);
 }
 
+int logtail::EventListener::AddMountWideWatch(const char* dir) {
+#ifdef FAN_REPORT_DFID_NAME
+    if (mFanotifyFd < 0) {
+        return -1;
+    }
+    struct statfs fsBuf;
+    if (statfs(dir, &fsBuf) != 0) {
+        return -1;
+    }
+    std::unique_ptr<char[]> handleBuf(new char[sizeof(struct file_handle) + MAX_HANDLE_SZ]);
+    auto* handle = reinterpret_cast<struct file_handle*>(handleBuf.get());
+    handle->handle_bytes = MAX_HANDLE_SZ;
+    int mountId = 0;
+    if (name_to_handle_at(AT_FDCWD, dir, handle, &mountId, AT_SYMLINK_FOLLOW) != 0) {
+        return -1;
+    }
+
+    std::string fsidKey(reinterpret_cast<const char*>(&fsBuf.f_fsid), sizeof(fsBuf.f_fsid));
+    auto fsIter = mMarkedFilesystems.find(fsidKey);
+    if (fsIter == mMarkedFilesystems.end()) {
+        // one mark covers all dirs on the filesystem, events of dirs not registered are dropped when read
+        bool marked
+            = fanotify_mark(mFanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, mMountWideEventMask, AT_FDCWD, dir) == 0;
+        if (marked) {
+            LOG_INFO(sLogger, ("add fanotify mark on the filesystem of dir", dir));
+        } else {
+            LOG_WARNING(sLogger,
+                        ("failed to add fanotify mark on the filesystem of dir, use inotify instead",
+                         dir)("reason", ErrnoToString(GetErrno())));
+        }
+        fsIter = mMarkedFilesystems.emplace(fsidKey, marked).first;
+    }
+    if (!fsIter->second) {
+        return -1;
+    }
+
+    std::string handleKey;
+    GetHandleKey(fsBuf.f_fsid, *handle, handleKey);
+    auto iter = mHandleWdMap.find(handleKey);
+    if (iter != mHandleWdMap.end()) {
+        // the same dir is registered by another path, e.g. a symbolic link
+        return iter->second;
+    }
+    int wd = mNextMountWideWd;
+    mNextMountWideWd = mNextMountWideWd == INT_MAX ? sMountWideWdBase : mNextMountWideWd + 1;
+    mHandleWdMap.emplace(handleKey, wd);
+    mWdHandleMap.emplace(wd, std::move(handleKey));
+    return wd;
+#else
+    return -1;
+#endif
+}
+
 bool logtail::EventListener::RemoveWatch(int wd) {
+    if (IsMountWideID(wd)) {
+        auto iter = mWdHandleMap.find(wd);
+        if (iter == mWdHandleMap.end()) {
+            return false;
+        }
+        mHandleWdMap.erase(iter->second);
+        mWdHandleMap.erase(iter);
+        return true;
+    }
     return inotify_rm_watch(mInotifyFd, wd) != -1;
 }
 
 int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVec) {
     eventVec.clear();
+    if (mFanotifyFd >= 0) {
+        ReadFanotifyEvents(eventVec);
+    }
     if (mInotifyFd < 0) {
-        return 0;
+        return (int32_t)eventVec.size();
     }
     int len = 0;
     ioctl(mInotifyFd, FIONREAD, &len);
     if (len < 1)
-        return 0;
-    static char* s_lastHalfEventBuf = new char[65536];
-    static int32_t s_lastHalfEventSize = 0;
+        return (int32_t)eventVec.size();
 
-    char* buffer = new char[len + s_lastHalfEventSize];
-    if (s_lastHalfEventSize > 0) {
-        memcpy(buffer, s_lastHalfEventBuf, s_lastHalfEventSize);
+    if (mEventBuf.size() < mHalfEventSize + len) {
+        mEventBuf.resize(mHalfEventSize + len);
     }
-    size_t readLen = read(mInotifyFd, buffer + s_lastHalfEventSize, len);
-    if (readLen == 0) {
+    ssize_t readLen = read(mInotifyFd, mEventBuf.data() + mHalfEventSize, len);
+    if (readLen <= 0) {
         LOG_ERROR(sLogger, ("read inotify fd error", ErrnoToString(GetErrno()))("read len", len));
-        delete[] buffer;
-        return 0;
-    }
-    // update len
-    len = readLen + s_lastHalfEventSize;
-    // when read success, set lastHalfSize 0
-    s_lastHalfEventSize = 0;
-    if (BOOL_FLAG(fs_events_inotify_enable)) {
-        static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
-        int n = 0;
-        struct inotify_event* event;
-        while (n < len) {
-            // maybe invalid, must check if this packet is a whole packet
-            event = (struct inotify_event*)&buffer[n];
-
-            int tailSize = len - n;
-            if ((size_t)tailSize < sizeof(struct inotify_event)
-                || (size_t)tailSize < event->len + sizeof(struct inotify_event)) {
-                s_lastHalfEventSize = tailSize;
-                LOG_WARNING(sLogger,
-                            ("read notify event abnormal, half packet is readed, proccess size", n)("read len", len));
-                memcpy(s_lastHalfEventBuf, buffer + n, tailSize);
-                break;
+        return (int32_t)eventVec.size();
+    }
+    size_t totalLen = mHalfEventSize + readLen;
+    size_t parsedLen = ParseEvents(mEventBuf.data(), totalLen, eventVec);
+    mHalfEventSize = totalLen - parsedLen;
+    if (mHalfEventSize > 0) {
+        LOG_WARNING(sLogger,
+                    ("read notify event abnormal, half packet is readed, proccess size", parsedLen)("read len",
+                                                                                                    totalLen));
+        memmove(mEventBuf.data(), mEventBuf.data() + parsedLen, mHalfEventSize);
+    }
+    return (int32_t)eventVec.size();
+}
+
+size_t logtail::EventListener::ParseEvents(const char* buffer, size_t len, std::vector<logtail::Event*>& eventVec) {
+    ModifiedFiles modifiedFiles;
+    size_t n = 0;
+    while (n < len) {
+        // maybe invalid, must check if this packet is a whole packet
+        const struct inotify_event* event = (const struct inotify_event*)&buffer[n];
+        size_t tailSize = len - n;
+        if (tailSize < sizeof(struct inotify_event) || tailSize < event->len + sizeof(struct inotify_event)) {
+            break;
+        }
+        n += sizeof(struct inotify_event) + event->len;
+
+        // when interrupt (config update), must check event buf tail, if not a whole packet, next read will crash
+        if (!BOOL_FLAG(fs_events_inotify_enable) || LogInput::GetInstance()->IsInterupt()) {
+            continue;
+        }
+        if (event->mask & IN_Q_OVERFLOW) {
+            LOG_INFO(sLogger, ("inotify event queue overflow", "miss inotify events"));
+            AlarmManager::GetInstance()->SendAlarmWarning(INOTIFY_EVENT_OVERFLOW_ALARM,
+                                                          "inotify event queue overflow");
+            continue;
+        }
+        EventType etype = 0;
+        etype |= event->mask & IN_DELETE_SELF ? EVENT_TIMEOUT : 0;
+        etype |= event->mask & IN_CREATE ? EVENT_CREATE : 0;
+        etype |= event->mask & IN_MODIFY ? EVENT_MODIFY : 0;
+        etype |= event->mask & IN_ISDIR ? EVENT_ISDIR : 0;
+        etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
+        etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
+        etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
+        if (etype == 0) {
+            continue;
+        }
+        std::string_view name = event->len > 0 ? std::string_view(event->name) : std::string_view();
+        AddEvent(event->wd, name, etype, event->cookie, modifiedFiles, eventVec);
+    }
+    return n;
+}
+
+void logtail::EventListener::ReadFanotifyEvents(std::vector<logtail::Event*>& eventVec) {
+    // FIONREAD of fanotify does not count info records, so events are read until none is left, which is bounded to
+    // keep the thread from being starved by endless writes
+    static const size_t sFanotifyEventBufSize = 64 * 1024;
+    static const int sMaxReadCnt = 16;
+    if (mFanotifyEventBuf.empty()) {
+        mFanotifyEventBuf.resize(sFanotifyEventBufSize);
+    }
+    for (int i = 0; i < sMaxReadCnt; ++i) {
+        // fanotify only returns whole events
+        ssize_t readLen = read(mFanotifyFd, mFanotifyEventBuf.data(), mFanotifyEventBuf.size());
+        if (readLen <= 0) {
+            if (readLen < 0 && errno != EAGAIN) {
+                LOG_ERROR(sLogger, ("read fanotify fd error", ErrnoToString(GetErrno())));
             }
+            break;
+        }
+        ParseFanotifyEvents(mFanotifyEventBuf.data(), readLen, eventVec);
+    }
+}
 
+void logtail::EventListener::ParseFanotifyEvents(const char* buffer,
+                                                 size_t len,
+                                                 std::vector<logtail::Event*>& eventVec) {
+#ifdef FAN_REPORT_DFID_NAME
+    static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+    ModifiedFiles modifiedFiles;
+    std::string handleKey;
+    std::string path;
+    size_t n = 0;
+    while (n + sizeof(struct fanotify_event_metadata) <= len) {
+        // events are only aligned to 4 bytes
+        struct fanotify_event_metadata meta;
+        memcpy(&meta, buffer + n, sizeof(meta));
+        if (meta.vers != FANOTIFY_METADATA_VERSION || meta.event_len < sizeof(meta) || n + meta.event_len > len) {
+            LOG_ERROR(sLogger, ("invalid fanotify event, version", (int)meta.vers)("event len", meta.event_len));
+            break;
+        }
+        const char* metaEnd = buffer + n + meta.event_len;
+        const char* infoBegin = buffer + n + meta.metadata_len;
+        n += meta.event_len;
+        if (meta.fd >= 0) {
+            close(meta.fd);
+        }
+        if (!BOOL_FLAG(fs_events_inotify_enable) || LogInput::GetInstance()->IsInterupt()) {
+            continue;
+        }
+        if (meta.mask & FAN_Q_OVERFLOW) {
+            LOG_INFO(sLogger, ("fanotify event queue overflow", "miss fanotify events, rescan watched dirs"));
+            AlarmManager::GetInstance()->SendAlarmWarning(INOTIFY_EVENT_OVERFLOW_ALARM,
+                                                          "fanotify event queue overflow");
+            RescanMountWideDirs(eventVec);
+            continue;
+        }
 
-            // when interrupt (config update), must check event buf tail, if not a whole packet, next read will crash
-            if (LogInput::GetInstance()->IsInterupt()) {
-                n += sizeof(struct inotify_event) + event->len;
-                continue;
+        // the dir changed and the name of the entry are reported in one info record
+        auto* info = reinterpret_cast<const struct fanotify_event_info_fid*>(infoBegin);
+        if (infoBegin + sizeof(*info) + sizeof(struct file_handle) > metaEnd
+            || info->hdr.info_type != FAN_EVENT_INFO_TYPE_DFID_NAME) {
+            continue;
+        }
+        auto* handle = reinterpret_cast<const struct file_handle*>(info->handle);
+        const char* name = reinterpret_cast<const char*>(handle->f_handle) + handle->handle_bytes;
+        if (name >= metaEnd) {
+            continue;
+        }
+        GetHandleKey(reinterpret_cast<const fsid_t&>(info->fsid), *handle, handleKey);
+        auto iter = mHandleWdMap.find(handleKey);
+        if (iter == mHandleWdMap.end()) {
+            continue;
+        }
+        int wd = iter->second;
+        EventType dirFlag = meta.mask & FAN_ONDIR ? EVENT_ISDIR : 0;
+        std::string_view object(name, strnlen(name, metaEnd - name));
+        if (object == ".") {
+            // events on the dir itself are reported with name "."
+            if (meta.mask & FAN_DELETE_SELF) {
+                AddEvent(wd, std::string_view(), EVENT_TIMEOUT | dirFlag, 0, modifiedFiles, eventVec);
             }
-            EventType etype = 0;
-            if (event->mask & IN_Q_OVERFLOW) {
-                LOG_INFO(sLogger, ("inotify event queue overflow", "miss inotify events"));
-                AlarmManager::GetInstance()->SendAlarmWarning(INOTIFY_EVENT_OVERFLOW_ALARM,
-                                                              "inotify event queue overflow");
-            } else {
-                etype |= event->mask & IN_DELETE_SELF ? EVENT_TIMEOUT : 0;
-                etype |= event->mask & IN_CREATE ? EVENT_CREATE : 0;
-                etype |= event->mask & IN_MODIFY ? EVENT_MODIFY : 0;
-                etype |= event->mask & IN_ISDIR ? EVENT_ISDIR : 0;
-                etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
-                etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
-                etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
-                std::string path;
-                if (etype != 0 && dispatcher->IsRegistered(event->wd, path))
-                    eventVec.push_back(
-                        new Event(path, event->len > 0 ? event->name : "", etype, event->wd, event->cookie));
+            continue;
+        }
+
+        // fanotify merges events of the same entry still in its queue, which are split in the order they are
+        // likely to happen. If the entry both left and came, it exists now only if it came last.
+        std::pair<uint64_t, EventType> arrivals[]
+            = {{FAN_CREATE, EVENT_CREATE}, {FAN_MOVED_TO, EVENT_MOVE_TO}, {FAN_MODIFY, EVENT_MODIFY}};
+        std::pair<uint64_t, EventType> departures[] = {{FAN_MOVED_FROM, EVENT_MOVE_FROM}, {FAN_DELETE, EVENT_DELETE}};
+        bool arrivalFirst = true;
+        if ((meta.mask & (FAN_CREATE | FAN_MOVED_TO)) && (meta.mask & (FAN_MOVED_FROM | FAN_DELETE))
+            && dispatcher->IsRegistered(wd, path)) {
+            struct stat statBuf;
+            arrivalFirst = lstat(path.append("/").append(object).c_str(), &statBuf) != 0;
+        }
+        auto addEvents = [&](const std::pair<uint64_t, EventType>* begin, const std::pair<uint64_t, EventType>* end) {
+            for (auto* it = begin; it != end; ++it) {
+                if (meta.mask & it->first) {
+                    AddEvent(wd, object, it->second | dirFlag, 0, modifiedFiles, eventVec);
+                }
             }
-            n += sizeof(struct inotify_event) + event->len;
+        };
+        if (arrivalFirst) {
+            addEvents(std::begin(arrivals), std::end(arrivals));
+            addEvents(std::begin(departures), std::end(departures));
+        } else {
+            addEvents(std::begin(departures), std::end(departures));
+            addEvents(std::begin(arrivals), std::end(arrivals));
         }
     }
-    delete[] buffer;
-    return (int32_t)eventVec.size();
+#endif
+}
+
+void logtail::EventListener::RescanMountWideDirs(std::vector<logtail::Event*>& eventVec) {
+    static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+    // which events are lost is unknown, so every file is treated as modified and every dir not registered as created
+    std::string path;
+    for (const auto& item : mWdHandleMap) {
+        int wd = item.first;
+        if (!dispatcher->IsRegistered(wd, path)) {
+            continue;
+        }
+        fsutil::Dir dir(path);
+        if (!dir.Open()) {
+            continue;
+        }
+        fsutil::Entry ent;
+        while ((ent = dir.ReadNext())) {
+            if (ent.IsRegFile()) {
+                eventVec.push_back(new Event(path, ent.Name(), EVENT_MODIFY, wd));
+            } else if (ent.IsDir()
+                       && dispatcher->IsDirRegistered(PathJoin(path, ent.Name())) == PATH_INODE_NOT_REGISTERED) {
+                eventVec.push_back(new Event(path, ent.Name(), EVENT_CREATE | EVENT_ISDIR, wd));
+            }
+        }
+    }
+}
+
+void logtail::EventListener::AddEvent(int wd,
+                                      std::string_view name,
+                                      EventType etype,
+                                      uint32_t cookie,
+                                      ModifiedFiles& modifiedFiles,
+                                      std::vector<logtail::Event*>& eventVec) {
+    static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+    // bursty writes generate a MODIFY record per write, which are coalesced into one before any event is created.
+    // Only MODIFY since the last other event of the same file is coalesced, so the order of events is kept.
+    if (etype == EVENT_MODIFY) {
+        if (!modifiedFiles[wd].insert(name).second) {
+            return;
+        }
+    } else if (!modifiedFiles.empty()) {
+        auto it = modifiedFiles.find(wd);
+        if (it != modifiedFiles.end()) {
+            it->second.erase(name);
+        }
+    }
+    std::string path;
+    if (dispatcher->IsRegistered(wd, path)) {
+        eventVec.push_back(new Event(path, std::string(name), etype, wd, cookie));
+    }
 }
 
 bool logtail::EventListener::IsInit() {
@@ -131,10 +396,21 @@ bool logtail::EventListener::IsInit() {
 void logtail::EventListener::Destroy() {
     if (mInotifyFd >= 0)
         close(mInotifyFd);
+    if (mFanotifyFd >= 0) {
+        close(mFanotifyFd);
+        mFanotifyFd = -1;
+    }
+    mMarkedFilesystems.clear();
+    mHandleWdMap.clear();
+    mWdHandleMap.clear();
 }
 
 bool EventListener::IsValidID(int id) {
     return id >= 0;
 }
 
+bool EventListener::IsMountWideID(int id) {
+    return id >= sMountWideWdBase;
+}
+
 } // namespace logtail
@@ -18,6 +18,9 @@
 #define LOGTAIL_EVENTLISTENER_H
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "file_server/event/Event.h"
@@ -39,16 +42,57 @@ public:
     void Destroy();
 
     static bool IsValidID(int id);
+    static bool IsMountWideID(int id);
     static const uint32_t mWatchEventMask;
+    static const uint64_t mMountWideEventMask;
 
     int AddWatch(const char* dir);
+    // watches the dir through the fanotify mark of its filesystem, which is added once for all dirs on it, so no
+    // inotify watch is consumed. Returns an invalid id if fanotify is disabled or not supported for the dir.
+    int AddMountWideWatch(const char* dir);
     bool RemoveWatch(int wd);
 
     int32_t ReadEvents(std::vector<Event*>& eventVec);
 
 private:
     EventListener() = default;
+
+    // MODIFY events already emitted in one read, keyed by wd and file name
+    using ModifiedFiles = std::unordered_map<int, std::unordered_set<std::string_view>>;
+
+    // returns the size of whole inotify records parsed, the rest is a half record to be completed by the next read
+    size_t ParseEvents(const char* buffer, size_t len, std::vector<Event*>& eventVec);
+    void ParseFanotifyEvents(const char* buffer, size_t len, std::vector<Event*>& eventVec);
+    void AddEvent(int wd,
+                  std::string_view name,
+                  EventType etype,
+                  uint32_t cookie,
+                  ModifiedFiles& modifiedFiles,
+                  std::vector<Event*>& eventVec);
+    void ReadFanotifyEvents(std::vector<Event*>& eventVec);
+    // generates events for all dirs watched by fanotify as if they were just registered, used when events are lost
+    void RescanMountWideDirs(std::vector<Event*>& eventVec);
+
+    // inotify allocates wd from 1 upwards, mount wide ids are allocated far above to keep them apart
+    static constexpr int sMountWideWdBase = 1 << 30;
+
     int32_t mInotifyFd = -1;
+    // reused across reads and grown to the largest burst seen, a half record left by the last read is kept at front
+    std::vector<char> mEventBuf;
+    size_t mHalfEventSize = 0;
+
+    int32_t mFanotifyFd = -1;
+    std::vector<char> mFanotifyEventBuf;
+    // fsid -> whether the filesystem is marked, filesystems failed to be marked are watched by inotify
+    std::unordered_map<std::string, bool> mMarkedFilesystems;
+    // fsid and file handle of a dir <-> wd
+    std::unordered_map<std::string, int> mHandleWdMap;
+    std::unordered_map<int, std::string> mWdHandleMap;
+    int mNextMountWideWd = sMountWideWdBase;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class LogInputUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -34,12 +34,20 @@ bool EventListener::IsValidID(int id) {
     return id >= 0;
 }
 
+bool EventListener::IsMountWideID(int id) {
+    return false;
+}
+
 int EventListener::AddWatch(const char* dir) {
     static int counter = 0;
     auto ret = counter++;
     return (ret >= 0) ? ret : 0;
 }
 
+int EventListener::AddMountWideWatch(const char* dir) {
+    return -1;
+}
+
 bool EventListener::RemoveWatch(int wd) {
     return 0;
 }
@@ -36,8 +36,10 @@ public:
     void Destroy();
 
     static bool IsValidID(int id);
+    static bool IsMountWideID(int id);
 
     int AddWatch(const char* dir);
+    int AddMountWideWatch(const char* dir);
     bool RemoveWatch(int wd);
 
     int32_t ReadEvents(std::vector<Event*>& eventVec);
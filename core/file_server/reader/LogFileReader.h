@@ -278,6 +278,12 @@ public:
             mFirstWatched = false;
         mLastFilePos = pos;
     }
+
+    // only read [begin, end) of the file, used when a static file is read by several line-aligned ranges
+    void SetReadRange(int64_t begin, int64_t end) {
+        SetLastFilePos(begin);
+        mLastFileSize = end;
+    }
     void
     InitReader(bool tailExisted = false, FileReadPolicy policy = BACKWARD_TO_FIXED_POS, uint32_t eoConcurrency = 0);
 
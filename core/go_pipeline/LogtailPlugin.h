@@ -22,6 +22,7 @@
 
 #include <cstdint>
 
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <unordered_map>
@@ -260,6 +261,8 @@ private:
     StopBuiltInModulesFun mStopBuiltInModulesFun;
     StartFun mStartFun;
     volatile bool mPluginValid;
+    // pipelines may be built concurrently, while loading plugin base and go pipelines must be serialized
+    std::mutex mLoadPipelineMux;
     logtail::FlusherSLS mPluginAlarmConfig;
     logtail::FlusherSLS mPluginContainerConfig;
     ProcessLogsFun mProcessLogsFun;
@@ -815,27 +815,17 @@ bool LinuxSystemInterface::GetDiskStateInformationOnce(DiskStateInformation& dis
         for (auto const& diskLine : diskLines) {
             DiskState diskStat;
 
-            // 去除前导空格后解析
-            std::string trimmedLine = boost::algorithm::trim_left_copy(diskLine);
-            FastFieldParser parser(trimmedLine);
+            // 前导空格由解析器跳过，字段索引一次建立
+            FastFieldParser parser(diskLine);
 
             size_t fieldCount = parser.GetFieldCount();
             if (fieldCount < (size_t)EnumDiskState::count) {
                 continue;
             }
             try {
-                std::vector<uint64_t> diskValues;
-                diskValues.reserve(static_cast<size_t>(EnumDiskState::count));
-
-                auto iter = parser.begin();
-                auto end = parser.end();
-                for (size_t i = 0; i < static_cast<size_t>(EnumDiskState::count) && iter != end; ++i, ++iter) {
-                    uint64_t value;
-                    diskValues.push_back(StringTo(*iter, value) ? value : 0);
-                }
-
-                if (diskValues.size() < static_cast<size_t>(EnumDiskState::count)) {
-                    continue; // 字段数量不足，跳过此行
+                uint64_t diskValues[static_cast<size_t>(EnumDiskState::count)];
+                for (size_t i = 0; i < static_cast<size_t>(EnumDiskState::count); ++i) {
+                    diskValues[i] = parser.GetFieldAs<uint64_t>(i, 0);
                 }
 
                 // 直接从数组索引访问，零遍历开销
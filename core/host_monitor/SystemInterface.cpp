@@ -31,6 +31,8 @@
 
 #include "common/Flags.h"
 #include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ReentrantMetricsRecord.h"
 #ifdef __linux__
 #include "host_monitor/LinuxSystemInterface.h"
 #endif
@@ -54,6 +56,16 @@ SystemInterface* SystemInterface::GetInstance() {
 #endif
 }
 
+void SystemInterface::InitMetrics() {
+    WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_HOST_MONITOR}});
+    mReadsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_HOST_MONITOR_SYSTEM_READS_TOTAL);
+    mReadsSavedTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_HOST_MONITOR_SYSTEM_READS_SAVED_TOTAL);
+    WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
+}
+
 bool SystemInterface::GetSystemInformation(SystemInformation& systemInfo) {
     // SystemInformation is static and will not be changed. So cache will never be expired.
     if (mSystemInformationCache.collectTime > 0) {
@@ -298,8 +310,19 @@ bool SystemInterface::MemoizedCall(SystemInformationCache<InfoT, Args...>& cache
                                    const std::string& errorType,
                                    Args... args) {
     if (cache.Get(now, info, args...)) {
+        ADD_COUNTER(mReadsSavedTotal, 1);
         return true;
     }
+    std::unique_lock<std::mutex> loadLock;
+    if constexpr (sizeof...(Args) == 0) {
+        // host-wide information is requested by all configs at the same tick, only the first one reads it
+        loadLock = std::unique_lock<std::mutex>(cache.GetLoadMutex());
+        if (cache.Get(now, info)) {
+            ADD_COUNTER(mReadsSavedTotal, 1);
+            return true;
+        }
+    }
+    ADD_COUNTER(mReadsTotal, 1);
     bool status = std::forward<F>(func)(info, args...);
     // We should use real time here, because input time may be delayed
     info.collectTime = time(nullptr);
@@ -39,6 +39,8 @@
 #include "collector/MetricCalculate.h"
 #include "common/Flags.h"
 #include "common/ProcParser.h"
+#include "monitor/metric_models/MetricRecord.h"
+#include "monitor/metric_models/MetricTypes.h"
 
 DECLARE_FLAG_INT32(system_interface_cache_queue_size);
 DECLARE_FLAG_INT32(system_interface_cache_max_cleanup_batch_size);
@@ -660,9 +662,12 @@ public:
         SystemInformationCache(size_t cacheSize) : mCacheDequeSize(cacheSize) {}
         bool Get(time_t targetTime, InfoT& info);
         bool Set(InfoT& info);
+        // held while loading, so that callers of the same tick wait for one read instead of reading concurrently
+        std::mutex& GetLoadMutex() { return mLoadMutex; }
 
     private:
         mutable std::mutex mMutex;
+        std::mutex mLoadMutex;
         std::deque<InfoT> mCache;
         size_t mCacheDequeSize;
 
@@ -717,7 +722,9 @@ public:
           mProcessFdCache(cacheSize),
           mExecutePathCache(cacheSize),
           mTCPStatInformationCache(cacheSize),
-          mNetInterfaceInformationCache(cacheSize) {}
+          mNetInterfaceInformationCache(cacheSize) {
+        InitMetrics();
+    }
     virtual ~SystemInterface() = default;
 
 private:
@@ -729,6 +736,8 @@ private:
                       const std::string& errorType,
                       Args... args);
 
+    void InitMetrics();
+
     virtual bool GetSystemInformationOnce(SystemInformation& systemInfo) = 0;
     virtual bool GetCPUInformationOnce(CPUInformation& cpuInfo) = 0;
     virtual bool GetProcessListInformationOnce(ProcessListInformation& processListInfo) = 0;
@@ -769,8 +778,15 @@ private:
     SystemInformationCache<TCPStatInformation> mTCPStatInformationCache;
     SystemInformationCache<NetInterfaceInformation> mNetInterfaceInformationCache;
 
+    MetricsRecordRef mMetricsRecordRef;
+    // system information read from /proc or /sys
+    CounterPtr mReadsTotal;
+    // system information served from the cache, which would have been read again otherwise
+    CounterPtr mReadsSavedTotal;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class SystemInterfaceUnittest;
+    friend class SystemInterfaceBenchmark;
 #endif
 };
 
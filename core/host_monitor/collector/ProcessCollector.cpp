@@ -44,11 +44,11 @@ DEFINE_FLAG_INT32(host_monitor_process_report_top_N, "number of process reported
 DEFINE_FLAG_INT32(basic_host_monitor_process_collect_interval,
                   "basic host monitor process collect interval, seconds",
                   5);
+DEFINE_FLAG_INT32(host_monitor_process_max_cached_stat_fds,
+                  "max number of /proc/<pid>/stat fds kept open by process collector",
+                  4096);
 #define PATH_MAX 4096
 
-// topN进行的缓存为55s
-const std::chrono::seconds ProcessSortInterval{55};
-
 const std::string ProcessCollector::sName = "process";
 const std::string kMetricLabelProcess = "valueTag";
 const std::string kMetricLabelMode = "mode";
@@ -78,15 +78,9 @@ static inline void GetProcessCpuSorted(std::vector<ProcessAllStat>& allPidStats)
     });
 }
 
-static inline void GetProcessCpuSorted(std::vector<std::pair<pid_t, ProcessCpuInformation>>& cpuInfos) {
-    std::sort(cpuInfos.begin(),
-              cpuInfos.end(),
-              [](const std::pair<pid_t, ProcessCpuInformation>& a, const std::pair<pid_t, ProcessCpuInformation>& b) {
-                  return a.second.percent > b.second.percent;
-              });
-}
-
-ProcessCollector::ProcessCollector() : mTopN(INT32_FLAG(host_monitor_process_report_top_N)) {
+ProcessCollector::ProcessCollector()
+    : mTopN(INT32_FLAG(host_monitor_process_report_top_N)),
+      mProcessTable(INT32_FLAG(host_monitor_process_max_cached_stat_fds)) {
 }
 
 bool ProcessCollector::Init(HostMonitorContext& collectContext) {
@@ -103,33 +97,21 @@ bool ProcessCollector::Init(HostMonitorContext& collectContext) {
 }
 
 bool ProcessCollector::Collect(HostMonitorContext& collectContext, PipelineEventGroup* groupPtr) {
-    ProcessListInformation processListInfo;
-
-    if (!SystemInterface::GetInstance()->GetProcessListInformation(collectContext.GetMetricTime(), processListInfo)) {
+    // 进程表跨周期保持 /proc/<pid>/stat 的 fd 和上一次的 CPU 时间，只对前 mTopN 个进程排序
+    if (!mProcessTable.Update(collectContext.mCollectTime.mScheduleTime)) {
         return false;
     }
+    time_t collectTime = collectContext.GetMetricTime();
 
-    pids = processListInfo.pids;
     std::vector<ProcessAllStat> allPidStats;
     std::vector<std::pair<pid_t, ProcessCpuInformation>> cpuInfos;
-
-    // 获取所有进程的cpu信息
-    for (auto pid : pids) {
-        ProcessCpuInformation info;
-        if (!GetProcessCpuInformation(collectContext.mCollectTime, pid, info)) {
-            continue;
-        }
-        cpuInfos.push_back(std::make_pair(pid, info));
-    }
-
-    // 对所有进程的cpu信息进行排序
-    GetProcessCpuSorted(cpuInfos);
+    mProcessTable.GetTopN(mTopN, cpuInfos);
 
     // 取cpu排名前mTopN的进程，获取每一个进程的信息
-    for (size_t i = 0; i < std::min(static_cast<size_t>(mTopN), cpuInfos.size()); i++) {
+    for (auto& [pid, cpuInfo] : cpuInfos) {
         ProcessAllStat stat;
-        stat.processCpu = cpuInfos[i].second;
-        if (!GetProcessAllStat(collectContext.mCollectTime, cpuInfos[i].first, stat)) {
+        stat.processCpu = cpuInfo;
+        if (!GetProcessAllStat(collectContext.mCollectTime, pid, stat)) {
             continue;
         }
         allPidStats.push_back(stat);
@@ -190,7 +172,7 @@ bool ProcessCollector::Collect(HostMonitorContext& collectContext, PipelineEvent
     if (!metricEvent) {
         return false;
     }
-    metricEvent->SetTimestamp(processListInfo.collectTime, 0);
+    metricEvent->SetTimestamp(collectTime, 0);
     metricEvent->SetValue<UntypedMultiDoubleValues>(metricEvent);
     auto* multiDoubleValues = metricEvent->MutableValue<UntypedMultiDoubleValues>();
     std::vector<std::string> vmNames = {
@@ -213,7 +195,7 @@ bool ProcessCollector::Collect(HostMonitorContext& collectContext, PipelineEvent
     // 每个pid一条记录上报
     for (size_t i = 0; i < mTopN && i < pushMerticList.size(); i++) {
         MetricEvent* metricEventEachPid = groupPtr->AddMetricEvent(true);
-        metricEventEachPid->SetTimestamp(processListInfo.collectTime, 0);
+        metricEventEachPid->SetTimestamp(collectTime, 0);
         metricEventEachPid->SetValue<UntypedMultiDoubleValues>(metricEventEachPid);
         auto* multiDoubleValuesEachPid = metricEventEachPid->MutableValue<UntypedMultiDoubleValues>();
         // 上传每一个pid对应的值
@@ -272,7 +254,6 @@ bool ProcessCollector::Collect(HostMonitorContext& collectContext, PipelineEvent
     mAvgProcessNumThreads.clear();
     pidNameMap.clear();
     pushMerticList.clear();
-    ClearProcessCpuTimeCache();
     return true;
 }
 
@@ -417,65 +398,6 @@ bool ProcessCollector::GetProcessState(time_t now, pid_t pid, ProcessStat& proce
     return true;
 }
 
-// 给pid做cache
-bool ProcessCollector::GetProcessCpuInCache(pid_t pid) {
-    if (cpuTimeCache.find(pid) != cpuTimeCache.end()) {
-        return true;
-    } else {
-        return false;
-    }
-}
-
-
-bool ProcessCollector::GetProcessCpuInformation(const CollectTime& collectTime,
-                                                pid_t pid,
-                                                ProcessCpuInformation& information) {
-    bool findCache = false;
-    ProcessCpuInformation* prev = nullptr;
-
-    // 由于计算CPU时间需要获取一个时间间隔
-    // 但是我们这里不应该睡眠，因此只能做一个cache，保存上一次获取的数据
-    findCache = GetProcessCpuInCache(pid);
-
-    ProcessTime processTime{};
-
-    if (!GetProcessTime(collectTime.mMetricTime, pid, processTime)) {
-        return false;
-    }
-    information.lastTime = collectTime.GetShiftSteadyTime(processTime.collectTime);
-
-    if (findCache) {
-        // cache found, calculate the cpu percent
-        auto recordedEntity = cpuTimeCache.find(pid);
-        if (recordedEntity != cpuTimeCache.end()) {
-            prev = &recordedEntity->second;
-        }
-    } else {
-        information.percent = 0.0;
-        information.sys = processTime.sys.count();
-        information.user = processTime.user.count();
-        information.total = processTime.total.count();
-        cpuTimeCache[pid] = information;
-        return true;
-    }
-
-    int64_t timeDiff
-        = std::chrono::duration_cast<std::chrono::milliseconds>(information.lastTime - prev->lastTime).count();
-
-    // update the cache
-    using namespace std::chrono;
-    information.startTime = processTime.startTime;
-    information.user = processTime.user.count();
-    information.sys = processTime.sys.count();
-    information.total = processTime.total.count();
-
-    // calculate cpuPercent = (thisTotal - prevTotal)/HZ;
-    auto totalCPUDiff = static_cast<double>(information.total - prev->total) / SYSTEM_HERTZ;
-    information.percent = 100 * totalCPUDiff / (static_cast<double>(timeDiff) / SYSTEM_HERTZ); // 100%
-    cpuTimeCache[pid] = information;
-    return true;
-}
-
 bool ProcessCollector::GetProcessTime(time_t now, pid_t pid, ProcessTime& output) {
     ProcessInformation processInfo;
 
@@ -508,29 +430,6 @@ bool ProcessCollector::ReadProcessStat(time_t now, pid_t pid, ProcessInformation
     return true;
 }
 
-void ProcessCollector::ClearProcessCpuTimeCache() {
-    try {
-        // 清除超时的cache
-        const auto now = std::chrono::steady_clock::now();
-        auto it = cpuTimeCache.begin();
-
-        while (it != cpuTimeCache.end()) {
-            // 检查当前元素是否超时
-            if (now - it->second.lastTime > ProcessSortInterval) {
-                // 超时，删除该元素
-                it = cpuTimeCache.erase(it);
-            } else {
-                // 未超时，继续检查下一个元素
-                ++it;
-            }
-        }
-    } catch (const std::exception& e) {
-        LOG_ERROR(sLogger, ("ClearProcessCpuTimeCache error", e.what()));
-    }
-
-    return;
-}
-
 const std::chrono::seconds ProcessCollector::GetCollectInterval() const {
     return std::chrono::seconds(INT32_FLAG(basic_host_monitor_process_collect_interval));
 }
@@ -23,6 +23,7 @@
 #include "host_monitor/SystemInterface.h"
 #include "host_monitor/collector/BaseCollector.h"
 #include "host_monitor/collector/MetricCalculate.h"
+#include "host_monitor/common/ProcessTable.h"
 
 using namespace std::chrono;
 
@@ -65,16 +66,7 @@ public:
 
     std::string GetExecutablePath(time_t now, pid_t pid);
 
-protected:
-    bool GetProcessCpuInformation(const CollectTime& collectTime, pid_t pid, ProcessCpuInformation& information);
-
-    bool GetProcessCpuInCache(pid_t pid);
-
-    void ClearProcessCpuTimeCache();
-
 private:
-    std::vector<pid_t> pids;
-    std::vector<pid_t> mSortPids;
     int mSelfPid = 0;
     int mParentPid = 0;
     uint64_t mTotalMemory = 0;
@@ -83,7 +75,7 @@ private:
     std::chrono::steady_clock::time_point mLastCollectSteadyTime;
     decltype(ProcessCpuInformation{}.total) mLastAgentTotalMillis = 0;
     std::shared_ptr<std::map<pid_t, uint64_t>> mLastPidCpuMap;
-    std::unordered_map<pid_t, ProcessCpuInformation> cpuTimeCache;
+    ProcessTable mProcessTable;
     std::unordered_map<pid_t, MetricCalculate<ProcessPushMertic>> mProcessPushMertic; // 记录每个pid对应的多值体系
     MetricCalculate<VMProcessNumStat> mVMProcessNumStat;
     std::unordered_map<pid_t, double> mAvgProcessCpuPercent;
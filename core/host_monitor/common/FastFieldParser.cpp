@@ -16,23 +16,36 @@
 
 #include "host_monitor/common/FastFieldParser.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 #include <vector>
 
 namespace logtail {
 
 StringView FastFieldParser::GetField(size_t index) {
-    auto iter = mSplitter.begin();
-    auto end = mSplitter.end();
+    if (!mIndexBuilt) {
+        BuildIndex();
+    }
+    if (index < mFieldCount) {
+        return mLine.substr(mFieldStarts[index], mFieldEnds[index] - mFieldStarts[index]);
+    }
+    if (mOverflowPos == StringView::npos) {
+        return StringView{}; // 返回空视图
+    }
 
-    for (size_t i = 0; i < index && iter != end; ++i, ++iter) {
+    // 超出索引范围的字段，从第一个未记录的字段开始顺序查找
+    StringViewSplitter splitter(mLine.substr(mOverflowPos), mDelimiter, true);
+    auto iter = splitter.begin();
+    auto end = splitter.end();
+    for (size_t i = kMaxIndexedFields; i < index && iter != end; ++i, ++iter) {
         // 跳过前面的字段
     }
-
     if (iter == end) {
-        return StringView{}; // 返回空视图
+        return StringView{};
     }
-
     return *iter;
 }
 
@@ -43,16 +56,75 @@ bool FastFieldParser::FieldStartsWith(size_t index, StringView prefix) {
 }
 
 size_t FastFieldParser::GetFieldCount() {
-    size_t count = 0;
-    auto iter = mSplitter.begin();
-    auto end = mSplitter.end();
-    while (iter != end) {
-        ++count;
-        ++iter;
+    if (!mIndexBuilt) {
+        BuildIndex();
+    }
+    size_t count = mFieldCount;
+    if (mOverflowPos != StringView::npos) {
+        StringViewSplitter splitter(mLine.substr(mOverflowPos), mDelimiter, true);
+        for (auto iter = splitter.begin(); iter != splitter.end(); ++iter) {
+            ++count;
+        }
     }
     return count;
 }
 
+void FastFieldParser::BuildIndex() {
+    mIndexBuilt = true;
+    const char* data = mLine.data();
+    size_t size = mLine.size();
+    // 行首视为分隔符之后
+    uint32_t prevDelimiter = 1;
+    size_t pos = 0;
+#if defined(__SSE2__)
+    const __m128i delimiterVec = _mm_set1_epi8(mDelimiterChar);
+    while (pos + 16 <= size) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, delimiterVec)));
+        if (!AddBoundaries(mask, prevDelimiter, pos, 16)) {
+            return;
+        }
+        prevDelimiter = (mask >> 15) & 1;
+        pos += 16;
+    }
+#endif
+    while (pos < size) {
+        size_t len = std::min<size_t>(16, size - pos);
+        uint32_t mask = 0;
+        for (size_t i = 0; i < len; ++i) {
+            mask |= static_cast<uint32_t>(data[pos + i] == mDelimiterChar) << i;
+        }
+        if (!AddBoundaries(mask, prevDelimiter, pos, len)) {
+            return;
+        }
+        prevDelimiter = (mask >> (len - 1)) & 1;
+        pos += len;
+    }
+    if (prevDelimiter == 0) {
+        // 最后一个字段延伸到行尾
+        mFieldEnds[mFieldCount++] = static_cast<uint32_t>(size);
+    }
+}
+
+bool FastFieldParser::AddBoundaries(uint32_t mask, uint32_t prevDelimiter, size_t base, size_t len) {
+    // 与前一个字符的分隔符状态不同的位置即为字段的起点（非分隔符）或终点（分隔符）
+    uint32_t transitions = (mask ^ ((mask << 1) | prevDelimiter)) & ((1U << len) - 1);
+    while (transitions != 0) {
+        uint32_t bit = __builtin_ctz(transitions);
+        transitions &= transitions - 1;
+        auto offset = static_cast<uint32_t>(base + bit);
+        if ((mask >> bit) & 1) {
+            mFieldEnds[mFieldCount++] = offset;
+        } else if (mFieldCount < kMaxIndexedFields) {
+            mFieldStarts[mFieldCount] = offset;
+        } else {
+            mOverflowPos = offset;
+            return false;
+        }
+    }
+    return true;
+}
+
 // NetDevParser implementation
 bool NetDevParser::ParseDeviceStats(StringView& deviceName, std::vector<uint64_t>& stats) {
     // 网络设备行格式: "  eth0: 1234 5678 ..."
@@ -73,12 +145,12 @@ bool NetDevParser::ParseDeviceStats(StringView& deviceName, std::vector<uint64_t
     auto statsLine = mLine.substr(colonPos + 1);
     FastFieldParser parser(statsLine);
 
+    size_t fieldCount = parser.GetFieldCount();
     stats.clear();
-    stats.reserve(16); // 网络设备通常有16个统计字段
+    stats.reserve(fieldCount); // 网络设备通常有16个统计字段
 
-    for (auto iter = parser.begin(); iter != parser.end(); ++iter) {
-        uint64_t value;
-        stats.push_back(StringTo(*iter, value) ? value : 0);
+    for (size_t i = 0; i < fieldCount; ++i) {
+        stats.push_back(parser.GetFieldAs<uint64_t>(i, 0));
     }
 
     return !stats.empty();
@@ -19,6 +19,7 @@
 #include <charconv>
 #include <cstdint>
 
+#include <limits>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -29,9 +30,15 @@ namespace logtail {
 
 /**
  * @brief 高性能字段解析器 - 零拷贝、按需解析
+ *
+ * 第一次按索引访问时，一次遍历整行（SSE2 每次比较 16 字节）记录所有字段的起止位置，之后的 GetField
+ * 均为 O(1)。连续的分隔符视为一个，行首行尾的分隔符被忽略，与 StringViewSplitter 的行为一致。
  */
 class FastFieldParser {
 public:
+    // 索引中最多记录的字段数，覆盖 /proc 下绝大部分的行，超出部分退化为顺序查找
+    static constexpr size_t kMaxIndexedFields = 64;
+
     explicit FastFieldParser(StringView line, char delimiter = ' ')
         : mLine(line),
           mDelimiterChar(delimiter),
@@ -59,6 +66,17 @@ public:
             return defaultValue;
         }
         T result;
+        if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>) {
+            if (ParseUnsigned(field, result)) {
+                return result;
+            }
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // /proc 中的数值绝大多数是整数，整数转换为浮点数与 strtod 的结果相同
+            uint64_t value = 0;
+            if (ParseUnsigned(field, value)) {
+                return static_cast<T>(value);
+            }
+        }
         return StringTo(field, result) ? result : defaultValue;
     }
 
@@ -84,15 +102,49 @@ public:
 
 
     /**
-     * @brief 获取字段总数（需要完整遍历）
+     * @brief 获取字段总数
      */
     size_t GetFieldCount();
 
+    /**
+     * @brief 无分支地解析纯数字字段，位数不超过 digits10 时不会溢出，其余情况（含溢出判断）交给 StringTo
+     * @return 是否成功，语义与 std::from_chars 要求整个字段被消费时一致
+     */
+    template <typename T>
+    static bool ParseUnsigned(StringView field, T& result) {
+        if (field.empty() || field.size() > static_cast<size_t>(std::numeric_limits<T>::digits10)) {
+            return false;
+        }
+        uint64_t value = 0;
+        uint32_t invalid = 0;
+        for (char c : field) {
+            uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(c)) - '0';
+            invalid |= static_cast<uint32_t>(digit > 9);
+            value = value * 10 + digit;
+        }
+        if (invalid != 0) {
+            return false;
+        }
+        result = static_cast<T>(value);
+        return true;
+    }
+
 private:
+    void BuildIndex();
+    // 处理一个块内的分隔符位图，mask 的第 i 位表示 base + i 处为分隔符
+    bool AddBoundaries(uint32_t mask, uint32_t prevDelimiter, size_t base, size_t len);
+
     StringView mLine;
     char mDelimiterChar;
     StringView mDelimiter;
     StringViewSplitter mSplitter;
+
+    bool mIndexBuilt = false;
+    // 字段数超过 kMaxIndexedFields 时，未记录的字段从 mOverflowPos 开始
+    size_t mOverflowPos = StringView::npos;
+    size_t mFieldCount = 0;
+    uint32_t mFieldStarts[kMaxIndexedFields];
+    uint32_t mFieldEnds[kMaxIndexedFields];
 };
 
 /**
@@ -154,38 +206,22 @@ public:
 
     /**
      * @brief 批量获取 CPU 统计数值 - 性能优化版本
-     * 使用一次遍历获取所有字段，避免重复查找
+     * 字段索引在第一次访问时一次建立，避免重复查找
      */
     template <typename T>
     void
     GetCpuStats(T& user, T& nice, T& system, T& idle, T& iowait, T& irq, T& softirq, T& steal, T& guest, T& guestNice) {
-        // 使用迭代器遍历字段1-10
-        auto iter = mParser.begin();
-        auto end = mParser.end();
-
-        // 跳过字段0 (cpu名称)
-        if (iter != end)
-            ++iter;
-
-        // 按顺序读取10个统计字段
-        auto parseField = [](StringViewSplitterIterator& it, StringViewSplitterIterator& end) -> T {
-            if (it != end) {
-                T result;
-                return StringTo(*it++, result) ? result : T{};
-            }
-            return T{};
-        };
-
-        user = parseField(iter, end);
-        nice = parseField(iter, end);
-        system = parseField(iter, end);
-        idle = parseField(iter, end);
-        iowait = parseField(iter, end);
-        irq = parseField(iter, end);
-        softirq = parseField(iter, end);
-        steal = parseField(iter, end);
-        guest = parseField(iter, end);
-        guestNice = parseField(iter, end);
+        // 字段0为cpu名称，字段1-10直接通过字段索引读取
+        user = mParser.GetFieldAs<T>(1);
+        nice = mParser.GetFieldAs<T>(2);
+        system = mParser.GetFieldAs<T>(3);
+        idle = mParser.GetFieldAs<T>(4);
+        iowait = mParser.GetFieldAs<T>(5);
+        irq = mParser.GetFieldAs<T>(6);
+        softirq = mParser.GetFieldAs<T>(7);
+        steal = mParser.GetFieldAs<T>(8);
+        guest = mParser.GetFieldAs<T>(9);
+        guestNice = mParser.GetFieldAs<T>(10);
     }
 
 private:
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "host_monitor/common/ProcessTable.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "host_monitor/Constants.h"
+#include "logger/Logger.h"
+
+namespace logtail {
+
+// /proc/<pid>/stat 通常不超过 512 字节，进程名最长 64 字节
+static constexpr size_t kStatBufferSize = 1024;
+
+ProcessTable::ProcessTable(size_t maxCachedFds) : mMaxCachedFds(maxCachedFds), mProcParser("") {
+}
+
+ProcessTable::~ProcessTable() {
+    for (auto& [pid, entry] : mEntries) {
+        CloseFd(entry);
+    }
+}
+
+bool ProcessTable::Update(std::chrono::steady_clock::time_point now) {
+    if (!ListPids()) {
+        return false;
+    }
+    ++mGeneration;
+
+    ProcessStat stat;
+    for (auto pid : mPids) {
+        auto& entry = mEntries[pid];
+        entry.pid = pid;
+        if (!ReadStat(entry, stat)) {
+            // 进程已退出，保持 generation 不变，随后被移除
+            continue;
+        }
+        entry.generation = mGeneration;
+
+        uint64_t total = stat.utimeTicks + stat.cutimeTicks + stat.stimeTicks + stat.cstimeTicks;
+        auto startTime = static_cast<int64_t>(stat.startTicks);
+        auto& cpu = entry.cpu;
+        if (entry.hasPrev && cpu.startTime == startTime && now > cpu.lastTime && total >= cpu.total) {
+            int64_t timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(now - cpu.lastTime).count();
+            // cpuPercent = (thisTotal - prevTotal)/HZ;
+            auto totalCPUDiff = static_cast<double>(total - cpu.total) / SYSTEM_HERTZ;
+            cpu.percent = 100 * totalCPUDiff / (static_cast<double>(timeDiff) / SYSTEM_HERTZ); // 100%
+        } else {
+            // 新进程或 pid 被复用，没有可用的上一次采样
+            cpu.percent = 0.0;
+        }
+        cpu.startTime = startTime;
+        cpu.lastTime = now;
+        cpu.user = stat.utimeTicks + stat.cutimeTicks;
+        cpu.sys = stat.stimeTicks + stat.cstimeTicks;
+        cpu.total = total;
+        entry.hasPrev = true;
+    }
+
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        if (it->second.generation != mGeneration) {
+            CloseFd(it->second);
+            it = mEntries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return true;
+}
+
+void ProcessTable::GetTopN(size_t n, std::vector<std::pair<pid_t, ProcessCpuInformation>>& top) const {
+    top.clear();
+    top.reserve(mEntries.size());
+    for (const auto& [pid, entry] : mEntries) {
+        top.emplace_back(pid, entry.cpu);
+    }
+    auto cmp = [](const std::pair<pid_t, ProcessCpuInformation>& a, const std::pair<pid_t, ProcessCpuInformation>& b) {
+        return a.second.percent > b.second.percent;
+    };
+    if (n < top.size()) {
+        std::nth_element(top.begin(), top.begin() + n, top.end(), cmp);
+        top.resize(n);
+    }
+    std::sort(top.begin(), top.end(), cmp);
+}
+
+bool ProcessTable::ListPids() {
+    mPids.clear();
+    DIR* dir = opendir(PROCESS_DIR.c_str());
+    if (dir == nullptr) {
+        LOG_ERROR(sLogger, ("failed to open process dir", PROCESS_DIR)("error", strerror(errno)));
+        return false;
+    }
+    while (auto* dirEntry = readdir(dir)) {
+        const char* name = dirEntry->d_name;
+        size_t len = strlen(name);
+        pid_t pid = 0;
+        auto [ptr, ec] = std::from_chars(name, name + len, pid);
+        if (ec == std::errc() && ptr == name + len && pid > 0) {
+            mPids.push_back(pid);
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
+bool ProcessTable::ReadStat(Entry& entry, ProcessStat& stat) {
+    int fd = entry.statFd;
+    if (fd < 0) {
+        auto path = PROCESS_DIR / std::to_string(entry.pid) / PROCESS_STAT;
+        fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        if (mCachedFdCount < mMaxCachedFds) {
+            entry.statFd = fd;
+            ++mCachedFdCount;
+        }
+    }
+
+    mStatBuffer.resize(kStatBufferSize);
+    ssize_t n = pread(fd, mStatBuffer.data(), mStatBuffer.size(), 0);
+    if (entry.statFd != fd) {
+        close(fd);
+    }
+    if (n <= 0) {
+        // 进程退出后，已打开的 fd 读取会返回 ESRCH
+        CloseFd(entry);
+        return false;
+    }
+    mStatBuffer.resize(n);
+    return mProcParser.ParseProcessStat(entry.pid, mStatBuffer, stat);
+}
+
+void ProcessTable::CloseFd(Entry& entry) {
+    if (entry.statFd >= 0) {
+        close(entry.statFd);
+        entry.statFd = -1;
+        --mCachedFdCount;
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/ProcParser.h"
+#include "host_monitor/SystemInterface.h"
+
+namespace logtail {
+
+/**
+ * @brief 跨采集周期保持状态的进程表
+ *
+ * 每个进程的 /proc/<pid>/stat 只在第一次出现时 open，之后通过 pread 读取；CPU 使用率基于上一次的采样增量计算。
+ * 消失的进程在下一次 Update 时被移除并关闭 fd。缓存的 fd 数量受 maxCachedFds 限制，超出的进程每次 open/close。
+ */
+class ProcessTable {
+public:
+    struct Entry {
+        pid_t pid = 0;
+        int statFd = -1;
+        bool hasPrev = false;
+        uint32_t generation = 0;
+        ProcessCpuInformation cpu;
+    };
+
+    explicit ProcessTable(size_t maxCachedFds);
+    ~ProcessTable();
+
+    ProcessTable(const ProcessTable&) = delete;
+    ProcessTable& operator=(const ProcessTable&) = delete;
+
+    // 遍历 PROCESS_DIR 并刷新所有进程的 CPU 信息
+    bool Update(std::chrono::steady_clock::time_point now);
+
+    // 按 CPU 使用率降序返回前 n 个进程，只对前 n 个排序
+    void GetTopN(size_t n, std::vector<std::pair<pid_t, ProcessCpuInformation>>& top) const;
+
+    [[nodiscard]] size_t Size() const { return mEntries.size(); }
+    [[nodiscard]] size_t CachedFdCount() const { return mCachedFdCount; }
+
+private:
+    bool ListPids();
+    bool ReadStat(Entry& entry, ProcessStat& stat);
+    void CloseFd(Entry& entry);
+
+    size_t mMaxCachedFds = 0;
+    size_t mCachedFdCount = 0;
+    uint32_t mGeneration = 0;
+    std::vector<pid_t> mPids;
+    std::string mStatBuffer;
+    std::unordered_map<pid_t, Entry> mEntries;
+    ProcParser mProcParser;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessTableUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -39,6 +39,9 @@ using namespace std;
 
 DEFINE_FLAG_STRING(ipv4_cluster_cidrs, "cluster cidr", "");
 DEFINE_FLAG_BOOL(disable_k8s_meta, "disable k8s metadata", false);
+DEFINE_FLAG_INT32(k8s_metadata_not_found_cid_ttl_sec,
+                  "seconds before a container id unknown to metadata server can be queried again",
+                  60);
 
 namespace logtail {
 
@@ -86,7 +89,10 @@ K8sMetadata::~K8sMetadata() {
 }
 
 K8sMetadata::K8sMetadata(size_t ipCacheSize, size_t cidCacheSize, size_t externalIpCacheSize)
-    : mIpCache(ipCacheSize, 20), mContainerCache(cidCacheSize, 20), mExternalIpCache(externalIpCacheSize, 20) {
+    : mIpCache(ipCacheSize, 20),
+      mContainerCache(cidCacheSize, 20),
+      mExternalIpCache(externalIpCacheSize, 20),
+      mNotFoundCidCache(cidCacheSize, 20) {
     mServiceHost = STRING_FLAG(k8s_metadata_server_name);
     mServicePort = INT32_FLAG(k8s_metadata_server_port);
     const char* value = getenv("_node_ip_");
@@ -125,6 +131,7 @@ K8sMetadata::K8sMetadata(size_t ipCacheSize, size_t cidCacheSize, size_t externa
     mCidCacheSize = mRef.CreateIntGauge(METRIC_RUNNER_METADATA_CID_CACHE_SIZE);
     mIpCacheSize = mRef.CreateIntGauge(METRIC_RUNNER_METADATA_IP_CACHE_SIZE);
     mExternalIpCacheSize = mRef.CreateIntGauge(METRIC_RUNNER_METADATA_EXTERNAL_IP_CACHE_SIZE);
+    mNotFoundCidCacheSize = mRef.CreateIntGauge(METRIC_RUNNER_METADATA_NOT_FOUND_CID_CACHE_SIZE);
     mRequestMetaServerTotal = mRef.CreateCounter(METRIC_RUNNER_METADATA_REQUEST_REMOTE_TOTAL);
     mRequestMetaServerFailedTotal = mRef.CreateCounter(METRIC_RUNNER_METADATA_REQUEST_REMOTE_FAILED_TOTAL);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mRef);
@@ -387,6 +394,9 @@ std::vector<std::string> K8sMetadata::GetByContainerIdsFromServer(std::vector<st
     std::vector<std::string> res;
     std::string reqBody = KeysToReqBody(containerIds);
     status = SendRequestToOperator(mServiceHost, reqBody, PodInfoType::ContainerIdInfo, res);
+    if (status) {
+        UpdateNotFoundCidCache(containerIds, res);
+    }
     return res;
 }
 
@@ -402,6 +412,7 @@ bool K8sMetadata::GetByLocalHostFromServer() {
 
 void K8sMetadata::SetContainerCache(const std::string& key, const std::shared_ptr<K8sPodInfo>& info) {
     mContainerCache.insert(key, info);
+    mNotFoundCidCache.remove(key);
 }
 
 void K8sMetadata::SetIpCache(const std::string& key, const std::shared_ptr<K8sPodInfo>& info) {
@@ -427,6 +438,30 @@ void K8sMetadata::UpdateExternalIpCache(const std::vector<std::string>& queryIps
     }
 }
 
+void K8sMetadata::UpdateNotFoundCidCache(const std::vector<std::string>& queryCids,
+                                         const std::vector<std::string>& retCids) {
+    std::unordered_set<std::string> hash(retCids.begin(), retCids.end());
+    time_t now = time(nullptr);
+    for (const auto& cid : queryCids) {
+        if (!hash.count(cid)) {
+            LOG_DEBUG(sLogger, (cid, "mark as not found container id"));
+            mNotFoundCidCache.insert(cid, now);
+        }
+    }
+}
+
+bool K8sMetadata::IsNotFoundContainerId(const std::string& cid) {
+    time_t markTime = 0;
+    if (!mNotFoundCidCache.tryGetCopy(cid, markTime)) {
+        return false;
+    }
+    if (time(nullptr) - markTime >= INT32_FLAG(k8s_metadata_not_found_cid_ttl_sec)) {
+        mNotFoundCidCache.remove(cid);
+        return false;
+    }
+    return true;
+}
+
 std::vector<std::string> K8sMetadata::GetByIpsFromServer(std::vector<std::string>& ips, bool& status, bool force) {
     std::vector<std::string> res;
     std::string reqBody = KeysToReqBody(ips);
@@ -441,9 +476,11 @@ std::shared_ptr<K8sPodInfo> K8sMetadata::GetInfoByContainerIdFromCache(const Str
     if (containerId.empty()) {
         return nullptr;
     }
-    auto cid = std::string(containerId);
+    // reuse the key buffer to avoid allocating a string for each lookup
+    static thread_local std::string sCid;
+    sCid.assign(containerId.data(), containerId.size());
     std::shared_ptr<K8sPodInfo> info;
-    bool isValid = mContainerCache.tryGetCopy(cid, info);
+    bool isValid = mContainerCache.tryGetCopy(sCid, info);
     if (isValid) {
         return info;
     }
@@ -454,9 +491,10 @@ std::shared_ptr<K8sPodInfo> K8sMetadata::GetInfoByIpFromCache(const StringView&
     if (ipv.empty()) {
         return nullptr;
     }
-    auto ip = std::string(ipv);
+    static thread_local std::string sIp;
+    sIp.assign(ipv.data(), ipv.size());
     std::shared_ptr<K8sPodInfo> info;
-    bool isValid = mIpCache.tryGetCopy(ip, info);
+    bool isValid = mIpCache.tryGetCopy(sIp, info);
     if (isValid) {
         return info;
     }
@@ -464,7 +502,9 @@ std::shared_ptr<K8sPodInfo> K8sMetadata::GetInfoByIpFromCache(const StringView&
 }
 
 bool K8sMetadata::IsExternalIp(const StringView& ip) const {
-    return mExternalIpCache.contains(std::string(ip));
+    static thread_local std::string sIp;
+    sIp.assign(ip.data(), ip.size());
+    return mExternalIpCache.contains(sIp);
 }
 
 bool K8sMetadata::IsClusterIpForIPv4(uint32_t ip) const {
@@ -489,6 +529,11 @@ void K8sMetadata::AsyncQueryMetadata(PodInfoType type, const StringView& str) {
         return;
     }
     std::string key = std::string(str);
+    // negative results are cached, don't bother the server again until they expire
+    if ((type == PodInfoType::ContainerIdInfo && IsNotFoundContainerId(key))
+        || (type == PodInfoType::IpInfo && mExternalIpCache.contains(key))) {
+        return;
+    }
     std::unique_lock<std::mutex> lock(mStateMux);
     if (mPendingKeys.find(key) != mPendingKeys.end()) {
         // already in query queue ...
@@ -523,6 +568,7 @@ void K8sMetadata::DetectNetwork() {
         SET_GAUGE(mCidCacheSize, mContainerCache.size());
         SET_GAUGE(mIpCacheSize, mIpCache.size());
         SET_GAUGE(mExternalIpCacheSize, mExternalIpCache.size());
+        SET_GAUGE(mNotFoundCidCacheSize, mNotFoundCidCache.size());
         if (mIsValid) {
             continue;
         }
@@ -28,8 +28,8 @@
 #include "json/value.h"
 
 #include "common/Flags.h"
-#include "common/LRUCache.h"
 #include "common/NetworkUtil.h"
+#include "common/ShardedLRUCache.h"
 #include "common/StringView.h"
 #include "common/http/HttpRequest.h"
 #include "metadata/ContainerInfo.h"
@@ -57,9 +57,13 @@ struct K8sMetadataHttpRequest;
 
 class K8sMetadata {
 private:
-    lru11::Cache<std::string, std::shared_ptr<K8sPodInfo>, std::mutex> mIpCache;
-    lru11::Cache<std::string, std::shared_ptr<K8sPodInfo>, std::mutex> mContainerCache;
-    lru11::Cache<std::string, uint8_t, std::mutex> mExternalIpCache;
+    // caches are looked up by every ebpf event, so they are sharded to keep readers from contending on one lock
+    ShardedLRUCache<std::string, std::shared_ptr<K8sPodInfo>> mIpCache;
+    ShardedLRUCache<std::string, std::shared_ptr<K8sPodInfo>> mContainerCache;
+    ShardedLRUCache<std::string, uint8_t> mExternalIpCache;
+    // container ids unknown to the metadata server, value is the time they are marked, so that misses of
+    // non-k8s containers are not queried again until expired
+    ShardedLRUCache<std::string, time_t> mNotFoundCidCache;
 
     std::string mServiceHost;
     int32_t mServicePort;
@@ -69,6 +73,7 @@ private:
     IntGaugePtr mCidCacheSize;
     IntGaugePtr mIpCacheSize;
     IntGaugePtr mExternalIpCacheSize;
+    IntGaugePtr mNotFoundCidCacheSize;
     CounterPtr mRequestMetaServerTotal;
     CounterPtr mRequestMetaServerFailedTotal;
 
@@ -106,6 +111,8 @@ private:
     void SetContainerCache(const std::string& key, const std::shared_ptr<K8sPodInfo>& info);
     void SetExternalIpCache(const std::string&);
     void UpdateExternalIpCache(const std::vector<std::string>& queryIps, const std::vector<std::string>& retIps);
+    void UpdateNotFoundCidCache(const std::vector<std::string>& queryCids, const std::vector<std::string>& retCids);
+    bool IsNotFoundContainerId(const std::string& cid);
     bool FromInfoJson(const Json::Value& json, K8sPodInfo& info);
     bool FromContainerJson(const Json::Value& json, std::shared_ptr<ContainerData> data, PodInfoType infoType);
     void HandleMetadataResponse(PodInfoType infoType,
@@ -29,6 +29,7 @@
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/queue/QueueMemoryBudget.h"
 #include "common/DevInode.h"
 #include "common/ExceptionBase.h"
 #include "common/LogtailCommonFlags.h"
@@ -188,6 +189,11 @@ void LogtailMonitor::Monitor() {
 
                 GetMemStat();
                 LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
+                // slow down inputs before the soft limit leads to a restart
+                auto* budget = QueueMemoryBudget::GetInstance();
+                budget->SetMemoryPressure(mMemStat.mRss > AppConfig::GetInstance()->GetMemUsageUpLimit());
+                LoongCollectorMonitor::GetInstance()->SetAgentQueueMemory(budget->GetUsedBytes() / 1024 / 1024,
+                                                                          budget->GetLimit() / 1024 / 1024);
                 CalCpuStat(curCpuStat, mCpuStat);
                 LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
                 if (CheckHardMemLimit()) {
@@ -652,9 +658,12 @@ void LoongCollectorMonitor::Init() {
     mAgentCpu = mMetricsRecordRef.CreateDoubleGauge(METRIC_AGENT_CPU);
     mAgentMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY);
     mAgentGoMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_GO);
+    mAgentQueueMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_QUEUE_MEMORY);
+    mAgentQueueMemoryLimit = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_QUEUE_MEMORY_LIMIT);
     mAgentGoRoutinesTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_GO_ROUTINES_TOTAL);
     mAgentOpenFdTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_OPEN_FD_TOTAL);
     mAgentConfigTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_PIPELINE_CONFIG_TOTAL);
+    mAgentConfigApplyTimeMs = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_PIPELINE_CONFIG_APPLY_TIME_MS);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
@@ -201,6 +201,10 @@ public:
     void SetAgentCpu(double cpu) { SET_GAUGE(mAgentCpu, cpu); }
     void SetAgentMemory(uint64_t mem) { SET_GAUGE(mAgentMemory, mem); }
     void SetAgentGoMemory(uint64_t mem) { SET_GAUGE(mAgentGoMemory, mem); }
+    void SetAgentQueueMemory(uint64_t mem, uint64_t limit) {
+        SET_GAUGE(mAgentQueueMemory, mem);
+        SET_GAUGE(mAgentQueueMemoryLimit, limit);
+    }
     void SetAgentGoRoutinesTotal(uint64_t total) { SET_GAUGE(mAgentGoRoutinesTotal, total); }
     void SetAgentOpenFdTotal(uint64_t total) {
 #ifndef APSARA_UNIT_TEST_MAIN
@@ -212,6 +216,7 @@ public:
         SET_GAUGE(mAgentConfigTotal, total);
 #endif
     }
+    void SetAgentConfigApplyTimeMs(uint64_t timeMs) { SET_GAUGE(mAgentConfigApplyTimeMs, timeMs); }
 
     static std::string mHostname;
     static std::string mIpAddr;
@@ -243,9 +248,12 @@ private:
     DoubleGaugePtr mAgentCpu;
     IntGaugePtr mAgentMemory;
     IntGaugePtr mAgentGoMemory;
+    IntGaugePtr mAgentQueueMemory;
+    IntGaugePtr mAgentQueueMemoryLimit;
     IntGaugePtr mAgentGoRoutinesTotal;
     IntGaugePtr mAgentOpenFdTotal;
     IntGaugePtr mAgentConfigTotal;
+    IntGaugePtr mAgentConfigApplyTimeMs;
 };
 
 } // namespace logtail
@@ -41,5 +41,8 @@ const string METRIC_AGENT_MEMORY = "memory_used_mb";
 const string METRIC_AGENT_MEMORY_GO = "go_memory_used_mb";
 const string METRIC_AGENT_OPEN_FD_TOTAL = "open_fd_total";
 const string METRIC_AGENT_PIPELINE_CONFIG_TOTAL = "pipeline_config_total";
+const string METRIC_AGENT_PIPELINE_CONFIG_APPLY_TIME_MS = "pipeline_config_apply_time_ms";
+const string METRIC_AGENT_QUEUE_MEMORY = "queue_memory_used_mb";
+const string METRIC_AGENT_QUEUE_MEMORY_LIMIT = "queue_memory_limit_mb";
 
 } // namespace logtail
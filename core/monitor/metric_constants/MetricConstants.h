@@ -45,6 +45,9 @@ extern const std::string METRIC_AGENT_MEMORY;
 extern const std::string METRIC_AGENT_MEMORY_GO;
 extern const std::string METRIC_AGENT_OPEN_FD_TOTAL;
 extern const std::string METRIC_AGENT_PIPELINE_CONFIG_TOTAL;
+extern const std::string METRIC_AGENT_PIPELINE_CONFIG_APPLY_TIME_MS;
+extern const std::string METRIC_AGENT_QUEUE_MEMORY;
+extern const std::string METRIC_AGENT_QUEUE_MEMORY_LIMIT;
 
 //////////////////////////////////////////////////////////////////////////
 // pipeline
@@ -295,6 +298,7 @@ extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_HOST_MONITOR;
 
 // metric keys
 extern const std::string& METRIC_RUNNER_IN_EVENTS_TOTAL;
@@ -356,7 +360,14 @@ extern const std::string METRIC_RUNNER_EBPF_LOST_LOG_EVENTS_TOTAL;
 extern const std::string METRIC_RUNNER_METADATA_CID_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_METADATA_IP_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_METADATA_EXTERNAL_IP_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_METADATA_NOT_FOUND_CID_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_METADATA_REQUEST_REMOTE_TOTAL;
 extern const std::string METRIC_RUNNER_METADATA_REQUEST_REMOTE_FAILED_TOTAL;
 
+/**********************************************************
+ *   host monitor
+ **********************************************************/
+extern const std::string METRIC_RUNNER_HOST_MONITOR_SYSTEM_READS_TOTAL;
+extern const std::string METRIC_RUNNER_HOST_MONITOR_SYSTEM_READS_SAVED_TOTAL;
+
 } // namespace logtail
@@ -31,6 +31,7 @@ const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR = "processor_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS = "prometheus_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER = "ebpf_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA = "k8s_metadata_runner";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_HOST_MONITOR = "host_monitor_runner";
 
 // metric keys
 const string& METRIC_RUNNER_IN_EVENTS_TOTAL = METRIC_IN_EVENTS_TOTAL;
@@ -92,8 +93,15 @@ const string METRIC_RUNNER_EBPF_LOST_LOG_EVENTS_TOTAL = "lost_log_event_total";
 const string METRIC_RUNNER_METADATA_CID_CACHE_SIZE = "cid_cache_size";
 const string METRIC_RUNNER_METADATA_IP_CACHE_SIZE = "ip_cache_size";
 const string METRIC_RUNNER_METADATA_EXTERNAL_IP_CACHE_SIZE = "external_ip_cache_size";
+const string METRIC_RUNNER_METADATA_NOT_FOUND_CID_CACHE_SIZE = "not_found_cid_cache_size";
 const string METRIC_RUNNER_METADATA_REQUEST_REMOTE_TOTAL = "request_metadata_server_total";
 const string METRIC_RUNNER_METADATA_REQUEST_REMOTE_FAILED_TOTAL = "request_metadata_server_failed_total";
 
+/**********************************************************
+ *   host monitor
+ **********************************************************/
+const string METRIC_RUNNER_HOST_MONITOR_SYSTEM_READS_TOTAL = "system_reads_total";
+const string METRIC_RUNNER_HOST_MONITOR_SYSTEM_READS_SAVED_TOTAL = "system_reads_saved_total";
+
 
 } // namespace logtail
@@ -14,8 +14,36 @@
 
 #include "DelimiterModeFsmParser.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace logtail {
 
+// Returns the position of the first separator or quote in [pos, end), or end if there is none.
+// Data chars between two special chars never change the state of the fsm except for the first one, so the
+// caller can skip them as a whole instead of feeding them to the fsm one by one.
+static inline int FindSpecialChar(const char* data, int pos, int end, char quote, char separator) {
+#if defined(__SSE2__)
+    const __m128i sepVec = _mm_set1_epi8(separator);
+    const __m128i quoteVec = _mm_set1_epi8(quote);
+    while (pos + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, sepVec), _mm_cmpeq_epi8(chunk, quoteVec)));
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+        pos += 16;
+    }
+#endif
+    for (; pos < end; ++pos) {
+        if (data[pos] == separator || data[pos] == quote) {
+            return pos;
+        }
+    }
+    return end;
+}
+
 DelimiterModeFsmParser::DelimiterModeFsmParser(char quote, char separator) : quote(quote), separator(separator) {
 }
 
@@ -185,6 +213,22 @@ bool DelimiterModeFsmParser::HandleData(int& fieldEnd, DelimiterModeFsm& fsm) {
     }
 }
 
+bool DelimiterModeFsmParser::HandleDataRun(int runLen, int& fieldEnd, DelimiterModeFsm& fsm) {
+    switch (fsm.currentState) {
+        case STATE_INITIAL:
+            fsm.currentState = STATE_DATA;
+            fieldEnd += runLen;
+            return true;
+        case STATE_QUOTE:
+        case STATE_DATA:
+            fieldEnd += runLen;
+            return true;
+        case STATE_DOUBLE_QUOTE:
+        default:
+            return false;
+    }
+}
+
 bool DelimiterModeFsmParser::HandleEOF(DelimiterModeFsm& fsm, std::vector<std::string>& columnValues) {
     switch (fsm.currentState) {
         case STATE_INITIAL:
@@ -270,20 +314,31 @@ bool DelimiterModeFsmParser::ParseDelimiterLine(
     const char* ch = buffer.data();
     int fieldStart = begin;
     int fieldEnd = begin;
-    for (int i = begin; i < end; ++i) {
+    int i = begin;
+    while (i < end) {
+        int next = FindSpecialChar(ch, i, end, quote, separator);
+        if (next > i) {
+            result = HandleDataRun(next - i, fieldEnd, fsm);
+            if (!result) {
+                columnValues.clear();
+                return false;
+            }
+            i = next;
+            if (i == end) {
+                break;
+            }
+        }
         if (ch[i] == separator) {
             result = HandleSeparator(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
-        } else if (ch[i] == quote) {
+        } else {
             result = HandleQuote(fieldStart, fieldEnd, fsm, doubleQuoteNum);
-        } else // data
-        {
-            result = HandleData(fieldEnd, fsm);
         }
 
         if (!result) {
             columnValues.clear();
             return false;
         }
+        ++i;
     }
     result = HandleEOF(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
     // clear all columns if failed to parse
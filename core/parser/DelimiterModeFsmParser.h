@@ -79,6 +79,8 @@ public:
     static bool HandleQuote(int& fieldStart, int& fieldEnd, DelimiterModeFsm& fsm, int& doubleQuoteNum);
     static bool HandleData(char ch, DelimiterModeFsm& fsm);
     static bool HandleData(int& fieldEnd, DelimiterModeFsm& fsm);
+    // Consume runLen consecutive data chars at once, equivalent to calling HandleData runLen times.
+    static bool HandleDataRun(int runLen, int& fieldEnd, DelimiterModeFsm& fsm);
     static bool HandleEOF(DelimiterModeFsm& fsm, std::vector<std::string>& columnValues);
     static bool HandleEOF(const char* ch,
                           const char quote,
@@ -91,6 +93,8 @@ public:
 
 public:
     bool ParseDelimiterLine(const char* buffer, int begin, int end, std::vector<std::string>& columnValues);
+    // Zero-copy version: columns are views into buffer, except for fields containing escaped quotes, which are
+    // unescaped into the source buffer of event. Runs of data chars are located with SIMD when available.
     bool
     ParseDelimiterLine(StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event);
 
@@ -14,6 +14,8 @@
 
 #include "plugin/flusher/blackhole/FlusherBlackHole.h"
 
+#include <atomic>
+
 #include "collection_pipeline/queue/SenderQueueManager.h"
 
 using namespace std;
@@ -23,7 +25,8 @@ namespace logtail {
 const string FlusherBlackHole::sName = "flusher_blackhole";
 
 bool FlusherBlackHole::Init(const Json::Value& config, Json::Value& optionalGoPipeline) {
-    static uint32_t cnt = 0;
+    // pipelines may be built concurrently
+    static atomic_uint32_t cnt = 0;
     GenerateQueueKey(to_string(++cnt));
     SenderQueueManager::GetInstance()->CreateQueue(mQueueKey, mPluginID, *mContext);
     return true;
@@ -14,6 +14,8 @@
 
 #include "plugin/flusher/file/FlusherFile.h"
 
+#include <atomic>
+
 #include "collection_pipeline/queue/SenderQueueManager.h"
 #include "common/FileSystemUtil.h"
 
@@ -24,7 +26,8 @@ namespace logtail {
 const string FlusherFile::sName = "flusher_file";
 
 bool FlusherFile::Init(const Json::Value& config, [[maybe_unused]] Json::Value& optionalGoPipeline) {
-    static uint32_t sCnt = 0;
+    // pipelines may be built concurrently
+    static atomic_uint32_t sCnt = 0;
     GenerateQueueKey(to_string(++sCnt));
     SenderQueueManager::GetInstance()->CreateQueue(mQueueKey, mPluginID, *mContext);
 
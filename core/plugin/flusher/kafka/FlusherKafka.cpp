@@ -18,6 +18,8 @@
 
 #include <cstring>
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 #include "collection_pipeline/CollectionPipeline.h"
@@ -103,6 +105,20 @@ bool FlusherKafka::Init(const Json::Value& config, Json::Value& optionalGoPipeli
                            mContext->GetRegion());
     }
 
+    if (mKafkaConfig.BatchFormat != BATCH_FORMAT_NDJSON && mKafkaConfig.BatchFormat != BATCH_FORMAT_JSON_ARRAY) {
+        PARAM_ERROR_RETURN(mContext->GetLogger(),
+                           mContext->GetAlarm(),
+                           std::string("Unknown BatchFormat: ") + mKafkaConfig.BatchFormat,
+                           sName,
+                           mContext->GetConfigName(),
+                           mContext->GetProjectName(),
+                           mContext->GetLogstoreName(),
+                           mContext->GetRegion());
+    }
+    mDeliveryCallback = [this](bool success, const KafkaProducer::ErrorInfo& errorInfo) {
+        HandleDeliveryResult(success, errorInfo);
+    };
+
     if (!mProducer->Init(mKafkaConfig)) {
         LOG_ERROR(mContext->GetLogger(), ("failed to init kafka producer", ""));
         return false;
@@ -161,6 +177,9 @@ bool FlusherKafka::SerializeAndSend(PipelineEventGroup&& group) {
         LOG_ERROR(mContext->GetLogger(), ("kafka producer not initialized", ""));
         return false;
     }
+    if (mKafkaConfig.EnableBatchProduce) {
+        return SerializeAndSendInBatch(std::move(group));
+    }
 
     auto events = std::move(group.MutableEvents());
 
@@ -229,6 +248,129 @@ bool FlusherKafka::SerializeAndSend(PipelineEventGroup&& group) {
     return allSuccess;
 }
 
+bool FlusherKafka::SerializeAndSendInBatch(PipelineEventGroup&& group) {
+    auto events = std::move(group.MutableEvents());
+
+    const bool isDynamicTopic = mTopicFormatter.IsDynamic();
+    const bool isHashPartitioner = mKafkaConfig.PartitionerType == PARTITIONER_HASH;
+
+    // events with the same topic and partition key are sent together, keeping their original order
+    std::map<std::pair<std::string, std::string>, EventsContainer> eventsByDest;
+    if (!isDynamicTopic && !isHashPartitioner) {
+        eventsByDest[{mExpandedTopic, std::string()}] = std::move(events);
+    } else {
+        std::pair<std::string, std::string> dest;
+        for (auto& event : events) {
+            dest.first = mExpandedTopic;
+            if (isDynamicTopic && !mTopicFormatter.Format(event, group.GetTags(), dest.first)) {
+                dest.first = mExpandedTopic;
+                LOG_ERROR(mContext->GetLogger(), ("Failed to format dynamic topic from template", mExpandedTopic));
+            }
+            if (isHashPartitioner) {
+                dest.second = GeneratePartitionKey(event);
+            }
+            eventsByDest[dest].emplace_back(std::move(event));
+        }
+    }
+
+    // tags are shared by all messages of the group, so the batch is reused with only events replaced
+    BatchedEvents batch;
+    batch.mTags = std::move(group.GetSizedTags());
+    batch.mSourceBuffers.emplace_back(group.GetSourceBuffer());
+    batch.mExactlyOnceCheckpoint = group.GetExactlyOnceCheckpoint();
+    const size_t tagsSize = batch.mTags.DataSize();
+    const bool isJsonArray = mKafkaConfig.BatchFormat == BATCH_FORMAT_JSON_ARRAY;
+    const size_t prefixSize = isJsonArray ? 1 : 0;
+
+    bool allSuccess = true;
+    bool anySent = false;
+    std::string errorMsg;
+    std::vector<KafkaProducer::Message> messages;
+    for (auto& item : eventsByDest) {
+        const auto& topic = item.first.first;
+        auto& destEvents = item.second;
+        messages.clear();
+        // the serializer only reads the batch, so events are moved back after serialization for the chunk to be split
+        // again if needed, and its tags are still valid for the next message
+        auto serialize = [&](size_t begin, size_t end, std::string& data) {
+            batch.mEvents.clear();
+            batch.mSizeBytes = 0;
+            for (size_t i = begin; i < end; ++i) {
+                batch.mSizeBytes += destEvents[i]->DataSize() + tagsSize;
+                batch.mEvents.emplace_back(std::move(destEvents[i]));
+            }
+            data.clear();
+            if (isJsonArray) {
+                data.push_back('[');
+            }
+            errorMsg.clear();
+            bool res = mSerializer->DoSerialize(std::move(batch), data, errorMsg);
+            for (size_t i = begin; i < end; ++i) {
+                destEvents[i] = std::move(batch.mEvents[i - begin]);
+            }
+            // the serializer fails without any error message when all events are empty, which is not an error
+            return res || (errorMsg.empty() && data.size() == prefixSize);
+        };
+
+        size_t begin = 0;
+        while (begin < destEvents.size()) {
+            // cut messages by the estimated serialized size first
+            size_t end = begin;
+            size_t estimatedSize = 0;
+            do {
+                estimatedSize += destEvents[end]->DataSize() + tagsSize;
+                ++end;
+            } while (end < destEvents.size()
+                     && estimatedSize + destEvents[end]->DataSize() + tagsSize <= mKafkaConfig.MaxMessageBytes);
+
+            // keys, quotes and escaping may make the message exceed MaxMessageBytes, which would be rejected by the
+            // producer as a whole, so the chunk is halved until the serialized message fits
+            std::string data;
+            bool serialized = serialize(begin, end, data);
+            while (serialized && data.size() > mKafkaConfig.MaxMessageBytes && end - begin > 1) {
+                end = begin + (end - begin) / 2;
+                serialized = serialize(begin, end, data);
+            }
+            size_t eventCnt = end - begin;
+            begin = end;
+            if (!serialized) {
+                LOG_ERROR(mContext->GetLogger(),
+                          ("failed to serialize events", errorMsg)("topic", topic)("action", "discard data"));
+                mContext->GetAlarm().SendAlarmCritical(SERIALIZE_FAIL_ALARM,
+                                                       "failed to serialize events: " + errorMsg
+                                                           + "\taction: discard data",
+                                                       mContext->GetRegion(),
+                                                       mContext->GetProjectName(),
+                                                       mContext->GetConfigName(),
+                                                       mContext->GetLogstoreName());
+                mDiscardCnt->Add(eventCnt);
+                allSuccess = false;
+                continue;
+            }
+            if (data.size() == prefixSize) {
+                // all events of the chunk are empty
+                continue;
+            }
+            if (isJsonArray) {
+                // each event is serialized in one line, and newlines inside values are always escaped
+                std::replace(data.begin(), data.end(), '\n', ',');
+                data.back() = ']';
+            }
+            messages.push_back({std::move(data), item.first.second});
+        }
+        if (messages.empty()) {
+            continue;
+        }
+        anySent = true;
+        mProducer->ProduceBatchAsync(topic, messages, mDeliveryCallback);
+    }
+    if (anySent) {
+        // the group is sent in as many messages as needed, but still counted as one
+        mSendCnt->Add(1);
+    }
+
+    return allSuccess;
+}
 
 void FlusherKafka::HandleDeliveryResult(bool success, const KafkaProducer::ErrorInfo& errorInfo) {
     mSendDoneCnt->Add(1);
@@ -57,6 +57,7 @@ public:
 
 private:
     bool SerializeAndSend(PipelineEventGroup&& group);
+    bool SerializeAndSendInBatch(PipelineEventGroup&& group);
     void HandleDeliveryResult(bool success, const KafkaProducer::ErrorInfo& errorInfo);
     std::string GeneratePartitionKey(const PipelineEventPtr& event) const;
 
@@ -66,6 +67,8 @@ private:
 
     FormattedString mTopicFormatter;
     std::string mExpandedTopic;
+    // shared by all messages, so that no callback needs to be allocated for each message
+    KafkaProducer::Callback mDeliveryCallback;
 
     CounterPtr mSendCnt;
     CounterPtr mSuccessCnt;
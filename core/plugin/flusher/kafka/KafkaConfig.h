@@ -50,6 +50,10 @@ struct KafkaConfig {
     uint32_t MaxRetries = 3;
     uint32_t RetryBackoffMs = 100;
 
+    // send events with the same topic and partition key in one message instead of one message per event
+    bool EnableBatchProduce = false;
+    std::string BatchFormat = "ndjson";
+
     std::map<std::string, std::string> CustomConfig;
 
     bool Load(const Json::Value& config, std::string& errorMsg) {
@@ -94,6 +98,9 @@ struct KafkaConfig {
         GetOptionalStringParam(config, "PartitionerType", PartitionerType, errorMsg);
         GetOptionalListParam<std::string>(config, "HashKeys", HashKeys, errorMsg);
 
+        GetOptionalBoolParam(config, "EnableBatchProduce", EnableBatchProduce, errorMsg);
+        GetOptionalStringParam(config, "BatchFormat", BatchFormat, errorMsg);
+
         if (config.isMember("Kafka") && config["Kafka"].isObject()) {
             const Json::Value& kafkaConfig = config["Kafka"];
             for (const auto& key : kafkaConfig.getMemberNames()) {
@@ -46,6 +46,9 @@ const std::string PARTITIONER_RANDOM = "random";
 const std::string PARTITIONER_HASH = "hash";
 const std::string PARTITIONER_PREFIX = "content.";
 
+const std::string BATCH_FORMAT_NDJSON = "ndjson";
+const std::string BATCH_FORMAT_JSON_ARRAY = "json_array";
+
 const std::string LIBRDKAFKA_PARTITIONER_RANDOM = "random";
 const std::string LIBRDKAFKA_PARTITIONER_MURMUR2_RANDOM = "murmur2_random";
 
@@ -46,6 +46,9 @@ extern const std::string PARTITIONER_RANDOM;
 extern const std::string PARTITIONER_HASH;
 extern const std::string PARTITIONER_PREFIX;
 
+extern const std::string BATCH_FORMAT_NDJSON;
+extern const std::string BATCH_FORMAT_JSON_ARRAY;
+
 extern const std::string LIBRDKAFKA_PARTITIONER_RANDOM;
 extern const std::string LIBRDKAFKA_PARTITIONER_MURMUR2_RANDOM;
 
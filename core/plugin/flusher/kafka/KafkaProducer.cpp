@@ -218,53 +218,24 @@ public:
                       std::string&& value,
                       KafkaProducer::Callback callback,
                       const std::string& key) {
-        rd_kafka_t* producer = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(mProducerMutex);
-            producer = mProducer;
-        }
+        rd_kafka_t* producer = GetProducer();
         if (!producer) {
-            KafkaProducer::ErrorInfo errorInfo;
-            errorInfo.type = KafkaProducer::ErrorType::OTHER_ERROR;
-            errorInfo.message = "producer not initialized";
-            errorInfo.code = 0;
-            callback(false, errorInfo);
+            OnProducerNotInitialized(callback);
             return;
         }
+        Produce(producer, topic, value, std::move(callback), key);
+    }
 
-        auto* context = GetContext();
-        context->callback = std::move(callback);
-
-        rd_kafka_resp_err_t err;
-        if (!key.empty()) {
-            err = rd_kafka_producev(producer,
-                                    RD_KAFKA_V_TOPIC(topic.c_str()),
-                                    RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA),
-                                    RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
-                                    RD_KAFKA_V_KEY(key.data(), key.size()),
-                                    RD_KAFKA_V_VALUE(value.data(), value.size()),
-                                    RD_KAFKA_V_OPAQUE(context),
-                                    RD_KAFKA_V_END);
-        } else {
-            err = rd_kafka_producev(producer,
-                                    RD_KAFKA_V_TOPIC(topic.c_str()),
-                                    RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA),
-                                    RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
-                                    RD_KAFKA_V_VALUE(value.data(), value.size()),
-                                    RD_KAFKA_V_OPAQUE(context),
-                                    RD_KAFKA_V_END);
-        }
-
-        if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
-            LOG_ERROR(sLogger,
-                      ("rd_kafka_producev error", rd_kafka_err2str(err))("code", static_cast<int>(err))("topic", topic)(
-                          "value_size", value.size()));
-            ReleaseContext(context);
-            KafkaProducer::ErrorInfo errorInfo;
-            errorInfo.type = KafkaProducer::MapKafkaError(err);
-            errorInfo.message = rd_kafka_err2str(err);
-            errorInfo.code = static_cast<int>(err);
-            callback(false, errorInfo);
+    void ProduceBatchAsync(const std::string& topic,
+                           std::vector<KafkaProducer::Message>& messages,
+                           const KafkaProducer::Callback& callback) {
+        rd_kafka_t* producer = GetProducer();
+        for (auto& message : messages) {
+            if (!producer) {
+                OnProducerNotInitialized(callback);
+                continue;
+            }
+            Produce(producer, topic, message.value, callback, message.key);
         }
     }
 
@@ -303,6 +274,62 @@ public:
     }
 
 private:
+    rd_kafka_t* GetProducer() {
+        std::lock_guard<std::mutex> lock(mProducerMutex);
+        return mProducer;
+    }
+
+    static void OnProducerNotInitialized(const KafkaProducer::Callback& callback) {
+        KafkaProducer::ErrorInfo errorInfo;
+        errorInfo.type = KafkaProducer::ErrorType::OTHER_ERROR;
+        errorInfo.message = "producer not initialized";
+        errorInfo.code = 0;
+        callback(false, errorInfo);
+    }
+
+    void Produce(rd_kafka_t* producer,
+                 const std::string& topic,
+                 const std::string& value,
+                 KafkaProducer::Callback callback,
+                 const std::string& key) {
+        auto* context = GetContext();
+        context->callback = std::move(callback);
+
+        rd_kafka_resp_err_t err;
+        if (!key.empty()) {
+            err = rd_kafka_producev(producer,
+                                    RD_KAFKA_V_TOPIC(topic.c_str()),
+                                    RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA),
+                                    RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
+                                    RD_KAFKA_V_KEY(key.data(), key.size()),
+                                    RD_KAFKA_V_VALUE(value.data(), value.size()),
+                                    RD_KAFKA_V_OPAQUE(context),
+                                    RD_KAFKA_V_END);
+        } else {
+            err = rd_kafka_producev(producer,
+                                    RD_KAFKA_V_TOPIC(topic.c_str()),
+                                    RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA),
+                                    RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
+                                    RD_KAFKA_V_VALUE(value.data(), value.size()),
+                                    RD_KAFKA_V_OPAQUE(context),
+                                    RD_KAFKA_V_END);
+        }
+
+        if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
+            LOG_ERROR(sLogger,
+                      ("rd_kafka_producev error", rd_kafka_err2str(err))("code", static_cast<int>(err))("topic", topic)(
+                          "value_size", value.size()));
+            // callback has been moved into the context
+            callback = std::move(context->callback);
+            ReleaseContext(context);
+            KafkaProducer::ErrorInfo errorInfo;
+            errorInfo.type = KafkaProducer::MapKafkaError(err);
+            errorInfo.message = rd_kafka_err2str(err);
+            errorInfo.code = static_cast<int>(err);
+            callback(false, errorInfo);
+        }
+    }
+
     bool SetConfig(const std::string& key, const std::string& value) {
         char errstr[512];
         if (rd_kafka_conf_set(mConf, key.c_str(), value.c_str(), errstr, sizeof(errstr)) != RD_KAFKA_CONF_OK) {
@@ -365,6 +392,12 @@ void KafkaProducer::ProduceAsync(const std::string& topic,
     mImpl->ProduceAsync(topic, std::move(value), std::move(callback), key);
 }
 
+void KafkaProducer::ProduceBatchAsync(const std::string& topic,
+                                      std::vector<Message>& messages,
+                                      const Callback& callback) {
+    mImpl->ProduceBatchAsync(topic, messages, callback);
+}
+
 bool KafkaProducer::Flush(int timeoutMs) {
     return mImpl->Flush(timeoutMs);
 }
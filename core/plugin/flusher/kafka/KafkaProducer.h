@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "plugin/flusher/kafka/KafkaConstant.h"
 
@@ -39,6 +40,11 @@ public:
 
     using Callback = std::function<void(bool success, const ErrorInfo& errorInfo)>;
 
+    struct Message {
+        std::string value;
+        std::string key;
+    };
+
     KafkaProducer();
     virtual ~KafkaProducer();
 
@@ -47,6 +53,8 @@ public:
                               std::string&& value,
                               Callback callback,
                               const std::string& key = std::string());
+    // values in messages may be moved out, callback is invoked once for each message
+    virtual void ProduceBatchAsync(const std::string& topic, std::vector<Message>& messages, const Callback& callback);
     virtual bool Flush(int timeoutMs);
     virtual void Close();
 
@@ -45,12 +45,10 @@ bool InputContainerStdio::Init(const Json::Value& config, Json::Value& optionalG
                            mContext->GetRegion());
     }
 
-    static Json::Value fileDiscoveryConfig(Json::objectValue);
-    if (fileDiscoveryConfig.empty()) {
-        fileDiscoveryConfig["FilePaths"] = Json::Value(Json::arrayValue);
-        fileDiscoveryConfig["FilePaths"].append("/**/*.log");
-        fileDiscoveryConfig["AllowingCollectingFilesInRootDir"] = true;
-    }
+    Json::Value fileDiscoveryConfig(Json::objectValue);
+    fileDiscoveryConfig["FilePaths"] = Json::Value(Json::arrayValue);
+    fileDiscoveryConfig["FilePaths"].append("/**/*.log");
+    fileDiscoveryConfig["AllowingCollectingFilesInRootDir"] = true;
 
     {
         string key = "AllowingIncludedByMultiConfigs";
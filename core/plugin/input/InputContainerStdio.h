@@ -61,6 +61,7 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class InputContainerStdioUnittest;
+    friend class PipelineManagerUnittest;
 #endif
 };
 
@@ -15,6 +15,10 @@
  */
 #include "plugin/processor/ProcessorDesensitizeNative.h"
 
+#include <cstring>
+
+#include <algorithm>
+
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/HashUtil.h"
 #include "common/ParamExtractor.h"
@@ -40,9 +44,8 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
                            mContext->GetRegion());
     }
 
-    // Method
-    std::string method;
-    if (!GetMandatoryStringParam(config, "Method", method, errorMsg)) {
+    Rule rule;
+    if (!ParseRule(config, rule, errorMsg)) {
         PARAM_ERROR_RETURN(mContext->GetLogger(),
                            mContext->GetAlarm(),
                            errorMsg,
@@ -52,24 +55,37 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
                            mContext->GetLogstoreName(),
                            mContext->GetRegion());
     }
-    if (method == "const") {
-        mMethod = DesensitizeMethod::CONST_OPTION;
-    } else if (method == "md5") {
-        mMethod = DesensitizeMethod::MD5_OPTION;
-    } else {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           "string param Method is not valid",
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
-    }
+    mMethod = rule.mMethod;
+    mReplacingString = rule.mReplacingString;
+    mContentPatternBeforeReplacedString = rule.mContentPatternBeforeReplacedString;
+    mReplacedContentPattern = rule.mReplacedContentPattern;
+    mRules.emplace_back(std::move(rule));
 
-    // ReplacingString
-    if (mMethod == DesensitizeMethod::CONST_OPTION) {
-        if (!GetMandatoryStringParam(config, "ReplacingString", mReplacingString, errorMsg)) {
+    // Rules
+    const char* key = "Rules";
+    const Json::Value* itr = config.find(key, key + strlen(key));
+    if (itr) {
+        if (!itr->isArray()) {
+            PARAM_ERROR_RETURN(mContext->GetLogger(),
+                               mContext->GetAlarm(),
+                               "param Rules is not of type array",
+                               sName,
+                               mContext->GetConfigName(),
+                               mContext->GetProjectName(),
+                               mContext->GetLogstoreName(),
+                               mContext->GetRegion());
+        }
+        for (Json::Value::ArrayIndex i = 0; i < itr->size(); ++i) {
+            const Json::Value& ruleConfig = (*itr)[i];
+            Rule extraRule;
+            if (!ruleConfig.isObject()) {
+                errorMsg = "param Rules[" + std::to_string(i) + "] is not of type object";
+            } else if (ParseRule(ruleConfig, extraRule, errorMsg)) {
+                mRules.emplace_back(std::move(extraRule));
+                continue;
+            } else {
+                errorMsg = "param Rules[" + std::to_string(i) + "] is not valid: " + errorMsg;
+            }
             PARAM_ERROR_RETURN(mContext->GetLogger(),
                                mContext->GetAlarm(),
                                errorMsg,
@@ -80,46 +96,21 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
                                mContext->GetRegion());
         }
     }
-    mReplacingString = std::string("\\1") + mReplacingString;
-
-    // ContentPatternBeforeReplacedString
-    if (!GetMandatoryStringParam(
-            config, "ContentPatternBeforeReplacedString", mContentPatternBeforeReplacedString, errorMsg)) {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
-    }
-
-    // ReplacedContentPattern
-    if (!GetMandatoryStringParam(config, "ReplacedContentPattern", mReplacedContentPattern, errorMsg)) {
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
-    }
-
-    std::string regexStr = std::string("(") + mContentPatternBeforeReplacedString + ")" + mReplacedContentPattern;
-    mRegex.reset(new re2::RE2(regexStr));
-    if (!mRegex->ok()) {
-        errorMsg = mRegex->error();
-        PARAM_ERROR_RETURN(mContext->GetLogger(),
-                           mContext->GetAlarm(),
-                           "param ContentPatternBeforeReplacedString or ReplacedContentPattern is not a valid regex: "
-                               + errorMsg,
-                           sName,
-                           mContext->GetConfigName(),
-                           mContext->GetProjectName(),
-                           mContext->GetLogstoreName(),
-                           mContext->GetRegion());
+    if (mRules.size() > 1) {
+        mRuleSet = std::make_unique<re2::RE2::Set>(re2::RE2::Options(), re2::RE2::UNANCHORED);
+        for (const auto& item : mRules) {
+            mRuleSet->Add(item.mRegex->pattern(), &errorMsg);
+        }
+        if (!mRuleSet->Compile()) {
+            PARAM_ERROR_RETURN(mContext->GetLogger(),
+                               mContext->GetAlarm(),
+                               "failed to compile param Rules, too many rules or the patterns are too complex",
+                               sName,
+                               mContext->GetConfigName(),
+                               mContext->GetProjectName(),
+                               mContext->GetLogstoreName(),
+                               mContext->GetRegion());
+        }
     }
 
     // ReplacingAll
@@ -143,6 +134,78 @@ bool ProcessorDesensitizeNative::Init(const Json::Value& config) {
     return true;
 }
 
+bool ProcessorDesensitizeNative::ParseRule(const Json::Value& config, Rule& rule, std::string& errorMsg) const {
+    // Method
+    std::string method;
+    if (!GetMandatoryStringParam(config, "Method", method, errorMsg)) {
+        return false;
+    }
+    if (method == "const") {
+        rule.mMethod = DesensitizeMethod::CONST_OPTION;
+    } else if (method == "md5") {
+        rule.mMethod = DesensitizeMethod::MD5_OPTION;
+    } else {
+        errorMsg = "string param Method is not valid";
+        return false;
+    }
+
+    // ReplacingString
+    if (rule.mMethod == DesensitizeMethod::CONST_OPTION) {
+        if (!GetMandatoryStringParam(config, "ReplacingString", rule.mReplacingString, errorMsg)) {
+            return false;
+        }
+    }
+    rule.mReplacingString = std::string("\\1") + rule.mReplacingString;
+
+    // ContentPatternBeforeReplacedString
+    if (!GetMandatoryStringParam(
+            config, "ContentPatternBeforeReplacedString", rule.mContentPatternBeforeReplacedString, errorMsg)) {
+        return false;
+    }
+
+    // ReplacedContentPattern
+    if (!GetMandatoryStringParam(config, "ReplacedContentPattern", rule.mReplacedContentPattern, errorMsg)) {
+        return false;
+    }
+
+    std::string regexStr
+        = std::string("(") + rule.mContentPatternBeforeReplacedString + ")" + rule.mReplacedContentPattern;
+    rule.mRegex.reset(new re2::RE2(regexStr));
+    if (!rule.mRegex->ok()) {
+        errorMsg = "param ContentPatternBeforeReplacedString or ReplacedContentPattern is not a valid regex: "
+            + rule.mRegex->error();
+        return false;
+    }
+    rule.mRequiredLiteral = ExtractRequiredLiteral(rule.mContentPatternBeforeReplacedString);
+
+    if (rule.mMethod == DesensitizeMethod::CONST_OPTION) {
+        std::string error;
+        if (!rule.mRegex->CheckRewriteString(rule.mReplacingString, &error)) {
+            errorMsg = "param ReplacingString is not valid: " + error;
+            return false;
+        }
+        // only \\ and \0 ~ \9 are left after the check above
+        RewritePiece piece;
+        const std::string& rewrite = rule.mReplacingString;
+        for (size_t i = 0; i < rewrite.size(); ++i) {
+            if (rewrite[i] != '\\') {
+                piece.mLiteral += rewrite[i];
+            } else if (rewrite[++i] == '\\') {
+                piece.mLiteral += '\\';
+            } else {
+                piece.mGroup = rewrite[i] - '0';
+                rule.mMaxSubmatch = std::max(rule.mMaxSubmatch, piece.mGroup);
+                rule.mRewrite.emplace_back(std::move(piece));
+                piece = RewritePiece();
+            }
+        }
+        if (!piece.mLiteral.empty()) {
+            rule.mRewrite.emplace_back(std::move(piece));
+        }
+    }
+    return true;
+}
+
 void ProcessorDesensitizeNative::Process(PipelineEventGroup& logGroup) {
     if (logGroup.GetEvents().empty()) {
         return;
@@ -178,10 +241,11 @@ void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
         if (item.second.empty()) {
             continue;
         }
-        std::string value = item.second.to_string();
-        CastOneSensitiveWord(&value);
-        StringBuffer valueBuffer = sourceEvent.GetSourceBuffer()->CopyString(value);
-        sourceEvent.SetContentNoCopy(item.first, StringView(valueBuffer.data, valueBuffer.size));
+        // the result is written to the source buffer directly, values without sensitive content are left untouched
+        StringView res;
+        if (CastSensitiveWords(item.second, *sourceEvent.GetSourceBuffer(), res)) {
+            sourceEvent.SetContentNoCopy(item.first, res);
+        }
         processed = true;
     }
     if (processed) {
@@ -195,57 +259,320 @@ void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
     }
 }
 
-void ProcessorDesensitizeNative::CastOneSensitiveWord(std::string* value) {
-    std::string* pVal = value;
-    bool rst = false;
+bool ProcessorDesensitizeNative::CastSensitiveWords(StringView value,
+                                                    SourceBuffer& sourceBuffer,
+                                                    StringView& res) const {
+    // most values contain no sensitive content, skip them by the required literals before running any regex
+    size_t candidateCnt = 0;
+    size_t candidate = 0;
+    for (size_t i = 0; i < mRules.size(); ++i) {
+        if (mRules[i].mRequiredLiteral.empty() || ContainsLiteral(value, mRules[i].mRequiredLiteral)) {
+            ++candidateCnt;
+            candidate = i;
+        }
+    }
+    if (candidateCnt == 0) {
+        return false;
+    }
+    if (candidateCnt == 1) {
+        return ApplyRule(mRules[candidate], value, sourceBuffer, res);
+    }
 
-    if (mMethod == DesensitizeMethod::CONST_OPTION) {
-        if (mReplacingAll) {
-            rst = RE2::GlobalReplace(pVal, *mRegex, mReplacingString);
-        } else {
-            rst = RE2::Replace(pVal, *mRegex, mReplacingString);
+    // find out all rules hit by one pass, rules missing the original value are not applied
+    std::vector<int> hits;
+    re2::RE2::Set::ErrorInfo errorInfo;
+    if (!mRuleSet->Match(re2::StringPiece(value.data(), value.size()), &hits, &errorInfo)) {
+        if (errorInfo.kind == re2::RE2::Set::kNoError) {
+            return false;
         }
-    } else {
-        re2::StringPiece srcStr(*pVal);
-        size_t maxSize = pVal->size();
-        size_t beginPos = 0;
-        rst = true;
-        std::string destStr;
-        do {
-            re2::StringPiece findRst;
-            if (!re2::RE2::FindAndConsume(&srcStr, *mRegex, &findRst)) {
-                if (beginPos == (size_t)0) {
-                    rst = false;
+        // the set fails when its DFA runs out of memory, which does not mean that no rule hits, so all candidate rules
+        // are applied with their own regex instead
+        hits.clear();
+        for (size_t i = 0; i < mRules.size(); ++i) {
+            if (mRules[i].mRequiredLiteral.empty() || ContainsLiteral(value, mRules[i].mRequiredLiteral)) {
+                hits.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+    bool changed = false;
+    res = value;
+    for (auto idx : hits) {
+        // each rule works on the result of the previous one
+        changed |= ApplyRule(mRules[idx], res, sourceBuffer, res);
+    }
+    return changed;
+}
+
+bool ProcessorDesensitizeNative::ApplyRule(const Rule& rule,
+                                           StringView value,
+                                           SourceBuffer& sourceBuffer,
+                                           StringView& res) const {
+    if (rule.mMethod == DesensitizeMethod::CONST_OPTION) {
+        return ReplaceWithConst(rule, value, sourceBuffer, res);
+    }
+    return ReplaceWithMd5(rule, value, sourceBuffer, res);
+}
+
+static size_t Utf8CharLength(const char* p, const char* end) {
+    auto c = static_cast<unsigned char>(*p);
+    size_t len = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+    return std::min(len, static_cast<size_t>(end - p));
+}
+
+static char* AppendTo(char* out, const char* data, size_t size) {
+    if (size > 0) {
+        memcpy(out, data, size);
+    }
+    return out + size;
+}
+
+bool ProcessorDesensitizeNative::ReplaceWithConst(const Rule& rule,
+                                                  StringView value,
+                                                  SourceBuffer& sourceBuffer,
+                                                  StringView& res) const {
+    const int nvec = rule.mMaxSubmatch + 1;
+    re2::StringPiece text(value.data(), value.size());
+    re2::StringPiece vec[10];
+    // all groups of all matches, nvec for each, collected first to know the size of the result
+    std::vector<re2::StringPiece> matches;
+    size_t resSize = text.size();
+    const char* p = text.data();
+    const char* end = p + text.size();
+    const char* lastEnd = nullptr;
+    // same as RE2::GlobalReplace and RE2::Replace, except that the result is not built in a std::string
+    while (p <= end) {
+        if (!rule.mRegex->Match(text, p - text.data(), text.size(), re2::RE2::UNANCHORED, vec, nvec)) {
+            break;
+        }
+        if (vec[0].data() == lastEnd && vec[0].empty()) {
+            // empty match right after the last match is not allowed, skip one character
+            p += p < end ? Utf8CharLength(p, end) : 1;
+            continue;
+        }
+        resSize -= vec[0].size();
+        for (const auto& piece : rule.mRewrite) {
+            resSize += piece.mLiteral.size() + (piece.mGroup >= 0 ? vec[piece.mGroup].size() : 0);
+        }
+        matches.insert(matches.end(), vec, vec + nvec);
+        p = vec[0].data() + vec[0].size();
+        lastEnd = p;
+        if (!mReplacingAll) {
+            break;
+        }
+    }
+    if (matches.empty()) {
+        return false;
+    }
+
+    StringBuffer sb = sourceBuffer.AllocateStringBuffer(resSize);
+    char* out = sb.data;
+    const char* copied = text.data();
+    for (size_t i = 0; i < matches.size(); i += nvec) {
+        const re2::StringPiece* groups = matches.data() + i;
+        out = AppendTo(out, copied, groups[0].data() - copied);
+        for (const auto& piece : rule.mRewrite) {
+            out = AppendTo(out, piece.mLiteral.data(), piece.mLiteral.size());
+            if (piece.mGroup >= 0) {
+                out = AppendTo(out, groups[piece.mGroup].data(), groups[piece.mGroup].size());
+            }
+        }
+        copied = groups[0].data() + groups[0].size();
+    }
+    out = AppendTo(out, copied, end - copied);
+    res = StringView(sb.data, out - sb.data);
+    return true;
+}
+
+bool ProcessorDesensitizeNative::ReplaceWithMd5(const Rule& rule,
+                                                StringView value,
+                                                SourceBuffer& sourceBuffer,
+                                                StringView& res) const {
+    static constexpr size_t kMd5HexSize = 32;
+
+    const char* base = value.data();
+    size_t maxSize = value.size();
+    re2::StringPiece srcStr(base, maxSize);
+    re2::StringPiece vec[2];
+    // [begin, end) of each sensitive content
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t resSize = maxSize;
+    size_t beginPos = 0;
+    do {
+        // same as RE2::FindAndConsume, the unconsumed part is matched on its own
+        if (!rule.mRegex->Match(srcStr, 0, srcStr.size(), re2::RE2::UNANCHORED, vec, 2)) {
+            break;
+        }
+        srcStr.remove_prefix(vec[0].data() + vec[0].size() - srcStr.data());
+        // like  xxxx, psw=123abc,xx
+        size_t beginOffset = vec[1].data() + vec[1].size() - base;
+        size_t endOffset = srcStr.empty() ? maxSize : srcStr.data() - base;
+        if (beginOffset < beginPos || endOffset <= beginPos || endOffset > maxSize) {
+            return false;
+        }
+        ranges.emplace_back(beginOffset, endOffset);
+        resSize = resSize - (endOffset - beginOffset) + kMd5HexSize;
+        beginPos = endOffset;
+        // refine for  : xxxx. psw=123abc
+        if (endOffset >= maxSize) {
+            break;
+        }
+    } while (mReplacingAll);
+    if (ranges.empty()) {
+        return false;
+    }
+
+    StringBuffer sb = sourceBuffer.AllocateStringBuffer(resSize);
+    char* out = sb.data;
+    size_t copied = 0;
+    for (const auto& [begin, end] : ranges) {
+        // add : xxxx, psw
+        out = AppendTo(out, base + copied, begin - copied);
+        // md5: 123abc
+        CalcMD5(base + begin, end - begin, out);
+        out += kMd5HexSize;
+        copied = end;
+    }
+    // add ,xx
+    out = AppendTo(out, base + copied, maxSize - copied);
+    res = StringView(sb.data, out - sb.data);
+    return true;
+}
+
+// Extracts the longest literal that every match of @pattern contains, e.g. 'password":"' from 'password":"\s*'.
+// Only literals outside of groups and character classes are taken, nothing is extracted if the pattern has top level
+// alternation or case insensitive flag.
+std::string ProcessorDesensitizeNative::ExtractRequiredLiteral(const std::string& pattern) {
+    std::string best;
+    std::string cur;
+    bool lastIsLiteral = false;
+    auto flush = [&]() {
+        if (cur.size() > best.size()) {
+            best = cur;
+        }
+        cur.clear();
+        lastIsLiteral = false;
+    };
+    // the quantified character may be absent, drop it (including its UTF-8 continuation bytes)
+    auto dropLast = [&]() {
+        if (lastIsLiteral) {
+            while (!cur.empty() && (static_cast<unsigned char>(cur.back()) & 0xC0) == 0x80) {
+                cur.pop_back();
+            }
+            if (!cur.empty()) {
+                cur.pop_back();
+            }
+        }
+        flush();
+    };
+
+    int depth = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        switch (c) {
+            case '\\': {
+                if (i + 1 == pattern.size()) {
+                    return "";
+                }
+                char next = pattern[++i];
+                if (isdigit(static_cast<unsigned char>(next)) || strchr("xpPQEC", next) != nullptr) {
+                    // octal, hex, unicode classes and quoting are not parsed
+                    return "";
+                }
+                if (depth == 0 && ispunct(static_cast<unsigned char>(next))) {
+                    cur += next;
+                    lastIsLiteral = true;
+                } else {
+                    flush();
                 }
                 break;
             }
-            // like  xxxx, psw=123abc,xx
-            size_t beginOffset = findRst.data() + findRst.size() - pVal->data();
-            size_t endOffset = srcStr.empty() ? maxSize : srcStr.data() - pVal->data();
-            if (beginOffset < beginPos || endOffset <= beginPos || endOffset > maxSize) {
-                rst = false;
+            case '(':
+                if (i + 1 < pattern.size() && pattern[i + 1] == '?') {
+                    size_t flagEnd = pattern.find_first_of(":)", i + 2);
+                    if (pattern.find('i', i + 2) < flagEnd) {
+                        return "";
+                    }
+                }
+                flush();
+                ++depth;
+                break;
+            case ')':
+                flush();
+                --depth;
+                break;
+            case '[': {
+                flush();
+                size_t j = i + 1;
+                if (j < pattern.size() && pattern[j] == '^') {
+                    ++j;
+                }
+                if (j < pattern.size() && pattern[j] == ']') {
+                    ++j;
+                }
+                for (; j < pattern.size() && pattern[j] != ']'; ++j) {
+                    if (pattern[j] == '\\') {
+                        ++j;
+                    } else if (pattern.compare(j, 2, "[:") == 0) {
+                        j = pattern.find(":]", j + 2);
+                        if (j == std::string::npos) {
+                            return "";
+                        }
+                        ++j;
+                    }
+                }
+                if (j >= pattern.size()) {
+                    return "";
+                }
+                i = j;
                 break;
             }
-            // add : xxxx, psw
-            destStr.append(pVal->substr(beginPos, beginOffset - beginPos));
-            // md5: 123abc
-            destStr.append(CalcMD5(pVal->substr(beginOffset, endOffset - beginOffset)));
-            beginPos = endOffset;
-            // refine for  : xxxx. psw=123abc
-            if (endOffset >= maxSize) {
+            case '|':
+                if (depth == 0) {
+                    return "";
+                }
+                flush();
+                break;
+            case '*':
+            case '?':
+                dropLast();
+                break;
+            case '{': {
+                dropLast();
+                size_t repeatEnd = pattern.find('}', i);
+                if (repeatEnd == std::string::npos) {
+                    return "";
+                }
+                i = repeatEnd;
                 break;
             }
-        } while (mReplacingAll);
-
-        if (rst && beginPos < pVal->size()) {
-            // add ,xx
-            destStr.append(pVal->substr(beginPos));
-        }
-        if (rst) {
-            *value = destStr;
-            pVal = value;
+            case '+':
+            case '.':
+            case '^':
+            case '$':
+                flush();
+                break;
+            default:
+                if (depth == 0) {
+                    cur += c;
+                    lastIsLiteral = true;
+                } else {
+                    flush();
+                }
+                break;
         }
     }
+    flush();
+    return best;
+}
+
+bool ProcessorDesensitizeNative::ContainsLiteral(StringView value, const std::string& literal) {
+#if defined(__linux__)
+    // glibc memmem is vectorized
+    return memmem(value.data(), value.size(), literal.data(), literal.size()) != nullptr;
+#else
+    return value.find(StringView(literal.data(), literal.size())) != StringView::npos;
+#endif
 }
 
 bool ProcessorDesensitizeNative::IsSupportedEvent(const PipelineEventPtr& e) const {
@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "re2/re2.h"
+#include "re2/set.h"
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 
@@ -51,10 +56,41 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
+    struct RewritePiece {
+        std::string mLiteral;
+        // capturing group appended after the literal, -1 for none
+        int mGroup = -1;
+    };
+
+    struct Rule {
+        DesensitizeMethod mMethod = DesensitizeMethod::CONST_OPTION;
+        std::string mReplacingString;
+        std::string mContentPatternBeforeReplacedString;
+        std::string mReplacedContentPattern;
+        std::unique_ptr<re2::RE2> mRegex;
+        // literal that every match must contain, empty if none can be derived from the pattern
+        std::string mRequiredLiteral;
+        // mReplacingString split by group references, only for const method
+        std::vector<RewritePiece> mRewrite;
+        int mMaxSubmatch = 0;
+    };
+
+    bool ParseRule(const Json::Value& config, Rule& rule, std::string& errorMsg) const;
     void ProcessEvent(PipelineEventPtr& e);
-    void CastOneSensitiveWord(std::string* value);
+    // returns false if @value contains no sensitive content, otherwise @res points to the result allocated from
+    // @sourceBuffer
+    bool CastSensitiveWords(StringView value, SourceBuffer& sourceBuffer, StringView& res) const;
+    bool ApplyRule(const Rule& rule, StringView value, SourceBuffer& sourceBuffer, StringView& res) const;
+    bool ReplaceWithConst(const Rule& rule, StringView value, SourceBuffer& sourceBuffer, StringView& res) const;
+    bool ReplaceWithMd5(const Rule& rule, StringView value, SourceBuffer& sourceBuffer, StringView& res) const;
+
+    static std::string ExtractRequiredLiteral(const std::string& pattern);
+    static bool ContainsLiteral(StringView value, const std::string& literal);
 
-    std::shared_ptr<re2::RE2> mRegex;
+    // the first rule comes from the top level params, followed by those in Rules
+    std::vector<Rule> mRules;
+    // all rules compiled together, so that one pass tells which rules hit, only built with more than one rule
+    std::unique_ptr<re2::RE2::Set> mRuleSet;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -63,6 +99,7 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorParseApsaraNativeUnittest;
+    friend class ProcessorDesensitizeNativeUnittest;
 #endif
 };
 
@@ -16,6 +16,12 @@
 
 #include "plugin/processor/ProcessorParseApsaraNative.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/LogtailCommonFlags.h"
@@ -105,6 +111,58 @@ void ProcessorParseApsaraNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+/*
+ * 在buffer[beginIndex, size)中查找以'\t'分隔的key:value字段，每个字段调用一次addField。
+ * '\t'与':'的位置每次以16字节为单位批量查找，两者之间的字符不会被逐个检查。
+ * @param buffer - 包含日志数据的字符串视图。
+ * @param beginIndex - 开始查找的索引，第一个字段的key从0开始。
+ * @param addField - 以key和value为参数的回调函数。
+ */
+template <class Func>
+static void ScanFields(const StringView& buffer, int32_t beginIndex, Func&& addField) {
+    const char* data = buffer.data();
+    int32_t length = buffer.size();
+    int32_t fieldBeginIndex = 0;
+    int32_t colonIndex = -1;
+    auto onSeparator = [&](int32_t index) {
+        if (data[index] == '\t') {
+            if (colonIndex >= 0) {
+                addField(StringView(data + fieldBeginIndex, colonIndex - fieldBeginIndex),
+                         StringView(data + colonIndex + 1, index - colonIndex - 1));
+                colonIndex = -1;
+            }
+            fieldBeginIndex = index + 1;
+        } else if (colonIndex == -1) {
+            colonIndex = index;
+        }
+    };
+
+    int32_t index = beginIndex;
+#if defined(__SSE2__)
+    const __m128i tabVec = _mm_set1_epi8('\t');
+    const __m128i colonVec = _mm_set1_epi8(':');
+    while (index + 16 <= length) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+        auto mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, tabVec), _mm_cmpeq_epi8(chunk, colonVec))));
+        while (mask != 0) {
+            onSeparator(index + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+        index += 16;
+    }
+#endif
+    for (; index < length; ++index) {
+        if (data[index] == '\t' || data[index] == ':') {
+            onSeparator(index);
+        }
+    }
+    if (colonIndex >= 0) {
+        addField(StringView(data + fieldBeginIndex, colonIndex - fieldBeginIndex),
+                 StringView(data + colonIndex + 1, length - colonIndex - 1));
+    }
+}
+
 /*
  * 处理单个日志事件。
  * @param logPath - 日志文件的路径。
@@ -199,28 +257,15 @@ bool ProcessorParseApsaraNative::ProcessEvent(const StringView& logPath,
     }
 
     sourceEvent.SetTimestamp(logTime, logTime_in_micro * 1000 % 1000000000);
-    int32_t beg_index = 0;
-    int32_t colon_index = -1;
-    int32_t index = -1;
-    index = ParseApsaraBaseFields(buffer, sourceEvent);
+    int32_t index = ParseApsaraBaseFields(buffer, sourceEvent);
     int32_t length = buffer.size();
     if (index < length) {
-        for (index = index + 1; index <= length; ++index) {
-            if (index == length || buffer.data()[index] == '\t') {
-                if (colon_index >= 0) {
-                    StringView key(buffer.data() + beg_index, colon_index - beg_index);
-                    StringView data(buffer.data() + colon_index + 1, index - colon_index - 1);
-                    AddLog(key, data, sourceEvent);
-                    if (key == mSourceKey) {
-                        sourceKeyOverwritten = true;
-                    }
-                    colon_index = -1;
-                }
-                beg_index = index + 1;
-            } else if (buffer.data()[index] == ':' && colon_index == -1) {
-                colon_index = index;
+        ScanFields(buffer, index + 1, [&](const StringView& key, const StringView& data) {
+            AddLog(key, data, sourceEvent);
+            if (key == mSourceKey) {
+                sourceKeyOverwritten = true;
             }
-        }
+        });
     }
     // logTime_in_micro = (int64_t)logTime_in_micro - (int64_t)mLogTimeZoneOffsetSecond * (int64_t)1000000;
     StringBuffer sb = sourceEvent.GetSourceBuffer()->AllocateStringBuffer(20);
@@ -240,6 +285,42 @@ bool ProcessorParseApsaraNative::ProcessEvent(const StringView& logPath,
     return true;
 }
 
+/*
+ * 按Strptime("%s")的方式解析秒级时间戳：前10位数字为秒，其余数字为秒的小数部分。
+ * Strptime会经过localtime和mktime的转换，对每条日志都调用开销较大。
+ * @param str - '['与']'之间的时间字符串。
+ * @param logTime - 解析出的时间。
+ * @return 如果解析成功，则返回true；如果字符串不是纯数字或者过长，则返回false，由Strptime处理。
+ */
+static bool ParseEpochTime(const StringView& str, LogtailTime& logTime) {
+    // 18 digits at most, so that the fraction part fits in 9 digits and strtoll never overflows
+    if (str.empty() || str.size() > 18) {
+        return false;
+    }
+    size_t secondLength = std::min<size_t>(str.size(), 10);
+    int64_t second = 0;
+    long nanosecond = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] < '0' || str[i] > '9') {
+            return false;
+        }
+        if (i < secondLength) {
+            second = second * 10 + (str[i] - '0');
+        } else {
+            nanosecond = nanosecond * 10 + (str[i] - '0');
+        }
+    }
+    if (second == 0) {
+        return false;
+    }
+    for (size_t i = str.size() - secondLength; i < 9; ++i) {
+        nanosecond *= 10;
+    }
+    logTime.tv_sec = second;
+    logTime.tv_nsec = nanosecond;
+    return true;
+}
+
 /*
  * 解析Apsara格式日志的时间。
  * @param buffer - 包含日志数据的字符串视图。
@@ -255,18 +336,23 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
     if (buffer[0] != '[') {
         return 0;
     }
+    size_t pos = buffer.find(']', 1);
+    if (pos == std::string::npos) {
+        LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
+        return 0;
+    }
+    // Strptime stops at the first char not matching the format, which is ']' at the latest, so the time can be
+    // parsed in place without copying it to a null terminated string.
+    const char* strTime = buffer.data() + 1;
     LogtailTime logTime = {};
+    int nanosecondLength = 0;
     if (buffer[1] == '1') // for normal time, e.g 1378882630, starts with '1'
     {
-        int nanosecondLength = 0;
-        size_t pos = buffer.find(']', 1);
-        if (pos == std::string::npos) {
-            LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
-            return 0;
+        if (ParseEpochTime(StringView(strTime, pos - 1), logTime)) {
+            microTime = (int64_t)logTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
+            return logTime.tv_sec;
         }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
-        auto strptimeResult = Strptime(strTime.c_str(), "%s", &logTime, nanosecondLength);
+        auto strptimeResult = Strptime(strTime, "%s", &logTime, nanosecondLength);
         if (NULL == strptimeResult || strptimeResult[0] != ']') {
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer)("timeformat", "%s"));
             return 0;
@@ -275,51 +361,43 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
         return logTime.tv_sec;
     }
     // test other date format case
-    {
-        size_t pos = buffer.find(']', 1);
-        if (pos == std::string::npos) {
-            LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
-            return 0;
-        }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
-        int nanosecondLength = 0;
-        if (IsPrefixString(strTime, cachedTimeStr) == true) {
-            if (strTime.size() > cachedTimeStr.size()) {
-                auto strptimeResult
-                    = Strptime(strTime.c_str() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
-                if (NULL == strptimeResult) {
-                    LOG_WARNING(sLogger,
-                                ("parse apsara log time microsecond",
-                                 "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S.%f"));
-                }
+    // logs of the same second share the result of the second part, only the fraction is parsed for each of them
+    if (IsPrefixString(StringView(strTime, pos - 1), cachedTimeStr)) {
+        if (pos - 1 > cachedTimeStr.size()) {
+            auto strptimeResult = Strptime(strTime + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
+            if (NULL == strptimeResult) {
+                LOG_WARNING(sLogger,
+                            ("parse apsara log time microsecond",
+                             "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S.%f"));
             }
-            microTime = (int64_t)cachedLogTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
-            return cachedLogTime.tv_sec;
         }
-        // parse second part
-        auto strptimeResult = Strptime(strTime.c_str(), "%Y-%m-%d %H:%M:%S", &logTime, nanosecondLength);
+        microTime = (int64_t)cachedLogTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
+        return cachedLogTime.tv_sec;
+    }
+    // parse second part
+    auto strptimeResult = Strptime(strTime, "%Y-%m-%d %H:%M:%S", &logTime, nanosecondLength);
+    if (NULL == strptimeResult) {
+        LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S"));
+        return 0;
+    }
+    bool isSecondPartCachable = strptimeResult - strTime == 19;
+    // parse nanosecond part (optional)
+    if (*strptimeResult != ']') {
+        strptimeResult = Strptime(strptimeResult + 1, "%f", &logTime, nanosecondLength);
         if (NULL == strptimeResult) {
             LOG_WARNING(sLogger,
-                        ("parse apsara log time", "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S"));
-            return 0;
+                        ("parse apsara log time microsecond", "fail")("string", buffer)("timeformat",
+                                                                                        "%Y-%m-%d %H:%M:%S.%f"));
         }
-        // parse nanosecond part (optional)
-        if (*strptimeResult != '\0') {
-            strptimeResult = Strptime(strptimeResult + 1, "%f", &logTime, nanosecondLength);
-            if (NULL == strptimeResult) {
-                LOG_WARNING(sLogger,
-                            ("parse apsara log time microsecond", "fail")("string", buffer)("timeformat",
-                                                                                            "%Y-%m-%d %H:%M:%S.%f"));
-            }
-        }
-        logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
-        microTime = (int64_t)logTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
-        // if the time is valid (strptime not return NULL), the date value size must be 19 ,like '2013-09-11 03:11:05'
-        cachedTimeStr = StringView(buffer.data() + 1, 19);
+    }
+    logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
+    microTime = (int64_t)logTime.tv_sec * 1000000 + logTime.tv_nsec / 1000;
+    // only cache the second part with the standard size 19, like '2013-09-11 03:11:05'
+    if (isSecondPartCachable) {
+        cachedTimeStr = StringView(strTime, 19);
         cachedLogTime = logTime;
-        return logTime.tv_sec;
     }
+    return logTime.tv_sec;
 }
 
 /*
@@ -328,8 +406,8 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
  * @param prefix - 要检查的前缀。
  * @return 如果字符串以指定前缀开头，则返回true；否则返回false。
  */
-bool ProcessorParseApsaraNative::IsPrefixString(const std::string& all, const StringView& prefix) {
-    return !prefix.empty() && std::equal(prefix.begin(), prefix.end(), all.begin());
+bool ProcessorParseApsaraNative::IsPrefixString(const StringView& all, const StringView& prefix) {
+    return !prefix.empty() && all.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), all.begin());
 }
 
 /*
@@ -23,6 +23,7 @@
 #if defined(__INCLUDE_SSE4_2__)
 #include <cinttypes>
 #include <cstdio>
+#include <cstring>
 
 #include "simdjson/simdjson.h"
 
@@ -56,19 +57,36 @@ bool ProcessorParseJsonNative::Init(const Json::Value& config) {
                            mContext->GetRegion());
     }
 
+    // Keys
+    if (!GetOptionalListParam<std::string>(config, "Keys", mKeys, errorMsg)) {
+        mKeys.clear();
+        PARAM_WARNING_IGNORE(mContext->GetLogger(),
+                             mContext->GetAlarm(),
+                             errorMsg,
+                             sName,
+                             mContext->GetConfigName(),
+                             mContext->GetProjectName(),
+                             mContext->GetLogstoreName(),
+                             mContext->GetRegion());
+    }
+
     if (!mCommonParserOptions.Init(config, *mContext, sName)) {
         return false;
     }
 
-    // Runtime check for SIMD support
+    // Runtime check for SIMD support, pick the widest one the cpu supports
     mUseSimdJson = false;
 #if defined(__INCLUDE_SSE4_2__)
-    auto my_implementation = simdjson::get_available_implementations()["westmere"];
-    if (my_implementation && my_implementation->supported_by_runtime_system()) {
-        mUseSimdJson = true;
-        simdjson::get_active_implementation() = my_implementation;
-        LOG_DEBUG(sLogger, ("simdjson active implementation : ", simdjson::get_active_implementation()->name()));
-    } else {
+    for (const char* name : {"icelake", "haswell", "westmere"}) {
+        auto implementation = simdjson::get_available_implementations()[name];
+        if (implementation && implementation->supported_by_runtime_system()) {
+            mUseSimdJson = true;
+            simdjson::get_active_implementation() = implementation;
+            LOG_DEBUG(sLogger, ("simdjson active implementation : ", simdjson::get_active_implementation()->name()));
+            break;
+        }
+    }
+    if (!mUseSimdJson) {
         LOG_DEBUG(sLogger, ("westmere not supported", "fallback to rapidjson"));
     }
 #endif
@@ -147,8 +165,7 @@ bool ProcessorParseJsonNative::ProcessEvent(const StringView& logPath,
 
 #if defined(__INCLUDE_SSE4_2__)
 // Optimized number processing function using stack buffer
-static StringBuffer
-ProcessNumberValueOptimized(simdjson::ondemand::value& value, LogEvent& sourceEvent, bool& success) {
+static StringView ProcessNumberValueOptimized(simdjson::ondemand::value& value, LogEvent& sourceEvent, bool& success) {
     // Use stack buffer to avoid heap allocation
     constexpr size_t BUFFER_SIZE = 32; // Sufficient for largest number string
     char buffer[BUFFER_SIZE];
@@ -161,14 +178,16 @@ ProcessNumberValueOptimized(simdjson::ondemand::value& value, LogEvent& sourceEv
                 // Use snprintf directly to avoid std::to_string allocation
                 int len = snprintf(buffer, BUFFER_SIZE, "%" PRId64, int_result.value());
                 success = true;
-                return sourceEvent.GetSourceBuffer()->CopyString(buffer, len);
+                StringBuffer sb = sourceEvent.GetSourceBuffer()->CopyString(buffer, len);
+                return StringView(sb.data, sb.size);
             }
         } else {
             auto uint_result = value.get_uint64();
             if (!uint_result.error()) {
                 int len = snprintf(buffer, BUFFER_SIZE, "%" PRIu64, uint_result.value());
                 success = true;
-                return sourceEvent.GetSourceBuffer()->CopyString(buffer, len);
+                StringBuffer sb = sourceEvent.GetSourceBuffer()->CopyString(buffer, len);
+                return StringView(sb.data, sb.size);
             }
         }
     } else {
@@ -177,42 +196,55 @@ ProcessNumberValueOptimized(simdjson::ondemand::value& value, LogEvent& sourceEv
             // Use std::to_string for consistency with rapidjson/ToString implementation
             std::string doubleStr = std::to_string(double_result.value());
             success = true;
-            return sourceEvent.GetSourceBuffer()->CopyString(doubleStr);
+            StringBuffer sb = sourceEvent.GetSourceBuffer()->CopyString(doubleStr);
+            return StringView(sb.data, sb.size);
         }
     }
-    // Return empty buffer on error
-    return sourceEvent.GetSourceBuffer()->CopyString("", 0);
+    return StringView("", 0);
 }
-#endif
 
-#if defined(__INCLUDE_SSE4_2__)
-// Optimized value to StringBuffer conversion function
-static StringBuffer
-OptimizedValueToStringBuffer(simdjson::ondemand::value& value, LogEvent& sourceEvent, bool& success) {
+// Maps @view, which points into the padded copy @json, to the same bytes in @source.
+static StringView ToSourceView(std::string_view view, const char* json, const StringView& source) {
+    return StringView(source.data() + (view.data() - json), view.size());
+}
+
+// Converts @value to string. Strings without escapes, objects and arrays are referenced in @source directly, only
+// unescaped strings and numbers are copied to the source buffer.
+static StringView OptimizedValueToStringView(simdjson::ondemand::value& value,
+                                             const char* json,
+                                             const StringView& source,
+                                             LogEvent& sourceEvent,
+                                             bool& success) {
     success = false;
     switch (value.type()) {
         case simdjson::ondemand::json_type::null: {
-            // Directly allocate empty string StringBuffer
             success = true;
-            return sourceEvent.GetSourceBuffer()->CopyString("", 0);
+            return StringView("", 0);
         }
         case simdjson::ondemand::json_type::boolean: {
             auto bool_result = value.get_bool();
             if (!bool_result.error()) {
-                const bool boolValue = bool_result.value();
-                const auto& boolStr = boolValue ? TRUE_STR : FALSE_STR;
+                const auto& boolStr = bool_result.value() ? TRUE_STR : FALSE_STR;
                 success = true;
-                return sourceEvent.GetSourceBuffer()->CopyString(boolStr.data(), boolStr.size());
+                return StringView(boolStr.data(), boolStr.size());
             }
             break;
         }
         case simdjson::ondemand::json_type::string: {
+            // the raw token starts with the opening quote, the first quote after it closes the string if no
+            // backslash comes before
+            std::string_view token = value.raw_json_token();
+            size_t end = token.find_first_of("\"\\", 1);
+            if (end != std::string_view::npos && token[end] == '"') {
+                success = true;
+                return ToSourceView(token.substr(1, end - 1), json, source);
+            }
             auto str_result = value.get_string();
             if (!str_result.error()) {
-                // Directly copy from simdjson string view, avoiding std::string intermediary
                 std::string_view str_view = str_result.value();
+                StringBuffer sb = sourceEvent.GetSourceBuffer()->CopyString(str_view.data(), str_view.size());
                 success = true;
-                return sourceEvent.GetSourceBuffer()->CopyString(str_view.data(), str_view.size());
+                return StringView(sb.data, sb.size);
             }
             break;
         }
@@ -223,9 +255,8 @@ OptimizedValueToStringBuffer(simdjson::ondemand::value& value, LogEvent& sourceE
         case simdjson::ondemand::json_type::array: {
             auto json_str = simdjson::to_json_string(value);
             if (!json_str.error()) {
-                std::string_view json_view = json_str.value();
                 success = true;
-                return sourceEvent.GetSourceBuffer()->CopyString(json_view.data(), json_view.size());
+                return ToSourceView(json_str.value(), json, source);
             }
             break;
         }
@@ -233,8 +264,7 @@ OptimizedValueToStringBuffer(simdjson::ondemand::value& value, LogEvent& sourceE
             break;
         }
     }
-    // Return empty buffer on error
-    return sourceEvent.GetSourceBuffer()->CopyString("", 0);
+    return StringView("", 0);
 }
 #endif
 
@@ -259,15 +289,19 @@ bool ProcessorParseJsonNative::JsonLogLineParserSimdJson(LogEvent& sourceEvent,
     if (buffer.empty())
         return false;
 
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string bufStr(buffer.data(), buffer.size());
+    // the parser and the padded copy are reused by all events handled by the same thread
+    static thread_local simdjson::ondemand::parser sParser;
+    static thread_local std::string sPaddedJson;
+    sPaddedJson.resize(buffer.size() + simdjson::SIMDJSON_PADDING);
+    memcpy(sPaddedJson.data(), buffer.data(), buffer.size());
+    const char* json = sPaddedJson.data();
     simdjson::ondemand::document doc;
     simdjson::ondemand::object object;
 
     // Use try-catch to handle all simdjson parsing errors generically
     // This maintains compatibility with rapidjson's error handling approach
     try {
-        auto error = parser.iterate(bufStr).get(doc);
+        auto error = sParser.iterate(json, buffer.size(), sPaddedJson.size()).get(doc);
         if (error) {
             if (AlarmManager::GetInstance()->IsLowLevelAlarmValid()) {
                 LOG_WARNING(
@@ -311,18 +345,37 @@ bool ProcessorParseJsonNative::JsonLogLineParserSimdJson(LogEvent& sourceEvent,
     // Pre-check mSourceKey to avoid string comparison in loop
     std::string_view sourceKeyView(mSourceKey);
 
+    // with Keys, stop iterating once all of them are found, only possible when they fit in the mask
+    const bool stopEarly = !mKeys.empty() && mKeys.size() <= 64;
+    const uint64_t allKeysMask = stopEarly ? (~0ULL >> (64 - mKeys.size())) : 0;
+    uint64_t foundKeysMask = 0;
+
     // Wrap the entire field iteration in try-catch as simdjson can throw during iteration
     try {
         for (auto field : object) {
-            // Use simdjson error handling mechanism, reduce exception overhead
-            std::string_view keyv;
-            if (auto key_result = field.unescaped_key(); !key_result.error()) {
+            // keys without escapes are referenced in the source buffer directly
+            std::string_view keyv = field.escaped_key();
+            StringView contentKey;
+            if (keyv.find('\\') == std::string_view::npos) {
+                contentKey = ToSourceView(keyv, json, buffer);
+            } else if (auto key_result = field.unescaped_key(); !key_result.error()) {
                 keyv = key_result.value();
+                StringBuffer contentKeyBuffer = sourceEvent.GetSourceBuffer()->CopyString(keyv.data(), keyv.size());
+                contentKey = StringView(contentKeyBuffer.data, contentKeyBuffer.size);
             } else {
                 continue; // Skip field with error
             }
 
-            StringBuffer contentKeyBuffer = sourceEvent.GetSourceBuffer()->CopyString(keyv.data(), keyv.size());
+            if (!mKeys.empty()) {
+                size_t idx = FindKey(keyv);
+                if (idx == mKeys.size()) {
+                    // the value is skipped by simdjson without being parsed
+                    continue;
+                }
+                if (stopEarly) {
+                    foundKeysMask |= 1ULL << idx;
+                }
+            }
 
             // Get value
             simdjson::ondemand::value value;
@@ -334,7 +387,7 @@ bool ProcessorParseJsonNative::JsonLogLineParserSimdJson(LogEvent& sourceEvent,
 
             // Use optimized value conversion function
             bool conversionSuccess = false;
-            StringBuffer contentValueBuffer = OptimizedValueToStringBuffer(value, sourceEvent, conversionSuccess);
+            StringView contentValue = OptimizedValueToStringView(value, json, buffer, sourceEvent, conversionSuccess);
 
             // If conversion failed, the function already returns an appropriate fallback buffer
             // No need for additional fallback logic here
@@ -345,8 +398,10 @@ bool ProcessorParseJsonNative::JsonLogLineParserSimdJson(LogEvent& sourceEvent,
             }
 
             // Store temporarily instead of adding directly
-            tempFields.emplace_back(StringView(contentKeyBuffer.data, contentKeyBuffer.size),
-                                    StringView(contentValueBuffer.data, contentValueBuffer.size));
+            tempFields.emplace_back(contentKey, contentValue);
+            if (stopEarly && foundKeysMask == allKeysMask) {
+                break;
+            }
         }
     } catch (simdjson::simdjson_error& error) {
         if (AlarmManager::GetInstance()->IsLowLevelAlarmValid()) {
@@ -449,6 +504,10 @@ bool ProcessorParseJsonNative::JsonLogLineParserRapidJson(LogEvent& sourceEvent,
     }
 
     for (rapidjson::Value::ConstMemberIterator itr = doc.MemberBegin(); itr != doc.MemberEnd(); ++itr) {
+        if (!mKeys.empty()
+            && FindKey(std::string_view(itr->name.GetString(), itr->name.GetStringLength())) == mKeys.size()) {
+            continue;
+        }
         std::string contentKey = RapidjsonValueToString(itr->name);
         std::string contentValue = RapidjsonValueToString(itr->value);
 
@@ -476,6 +535,16 @@ void ProcessorParseJsonNative::AddLog(const StringView& key,
     targetEvent.SetContentNoCopy(key, value);
 }
 
+size_t ProcessorParseJsonNative::FindKey(std::string_view key) const {
+    // Keys is expected to be short, linear search beats hashing here
+    for (size_t i = 0; i < mKeys.size(); ++i) {
+        if (key == mKeys[i]) {
+            return i;
+        }
+    }
+    return mKeys.size();
+}
+
 bool ProcessorParseJsonNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
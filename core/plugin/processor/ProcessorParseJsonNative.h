@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
 #include "plugin/processor/CommonParserOptions.h"
@@ -33,6 +37,9 @@ public:
     std::string mSourceKey;
     CommonParserOptions mCommonParserOptions;
 
+    // Top level keys to extract, all keys are extracted if empty. Other fields are skipped without being parsed.
+    std::vector<std::string> mKeys;
+
     // Flag to indicate which JSON parser implementation to use at runtime
     bool mUseSimdJson = false;
 
@@ -53,6 +60,8 @@ private:
                                     PipelineEventPtr& e,
                                     bool& sourceKeyOverwritten);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
+    // returns the index of @key in mKeys, or mKeys.size() if not found
+    size_t FindKey(std::string_view key) const;
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, const GroupMetadata& metadata);
 
     CounterPtr mDiscardedEventsTotal;
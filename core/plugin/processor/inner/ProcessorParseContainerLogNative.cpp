@@ -16,7 +16,11 @@
 
 #include "plugin/processor/inner/ProcessorParseContainerLogNative.h"
 
-#include <codecvt>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
 
 #include "common/JsonUtil.h"
 #include "common/ParamExtractor.h"
@@ -126,13 +130,17 @@ void ProcessorParseContainerLogNative::Process(PipelineEventGroup& logGroup) {
 
     EventsContainer& events = logGroup.MutableEvents();
 
-    for (auto it = events.begin(); it != events.end();) {
-        if (ProcessEvent(containerType, *it, logGroup)) {
-            ++it;
-        } else {
-            it = events.erase(it);
+    // compact in place instead of erasing, so that ignoring a stream costs O(n) for the whole group
+    size_t wIdx = 0;
+    for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
+        if (ProcessEvent(containerType, events[rIdx], logGroup)) {
+            if (wIdx != rIdx) {
+                events[wIdx] = std::move(events[rIdx]);
+            }
+            ++wIdx;
         }
     }
+    events.resize(wIdx);
 }
 
 bool ProcessorParseContainerLogNative::ProcessEvent(StringView containerType,
@@ -173,6 +181,13 @@ bool ProcessorParseContainerLogNative::ProcessEvent(StringView containerType,
     return shouldKeepEvent;
 }
 
+// memchr is vectorized by libc, which matters for the long content field scanned when the tag is missing.
+static inline const char* FindDelimiter(const char* begin, const char* end) {
+    const char* res = static_cast<const char*>(
+        memchr(begin, ProcessorParseContainerLogNative::CONTAINERD_DELIMITER, end - begin));
+    return res == nullptr ? end : res;
+}
+
 bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sourceEvent,
                                                                   std::string& errorMsg,
                                                                   PipelineEventGroup& logGroup) {
@@ -180,7 +195,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
 
     // 寻找第一个分隔符位置 时间 _time_
     StringView timeValue;
-    const char* pch1 = std::find(contentValue.begin(), contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch1 = FindDelimiter(contentValue.data(), contentValue.end());
     if (pch1 == contentValue.end()) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "time field cannot be found in log line."
@@ -192,7 +207,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
 
     // 寻找第二个分隔符位置 容器标签 _source_
     StringView sourceValue;
-    const char* pch2 = std::find(pch1 + 1, contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch2 = FindDelimiter(pch1 + 1, contentValue.end());
     if (pch2 == contentValue.end()) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "source field cannot be found in log line."
@@ -232,7 +247,7 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
     }
 
     // 寻找第三个分隔符位置
-    const char* pch3 = std::find(pch2 + 1, contentValue.end(), CONTAINERD_DELIMITER);
+    const char* pch3 = FindDelimiter(pch2 + 1, contentValue.end());
     if (pch3 == contentValue.end() || pch3 != pch2 + 2) {
         // case: 2021-08-25T07:00:00.000000000Z stdout P
         // case: 2021-08-25T07:00:00.000000000Z stdout PP 1
@@ -291,66 +306,145 @@ static int32_t parseLogType(char* buffer, int32_t idx, int32_t size, DockerLogTy
     return idx;
 }
 
-// windows can't instantiation with char32_t.
-#if defined(_MSC_VER)
-std::wstring_convert<std::codecvt_utf8<unsigned long>, unsigned long> convert;
-#else
-std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
+static inline int32_t hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// parse the 4 hex digits of a unicode escape sequence, return -1 if any of them is invalid
+static inline int32_t parseUnicodeEscape(const char* buffer) {
+    int32_t res = 0;
+    for (int32_t i = 0; i < 4; ++i) {
+        int32_t v = hexValue(buffer[i]);
+        if (v < 0) {
+            return -1;
+        }
+        res = (res << 4) | v;
+    }
+    return res;
+}
+
+static inline int32_t appendUtf8(char* buffer, int32_t endIndex, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        buffer[endIndex++] = static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        buffer[endIndex++] = static_cast<char>(0xC0 | (codePoint >> 6));
+        buffer[endIndex++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        buffer[endIndex++] = static_cast<char>(0xE0 | (codePoint >> 12));
+        buffer[endIndex++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[endIndex++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        buffer[endIndex++] = static_cast<char>(0xF0 | (codePoint >> 18));
+        buffer[endIndex++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        buffer[endIndex++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[endIndex++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    return endIndex;
+}
+
+// Returns the position of the first '"' or '\\' in [idx, size), or size if there is none.
+static inline int32_t findQuoteOrEscape(const char* buffer, int32_t idx, int32_t size) {
+#if defined(__SSE2__)
+    const __m128i quoteVec = _mm_set1_epi8('\"');
+    const __m128i escapeVec = _mm_set1_epi8('\\');
+    while (idx + 16 <= size) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + idx));
+        int mask
+            = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quoteVec), _mm_cmpeq_epi8(chunk, escapeVec)));
+        if (mask != 0) {
+            return idx + __builtin_ctz(mask);
+        }
+        idx += 16;
+    }
 #endif
+    while (idx < size && buffer[idx] != '\"' && buffer[idx] != '\\') {
+        ++idx;
+    }
+    return idx;
+}
 
+// Unescape the value starting at idx in place, writing to buffer[endIndex...]. Since unescaping never makes the
+// value longer, endIndex never overtakes idx. Plain runs are located with SIMD and only moved once an escape has
+// been seen, so values without escapes are not touched at all.
 static int32_t parseValue(char* buffer, int32_t idx, int32_t size, DockerLogType logType, int32_t& endIndex) {
-    while (idx < size && buffer[idx] != '\"') {
-        if (buffer[idx] == '\\') {
-            if (logType != DockerLogType::Log) {
-                return -1;
-            }
-            ++idx; // skip escape char
-            if (idx >= size) {
-                return -1;
+    while (idx < size) {
+        int32_t next = findQuoteOrEscape(buffer, idx, size);
+        if (next > idx) {
+            if (endIndex != idx) {
+                memmove(buffer + endIndex, buffer + idx, next - idx);
             }
-            switch (buffer[idx]) {
-                case '\"':
-                    buffer[endIndex++] = '\"';
-                    break;
-                case '\\':
+            endIndex += next - idx;
+            idx = next;
+        }
+        if (idx >= size || buffer[idx] == '\"') {
+            break;
+        }
+        // buffer[idx] == '\\'
+        if (logType != DockerLogType::Log) {
+            return -1;
+        }
+        ++idx; // skip escape char
+        if (idx >= size) {
+            return -1;
+        }
+        switch (buffer[idx]) {
+            case '\"':
+                buffer[endIndex++] = '\"';
+                break;
+            case '\\':
+                buffer[endIndex++] = '\\';
+                break;
+            case '/':
+                buffer[endIndex++] = '/';
+                break;
+            case 'b':
+                buffer[endIndex++] = '\b';
+                break;
+            case 'f':
+                buffer[endIndex++] = '\f';
+                break;
+            case 'n':
+                buffer[endIndex++] = '\n';
+                break;
+            case 'r':
+                buffer[endIndex++] = '\r';
+                break;
+            case 't':
+                buffer[endIndex++] = '\t';
+                break;
+            default: {
+                int32_t codeUnit = -1;
+                if (idx + 4 < size && buffer[idx] == 'u') {
+                    codeUnit = parseUnicodeEscape(buffer + idx + 1);
+                }
+                if (codeUnit < 0) {
                     buffer[endIndex++] = '\\';
+                    buffer[endIndex++] = buffer[idx];
                     break;
-                case '/':
-                    buffer[endIndex++] = '/';
-                    break;
-                case 'b':
-                    buffer[endIndex++] = '\b';
-                    break;
-                case 'f':
-                    buffer[endIndex++] = '\f';
-                    break;
-                case 'n':
-                    buffer[endIndex++] = '\n';
-                    break;
-                case 'r':
-                    buffer[endIndex++] = '\r';
-                    break;
-                case 't':
-                    buffer[endIndex++] = '\t';
-                    break;
-                default:
-                    if (idx + 4 < size && buffer[idx] == 'u') {
-                        std::string unicode_seq;
-                        unicode_seq.append(buffer + idx + 1, 4);
-                        unsigned long unicode_char = std::stoul(unicode_seq, nullptr, 16);
-                        std::string res = convert.to_bytes(unicode_char);
-                        for (size_t i = 0; i < res.size(); ++i) {
-                            buffer[endIndex++] = res[i];
-                        }
-                        idx += 4;
-                    } else {
-                        buffer[endIndex++] = '\\';
-                        buffer[endIndex++] = buffer[idx];
+                }
+                idx += 4;
+                uint32_t codePoint = codeUnit;
+                // combine utf-16 surrogate pair which is escaped as two consecutive sequences
+                if (codeUnit >= 0xD800 && codeUnit <= 0xDBFF && idx + 6 < size && buffer[idx + 1] == '\\'
+                    && buffer[idx + 2] == 'u') {
+                    int32_t low = parseUnicodeEscape(buffer + idx + 3);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        codePoint = 0x10000 + ((codeUnit - 0xD800) << 10) + (low - 0xDC00);
+                        idx += 6;
                     }
-                    break;
+                }
+                endIndex = appendUtf8(buffer, endIndex, codePoint);
+                break;
             }
-        } else {
-            buffer[endIndex++] = buffer[idx];
         }
         ++idx;
     }
@@ -509,11 +603,9 @@ bool ProcessorParseContainerLogNative::ParseDockerJsonLogLine(LogEvent& sourceEv
         return mKeepingSourceWhenParseFail;
     }
 
-    // time
-    sourceEvent.SetContent(containerTimeKey, timeValue);
-
-    // source
-    sourceEvent.SetContent(containerSourceKey, sourceValue);
+    // time and source are views into the source buffer as well, no need to copy them
+    sourceEvent.SetContentNoCopy(containerTimeKey, timeValue);
+    sourceEvent.SetContentNoCopy(containerSourceKey, sourceValue);
 
     // content
     if (!content.empty() && content.back() == '\n') {
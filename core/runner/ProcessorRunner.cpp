@@ -174,7 +174,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
                 }
             }
         } else {
-            pipeline->Send(std::move(eventGroupList));
+            pipeline->SendInOrder(std::move(eventGroupList), item->mSeqNo);
         }
         pipeline->SubInProcessCnt();
 
@@ -27,6 +27,7 @@ public:
     void TestCheckpointFileNames() const;
     void TestDumpCheckpoints() const;
     void TestInvalidCheckpointFile() const;
+    void TestUpdateRangeCheckpoint() const;
 
 protected:
     void SetUp() override {
@@ -635,11 +636,100 @@ void InputStaticFileCheckpointManagerUnittest::TestInvalidCheckpointFile() const
     }
 }
 
+void InputStaticFileCheckpointManagerUnittest::TestUpdateRangeCheckpoint() const {
+    filesystem::create_directories("test_logs");
+    vector<filesystem::path> files{"./test_logs/test_file_1.log", "./test_logs/test_file_2.log"};
+    {
+        ofstream fout(files[0], std::ios_base::binary);
+        fout << string(999, 'a') << "\n" << string(999, 'b') << "\n" << string(999, 'c') << "\n";
+    }
+    {
+        ofstream fout(files[1], std::ios_base::binary);
+        fout << string(100, 'd') << "\n";
+    }
+    sManager->CreateCheckpoint("test_config_1", 0, files);
+    {
+        // set ranges, from waiting to reading
+        vector<FileRangeCheckpoint> ranges{{0, 1000}, {1000, 2000}, {2000, 3000}};
+        APSARA_TEST_TRUE(sManager->SetCurrentFileRanges("test_config_1", 0, 3000, std::move(ranges)));
+        size_t fileIdx = 1;
+        vector<FileRangeCheckpoint> res;
+        APSARA_TEST_TRUE(sManager->GetCurrentFileRanges("test_config_1", 0, fileIdx, res));
+        APSARA_TEST_EQUAL(0U, fileIdx);
+        APSARA_TEST_EQUAL(3U, res.size());
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config_1", 0));
+        APSARA_TEST_EQUAL(FileStatus::READING, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_EQUAL(3000U, cpt.mFileCheckpoints[0].mSize);
+        APSARA_TEST_EQUAL(0U, cpt.mFileCheckpoints[0].mOffset);
+
+        // existing ranges are kept
+        vector<FileRangeCheckpoint> other{{0, 3000}};
+        APSARA_TEST_TRUE(sManager->SetCurrentFileRanges("test_config_1", 0, 3000, std::move(other)));
+        APSARA_TEST_EQUAL(3U, cpt.mFileCheckpoints[0].mRanges.size());
+    }
+    {
+        // ranges are read out of order
+        APSARA_TEST_TRUE(sManager->UpdateCurrentFileRangeCheckpoint("test_config_1", 0, 0, 2, 2500));
+        APSARA_TEST_TRUE(sManager->UpdateCurrentFileRangeCheckpoint("test_config_1", 0, 0, 0, 1000));
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config_1", 0));
+        // the offset is where the first unfinished range is, not the number of bytes read
+        APSARA_TEST_EQUAL(1000U, cpt.mFileCheckpoints[0].mOffset);
+        APSARA_TEST_EQUAL(FileStatus::READING, cpt.mFileCheckpoints[0].mStatus);
+
+        // ranges are persisted
+        sManager->DumpAllCheckpointFiles();
+        InputStaticFileCheckpoint cptLoaded;
+        APSARA_TEST_TRUE(
+            sManager->LoadCheckpointFile(sManager->mCheckpointRootPath / "test_config_1@0.json", &cptLoaded));
+        const auto& ranges = cptLoaded.mFileCheckpoints[0].mRanges;
+        APSARA_TEST_EQUAL(3U, ranges.size());
+        APSARA_TEST_EQUAL(2000U, ranges[2].mBegin);
+        APSARA_TEST_EQUAL(3000U, ranges[2].mEnd);
+        APSARA_TEST_EQUAL(2500U, ranges[2].mOffset);
+        APSARA_TEST_EQUAL(1000U, ranges[0].mOffset);
+        APSARA_TEST_EQUAL(1000U, ranges[1].mOffset);
+
+        // the file is read sequentially after restart from the offset, with the ranges dropped
+        uint64_t offset = 0;
+        APSARA_TEST_TRUE(cptLoaded.ClearCurrentFileRanges(offset));
+        APSARA_TEST_EQUAL(1000U, offset);
+        APSARA_TEST_TRUE(cptLoaded.mFileCheckpoints[0].mRanges.empty());
+        APSARA_TEST_FALSE(cptLoaded.ClearCurrentFileRanges(offset));
+    }
+    {
+        // all ranges done, move to the next file
+        APSARA_TEST_TRUE(sManager->UpdateCurrentFileRangeCheckpoint("test_config_1", 0, 0, 2, 3000));
+        APSARA_TEST_TRUE(sManager->UpdateCurrentFileRangeCheckpoint("test_config_1", 0, 0, 1, 2000));
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config_1", 0));
+        APSARA_TEST_EQUAL(1U, cpt.mCurrentFileIndex);
+        APSARA_TEST_EQUAL(FileStatus::FINISHED, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_EQUAL(3000U, cpt.mFileCheckpoints[0].mOffset);
+        APSARA_TEST_TRUE(cpt.mFileCheckpoints[0].mRanges.empty());
+
+        // late update of the finished file is ignored
+        APSARA_TEST_FALSE(sManager->UpdateCurrentFileRangeCheckpoint("test_config_1", 0, 0, 1, 2000));
+        APSARA_TEST_FALSE(sManager->InvalidateCurrentFileRangeCheckpoint("test_config_1", 0, 0));
+        APSARA_TEST_EQUAL(FileStatus::WAITING, cpt.mFileCheckpoints[1].mStatus);
+    }
+    {
+        // one range fails, the whole file is abandoned
+        vector<FileRangeCheckpoint> ranges{{0, 50}, {50, 101}};
+        APSARA_TEST_TRUE(sManager->SetCurrentFileRanges("test_config_1", 0, 101, std::move(ranges)));
+        APSARA_TEST_TRUE(sManager->InvalidateCurrentFileRangeCheckpoint("test_config_1", 0, 1));
+        APSARA_TEST_FALSE(sManager->UpdateCurrentFileRangeCheckpoint("test_config_1", 0, 1, 0, 50));
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config_1", 0));
+        APSARA_TEST_EQUAL(StaticFileReadingStatus::FINISHED, cpt.mStatus);
+        APSARA_TEST_EQUAL(FileStatus::ABORT, cpt.mFileCheckpoints[1].mStatus);
+    }
+    filesystem::remove_all("test_logs");
+}
+
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestUpdateCheckpointMap)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestUpdateCheckpoint)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestCheckpointFileNames)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestDumpCheckpoints)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestInvalidCheckpointFile)
+UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestUpdateRangeCheckpoint)
 
 } // namespace logtail
 
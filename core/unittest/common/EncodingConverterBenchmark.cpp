@@ -0,0 +1,112 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iconv.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/EncodingConverter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr int kLineCnt = 200000;
+constexpr int kRoundCnt = 10;
+
+// what ConvertGbk2Utf8 did before: one iconv call per line
+size_t ConvertByIconv(iconv_t cd, const char* src, char* des, size_t desLength, const vector<long>& linePosVec) {
+    size_t beginIndex = 0;
+    size_t destIndex = 0;
+    for (auto pos : linePosVec) {
+        size_t endIndex = pos + 1;
+        char* in = const_cast<char*>(src + beginIndex);
+        size_t inLeft = endIndex - beginIndex;
+        char* out = des + destIndex;
+        size_t outLeft = desLength - destIndex;
+        if (iconv(cd, &in, &inLeft, &out, &outLeft) == (size_t)(-1)) {
+            iconv(cd, NULL, NULL, NULL, NULL);
+            memcpy(des + destIndex, src + beginIndex, endIndex - beginIndex);
+            destIndex += endIndex - beginIndex;
+        } else {
+            destIndex = out - des;
+        }
+        beginIndex = endIndex;
+    }
+    return destIndex;
+}
+
+} // namespace
+
+class EncodingConverterBenchmark : public testing::Test {
+public:
+    void TestConvertGbk2Utf8();
+
+protected:
+    void SetUp() override {
+        // typical application logs: mostly ASCII with a few chinese words in each line
+        for (int i = 0; i < kLineCnt; ++i) {
+            mGbk += "2025-01-01 12:00:00.123 INFO [main] ";
+            mGbk += "\xc7\xeb\xc7\xf3\xb4\xa6\xc0\xed\xcd\xea\xb3\xc9"; // 请求处理完成
+            mGbk += " request_id=" + to_string(i) + " status=200 latency=12ms\n";
+            mLinePosVec.push_back(mGbk.size() - 1);
+        }
+    }
+
+    string mGbk;
+    vector<long> mLinePosVec;
+};
+
+void EncodingConverterBenchmark::TestConvertGbk2Utf8() {
+    string expected(mGbk.size() * 2 + 1, '\0');
+    string res(mGbk.size() * 2 + 1, '\0');
+    size_t expectedSize = 0;
+    size_t resSize = 0;
+    {
+        iconv_t cd = iconv_open("UTF-8", "GBK");
+        APSARA_TEST_TRUE_FATAL(cd != (iconv_t)(-1));
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < kRoundCnt; ++i) {
+            expectedSize = ConvertByIconv(cd, mGbk.data(), expected.data(), expected.size(), mLinePosVec);
+        }
+        chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+        iconv_close(cd);
+        cout << "[iconv per line] " << mGbk.size() * kRoundCnt / elapsed.count() / 1024 / 1024 << " MB/s" << endl;
+    }
+    {
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < kRoundCnt; ++i) {
+            size_t srcLength = mGbk.size();
+            resSize = EncodingConverter::GetInstance()->ConvertGbk2Utf8(
+                mGbk.data(), &srcLength, res.data(), res.size(), mLinePosVec);
+        }
+        chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+        cout << "[EncodingConverter] " << mGbk.size() * kRoundCnt / elapsed.count() / 1024 / 1024 << " MB/s" << endl;
+    }
+    APSARA_TEST_EQUAL(expectedSize, resSize);
+    APSARA_TEST_EQUAL(0, memcmp(expected.data(), res.data(), resSize));
+}
+
+UNIT_TEST_CASE(EncodingConverterBenchmark, TestConvertGbk2Utf8)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if defined(__linux__)
+#include <iconv.h>
+#endif
+
+#include <string>
+#include <vector>
+
 #include "common/EncodingConverter.h"
 #include "unittest/Unittest.h"
 #if defined(__linux__)
@@ -23,9 +30,29 @@ namespace logtail {
 class EncodingConverterUnittest : public ::testing::Test {
 public:
     void ConvertGbk2Utf8();
+#if defined(__linux__)
+    void ConvertGbk2Utf8SameAsIconv();
+    void ConvertGbk2Utf8WithInvalidLine();
+
+private:
+    static std::string Convert(const std::string& gbk, const std::vector<long>& linePosVec) {
+        size_t srcLen = gbk.size();
+        size_t requireSize
+            = EncodingConverter::GetInstance()->ConvertGbk2Utf8(gbk.data(), &srcLen, nullptr, 0, linePosVec) + 1;
+        std::string res(requireSize, '\0');
+        size_t actualSize = EncodingConverter::GetInstance()->ConvertGbk2Utf8(
+            gbk.data(), &srcLen, res.data(), requireSize, linePosVec);
+        res.resize(actualSize);
+        return res;
+    }
+#endif
 };
 
 APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertGbk2Utf8, 0);
+#if defined(__linux__)
+APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertGbk2Utf8SameAsIconv, 0);
+APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertGbk2Utf8WithInvalidLine, 0);
+#endif
 
 void EncodingConverterUnittest::ConvertGbk2Utf8() {
     char gbkStr[] = "ilogtail\xbf\xc9\xb9\xdb\xb2\xe2\xd0\xd4\xb2\xc9\xbc\xaf\xc6\xf7";
@@ -41,6 +68,60 @@ void EncodingConverterUnittest::ConvertGbk2Utf8() {
     APSARA_TEST_STREQ("ilogtail可观测性采集器", destChar.get());
 }
 
+#if defined(__linux__)
+void EncodingConverterUnittest::ConvertGbk2Utf8SameAsIconv() {
+    iconv_t cd = iconv_open("UTF-8", "GBK");
+    APSARA_TEST_TRUE_FATAL(cd != (iconv_t)(-1));
+    // every valid double byte character, one per line, with ASCII long enough to go through the vectorized copy
+    std::string gbk;
+    std::string expected;
+    std::vector<long> linePosVec;
+    for (int lead = 0x81; lead <= 0xFE; ++lead) {
+        for (int trail = 0x40; trail <= 0xFE; ++trail) {
+            std::string line = "2025-01-01 00:00:00 [INFO] character ";
+            line += static_cast<char>(lead);
+            line += static_cast<char>(trail);
+            line += " end\n";
+            char buf[128];
+            char* in = line.data();
+            size_t inLeft = line.size();
+            char* out = buf;
+            size_t outLeft = sizeof(buf);
+            iconv(cd, NULL, NULL, NULL, NULL);
+            if (iconv(cd, &in, &inLeft, &out, &outLeft) == (size_t)(-1)) {
+                continue;
+            }
+            gbk += line;
+            expected.append(buf, out - buf);
+            linePosVec.push_back(gbk.size() - 1);
+        }
+    }
+    iconv_close(cd);
+    APSARA_TEST_GT(linePosVec.size(), 20000UL);
+    APSARA_TEST_EQUAL(expected, Convert(gbk, linePosVec));
+}
+
+void EncodingConverterUnittest::ConvertGbk2Utf8WithInvalidLine() {
+    // the second line ends with a truncated character, the third one has an invalid trail byte
+    std::string gbk = "first \xbf\xc9\xb9\xdb\n"
+                      "second \xb2\n"
+                      "third \xb2\x20\n"
+                      "\xb2\xe2\xd0\xd4 fourth line without line feed";
+    std::vector<long> linePosVec;
+    for (size_t i = 0; i < gbk.size(); ++i) {
+        if (gbk[i] == '\n') {
+            linePosVec.push_back(i);
+        }
+    }
+    linePosVec.push_back(gbk.size() - 1);
+    APSARA_TEST_EQUAL(std::string("first 可观\n"
+                                  "second \xb2\n"
+                                  "third \xb2\x20\n"
+                                  "测性 fourth line without line feed"),
+                      Convert(gbk, linePosVec));
+}
+#endif
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
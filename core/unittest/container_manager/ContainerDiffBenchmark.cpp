@@ -0,0 +1,128 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "container_manager/ContainerManager.h"
+#include "logger/Logger.h"
+
+namespace logtail {
+
+// simulates a node with many containers and configs, where a few containers change between two checks
+class ContainerDiffBenchmark {
+public:
+    ContainerDiffBenchmark(int containerNum, int configNum) : mConfigs(configNum) {
+        for (int i = 0; i < containerNum; ++i) {
+            updateContainer(i);
+        }
+        for (int i = 0; i < configNum; ++i) {
+            auto& config = mConfigs[i];
+            config.mFilters.mContainerLabelFilter.mIncludeFields.mFieldsMap["app"] = "app-" + std::to_string(i % 50);
+            config.mFilters.mEnvFilter.mExcludeFields.mFieldsRegMap["ENV"]
+                = std::make_shared<boost::regex>("^debug.*");
+        }
+    }
+
+    void Run(int rounds, int changesPerRound, bool incremental) {
+        std::srand(0);
+        uint64_t durationTime = 0;
+        size_t diffNum = 0;
+        for (int round = 0; round < rounds; ++round) {
+            for (int i = 0; i < changesPerRound; ++i) {
+                updateContainer(std::rand() % mContainerNum);
+            }
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            for (auto& config : mConfigs) {
+                ContainerDiff diff;
+                std::unordered_set<std::string> changedIDs;
+                if (incremental && mManager.getChangedContainerIDsSince(config.mLastSeq, changedIDs)) {
+                    mManager.computeChangedContainersDiff(
+                        config.mFullList, config.mMatchList, config.mFilters, false, changedIDs, diff);
+                } else {
+                    mManager.computeMatchedContainersDiff(
+                        config.mFullList, config.mMatchList, config.mFilters, false, diff);
+                }
+                config.mLastSeq = mManager.mContainerChangeSeq;
+                for (const auto& id : diff.mRemoved) {
+                    config.mMatchList.erase(id);
+                }
+                for (const auto& info : diff.mModified) {
+                    config.mMatchList[info->mID] = info;
+                }
+                for (const auto& info : diff.mAdded) {
+                    config.mMatchList[info->mID] = info;
+                }
+                diffNum += diff.mAdded.size() + diff.mModified.size() + diff.mRemoved.size();
+            }
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "per round: " << durationTime / rounds << " us" << std::endl;
+        std::cout << "diffs: " << diffNum << std::endl;
+    }
+
+private:
+    struct Config {
+        ContainerFilters mFilters;
+        std::set<std::string> mFullList;
+        std::unordered_map<std::string, std::shared_ptr<RawContainerInfo>> mMatchList;
+        uint64_t mLastSeq = 0;
+    };
+
+    void updateContainer(int idx) {
+        auto info = std::make_shared<RawContainerInfo>();
+        info->mID = "container-" + std::to_string(idx);
+        info->mStatus = "running";
+        info->mLogPath = "/var/lib/docker/containers/" + info->mID + "/" + std::to_string(std::rand());
+        info->mContainerLabels["app"] = "app-" + std::to_string(idx % 50);
+        info->mContainerLabels["io.kubernetes.pod.namespace"] = "default";
+        info->mEnv["ENV"] = idx % 7 == 0 ? "debug" : "production";
+        info->mEnv["PATH"] = "/usr/local/sbin:/usr/local/bin:/usr/sbin:/usr/bin:/sbin:/bin";
+        mManager.mContainerMap[info->mID] = info;
+        mManager.recordContainerChange(info->mID);
+        mContainerNum = std::max(mContainerNum, idx + 1);
+    }
+
+    ContainerManager mManager;
+    std::vector<Config> mConfigs;
+    int mContainerNum = 0;
+};
+
+} // namespace logtail
+
+using namespace logtail;
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (bool incremental : {false, true}) {
+        std::cout << (incremental ? "incremental diff" : "full diff") << std::endl;
+        ContainerDiffBenchmark benchmark(300, 500);
+        benchmark.Run(100, 5, incremental);
+    }
+    return 0;
+}
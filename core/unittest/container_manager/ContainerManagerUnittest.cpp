@@ -20,6 +20,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -42,6 +43,8 @@ public:
     void TestcomputeMatchedContainersDiff() const;
     void TestrefreshAllContainersSnapshot() const;
     void TestincrementallyUpdateContainersSnapshot() const;
+    void TestcomputeChangedContainersDiff() const;
+    void TestContainerChangeLog() const;
     void TestSaveLoadContainerInfo() const;
     void TestLoadContainerInfoFromDetailFormat() const;
     void TestLoadContainerInfoFromContainersFormat() const;
@@ -502,6 +505,111 @@ void ContainerManagerUnittest::TestincrementallyUpdateContainersSnapshot() const
     }
 }
 
+void ContainerManagerUnittest::TestcomputeChangedContainersDiff() const {
+    // incremental diff must produce exactly the same result as the full diff under random churn
+    ContainerManager containerManager;
+    ContainerFilters filters;
+    filters.mContainerLabelFilter.mIncludeFields.mFieldsMap["app"] = "nginx";
+
+    std::set<std::string> fullListA, fullListB;
+    std::unordered_map<std::string, std::shared_ptr<RawContainerInfo>> matchListA, matchListB;
+    auto applyDiff = [](const ContainerDiff& diff,
+                        std::unordered_map<std::string, std::shared_ptr<RawContainerInfo>>& matchList) {
+        for (const auto& id : diff.mRemoved) {
+            matchList.erase(id);
+        }
+        for (const auto& info : diff.mModified) {
+            matchList[info->mID] = info;
+        }
+        for (const auto& info : diff.mAdded) {
+            matchList[info->mID] = info;
+        }
+    };
+    auto sortedIDs = [](const std::vector<std::shared_ptr<RawContainerInfo>>& infos) {
+        std::vector<std::string> ids;
+        for (const auto& info : infos) {
+            ids.push_back(info->mID);
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    uint64_t seq = 0;
+    std::srand(0);
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 10; ++i) {
+            std::string id = "c" + std::to_string(std::rand() % 30);
+            switch (std::rand() % 3) {
+                case 0: {
+                    if (containerManager.mContainerMap.erase(id) > 0) {
+                        containerManager.recordContainerChange(id);
+                    }
+                    break;
+                }
+                default: {
+                    auto info = std::make_shared<RawContainerInfo>();
+                    info->mID = id;
+                    info->mStatus = std::rand() % 4 == 0 ? "exited" : "running";
+                    info->mLogPath = "/var/lib/docker/containers/" + id + "/" + std::to_string(std::rand() % 2);
+                    info->mContainerLabels["app"] = std::rand() % 2 == 0 ? "nginx" : "redis";
+                    containerManager.mContainerMap[id] = info;
+                    containerManager.recordContainerChange(id);
+                    break;
+                }
+            }
+        }
+
+        ContainerDiff fullDiff;
+        containerManager.computeMatchedContainersDiff(fullListA, matchListA, filters, false, fullDiff);
+
+        ContainerDiff changedDiff;
+        std::unordered_set<std::string> changedIDs;
+        if (seq == 0) {
+            EXPECT_FALSE(containerManager.getChangedContainerIDsSince(seq, changedIDs));
+            containerManager.computeMatchedContainersDiff(fullListB, matchListB, filters, false, changedDiff);
+        } else {
+            EXPECT_TRUE(containerManager.getChangedContainerIDsSince(seq, changedIDs));
+            containerManager.computeChangedContainersDiff(
+                fullListB, matchListB, filters, false, changedIDs, changedDiff);
+        }
+        seq = containerManager.mContainerChangeSeq;
+
+        std::vector<std::string> removedA = fullDiff.mRemoved, removedB = changedDiff.mRemoved;
+        std::sort(removedA.begin(), removedA.end());
+        std::sort(removedB.begin(), removedB.end());
+        EXPECT_EQ(removedA, removedB);
+        EXPECT_EQ(sortedIDs(fullDiff.mAdded), sortedIDs(changedDiff.mAdded));
+        EXPECT_EQ(sortedIDs(fullDiff.mModified), sortedIDs(changedDiff.mModified));
+        EXPECT_EQ(fullListA, fullListB);
+
+        applyDiff(fullDiff, matchListA);
+        applyDiff(changedDiff, matchListB);
+    }
+}
+
+void ContainerManagerUnittest::TestContainerChangeLog() const {
+    ContainerManager containerManager;
+    std::unordered_set<std::string> ids;
+    // never evaluated configs always need a full diff
+    EXPECT_FALSE(containerManager.getChangedContainerIDsSince(0, ids));
+
+    containerManager.recordContainerChange("a");
+    containerManager.recordContainerChange("b");
+    containerManager.recordContainerChange("a");
+    EXPECT_EQ(containerManager.mContainerChangeSeq, 3U);
+    EXPECT_TRUE(containerManager.getChangedContainerIDsSince(1, ids));
+    EXPECT_EQ(ids, std::unordered_set<std::string>({"a", "b"}));
+    ids.clear();
+    EXPECT_TRUE(containerManager.getChangedContainerIDsSince(3, ids));
+    EXPECT_TRUE(ids.empty());
+
+    // after the whole snapshot is replaced, configs evaluated before must fall back to the full diff
+    containerManager.resetContainerChangeLog();
+    EXPECT_FALSE(containerManager.getChangedContainerIDsSince(3, ids));
+    EXPECT_TRUE(containerManager.getChangedContainerIDsSince(containerManager.mContainerChangeSeq, ids));
+    EXPECT_TRUE(ids.empty());
+}
+
 void ContainerManagerUnittest::TestSaveLoadContainerInfo() const {
     ContainerManager containerManager;
 
@@ -1009,6 +1117,8 @@ void ContainerManagerUnittest::parseLabelFilters(const Json::Value& filtersJson,
 UNIT_TEST_CASE(ContainerManagerUnittest, TestcomputeMatchedContainersDiff)
 UNIT_TEST_CASE(ContainerManagerUnittest, TestrefreshAllContainersSnapshot)
 UNIT_TEST_CASE(ContainerManagerUnittest, TestincrementallyUpdateContainersSnapshot)
+UNIT_TEST_CASE(ContainerManagerUnittest, TestcomputeChangedContainersDiff)
+UNIT_TEST_CASE(ContainerManagerUnittest, TestContainerChangeLog)
 UNIT_TEST_CASE(ContainerManagerUnittest, TestSaveLoadContainerInfo)
 UNIT_TEST_CASE(ContainerManagerUnittest, TestLoadContainerInfoFromDetailFormat)
 UNIT_TEST_CASE(ContainerManagerUnittest, TestLoadContainerInfoFromContainersFormat)
@@ -0,0 +1,191 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ebpf/util/AggregateTree.h"
+#include "ebpf/util/FlatAggregateTree.h"
+#include "unittest/Unittest.h"
+
+// all allocations are counted, so that the memory cost of both trees can be compared
+static std::atomic_size_t sAllocCount{0};
+static std::atomic_size_t sAllocBytes{0};
+
+void* operator new(size_t size) {
+    sAllocCount.fetch_add(1, std::memory_order_relaxed);
+    sAllocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace logtail {
+namespace ebpf {
+
+namespace {
+
+// mimics L7Record and AppMetricData
+struct BenchRecord {
+    size_t mAppKey;
+    size_t mRpcKey;
+    int mStatusCode;
+    double mLatency;
+};
+
+struct BenchMetricData {
+    uint64_t mCount = 0;
+    uint64_t mErrCount = 0;
+    uint64_t m2xxCount = 0;
+    uint64_t m5xxCount = 0;
+    double mSum = 0;
+};
+
+void AggregateRecord(std::unique_ptr<BenchMetricData>& base, const BenchRecord* other) {
+    if (other->mStatusCode >= 500) {
+        base->m5xxCount++;
+        base->mErrCount++;
+    } else {
+        base->m2xxCount++;
+    }
+    base->mCount++;
+    base->mSum += other->mLatency;
+}
+
+struct BenchAggregateFunc {
+    void operator()(std::unique_ptr<BenchMetricData>& base, const BenchRecord* other) const {
+        AggregateRecord(base, other);
+    }
+};
+
+struct BenchBuildFunc {
+    std::unique_ptr<BenchMetricData> operator()(const BenchRecord*, std::shared_ptr<SourceBuffer>&) const {
+        return std::make_unique<BenchMetricData>();
+    }
+};
+
+constexpr size_t kAppCnt = 20;
+constexpr size_t kRpcCnt = 500;
+constexpr size_t kRecordCnt = 1000000;
+constexpr int kPeriodCnt = 5;
+
+} // namespace
+
+class AggTreeBenchmark : public testing::Test {
+public:
+    void TestAggTree();
+    void TestFlatAggTree();
+
+protected:
+    void SetUp() override {
+        // agg keys are hashes of attributes in the real world
+        std::hash<std::string> hasher;
+        std::vector<size_t> appKeys;
+        std::vector<size_t> rpcKeys;
+        for (size_t i = 0; i < kAppCnt; ++i) {
+            appKeys.push_back(hasher("app-" + std::to_string(i)));
+        }
+        for (size_t i = 0; i < kRpcCnt; ++i) {
+            rpcKeys.push_back(hasher("/api/v1/resource/" + std::to_string(i)));
+        }
+        std::mt19937_64 rng(42);
+        mRecords.reserve(kRecordCnt);
+        for (size_t i = 0; i < kRecordCnt; ++i) {
+            mRecords.push_back(BenchRecord{appKeys[rng() % kAppCnt],
+                                           rpcKeys[rng() % kRpcCnt],
+                                           rng() % 100 == 0 ? 500 : 200,
+                                           0.001 * (rng() % 1000)});
+        }
+    }
+
+    template <class Tree>
+    void RunPeriods(const std::string& name, Tree& tree);
+
+private:
+    std::vector<BenchRecord> mRecords;
+};
+
+template <class Tree>
+void AggTreeBenchmark::RunPeriods(const std::string& name, Tree& tree) {
+    std::chrono::duration<double> aggElapsed{0};
+    std::chrono::duration<double> exportElapsed{0};
+    size_t allocCount = sAllocCount.load();
+    size_t allocBytes = sAllocBytes.load();
+    uint64_t total = 0;
+    for (int period = 0; period < kPeriodCnt; ++period) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& record : mRecords) {
+            tree.Aggregate(&record, std::array<size_t, 2>{record.mAppKey, record.mRpcKey});
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        if constexpr (std::is_same_v<Tree, SIZETAggTreeWithSourceBuffer<BenchMetricData, const BenchRecord*>>) {
+            auto res = tree.GetAndReset();
+            for (auto* node : res.GetNodesWithAggDepth(1)) {
+                res.ForEach(node, [&](const BenchMetricData* data) { total += data->mCount; });
+            }
+        } else {
+            tree.ForEachGroup([&](auto& group) {
+                tree.ForEach(group, [&](const BenchMetricData* data) { total += data->mCount; });
+            });
+            tree.Reset();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        aggElapsed += mid - start;
+        exportElapsed += end - mid;
+    }
+    APSARA_TEST_EQUAL(kRecordCnt * kPeriodCnt, total);
+    std::cout << "[" << name << "] aggregate: " << aggElapsed.count() << " seconds, "
+              << static_cast<uint64_t>(kRecordCnt * kPeriodCnt / aggElapsed.count()) << " records/s" << std::endl;
+    std::cout << "[" << name << "] export and reset: " << exportElapsed.count() << " seconds" << std::endl;
+    std::cout << "[" << name << "] allocations: " << sAllocCount.load() - allocCount
+              << ", allocated bytes: " << sAllocBytes.load() - allocBytes << std::endl;
+}
+
+void AggTreeBenchmark::TestAggTree() {
+    SIZETAggTreeWithSourceBuffer<BenchMetricData, const BenchRecord*> tree(
+        kAppCnt * (kRpcCnt + 1), AggregateRecord, [](const BenchRecord* in, std::shared_ptr<SourceBuffer>&) {
+            return std::make_unique<BenchMetricData>();
+        });
+    RunPeriods("AggTree", tree);
+}
+
+void AggTreeBenchmark::TestFlatAggTree() {
+    FlatAggTree<BenchMetricData, const BenchRecord*, 2, BenchAggregateFunc, BenchBuildFunc, true> tree(
+        kAppCnt * (kRpcCnt + 1), BenchAggregateFunc(), BenchBuildFunc());
+    RunPeriods("FlatAggTree", tree);
+    std::cout << "[FlatAggTree] reserved bytes: " << tree.ReservedBytes() << std::endl;
+}
+
+UNIT_TEST_CASE(AggTreeBenchmark, TestAggTree)
+UNIT_TEST_CASE(AggTreeBenchmark, TestFlatAggTree)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
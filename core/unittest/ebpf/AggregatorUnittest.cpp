@@ -24,6 +24,7 @@
 #include "ebpf/type/FileEvent.h"
 #include "ebpf/type/NetworkEvent.h"
 #include "ebpf/util/AggregateTree.h"
+#include "ebpf/util/FlatAggregateTree.h"
 #include "logger/Logger.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
@@ -52,6 +53,8 @@ public:
     void TestGetAndReset();
     void TestAggManager();
     void TestAggregator();
+    void TestFlatAggTree();
+    void TestFlatAggTreeMaxNodes();
 
 protected:
     void SetUp() override {
@@ -212,6 +215,95 @@ void AggregatorUnittest::TestAggregator() {
     this->mAggregateTree->Reset();
 }
 
+struct FlatHTAggregateFunc {
+    void operator()(std::unique_ptr<HT>& base, const std::vector<std::string>& other) const {
+        base->tt[base->val] = other.back();
+        base->val++;
+    }
+};
+
+struct FlatHTBuildFunc {
+    std::unique_ptr<HT> operator()(const std::vector<std::string>& in,
+                                   std::shared_ptr<SourceBuffer>& sourceBuffer) const {
+        APSARA_TEST_TRUE(sourceBuffer != nullptr);
+        return std::make_unique<HT>(0);
+    }
+};
+
+using FlatHTAggTree = FlatAggTree<HT, std::vector<std::string>, 2, FlatHTAggregateFunc, FlatHTBuildFunc, true>;
+
+static std::array<size_t, 2> GetFlatAggKey(const std::vector<std::string>& data) {
+    std::hash<std::string> hasher;
+    return {hasher(data[0]), hasher(data[1])};
+}
+
+void AggregatorUnittest::TestFlatAggTree() {
+    FlatHTAggTree tree(1024, FlatHTAggregateFunc(), FlatHTBuildFunc());
+    for (int round = 0; round < 2; ++round) {
+        // enough keys to trigger rehashing
+        for (int i = 0; i < 100; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                std::vector<std::string> data = {"app" + std::to_string(j), "rpc" + std::to_string(i), "x"};
+                APSARA_TEST_TRUE(tree.Aggregate(data, GetFlatAggKey(data)));
+            }
+        }
+        std::vector<std::string> data = {"app0", "rpc0", "y"};
+        APSARA_TEST_TRUE(tree.Aggregate(data, GetFlatAggKey(data)));
+        APSARA_TEST_EQUAL(303UL, tree.NodeCount());
+        APSARA_TEST_EQUAL(3UL, tree.GroupCount());
+        APSARA_TEST_EQUAL(301UL, tree.EventCount());
+
+        std::vector<size_t> groupKeys;
+        tree.ForEachGroup([&](auto& group) {
+            groupKeys.push_back(group.mKey);
+            APSARA_TEST_TRUE(group.mSourceBuffer != nullptr);
+            int leafCnt = 0;
+            int sum = 0;
+            tree.ForEach(group, [&](const HT* ht) {
+                leafCnt++;
+                sum += ht->val;
+            });
+            APSARA_TEST_EQUAL(100, leafCnt);
+            APSARA_TEST_EQUAL(group.mKey == std::hash<std::string>{}("app0") ? 101 : 100, sum);
+        });
+        // groups are exported in the order of their first appearance
+        APSARA_TEST_EQUAL(3UL, groupKeys.size());
+        for (size_t j = 0; j < groupKeys.size(); ++j) {
+            APSARA_TEST_EQUAL(std::hash<std::string>{}("app" + std::to_string(j)), groupKeys[j]);
+        }
+
+        auto reserved = tree.ReservedBytes();
+        tree.Reset();
+        APSARA_TEST_EQUAL(0UL, tree.NodeCount());
+        APSARA_TEST_EQUAL(0UL, tree.EventCount());
+        int dataCnt = 0;
+        tree.ForEach([&](const HT*) { dataCnt++; });
+        APSARA_TEST_EQUAL(0, dataCnt);
+        // memory of nodes is kept for the next period
+        APSARA_TEST_EQUAL(reserved, tree.ReservedBytes());
+    }
+}
+
+void AggregatorUnittest::TestFlatAggTreeMaxNodes() {
+    FlatHTAggTree tree(5, FlatHTAggregateFunc(), FlatHTBuildFunc());
+    std::vector<std::string> data = {"app0", "rpc0"};
+    APSARA_TEST_TRUE(tree.Aggregate(data, GetFlatAggKey(data)));
+    data = {"app0", "rpc1"};
+    APSARA_TEST_TRUE(tree.Aggregate(data, GetFlatAggKey(data)));
+    data = {"app1", "rpc0"};
+    APSARA_TEST_TRUE(tree.Aggregate(data, GetFlatAggKey(data)));
+    APSARA_TEST_EQUAL(5UL, tree.NodeCount());
+    // new leaves are dropped, while existing ones can still be aggregated
+    data = {"app1", "rpc1"};
+    APSARA_TEST_FALSE(tree.Aggregate(data, GetFlatAggKey(data)));
+    data = {"app2", "rpc0"};
+    APSARA_TEST_FALSE(tree.Aggregate(data, GetFlatAggKey(data)));
+    data = {"app0", "rpc1"};
+    APSARA_TEST_TRUE(tree.Aggregate(data, GetFlatAggKey(data)));
+    APSARA_TEST_EQUAL(5UL, tree.NodeCount());
+    APSARA_TEST_EQUAL(4UL, tree.EventCount());
+}
+
 void AggregatorUnittest::TestBasicAgg() {
     Aggregate({"a", "b", "c", "d"}, 4);
     Aggregate({"a", "b", "c", "d", "e"}, 4);
@@ -249,6 +341,8 @@ void AggregatorUnittest::TestGetAndReset() {
 UNIT_TEST_CASE(AggregatorUnittest, TestBasicAgg);
 UNIT_TEST_CASE(AggregatorUnittest, TestGetAndReset);
 UNIT_TEST_CASE(AggregatorUnittest, TestAggregator);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAggTree);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAggTreeMaxNodes);
 
 
 } // namespace ebpf
@@ -0,0 +1,164 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ebpf/plugin/network_observer/ConnectionManager.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+namespace ebpf {
+
+namespace {
+
+constexpr int kConnectionCnt = 200000;
+constexpr int kEventCnt = 4000000;
+// events consumed by one poll, after which Iterations is called
+constexpr int kPollBatchSize = 1024;
+// simulated time of one poll
+constexpr int64_t kPollIntervalMs = 10;
+
+enum class EventType { CTRL_CONNECT, CTRL_CLOSE, DATA, STATS };
+
+struct SyntheticEvent {
+    EventType mType;
+    int mConnIdx;
+};
+
+} // namespace
+
+class ConnectionManagerBenchmark : public testing::Test {
+public:
+    void TestEventReplay();
+    void TestFullSweep();
+
+protected:
+    void SetUp() override {
+        // most events are data and stats events of long-lived connections, and a few connections are replaced
+        std::mt19937 rng(42);
+        mEvents.reserve(kEventCnt);
+        for (int i = 0; i < kEventCnt; ++i) {
+            int connIdx = rng() % kConnectionCnt;
+            int r = rng() % 100;
+            EventType type = r < 60 ? EventType::DATA
+                : r < 95            ? EventType::STATS
+                : r < 98            ? EventType::CTRL_CONNECT
+                                    : EventType::CTRL_CLOSE;
+            mEvents.push_back({type, connIdx});
+        }
+    }
+
+    static void FillConnId(struct connect_id_t& connId, int connIdx, uint64_t generation) {
+        connId.fd = connIdx % 1024;
+        connId.tgid = 1000 + connIdx / 1024;
+        connId.start = 1000000000ULL + generation;
+    }
+
+    std::vector<SyntheticEvent> mEvents;
+};
+
+void ConnectionManagerBenchmark::TestEventReplay() {
+    auto manager = ConnectionManager::Create(kConnectionCnt * 2);
+    // closed connections are replaced by new ones with a new start time
+    std::vector<uint64_t> generations(kConnectionCnt, 0);
+    std::vector<double> iterationCosts;
+
+    struct conn_ctrl_event_t ctrlEvent = {};
+    struct conn_data_event_t dataEvent = {};
+    struct conn_stats_event_t statsEvent = {};
+    dataEvent.protocol = support_proto_e::ProtoHTTP;
+    dataEvent.role = support_role_e::IsServer;
+    statsEvent.si.family = AF_INET;
+    statsEvent.si.ap.saddr = 0x0100007F;
+    statsEvent.si.ap.daddr = 0x0101A8C0;
+
+    int64_t nowMs = 1;
+    std::chrono::duration<double> eventElapsed{0};
+    std::chrono::duration<double> iterationElapsed{0};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < mEvents.size(); ++i) {
+        const auto& event = mEvents[i];
+        auto generation = generations[event.mConnIdx];
+        switch (event.mType) {
+            case EventType::CTRL_CONNECT:
+            case EventType::CTRL_CLOSE:
+                FillConnId(ctrlEvent.conn_id, event.mConnIdx, generation);
+                ctrlEvent.type = event.mType == EventType::CTRL_CLOSE ? EventClose : EventConnect;
+                ctrlEvent.ts = nowMs;
+                manager->AcceptNetCtrlEvent(&ctrlEvent);
+                if (event.mType == EventType::CTRL_CLOSE) {
+                    generations[event.mConnIdx]++;
+                }
+                break;
+            case EventType::DATA:
+                FillConnId(dataEvent.conn_id, event.mConnIdx, generation);
+                manager->AcceptNetDataEvent(&dataEvent);
+                break;
+            case EventType::STATS:
+                FillConnId(statsEvent.conn_id, event.mConnIdx, generation);
+                statsEvent.ts = nowMs;
+                manager->AcceptNetStatsEvent(&statsEvent);
+                break;
+        }
+        if ((i + 1) % kPollBatchSize == 0) {
+            auto mid = std::chrono::high_resolution_clock::now();
+            eventElapsed += mid - start;
+            nowMs += kPollIntervalMs;
+            manager->cleanClosedConnections();
+            manager->advanceTimingWheel(nowMs);
+            start = std::chrono::high_resolution_clock::now();
+            iterationElapsed += start - mid;
+            iterationCosts.push_back(std::chrono::duration<double, std::micro>(start - mid).count());
+        }
+    }
+    std::sort(iterationCosts.begin(), iterationCosts.end());
+    std::cout << "[event replay] events: " << mEvents.size() << ", connections: " << manager->ConnectionTotal()
+              << ", elapsed: " << eventElapsed.count() << " seconds, "
+              << static_cast<uint64_t>(mEvents.size() / eventElapsed.count()) << " events/s" << std::endl;
+    std::cout << "[event replay] iterations: " << iterationCosts.size() << ", total " << iterationElapsed.count()
+              << " seconds, p50 " << iterationCosts[iterationCosts.size() / 2] << " us, p99 "
+              << iterationCosts[iterationCosts.size() * 99 / 100] << " us, max " << iterationCosts.back() << " us"
+              << std::endl;
+    APSARA_TEST_TRUE(manager->ConnectionTotal() > 0);
+}
+
+void ConnectionManagerBenchmark::TestFullSweep() {
+    // visiting all connections at once, which is what happened every gc interval before the timing wheel
+    auto manager = ConnectionManager::Create(kConnectionCnt * 2);
+    for (int i = 0; i < kConnectionCnt; ++i) {
+        struct connect_id_t connId = {};
+        FillConnId(connId, i, 0);
+        manager->getOrCreateConnection(ConnId(connId));
+    }
+    int64_t nowMs = 1;
+    manager->advanceTimingWheel(nowMs);
+    auto start = std::chrono::high_resolution_clock::now();
+    manager->advanceTimingWheel(nowMs + manager->mGcIntervalMs);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "[full sweep] connections: " << manager->ConnectionTotal() << ", elapsed: "
+              << std::chrono::duration<double, std::micro>(end - start).count() << " us" << std::endl;
+    APSARA_TEST_EQUAL(kConnectionCnt, manager->ConnectionTotal());
+}
+
+UNIT_TEST_CASE(ConnectionManagerBenchmark, TestEventReplay)
+UNIT_TEST_CASE(ConnectionManagerBenchmark, TestFullSweep)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -35,6 +35,8 @@ public:
     void TestProtocolDetection();
     void TestResourceManagement();
     void TestErrorHandling();
+    void TestTimingWheel();
+    void TestMaxConnections();
 
 protected:
     void SetUp() override {}
@@ -238,9 +240,71 @@ void ConnectionManagerUnittest::TestErrorHandling() {
     ValidateTracker(nullTracker, false);
 
     auto connId = CreateTestConnId();
+    manager->getOrCreateConnection(connId);
     manager->deleteConnection(connId);
     // re-delete
     manager->deleteConnection(connId);
+    APSARA_TEST_EQUAL(0, manager->ConnectionTotal());
+}
+
+void ConnectionManagerUnittest::TestTimingWheel() {
+    auto manager = CreateManager();
+    // one slot per 10ms
+    manager->mGcIntervalMs = 500;
+    int64_t nowMs = 1000;
+    manager->advanceTimingWheel(nowMs);
+
+    std::vector<ConnId> connIds;
+    const int connectionCount = 100;
+    for (int i = 0; i < connectionCount; ++i) {
+        connIds.push_back(CreateTestConnId(i));
+        auto tracker = manager->getOrCreateConnection(connIds.back());
+        if (i < connectionCount / 2) {
+            tracker->mIsClose = true;
+            tracker->mEpoch = -1;
+        }
+    }
+
+    // new connections are visited after a whole gc interval
+    manager->advanceTimingWheel(nowMs + 490);
+    APSARA_TEST_EQUAL(connectionCount, manager->ConnectionTotal());
+    manager->advanceTimingWheel(nowMs + 500);
+    APSARA_TEST_EQUAL(connectionCount / 2, manager->ConnectionTotal());
+    for (int i = 0; i < connectionCount; ++i) {
+        ValidateTracker(manager->getConnection(connIds[i]), i >= connectionCount / 2);
+    }
+
+    // the entry of a deleted connection is skipped, even if the id is reused by a connection allocated at the same
+    // address
+    uint64_t oldGeneration = manager->getConnection(connIds.back())->GetGeneration();
+    manager->deleteConnection(connIds.back());
+    auto newTracker = manager->getOrCreateConnection(connIds.back());
+    APSARA_TEST_NOT_EQUAL(oldGeneration, newTracker->GetGeneration());
+    size_t entryCount = 0;
+    for (const auto& slot : manager->mTimingWheel) {
+        entryCount += slot.size();
+    }
+    APSARA_TEST_EQUAL(static_cast<size_t>(connectionCount / 2 + 1), entryCount);
+
+    manager->advanceTimingWheel(nowMs + 1000);
+    entryCount = 0;
+    for (const auto& slot : manager->mTimingWheel) {
+        entryCount += slot.size();
+    }
+    APSARA_TEST_EQUAL(static_cast<size_t>(connectionCount / 2), entryCount);
+    APSARA_TEST_EQUAL(newTracker, manager->getConnection(connIds.back()));
+    // visited once per round
+    APSARA_TEST_EQUAL(kConnectionEpoch - 1, newTracker->GetEpoch());
+    APSARA_TEST_EQUAL(connectionCount / 2, manager->ConnectionTotal());
+}
+
+void ConnectionManagerUnittest::TestMaxConnections() {
+    auto manager = ConnectionManager::Create(1);
+    auto tracker = manager->getOrCreateConnection(CreateTestConnId(1));
+    ValidateTracker(tracker, true);
+    ValidateTracker(manager->getOrCreateConnection(CreateTestConnId(2)), false);
+    // existing connections are still available when the limit is reached
+    APSARA_TEST_EQUAL(tracker, manager->getOrCreateConnection(CreateTestConnId(1)));
 }
 
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestBasicOperations);
@@ -250,6 +314,8 @@ UNIT_TEST_CASE(ConnectionManagerUnittest, TestMetadataHandling);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestProtocolDetection);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestResourceManagement);
 UNIT_TEST_CASE(ConnectionManagerUnittest, TestErrorHandling);
+UNIT_TEST_CASE(ConnectionManagerUnittest, TestTimingWheel);
+UNIT_TEST_CASE(ConnectionManagerUnittest, TestMaxConnections);
 
 } // namespace ebpf
 } // namespace logtail
@@ -0,0 +1,190 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ebpf/util/DDSketch.h"
+#include "unittest/Unittest.h"
+
+namespace logtail::ebpf {
+
+class DDSketchUnittest : public ::testing::Test {
+public:
+    void TestEmpty();
+    void TestAccuracy();
+    void TestZeroValues();
+    void TestMerge();
+    void TestMaxBins();
+    void TestCountNoLargerThan();
+    void TestMergeCost();
+
+protected:
+    void SetUp() override {
+        // latencies in nanoseconds, with a median of 5ms and a long tail
+        std::mt19937_64 rng(42);
+        std::lognormal_distribution<double> dist(std::log(5e6), 1.5);
+        mValues.resize(100000);
+        for (auto& v : mValues) {
+            v = dist(rng);
+        }
+        mSortedValues = mValues;
+        std::sort(mSortedValues.begin(), mSortedValues.end());
+    }
+
+    double ExactQuantile(double q) const { return mSortedValues[static_cast<size_t>(q * (mSortedValues.size() - 1))]; }
+
+    std::vector<double> mValues;
+    std::vector<double> mSortedValues;
+};
+
+void DDSketchUnittest::TestEmpty() {
+    DDSketch sketch;
+    APSARA_TEST_TRUE(sketch.Empty());
+    APSARA_TEST_TRUE(std::isnan(sketch.Quantile(0.5)));
+    APSARA_TEST_EQUAL(0UL, sketch.CountNoLargerThan(1.0));
+
+    sketch.Add(100);
+    APSARA_TEST_FALSE(sketch.Empty());
+    sketch.Clear();
+    APSARA_TEST_TRUE(sketch.Empty());
+    APSARA_TEST_EQUAL(0UL, sketch.BinCount());
+}
+
+void DDSketchUnittest::TestAccuracy() {
+    DDSketch sketch;
+    for (auto v : mValues) {
+        sketch.Add(v);
+    }
+    APSARA_TEST_EQUAL(mValues.size(), sketch.Count());
+    APSARA_TEST_EQUAL(mSortedValues.front(), sketch.Min());
+    APSARA_TEST_EQUAL(mSortedValues.back(), sketch.Max());
+    for (double q : {0.0, 0.01, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 1.0}) {
+        double exact = ExactQuantile(q);
+        double estimated = sketch.Quantile(q);
+        APSARA_TEST_TRUE_DESC(std::abs(estimated - exact) <= exact * sketch.RelativeAccuracy(),
+                              "q: " + std::to_string(q) + ", exact: " + std::to_string(exact)
+                                  + ", estimated: " + std::to_string(estimated));
+    }
+    APSARA_TEST_TRUE(sketch.BinCount() <= DDSketch::kDefaultMaxBins);
+}
+
+void DDSketchUnittest::TestZeroValues() {
+    DDSketch sketch;
+    sketch.Add(0, 2);
+    sketch.Add(1000);
+    APSARA_TEST_EQUAL(3UL, sketch.Count());
+    APSARA_TEST_EQUAL(0.0, sketch.Quantile(0));
+    APSARA_TEST_EQUAL(0.0, sketch.Quantile(0.5));
+    APSARA_TEST_EQUAL(1000.0, sketch.Quantile(1));
+    APSARA_TEST_EQUAL(2UL, sketch.CountNoLargerThan(1));
+}
+
+void DDSketchUnittest::TestMerge() {
+    DDSketch whole;
+    std::vector<DDSketch> parts(8);
+    for (size_t i = 0; i < mValues.size(); ++i) {
+        whole.Add(mValues[i]);
+        parts[i % parts.size()].Add(mValues[i]);
+    }
+    DDSketch merged;
+    for (const auto& part : parts) {
+        APSARA_TEST_TRUE(merged.Merge(part));
+    }
+    APSARA_TEST_EQUAL(whole.Count(), merged.Count());
+    APSARA_TEST_EQUAL(whole.Min(), merged.Min());
+    APSARA_TEST_EQUAL(whole.Max(), merged.Max());
+    for (double q : {0.0, 0.5, 0.9, 0.99, 1.0}) {
+        APSARA_TEST_EQUAL(whole.Quantile(q), merged.Quantile(q));
+    }
+
+    DDSketch other(0.05);
+    other.Add(1);
+    APSARA_TEST_FALSE(merged.Merge(other));
+    APSARA_TEST_EQUAL(whole.Count(), merged.Count());
+}
+
+void DDSketchUnittest::TestMaxBins() {
+    const size_t maxBins = 64;
+    DDSketch sketch(DDSketch::kDefaultRelativeAccuracy, maxBins);
+    DDSketch merged(DDSketch::kDefaultRelativeAccuracy, maxBins);
+    for (auto v : mValues) {
+        sketch.Add(v);
+        DDSketch single(DDSketch::kDefaultRelativeAccuracy, maxBins);
+        single.Add(v);
+        merged.Merge(single);
+    }
+    APSARA_TEST_EQUAL(maxBins, sketch.BinCount());
+    APSARA_TEST_EQUAL(maxBins, merged.BinCount());
+    APSARA_TEST_EQUAL(mValues.size(), sketch.Count());
+    // lowest bins are collapsed, so that the highest quantiles are still accurate
+    double exact = ExactQuantile(0.999);
+    APSARA_TEST_TRUE(std::abs(sketch.Quantile(0.999) - exact) <= exact * sketch.RelativeAccuracy());
+    APSARA_TEST_TRUE(std::abs(merged.Quantile(0.999) - exact) <= exact * merged.RelativeAccuracy());
+    APSARA_TEST_EQUAL(sketch.Max(), sketch.Quantile(1));
+}
+
+void DDSketchUnittest::TestCountNoLargerThan() {
+    DDSketch sketch;
+    for (auto v : mValues) {
+        sketch.Add(v);
+    }
+    for (double bound : {1e6, 5e6, 1e7, 1e8}) {
+        // values within the relative accuracy of the bound may be counted on either side
+        size_t lower = std::upper_bound(mSortedValues.begin(), mSortedValues.end(), bound / 1.05)
+            - mSortedValues.begin();
+        size_t upper = std::upper_bound(mSortedValues.begin(), mSortedValues.end(), bound * 1.05)
+            - mSortedValues.begin();
+        auto count = sketch.CountNoLargerThan(bound);
+        APSARA_TEST_TRUE(count >= lower && count <= upper);
+    }
+    APSARA_TEST_EQUAL(sketch.Count(), sketch.CountNoLargerThan(sketch.Max()));
+    APSARA_TEST_EQUAL(0UL, sketch.CountNoLargerThan(sketch.Min() / 2));
+}
+
+void DDSketchUnittest::TestMergeCost() {
+    DDSketch sketch;
+    for (auto v : mValues) {
+        sketch.Add(v);
+    }
+    const int mergeTimes = 10000;
+    DDSketch merged;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < mergeTimes; ++i) {
+        merged.Merge(sketch);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / mergeTimes;
+    std::cout << "bins: " << sketch.BinCount() << ", merge cost: " << cost << " ns" << std::endl;
+    APSARA_TEST_EQUAL(sketch.Count() * mergeTimes, merged.Count());
+    // merging is a linear pass over at most kDefaultMaxBins counters
+    APSARA_TEST_TRUE(cost < 100000);
+}
+
+UNIT_TEST_CASE(DDSketchUnittest, TestEmpty)
+UNIT_TEST_CASE(DDSketchUnittest, TestAccuracy)
+UNIT_TEST_CASE(DDSketchUnittest, TestZeroValues)
+UNIT_TEST_CASE(DDSketchUnittest, TestMerge)
+UNIT_TEST_CASE(DDSketchUnittest, TestMaxBins)
+UNIT_TEST_CASE(DDSketchUnittest, TestCountNoLargerThan)
+UNIT_TEST_CASE(DDSketchUnittest, TestMergeCost)
+
+} // namespace logtail::ebpf
+
+UNIT_TEST_MAIN
@@ -0,0 +1,192 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "ebpf/protocol/http/HttpParser.h"
+#include "unittest/Unittest.h"
+
+// all allocations are counted, so that the allocation cost per data event can be compared
+static std::atomic_size_t sAllocCount{0};
+
+void* operator new(size_t size) {
+    sAllocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace logtail {
+namespace ebpf {
+
+namespace {
+
+// request and response byte streams captured from a typical web service
+const std::vector<std::pair<std::string, std::string>> kStreams = {
+    {"GET /api/v1/users/1024?fields=name,email HTTP/1.1\r\n"
+     "Host: user-service.default.svc.cluster.local:8080\r\n"
+     "User-Agent: Go-http-client/1.1\r\n"
+     "Accept: application/json\r\n"
+     "Accept-Encoding: gzip\r\n"
+     "X-Request-Id: 5f0c6a3e-8c1b-4a8e-9f3a-2d1b8c7e6f5a\r\n"
+     "Traceparent: 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01\r\n"
+     "\r\n",
+     "HTTP/1.1 200 OK\r\n"
+     "Content-Type: application/json; charset=utf-8\r\n"
+     "Date: Mon, 12 May 2025 08:00:00 GMT\r\n"
+     "Content-Length: 51\r\n"
+     "\r\n"
+     "{\"id\":1024,\"name\":\"alice\",\"email\":\"a@example.com\"}\n"},
+    {"POST /api/v1/orders HTTP/1.1\r\n"
+     "Host: order-service.default.svc.cluster.local:8080\r\n"
+     "User-Agent: okhttp/4.9.3\r\n"
+     "Content-Type: application/json\r\n"
+     "Content-Length: 43\r\n"
+     "Cookie: session=abc123; user=john\r\n"
+     "\r\n"
+     "{\"item\":\"book\",\"count\":2,\"price\":\"12.50\"}\r\n",
+     "HTTP/1.1 201 Created\r\n"
+     "Content-Type: application/json\r\n"
+     "Location: /api/v1/orders/42\r\n"
+     "Content-Length: 9\r\n"
+     "\r\n"
+     "{\"id\":42}"},
+    {"GET /static/app.js HTTP/1.1\r\n"
+     "Host: www.example.com\r\n"
+     "Accept: */*\r\n"
+     "Connection: keep-alive\r\n"
+     "\r\n",
+     "HTTP/1.1 200 OK\r\n"
+     "Content-Type: application/javascript\r\n"
+     "Transfer-Encoding: chunked\r\n"
+     "\r\n"
+     "1a\r\n"
+     "console.log('hello world')\r\n"
+     "0\r\n"
+     "\r\n"},
+};
+
+constexpr int kRoundCnt = 300000;
+
+} // namespace
+
+class HttpParserBenchmark : public testing::Test {
+public:
+    void TestMakeSharedWithAllHeaders();
+    void TestPooledWithSelectedHeaders();
+    void TestProtocolParser();
+
+protected:
+    void SetUp() override {
+        ObserverNetworkOption options;
+        options.mL7Config.mSampleRate = 1.0;
+        mAppDetail = std::make_shared<AppDetail>(&options);
+        mConnection = std::make_shared<Connection>(ConnId(1, 1, 1));
+        for (const auto& [req, resp] : kStreams) {
+            auto& event = mEvents.emplace_back();
+            std::memset(&event, 0, sizeof(event));
+            event.protocol = support_proto_e::ProtoHTTP;
+            event.start_ts = 1000000;
+            event.end_ts = 2000000;
+            event.request_len = req.size();
+            event.response_len = resp.size();
+            std::memcpy(event.msg, req.data(), req.size());
+            std::memcpy(event.msg + req.size(), resp.data(), resp.size());
+        }
+    }
+
+    template <class Func>
+    void Run(const std::string& name, Func&& parse);
+
+    std::shared_ptr<AppDetail> mAppDetail;
+    std::shared_ptr<Connection> mConnection;
+    std::vector<conn_data_event_t> mEvents;
+};
+
+template <class Func>
+void HttpParserBenchmark::Run(const std::string& name, Func&& parse) {
+    // warm up
+    for (auto& event : mEvents) {
+        parse(event);
+    }
+    size_t allocCount = sAllocCount.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kRoundCnt; ++i) {
+        for (auto& event : mEvents) {
+            APSARA_TEST_TRUE(parse(event));
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    size_t eventCnt = kRoundCnt * mEvents.size();
+    std::cout << "[" << name << "] elapsed: " << elapsed.count() << " seconds, "
+              << static_cast<uint64_t>(eventCnt / elapsed.count()) << " events/s, "
+              << static_cast<double>(sAllocCount.load() - allocCount) / eventCnt << " allocations/event" << std::endl;
+}
+
+void HttpParserBenchmark::TestMakeSharedWithAllHeaders() {
+    Run("make_shared, all headers", [&](conn_data_event_t& event) {
+        auto record = std::make_shared<HttpRecord>(mConnection, mAppDetail);
+        std::string_view resp(event.msg + event.request_len, event.response_len);
+        std::string_view req(event.msg, event.request_len);
+        return http::ParseResponse(resp, record, true, true) == ParseState::kSuccess
+            && http::ParseRequest(req, record, true) == ParseState::kSuccess;
+    });
+}
+
+void HttpParserBenchmark::TestPooledWithSelectedHeaders() {
+    std::vector<std::string> selectedHeaders = {"Content-Type"};
+    Run("pooled, selected headers", [&](conn_data_event_t& event) {
+        auto record = HTTPProtocolParser::GetRecordPool().Acquire();
+        record->SetConnection(mConnection);
+        record->SetAppDetail(mAppDetail);
+        std::string_view resp(event.msg + event.request_len, event.response_len);
+        std::string_view req(event.msg, event.request_len);
+        return http::ParseResponse(resp, record, true, true, &selectedHeaders) == ParseState::kSuccess
+            && http::ParseRequest(req, record, true, &selectedHeaders) == ParseState::kSuccess;
+    });
+}
+
+void HttpParserBenchmark::TestProtocolParser() {
+    HTTPProtocolParser parser;
+    Run("HTTPProtocolParser", [&](conn_data_event_t& event) {
+        return parser.Parse(&event, mConnection, mAppDetail, nullptr).size() == 1;
+    });
+}
+
+UNIT_TEST_CASE(HttpParserBenchmark, TestMakeSharedWithAllHeaders)
+UNIT_TEST_CASE(HttpParserBenchmark, TestPooledWithSelectedHeaders)
+UNIT_TEST_CASE(HttpParserBenchmark, TestProtocolParser)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -36,6 +36,8 @@ public:
     void TestParsePartialRequests();
     void TestProtocolParserManager();
     void TestHttpParserEdgeCases();
+    void TestParseHttpSelectedHeaders();
+    void TestHttpRecordPool();
 
     void RequestBenchmark();
     void RequestWithoutBodyBenchmark();
@@ -249,6 +251,73 @@ void ProtocolParserUnittest::TestHttpParserEdgeCases() {
     APSARA_TEST_EQUAL(state, ParseState::kInvalid);
 }
 
+void ProtocolParserUnittest::TestParseHttpSelectedHeaders() {
+    const std::string request = "POST /test HTTP/1.1\r\n"
+                                "Host: example.com\r\n"
+                                "Content-Type: application/json\r\n"
+                                "Content-Length: 4\r\n"
+                                "\r\n"
+                                "body";
+    std::vector<std::string> selectedHeaders = {"content-type"};
+    std::string_view buf(request);
+    std::shared_ptr<HttpRecord> result = std::make_shared<HttpRecord>(nullptr, nullptr);
+    ParseState state = http::ParseRequest(buf, result, true, &selectedHeaders);
+    APSARA_TEST_EQUAL(state, ParseState::kSuccess);
+    APSARA_TEST_EQUAL(result->GetReqHeaderMap().size(), 1UL);
+    APSARA_TEST_EQUAL(result->GetReqHeaderMap().begin()->second, "application/json");
+    // body is still parsed by Content-Length, though the header is not copied
+    APSARA_TEST_EQUAL(result->GetReqBody(), "body");
+    APSARA_TEST_EQUAL(result->GetReqBodySize(), 4UL);
+
+    const std::string response = "HTTP/1.1 200 OK\r\n"
+                                 "Transfer-Encoding: chunked\r\n"
+                                 "\r\n"
+                                 "5\r\n"
+                                 "Hello\r\n"
+                                 "0\r\n"
+                                 "\r\n";
+    std::vector<std::string> noHeaders;
+    std::string_view buf2(response);
+    state = http::ParseResponse(buf2, result, false, true, &noHeaders);
+    APSARA_TEST_EQUAL(state, ParseState::kSuccess);
+    APSARA_TEST_TRUE(result->GetRespHeaderMap().empty());
+    APSARA_TEST_EQUAL(result->GetRespBody(), "Hello");
+}
+
+void ProtocolParserUnittest::TestHttpRecordPool() {
+    RecordPool<HttpRecord> pool;
+    auto conn = std::make_shared<Connection>(ConnId(1, 2, 3));
+    HttpRecord* raw = nullptr;
+    {
+        auto record = pool.Acquire();
+        raw = record.get();
+        record->SetConnection(conn);
+        record->MarkSample();
+        record->SetStatusCode(500);
+        record->SetPath("/api");
+        std::shared_ptr<L7Record> base = record;
+        APSARA_TEST_EQUAL(conn.use_count(), 2L);
+    }
+    // the record is reset on release, and the connection is not held by the pool
+    APSARA_TEST_EQUAL(pool.CachedCount(), 1UL);
+    APSARA_TEST_EQUAL(conn.use_count(), 1L);
+
+    auto record = pool.Acquire();
+    APSARA_TEST_EQUAL(record.get(), raw);
+    APSARA_TEST_EQUAL(pool.CachedCount(), 0UL);
+    APSARA_TEST_TRUE(record->GetConnection() == nullptr);
+    APSARA_TEST_FALSE(record->ShouldSample());
+    APSARA_TEST_EQUAL(record->GetStatusCode(), 0);
+    APSARA_TEST_TRUE(record->GetPath().empty());
+
+    RecordPool<HttpRecord> smallPool(1);
+    {
+        auto r1 = smallPool.Acquire();
+        auto r2 = smallPool.Acquire();
+    }
+    APSARA_TEST_EQUAL(smallPool.CachedCount(), 1UL);
+}
+
 const std::string REQ
     = "GET /wp-content/uploads/2010/03/hello-kitty-darth-vader-pink.jpg HTTP/1.1\r\n"
       "Host: www.kittyhell.com\r\n"
@@ -352,6 +421,8 @@ UNIT_TEST_CASE(ProtocolParserUnittest, TestParseInvalidRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestParsePartialRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestProtocolParserManager);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestHttpParserEdgeCases);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestParseHttpSelectedHeaders);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestHttpRecordPool);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestWithoutBodyBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, ResponseBenchmark);
@@ -0,0 +1,162 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/Flags.h"
+#include "file_server/EventDispatcher.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_listener/EventListener.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(fs_events_fanotify_enable);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr size_t kDirCnt = 10000;
+constexpr size_t kWriteCnt = 1000;
+constexpr size_t kRoundCnt = 10;
+
+double GetCpuSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+} // namespace
+
+// container log roots: one dir per pod on tmpfs, each with a log file being written
+class EventListenerBenchmark : public testing::Test {
+public:
+    void TestWatchDirs();
+
+protected:
+    void SetUp() override {
+        mRoot = filesystem::exists("/dev/shm") ? filesystem::path("/dev/shm") : filesystem::temp_directory_path();
+        mRoot /= "event_listener_benchmark";
+        filesystem::remove_all(mRoot);
+        for (size_t i = 0; i < kDirCnt; ++i) {
+            auto dir = mRoot / ("pod_" + to_string(i));
+            filesystem::create_directories(dir);
+            mDirs.push_back(dir.string());
+        }
+    }
+
+    void TearDown() override {
+        filesystem::remove_all(mRoot);
+        BOOL_FLAG(fs_events_fanotify_enable) = false;
+        EventListener::GetInstance()->Destroy();
+        EventListener::GetInstance()->Init();
+    }
+
+private:
+    void RunWatchDirs(bool mountWide);
+
+    filesystem::path mRoot;
+    vector<string> mDirs;
+};
+
+void EventListenerBenchmark::RunWatchDirs(bool mountWide) {
+    BOOL_FLAG(fs_events_fanotify_enable) = mountWide;
+    EventListener* listener = EventListener::GetInstance();
+    EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+    listener->Destroy();
+    APSARA_TEST_TRUE_FATAL(listener->Init());
+
+    vector<int> wds;
+    size_t failedCnt = 0;
+    double cpu = GetCpuSeconds();
+    auto start = chrono::steady_clock::now();
+    for (const auto& dir : mDirs) {
+        int wd = mountWide ? listener->AddMountWideWatch(dir.c_str()) : listener->AddWatch(dir.c_str());
+        if (!EventListener::IsValidID(wd)) {
+            ++failedCnt;
+            continue;
+        }
+        dispatcher->AddOneToOneMapEntry(new DirInfo(dir, 0, false, nullptr), wd);
+        wds.push_back(wd);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    if (mountWide && wds.empty()) {
+        cout << "[fanotify] not supported, skipped" << endl;
+        return;
+    }
+    cout << (mountWide ? "[fanotify]" : "[inotify]") << " dirs: " << kDirCnt << "\twatched: " << wds.size()
+         << "\tfailed: " << failedCnt << "\tregister time: " << elapsed.count() * 1000
+         << " ms\tcpu: " << (GetCpuSeconds() - cpu) * 1000 << " ms" << endl;
+
+    // each round writes to files in different dirs, and waits until the events of all of them are read
+    double writeCpu = 0;
+    double readCpu = 0;
+    double latency = 0;
+    for (size_t round = 0; round < kRoundCnt; ++round) {
+        unordered_set<string> pending;
+        cpu = GetCpuSeconds();
+        for (size_t i = 0; i < kWriteCnt; ++i) {
+            const string& dir = mDirs[(round * kWriteCnt + i * 7) % wds.size()];
+            int fd = open((dir + "/0.log").c_str(), O_CREAT | O_WRONLY | O_APPEND, 0644);
+            APSARA_TEST_TRUE_FATAL(fd >= 0);
+            APSARA_TEST_EQUAL_FATAL(4, write(fd, "log\n", 4));
+            close(fd);
+            pending.insert(dir);
+        }
+        writeCpu += GetCpuSeconds() - cpu;
+
+        cpu = GetCpuSeconds();
+        start = chrono::steady_clock::now();
+        vector<Event*> events;
+        while (!pending.empty() && chrono::steady_clock::now() - start < chrono::seconds(10)) {
+            listener->ReadEvents(events);
+            for (auto* event : events) {
+                pending.erase(event->GetSource());
+                delete event;
+            }
+        }
+        latency += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        readCpu += GetCpuSeconds() - cpu;
+        APSARA_TEST_TRUE(pending.empty());
+    }
+    cout << (mountWide ? "[fanotify]" : "[inotify]") << " writes: " << kWriteCnt * kRoundCnt
+         << "\tavg latency: " << latency / kRoundCnt * 1000 << " ms\twrite cpu: " << writeCpu * 1000
+         << " ms\tread cpu: " << readCpu * 1000 << " ms" << endl;
+
+    for (int wd : wds) {
+        listener->RemoveWatch(wd);
+        dispatcher->RemoveOneToOneMapEntry(wd);
+    }
+}
+
+void EventListenerBenchmark::TestWatchDirs() {
+    RunWatchDirs(false);
+    RunWatchDirs(true);
+}
+
+UNIT_TEST_CASE(EventListenerBenchmark, TestWatchDirs)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
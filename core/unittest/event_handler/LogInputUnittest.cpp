@@ -12,17 +12,27 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/fanotify.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
+#include "file_server/EventDispatcher.h"
 #include "file_server/event/Event.h"
+#include "file_server/event_handler/EventHandler.h"
 #include "file_server/event_handler/LogInput.h"
+#include "file_server/event_listener/EventListener.h"
 #include "file_server/polling/PollingEventQueue.h"
 #include "unittest/Unittest.h"
 using namespace std;
@@ -30,6 +40,16 @@ using namespace std;
 DECLARE_FLAG_STRING(ilogtail_config);
 
 namespace logtail {
+
+class CountingEventHandler : public EventHandler {
+public:
+    void Handle(const Event& event) override { mEvents.emplace_back(event.GetEventObject(), event.GetType()); }
+    void HandleTimeOut() override {}
+    bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) override { return true; }
+
+    vector<pair<string, EventType>> mEvents;
+};
+
 class LogInputUnittest : public ::testing::Test {
 protected:
     void SetUp() override {}
@@ -64,10 +84,215 @@ public:
         Event* ev = LogInput::GetInstance()->PopEventQueue();
         delete ev;
     }
+
+    void TestReadInotifyEventsBurst() {
+        LOG_INFO(sLogger, ("TestReadInotifyEventsBurst() begin", time(NULL)));
+        const int wd = 10000;
+        CountingEventHandler handler;
+        EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        dispatcher->AddOneToOneMapEntry(new DirInfo("/source", 0, false, &handler), wd);
+
+        // a burst of writes to rotating files
+        string buffer;
+        for (int i = 0; i < 1000; ++i) {
+            AppendInotifyEvent(buffer, wd, IN_MODIFY, "a.log");
+            AppendInotifyEvent(buffer, wd, IN_MODIFY, "b.log");
+        }
+        AppendInotifyEvent(buffer, wd, IN_MOVED_FROM, "a.log");
+        AppendInotifyEvent(buffer, wd, IN_CREATE, "a.log");
+        for (int i = 0; i < 1000; ++i) {
+            AppendInotifyEvent(buffer, wd, IN_MODIFY, "a.log");
+        }
+        // events of dirs not registered are ignored
+        AppendInotifyEvent(buffer, wd + 1, IN_MODIFY, "c.log");
+        // a half record is left for the next read
+        size_t wholeSize = buffer.size();
+        AppendInotifyEvent(buffer, wd, IN_MODIFY, "b.log");
+        buffer.resize(buffer.size() - 4);
+
+        vector<Event*> events;
+        APSARA_TEST_EQUAL(wholeSize, EventListener::GetInstance()->ParseEvents(buffer.data(), buffer.size(), events));
+        APSARA_TEST_EQUAL(5U, events.size());
+        LogInput::GetInstance()->PushEventQueue(events);
+        for (Event* ev = LogInput::GetInstance()->PopEventQueue(); ev != nullptr;
+             ev = LogInput::GetInstance()->PopEventQueue()) {
+            LogInput::GetInstance()->ProcessEvent(dispatcher, ev);
+        }
+        // the last MODIFY of a.log is merged with the one still in the queue
+        vector<pair<string, EventType>> expected{
+            {"a.log", EVENT_MODIFY}, {"b.log", EVENT_MODIFY}, {"a.log", EVENT_MOVE_FROM}, {"a.log", EVENT_CREATE}};
+        APSARA_TEST_EQUAL(expected, handler.mEvents);
+
+        dispatcher->RemoveOneToOneMapEntry(wd);
+    }
+
+#ifdef FAN_REPORT_DFID_NAME
+    void TestReadFanotifyEvents() {
+        LOG_INFO(sLogger, ("TestReadFanotifyEvents() begin", time(NULL)));
+        const int wd = (1 << 30) + 10000;
+        filesystem::path dir = filesystem::temp_directory_path() / "log_input_unittest_fanotify";
+        filesystem::remove_all(dir);
+        filesystem::create_directories(dir);
+        ofstream(dir / "exist.log") << "log\n";
+        EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        dispatcher->AddOneToOneMapEntry(new DirInfo(dir.string(), 0, false, nullptr), wd);
+        EventListener::GetInstance()->mHandleWdMap[GetFanotifyHandleKey(1)] = wd;
+
+        string buffer;
+        // merged masks are split with arrivals first
+        AppendFanotifyEvent(buffer, FAN_CREATE | FAN_MODIFY, 1, "a.log");
+        AppendFanotifyEvent(buffer, FAN_MODIFY, 1, "a.log");
+        AppendFanotifyEvent(buffer, FAN_MOVED_TO | FAN_DELETE, 1, "gone.log");
+        // unless the entry still exists, which means it came last
+        AppendFanotifyEvent(buffer, FAN_CREATE | FAN_DELETE, 1, "exist.log");
+        AppendFanotifyEvent(buffer, FAN_CREATE | FAN_ONDIR, 1, "sub");
+        // events of the dir itself, of which only the deletion is reported
+        AppendFanotifyEvent(buffer, FAN_MODIFY | FAN_ONDIR, 1, ".");
+        AppendFanotifyEvent(buffer, FAN_DELETE_SELF | FAN_ONDIR, 1, ".");
+        // events of dirs not watched are ignored
+        AppendFanotifyEvent(buffer, FAN_MODIFY, 2, "b.log");
+        // records whose handle exceeds the record are ignored
+        size_t recordBegin = buffer.size();
+        AppendFanotifyEvent(buffer, FAN_MODIFY, 1, "c.log");
+        struct file_handle handle {};
+        handle.handle_bytes = 4096;
+        buffer.replace(recordBegin + sizeof(struct fanotify_event_metadata) + sizeof(struct fanotify_event_info_fid),
+                       sizeof(handle.handle_bytes),
+                       reinterpret_cast<const char*>(&handle.handle_bytes),
+                       sizeof(handle.handle_bytes));
+        // a record exceeding the buffer stops the parsing
+        AppendFanotifyEvent(buffer, FAN_MODIFY, 1, "d.log");
+        buffer.resize(buffer.size() - 4);
+
+        vector<Event*> events;
+        EventListener::GetInstance()->ParseFanotifyEvents(buffer.data(), buffer.size(), events);
+        vector<pair<string, EventType>> expected{{"a.log", EVENT_CREATE},
+                                                 {"a.log", EVENT_MODIFY},
+                                                 {"gone.log", EVENT_MOVE_TO},
+                                                 {"gone.log", EVENT_DELETE},
+                                                 {"exist.log", EVENT_DELETE},
+                                                 {"exist.log", EVENT_CREATE},
+                                                 {"sub", EVENT_CREATE | EVENT_ISDIR},
+                                                 {"", EVENT_TIMEOUT | EVENT_ISDIR}};
+        vector<pair<string, EventType>> result;
+        for (Event* ev : events) {
+            APSARA_TEST_EQUAL(dir.string(), ev->GetSource());
+            result.emplace_back(ev->GetEventObject(), ev->GetType());
+            delete ev;
+        }
+        APSARA_TEST_EQUAL(expected, result);
+
+        EventListener::GetInstance()->mHandleWdMap.clear();
+        dispatcher->RemoveOneToOneMapEntry(wd);
+        filesystem::remove_all(dir);
+    }
+
+    void TestReadFanotifyEventsOverflow() {
+        LOG_INFO(sLogger, ("TestReadFanotifyEventsOverflow() begin", time(NULL)));
+        const int wd = (1 << 30) + 10000;
+        const int subWd = wd + 1;
+        filesystem::path dir = filesystem::temp_directory_path() / "log_input_unittest_fanotify_overflow";
+        filesystem::remove_all(dir);
+        filesystem::create_directories(dir / "registered");
+        filesystem::create_directories(dir / "new");
+        ofstream(dir / "a.log") << "log\n";
+        EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        dispatcher->AddOneToOneMapEntry(new DirInfo(dir.string(), 0, false, nullptr), wd);
+        fsutil::PathStat statBuf;
+        APSARA_TEST_TRUE_FATAL(fsutil::PathStat::stat((dir / "registered").string(), statBuf));
+        dispatcher->AddOneToOneMapEntry(
+            new DirInfo((dir / "registered").string(), statBuf.GetDevInode().inode, false, nullptr), subWd);
+        EventListener::GetInstance()->mWdHandleMap[wd] = GetFanotifyHandleKey(1);
+
+        // the overflow record carries no info, all watched dirs are listed again instead
+        string buffer;
+        struct fanotify_event_metadata meta {};
+        meta.event_len = sizeof(meta);
+        meta.vers = FANOTIFY_METADATA_VERSION;
+        meta.metadata_len = sizeof(meta);
+        meta.mask = FAN_Q_OVERFLOW;
+        meta.fd = FAN_NOFD;
+        buffer.append(reinterpret_cast<const char*>(&meta), sizeof(meta));
+
+        vector<Event*> events;
+        EventListener::GetInstance()->ParseFanotifyEvents(buffer.data(), buffer.size(), events);
+        vector<pair<string, EventType>> expected{{"a.log", EVENT_MODIFY}, {"new", EVENT_CREATE | EVENT_ISDIR}};
+        vector<pair<string, EventType>> result;
+        for (Event* ev : events) {
+            APSARA_TEST_EQUAL(dir.string(), ev->GetSource());
+            APSARA_TEST_EQUAL(wd, ev->GetWd());
+            result.emplace_back(ev->GetEventObject(), ev->GetType());
+            delete ev;
+        }
+        sort(result.begin(), result.end());
+        APSARA_TEST_EQUAL(expected, result);
+
+        EventListener::GetInstance()->mWdHandleMap.clear();
+        dispatcher->RemoveOneToOneMapEntry(wd);
+        dispatcher->RemoveOneToOneMapEntry(subWd);
+        filesystem::remove_all(dir);
+    }
+#endif
+
+private:
+    static void AppendInotifyEvent(string& buffer, int wd, uint32_t mask, const string& name) {
+        // names are padded with null bytes as the kernel does
+        uint32_t nameLen = (name.size() / 16 + 1) * 16;
+        struct inotify_event event {};
+        event.wd = wd;
+        event.mask = mask;
+        event.len = nameLen;
+        buffer.append(reinterpret_cast<const char*>(&event), sizeof(event));
+        buffer.append(name);
+        buffer.append(nameLen - name.size(), '\0');
+    }
+
+#ifdef FAN_REPORT_DFID_NAME
+    // the dir is identified by a 4-byte handle on a fake filesystem, in the same layout as the kernel reports
+    static void AppendFanotifyEvent(string& buffer, uint64_t mask, uint32_t handleValue, const string& name) {
+        struct fanotify_event_info_fid info {};
+        struct file_handle handle {};
+        size_t infoLen = sizeof(info) + sizeof(handle) + sizeof(handleValue) + name.size() + 1;
+        infoLen = (infoLen + 3) / 4 * 4;
+        struct fanotify_event_metadata meta {};
+        meta.event_len = sizeof(meta) + infoLen;
+        meta.vers = FANOTIFY_METADATA_VERSION;
+        meta.metadata_len = sizeof(meta);
+        meta.mask = mask;
+        meta.fd = FAN_NOFD;
+        info.hdr.info_type = FAN_EVENT_INFO_TYPE_DFID_NAME;
+        info.hdr.len = infoLen;
+        info.fsid.val[0] = 1;
+        handle.handle_bytes = sizeof(handleValue);
+        handle.handle_type = 1;
+        size_t recordBegin = buffer.size();
+        buffer.append(reinterpret_cast<const char*>(&meta), sizeof(meta));
+        buffer.append(reinterpret_cast<const char*>(&info), sizeof(info));
+        buffer.append(reinterpret_cast<const char*>(&handle), sizeof(handle));
+        buffer.append(reinterpret_cast<const char*>(&handleValue), sizeof(handleValue));
+        buffer.append(name);
+        buffer.append(recordBegin + meta.event_len - buffer.size(), '\0');
+    }
+
+    static string GetFanotifyHandleKey(uint32_t handleValue) {
+        struct fanotify_event_info_fid info {};
+        info.fsid.val[0] = 1;
+        int handleType = 1;
+        string key(reinterpret_cast<const char*>(&info.fsid), sizeof(info.fsid));
+        key.append(reinterpret_cast<const char*>(&handleType), sizeof(handleType));
+        key.append(reinterpret_cast<const char*>(&handleValue), sizeof(handleValue));
+        return key;
+    }
+#endif
 };
 
 APSARA_UNIT_TEST_CASE(LogInputUnittest, TestTryReadEventsPollingEvents, 0);
 APSARA_UNIT_TEST_CASE(LogInputUnittest, TestTryReadEventsDuplicatedEvents, 0);
+APSARA_UNIT_TEST_CASE(LogInputUnittest, TestReadInotifyEventsBurst, 0);
+#ifdef FAN_REPORT_DFID_NAME
+APSARA_UNIT_TEST_CASE(LogInputUnittest, TestReadFanotifyEvents, 0);
+APSARA_UNIT_TEST_CASE(LogInputUnittest, TestReadFanotifyEventsOverflow, 0);
+#endif
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
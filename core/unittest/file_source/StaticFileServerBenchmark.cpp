@@ -0,0 +1,153 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/FileTagOptions.h"
+#include "file_server/MultilineOptions.h"
+#include "file_server/StaticFileServer.h"
+#include "file_server/reader/FileReaderOptions.h"
+#include "file_server/reader/LogFileReader.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// size of the generated file in MB, can be overridden by STATIC_FILE_BENCHMARK_SIZE_MB
+constexpr uint64_t kDefaultFileSizeMB = 1024;
+constexpr uint64_t kRangeBytes = 64 * 1024 * 1024;
+constexpr size_t kThreadNum = 4;
+
+uint64_t GetFileSizeMB() {
+    const char* env = getenv("STATIC_FILE_BENCHMARK_SIZE_MB");
+    return env == nullptr ? kDefaultFileSizeMB : strtoull(env, nullptr, 10);
+}
+
+} // namespace
+
+class StaticFileServerBenchmark : public testing::Test {
+public:
+    void TestReadByRanges();
+
+protected:
+    void SetUp() override {
+        mReaderOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        filesystem::create_directories(mDir);
+        ofstream fout(mDir / mFileName, ios::binary);
+        string line;
+        uint64_t size = GetFileSizeMB() * 1024 * 1024;
+        for (uint64_t written = 0, i = 0; written < size; written += line.size(), ++i) {
+            line = "2025-01-01 00:00:00.000 [INFO] [" + to_string(i) + "] request handled, method=GET, path=/api/v1/"
+                + string(i % 97, 'x') + ", latency=" + to_string(i % 1000) + "ms\n";
+            fout << line;
+        }
+    }
+
+    void TearDown() override { filesystem::remove_all(mDir); }
+
+    LogFileReaderPtr CreateReader() {
+        LogFileReaderPtr reader(new LogFileReader(mDir.string(),
+                                                  mFileName,
+                                                  DevInode(),
+                                                  make_pair(&mReaderOpts, &mCtx),
+                                                  make_pair(&mMultilineOpts, &mCtx),
+                                                  make_pair(&mFileTagOpts, &mCtx)));
+        // same as the readers created by StaticFileServer
+        reader->UpdateFilePtr();
+        reader->CheckFileSignatureAndOffset(false);
+        return reader;
+    }
+
+    // returns the number of lines read
+    static uint64_t ReadAll(LogFileReader& reader) {
+        uint64_t lines = 0;
+        bool moreData = true;
+        while (moreData) {
+            LogBuffer logBuffer;
+            moreData = reader.ReadLog(logBuffer, nullptr);
+            if (!logBuffer.rawBuffer.empty()) {
+                lines += count(logBuffer.rawBuffer.begin(), logBuffer.rawBuffer.end(), '\n') + 1;
+            }
+        }
+        return lines;
+    }
+
+    filesystem::path mDir = "static_file_server_benchmark";
+    string mFileName = "large.log";
+    FileReaderOptions mReaderOpts;
+    MultilineOptions mMultilineOpts;
+    FileTagOptions mFileTagOpts;
+    CollectionPipelineContext mCtx;
+};
+
+void StaticFileServerBenchmark::TestReadByRanges() {
+    // warm up the page cache, so that both runs are bounded by cpu rather than disk
+    auto sequential = CreateReader();
+    ReadAll(*sequential);
+
+    sequential = CreateReader();
+    uint64_t size = sequential->GetFileSize();
+    auto start = chrono::steady_clock::now();
+    uint64_t sequentialLines = ReadAll(*sequential);
+    chrono::duration<double> sequentialCost = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    vector<FileRangeCheckpoint> ranges;
+    StaticFileServer::SplitFileByLines((mDir / mFileName).string(), size, kRangeBytes, ranges);
+    atomic_size_t next = 0;
+    vector<future<uint64_t>> results;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+        results.emplace_back(async(launch::async, [&]() {
+            uint64_t lines = 0;
+            for (size_t idx = next++; idx < ranges.size(); idx = next++) {
+                auto reader = CreateReader();
+                reader->SetReadRange(ranges[idx].mBegin, ranges[idx].mEnd);
+                lines += ReadAll(*reader);
+            }
+            return lines;
+        }));
+    }
+    uint64_t parallelLines = 0;
+    for (auto& res : results) {
+        parallelLines += res.get();
+    }
+    chrono::duration<double> parallelCost = chrono::steady_clock::now() - start;
+
+    APSARA_TEST_EQUAL(sequentialLines, parallelLines);
+    cout << "file size: " << size / 1024 / 1024 << " MB, lines: " << sequentialLines << ", ranges: " << ranges.size()
+         << endl;
+    cout << "[sequential] " << sequentialCost.count() << " s, " << size / 1024.0 / 1024 / sequentialCost.count()
+         << " MB/s" << endl;
+    cout << "[" << kThreadNum << " threads by ranges] " << parallelCost.count() << " s, "
+         << size / 1024.0 / 1024 / parallelCost.count() << " MB/s" << endl;
+}
+
+UNIT_TEST_CASE(StaticFileServerBenchmark, TestReadByRanges)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
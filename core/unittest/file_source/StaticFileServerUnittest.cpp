@@ -12,14 +12,26 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <future>
+#include <map>
+#include <thread>
+
 #include "collection_pipeline/CollectionPipeline.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/JsonUtil.h"
+#include "constants/Constants.h"
 #include "file_server/StaticFileServer.h"
 #include "file_server/checkpoint/InputStaticFileCheckpointManager.h"
 #include "plugin/input/InputStaticFile.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(static_file_read_thread_num);
+DECLARE_FLAG_INT64(static_file_range_split_min_bytes);
+DECLARE_FLAG_INT64(static_file_range_bytes);
+
 using namespace std;
 
 namespace logtail {
@@ -29,6 +41,11 @@ public:
     void TestGetNextAvailableReader() const;
     void TestUpdateInputs() const;
     void TestClearUnusedCheckpoints() const;
+    void TestSplitFileByLines() const;
+    void TestSetReadRange() const;
+    void TestReadByRanges() const;
+    void TestRemoveInputWaitsForRanges() const;
+    void TestRangeSignatureFailure() const;
 
 protected:
     static void SetUpTestCase() { PluginRegistry::GetInstance()->LoadPlugins(); }
@@ -47,6 +64,53 @@ protected:
         filesystem::remove_all(sManager->mCheckpointRootPath);
     }
 
+    // writes @cnt distinct lines to the file and returns the content
+    static string WriteLines(const filesystem::path& filepath, size_t cnt) {
+        string content;
+        for (size_t i = 0; i < cnt; ++i) {
+            content += "line-" + to_string(i) + "-" + string(i % 37, 'x') + "\n";
+        }
+        ofstream fout(filepath, std::ios_base::binary);
+        fout << content;
+        return content;
+    }
+
+    static void CountLines(StringView content, map<string, size_t>& lines) {
+        size_t begin = 0;
+        while (begin < content.size()) {
+            size_t end = content.find('\n', begin);
+            if (end == StringView::npos) {
+                end = content.size();
+            }
+            if (end > begin) {
+                ++lines[string(content.substr(begin, end - begin))];
+            }
+            begin = end + 1;
+        }
+    }
+
+    // pops events from the process queue until @cnt distinct lines are received or timeout
+    static void PopLines(size_t cnt, map<string, size_t>& lines) {
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+        while (lines.size() < cnt && chrono::steady_clock::now() < deadline) {
+            unique_ptr<ProcessQueueItem> item;
+            string configName;
+            if (!ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+                continue;
+            }
+            for (const auto& e : item->mEventGroup.GetEvents()) {
+                CountLines(e.Cast<LogEvent>().GetContent(DEFAULT_CONTENT_KEY), lines);
+            }
+        }
+    }
+
+    bool IsInputFinished(const string& configName) const {
+        lock_guard<mutex> lock(sManager->mUpdateMux);
+        auto it = sManager->mInputCheckpointMap.find(make_pair(configName, 0));
+        return it != sManager->mInputCheckpointMap.end() && it->second.mStatus == StaticFileReadingStatus::FINISHED;
+    }
+
 private:
     InputStaticFileCheckpointManager* sManager;
     StaticFileServer* sServer;
@@ -186,9 +250,285 @@ void StaticFileServerUnittest::TestClearUnusedCheckpoints() const {
     INT32_FLAG(unused_checkpoints_clear_interval_sec) = 600;
 }
 
+void StaticFileServerUnittest::TestSplitFileByLines() const {
+    filesystem::create_directories("test_logs");
+    string filepath = "./test_logs/test_file.log";
+    string content;
+    for (size_t i = 0; i < 100; ++i) {
+        content += string(i % 17 + 1, 'a') + "\n";
+    }
+    {
+        ofstream fout(filepath, std::ios_base::binary);
+        fout << content;
+        // the last line has no line feed
+        fout << string(30, 'b');
+    }
+    uint64_t size = content.size() + 30;
+
+    vector<FileRangeCheckpoint> ranges;
+    StaticFileServer::SplitFileByLines(filepath, size, 100, ranges);
+    APSARA_TEST_TRUE(ranges.size() > 1);
+    APSARA_TEST_EQUAL(0U, ranges.front().mBegin);
+    APSARA_TEST_EQUAL(size, ranges.back().mEnd);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        APSARA_TEST_EQUAL(ranges[i].mBegin, ranges[i].mOffset);
+        APSARA_TEST_TRUE(ranges[i].mBegin < ranges[i].mEnd);
+        if (i > 0) {
+            APSARA_TEST_EQUAL(ranges[i - 1].mEnd, ranges[i].mBegin);
+            // each range starts at the beginning of a line
+            APSARA_TEST_EQUAL('\n', content[ranges[i].mBegin - 1]);
+            APSARA_TEST_TRUE(ranges[i].mBegin - ranges[i - 1].mBegin >= 100);
+        }
+    }
+
+    // no line feed after the split point
+    StaticFileServer::SplitFileByLines(filepath, size, size - 20, ranges);
+    APSARA_TEST_EQUAL(1U, ranges.size());
+    APSARA_TEST_EQUAL(size, ranges[0].mEnd);
+
+    // file smaller than one range
+    StaticFileServer::SplitFileByLines(filepath, size, size, ranges);
+    APSARA_TEST_EQUAL(1U, ranges.size());
+
+    filesystem::remove_all("test_logs");
+}
+
+void StaticFileServerUnittest::TestSetReadRange() const {
+    filesystem::create_directories("test_logs");
+    string content = WriteLines("./test_logs/test_file.log", 100);
+
+    FileReaderOptions readerOpts;
+    readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+    MultilineOptions multilineOpts;
+    FileTagOptions tagOpts;
+    CollectionPipelineContext ctx;
+    auto readRange = [&](uint64_t begin, uint64_t end) {
+        LogFileReaderPtr reader(new LogFileReader("./test_logs",
+                                                  "test_file.log",
+                                                  DevInode(),
+                                                  make_pair(&readerOpts, &ctx),
+                                                  make_pair(&multilineOpts, &ctx),
+                                                  make_pair(&tagOpts, &ctx)));
+        reader->UpdateFilePtr();
+        reader->CheckFileSignatureAndOffset(false);
+        reader->SetReadRange(begin, end);
+        string res;
+        bool moreData = true;
+        while (moreData) {
+            LogBuffer logBuffer;
+            moreData = reader->ReadLog(logBuffer, nullptr);
+            if (!logBuffer.rawBuffer.empty()) {
+                res += string(logBuffer.rawBuffer) + "\n";
+            }
+        }
+        APSARA_TEST_EQUAL(static_cast<int64_t>(end), reader->GetLastFilePos());
+        return res;
+    };
+
+    vector<FileRangeCheckpoint> ranges;
+    StaticFileServer::SplitFileByLines("./test_logs/test_file.log", content.size(), 500, ranges);
+    APSARA_TEST_TRUE(ranges.size() > 2);
+    for (const auto& range : ranges) {
+        // nothing beyond the range is read although the file is larger
+        APSARA_TEST_EQUAL(content.substr(range.mBegin, range.mEnd - range.mBegin), readRange(range.mBegin, range.mEnd));
+    }
+
+    // resume from the middle of a range
+    uint64_t mid = content.find('\n', (ranges[1].mBegin + ranges[1].mEnd) / 2) + 1;
+    APSARA_TEST_TRUE(mid < ranges[1].mEnd);
+    APSARA_TEST_EQUAL(content.substr(mid, ranges[1].mEnd - mid), readRange(mid, ranges[1].mEnd));
+
+    filesystem::remove_all("test_logs");
+}
+
+void StaticFileServerUnittest::TestReadByRanges() const {
+    auto threadNum = INT32_FLAG(static_file_read_thread_num);
+    auto splitMinBytes = INT64_FLAG(static_file_range_split_min_bytes);
+    auto rangeBytes = INT64_FLAG(static_file_range_bytes);
+    INT32_FLAG(static_file_read_thread_num) = 2;
+    INT64_FLAG(static_file_range_split_min_bytes) = 0;
+    INT64_FLAG(static_file_range_bytes) = 4096;
+
+    filesystem::create_directories("test_logs");
+    filesystem::path filePath = filesystem::absolute("./test_logs/test_file.log");
+    const size_t lineCnt = 1000;
+    string content = WriteLines(filePath, lineCnt);
+
+    CollectionPipeline p;
+    p.mName = "test_config";
+    p.mPluginID.store(0);
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    ctx.SetPipeline(p);
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config");
+    ctx.SetProcessQueueKey(key);
+    ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    ProcessQueueManager::GetInstance()->EnablePop("test_config");
+
+    string configStr = R"(
+        {
+            "Type": "input_static_file_onetime",
+            "FilePaths": []
+        }
+    )";
+    string errorMsg;
+    Json::Value configJson, optionalGoPipeline;
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    configJson["FilePaths"].append(Json::Value(filePath.string()));
+    {
+        // read by 2 workers, every line arrives exactly once
+        InputStaticFile input;
+        input.SetContext(ctx);
+        input.CreateMetricsRecordRef(InputStaticFile::sName, "1");
+        APSARA_TEST_TRUE(input.Init(configJson, optionalGoPipeline));
+        input.CommitMetricsRecordRef();
+        APSARA_TEST_TRUE(input.Start());
+        APSARA_TEST_EQUAL(2U, sServer->mRangeWorkerRes.size());
+
+        map<string, size_t> lines;
+        PopLines(lineCnt, lines);
+        for (size_t i = 0; i < 500 && !IsInputFinished("test_config"); ++i) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        APSARA_TEST_TRUE(IsInputFinished("test_config"));
+        // all events have been pushed before the file is finished
+        PopLines(lineCnt + 1, lines);
+        APSARA_TEST_EQUAL(lineCnt, lines.size());
+        map<string, size_t> expected;
+        CountLines(content, expected);
+        APSARA_TEST_EQUAL(expected, lines);
+        APSARA_TEST_TRUE(input.Stop(true));
+    }
+    {
+        // restart from a checkpoint in which the first range is finished and the second one is half read
+        APSARA_TEST_TRUE(sManager->CreateCheckpoint("test_config", 0, vector<filesystem::path>{filePath}));
+        vector<FileRangeCheckpoint> ranges;
+        StaticFileServer::SplitFileByLines(filePath.string(), content.size(), INT64_FLAG(static_file_range_bytes), ranges);
+        APSARA_TEST_TRUE(ranges.size() > 2);
+        uint64_t mid = content.find('\n', (ranges[1].mBegin + ranges[1].mEnd) / 2) + 1;
+        APSARA_TEST_TRUE(mid < ranges[1].mEnd);
+        uint64_t firstEnd = ranges[0].mEnd;
+        APSARA_TEST_TRUE(sManager->SetCurrentFileRanges("test_config", 0, content.size(), std::move(ranges)));
+        APSARA_TEST_TRUE(sManager->UpdateCurrentFileRangeCheckpoint("test_config", 0, 0, 0, firstEnd));
+        APSARA_TEST_TRUE(sManager->UpdateCurrentFileRangeCheckpoint("test_config", 0, 0, 1, mid));
+        sManager->DumpAllCheckpointFiles();
+        sManager->mInputCheckpointMap.clear();
+        sManager->GetAllCheckpointFileNames();
+
+        InputStaticFile input;
+        ctx.SetIsOnetimePipelineRunningBeforeStart(true);
+        input.SetContext(ctx);
+        input.CreateMetricsRecordRef(InputStaticFile::sName, "1");
+        APSARA_TEST_TRUE(input.Init(configJson, optionalGoPipeline));
+        input.CommitMetricsRecordRef();
+        APSARA_TEST_TRUE(input.Start());
+
+        map<string, size_t> expected;
+        CountLines(StringView(content).substr(mid), expected);
+        map<string, size_t> lines;
+        PopLines(expected.size(), lines);
+        for (size_t i = 0; i < 500 && !IsInputFinished("test_config"); ++i) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        APSARA_TEST_TRUE(IsInputFinished("test_config"));
+        PopLines(expected.size() + 1, lines);
+        APSARA_TEST_EQUAL(expected, lines);
+        APSARA_TEST_TRUE(input.Stop(true));
+    }
+
+    ProcessQueueManager::GetInstance()->DeleteQueue(key);
+    filesystem::remove_all("test_logs");
+    INT32_FLAG(static_file_read_thread_num) = threadNum;
+    INT64_FLAG(static_file_range_split_min_bytes) = splitMinBytes;
+    INT64_FLAG(static_file_range_bytes) = rangeBytes;
+}
+
+void StaticFileServerUnittest::TestRemoveInputWaitsForRanges() const {
+    auto input = make_pair(string("test_config"), static_cast<size_t>(0));
+    auto other = make_pair(string("test_config_other"), static_cast<size_t>(0));
+    {
+        lock_guard<mutex> lock(sServer->mRangeMux);
+        // one range of the input is being read and another one is queued
+        sServer->mRangeTaskCnt[input] = 2;
+        StaticFileServer::RangeTask task;
+        task.mConfigName = input.first;
+        sServer->mRangeTasks.push_back(task);
+        sServer->mRangeTaskCnt[other] = 1;
+        task.mConfigName = other.first;
+        sServer->mRangeTasks.push_back(task);
+    }
+    auto res = async(launch::async, [&]() { sServer->RemoveInput(input.first, input.second); });
+    APSARA_TEST_EQUAL(future_status::timeout, res.wait_for(chrono::milliseconds(100)));
+    {
+        lock_guard<mutex> lock(sServer->mRangeMux);
+        // the queued range is dropped, the running one is told to stop
+        APSARA_TEST_EQUAL(1U, sServer->mRangeTasks.size());
+        APSARA_TEST_EQUAL(other.first, sServer->mRangeTasks.front().mConfigName);
+        APSARA_TEST_EQUAL(1U, sServer->mRangeTaskCnt[input]);
+        APSARA_TEST_EQUAL(1U, sServer->mStoppedRangeInputs.count(input));
+        // the running range finishes, as the range worker does
+        sServer->mRangeTaskCnt.erase(input);
+    }
+    sServer->mRangeCV.notify_all();
+    APSARA_TEST_EQUAL(future_status::ready, res.wait_for(chrono::seconds(1)));
+    {
+        lock_guard<mutex> lock(sServer->mRangeMux);
+        APSARA_TEST_TRUE(sServer->mStoppedRangeInputs.empty());
+        APSARA_TEST_EQUAL(1U, sServer->mRangeTaskCnt[other]);
+    }
+}
+
+void StaticFileServerUnittest::TestRangeSignatureFailure() const {
+    filesystem::create_directories("test_logs");
+    filesystem::path filePath = "./test_logs/test_file.log";
+    string content = WriteLines(filePath, 100);
+    APSARA_TEST_TRUE(sManager->CreateCheckpoint("test_config", 0, vector<filesystem::path>{filePath}));
+    vector<FileRangeCheckpoint> ranges;
+    StaticFileServer::SplitFileByLines(filePath.string(), content.size(), 500, ranges);
+    APSARA_TEST_TRUE(ranges.size() > 2);
+    APSARA_TEST_TRUE(
+        sManager->SetCurrentFileRanges("test_config", 0, content.size(), vector<FileRangeCheckpoint>(ranges)));
+
+    FileDiscoveryOptions discoveryOpts;
+    FileReaderOptions readerOpts;
+    readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+    MultilineOptions multilineOpts;
+    FileTagOptions tagOpts;
+    CollectionPipelineContext ctx;
+    StaticFileServer::RangeTask task;
+    task.mConfigName = "test_config";
+    task.mRangeIdx = 1;
+    task.mRange = ranges[1];
+    APSARA_TEST_TRUE(sManager->GetCurrentFileFingerprint("test_config", 0, &task.mFingerprint));
+    // the file is not the one split before
+    task.mFingerprint.mSignatureHash += 1;
+    task.mDiscoveryConfig = make_pair(&discoveryOpts, &ctx);
+    task.mReaderConfig = make_pair(&readerOpts, &ctx);
+    task.mMultilineConfig = make_pair(&multilineOpts, &ctx);
+    task.mTagConfig = make_pair(&tagOpts, &ctx);
+    sServer->ReadRange(task);
+
+    {
+        // the file is abandoned, and so is the input since it has only one file
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config", 0));
+        APSARA_TEST_EQUAL(StaticFileReadingStatus::FINISHED, cpt.mStatus);
+        APSARA_TEST_EQUAL(FileStatus::ABORT, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_TRUE(cpt.mFileCheckpoints[0].mRanges.empty());
+    }
+    // other ranges of the file stop once they try to update the checkpoint
+    APSARA_TEST_FALSE(sManager->UpdateCurrentFileRangeCheckpoint("test_config", 0, 0, 0, ranges[0].mEnd));
+
+    filesystem::remove_all("test_logs");
+}
+
 UNIT_TEST_CASE(StaticFileServerUnittest, TestGetNextAvailableReader)
 UNIT_TEST_CASE(StaticFileServerUnittest, TestUpdateInputs)
 UNIT_TEST_CASE(StaticFileServerUnittest, TestClearUnusedCheckpoints)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestSplitFileByLines)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestSetReadRange)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestReadByRanges)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestRemoveInputWaitsForRanges)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestRangeSignatureFailure)
 
 } // namespace logtail
 
@@ -0,0 +1,99 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctime>
+
+#include <iostream>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/TimeUtil.h"
+#include "plugin/flusher/kafka/FlusherKafka.h"
+#include "unittest/Unittest.h"
+#include "unittest/flusher/MockKafkaProducer.h"
+
+using namespace logtail;
+
+static PipelineEventGroup CreateGroup(int eventCnt) {
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    group.SetTag(std::string("__hostname__"), std::string("host-172-16-0-1"));
+    group.SetTag(std::string("__path__"), std::string("/var/log/nginx/access.log"));
+    for (int i = 0; i < eventCnt; ++i) {
+        LogEvent* e = group.AddLogEvent();
+        e->SetTimestamp(1700000000 + i);
+        e->SetContent(std::string("application"), std::string("service") + std::to_string(i % 8));
+        e->SetContent(std::string("remote_addr"), std::string("10.200.98.220"));
+        e->SetContent(std::string("request"), std::string("GET /api/v1/query?name=ilogtail&limit=100 HTTP/1.1"));
+        e->SetContent(std::string("status"), std::string("200"));
+        e->SetContent(std::string("body_bytes_sent"), std::string("2048"));
+    }
+    return group;
+}
+
+static void BM_Send(const std::string& name, bool enableBatch, bool hash, int eventCnt, int groupCnt) {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    FlusherKafka flusher;
+    auto producer = std::make_unique<MockKafkaProducer>();
+    auto* mockProducer = producer.get();
+    flusher.SetProducerForTest(std::move(producer));
+    flusher.SetContext(ctx);
+    flusher.CreateMetricsRecordRef(FlusherKafka::sName, "1");
+
+    Json::Value config, optionalGoPipeline;
+    config["Brokers"].append("127.0.0.1:9092");
+    config["Topic"] = "benchmark";
+    config["Version"] = "2.6.0";
+    config["EnableBatchProduce"] = enableBatch;
+    if (hash) {
+        config["PartitionerType"] = "hash";
+        config["HashKeys"].append("content.application");
+    }
+    flusher.Init(config, optionalGoPipeline);
+    flusher.Start();
+
+    uint64_t durationTime = 0;
+    clock_t cpuTime = 0;
+    for (int i = 0; i < groupCnt; ++i) {
+        auto group = CreateGroup(eventCnt);
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        clock_t startCpu = clock();
+        flusher.Send(std::move(group));
+        cpuTime += clock() - startCpu;
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        mockProducer->ClearCompletedRequests();
+    }
+    flusher.Stop(true);
+    flusher.CommitMetricsRecordRef();
+
+    uint64_t totalEvents = static_cast<uint64_t>(eventCnt) * groupCnt;
+    std::cout << name << std::endl;
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "events: " << totalEvents * 1000000 / (durationTime ? durationTime : 1) << "/s" << std::endl;
+    std::cout << "cpu per event: " << static_cast<double>(cpuTime) * 1000000000 / CLOCKS_PER_SEC / totalEvents
+              << " ns" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_Send("per event", false, false, 1000, 200);
+    BM_Send("batch", true, false, 1000, 200);
+    BM_Send("per event with hash partitioner", false, true, 1000, 200);
+    BM_Send("batch with hash partitioner", true, true, 1000, 200);
+    return 0;
+}
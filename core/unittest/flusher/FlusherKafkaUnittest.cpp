@@ -19,6 +19,7 @@
 
 #include <cassert>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <set>
@@ -101,6 +102,13 @@ public:
     void TestUnknownPartitionerType();
     void TestGeneratePartitionKey_NotHash();
     void TestGeneratePartitionKey_ShortKeyAndJoinAndNonLog();
+    void TestInitUnknownBatchFormat();
+    void TestBatchProduceNdjson();
+    void TestBatchProduceJsonArray();
+    void TestBatchProduceHashKeys();
+    void TestBatchProduceSplitByMaxMessageBytes();
+    void TestBatchProduceSplitBySerializedSize();
+    void TestBatchProduceEmptyEvents();
 
 protected:
     void SetUp();
@@ -469,7 +477,8 @@ void FlusherKafkaUnittest::TestPartitionerHashKeySend() {
     e2->SetContent(StringView("application"), StringView("serviceB"));
 
     APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
-    APSARA_TEST_EQUAL(2, mFlusher->mSendCnt->GetValue());
+    // one group is counted once, no matter how many messages it is sent in
+    APSARA_TEST_EQUAL(1, mFlusher->mSendCnt->GetValue());
 
     const auto& reqs = mMockProducer->GetCompletedRequests();
     APSARA_TEST_EQUAL(2U, reqs.size());
@@ -544,6 +553,185 @@ void FlusherKafkaUnittest::TestGeneratePartitionKey_ShortKeyAndJoinAndNonLog() {
     APSARA_TEST_EQUAL(std::string(""), k2);
 }
 
+void FlusherKafkaUnittest::TestInitUnknownBatchFormat() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+    config["BatchFormat"] = "csv";
+
+    APSARA_TEST_FALSE(mFlusher->Init(config, optionalGoPipeline));
+}
+
+void FlusherKafkaUnittest::TestBatchProduceNdjson() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+
+    APSARA_TEST_TRUE(mFlusher->Init(config, optionalGoPipeline));
+    APSARA_TEST_TRUE(mFlusher->Start());
+
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    group.SetTag(StringView("tag"), StringView("t"));
+    for (int i = 0; i < 3; ++i) {
+        auto* event = group.AddLogEvent();
+        event->SetTimestamp(1234567890);
+        event->SetContent(StringView("key"), StringView("value" + std::to_string(i)));
+    }
+
+    APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
+    APSARA_TEST_EQUAL(1U, mMockProducer->GetBatchCount());
+    APSARA_TEST_EQUAL(1, mFlusher->mSendCnt->GetValue());
+    APSARA_TEST_EQUAL(1, mFlusher->mSuccessCnt->GetValue());
+
+    const auto& reqs = mMockProducer->GetCompletedRequests();
+    APSARA_TEST_EQUAL(1U, reqs.size());
+    APSARA_TEST_EQUAL(mTopic, reqs[0].Topic);
+    std::string expected;
+    for (int i = 0; i < 3; ++i) {
+        expected += R"({"tag":"t","__time__":1234567890,"key":"value)" + std::to_string(i) + "\"}\n";
+    }
+    APSARA_TEST_EQUAL(expected, reqs[0].Value);
+}
+
+void FlusherKafkaUnittest::TestBatchProduceJsonArray() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+    config["BatchFormat"] = "json_array";
+
+    APSARA_TEST_TRUE(mFlusher->Init(config, optionalGoPipeline));
+    APSARA_TEST_TRUE(mFlusher->Start());
+
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    for (int i = 0; i < 2; ++i) {
+        auto* event = group.AddLogEvent();
+        event->SetTimestamp(1234567890);
+        event->SetContent(StringView("key"), StringView("line1\nline2"));
+    }
+
+    APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
+    const auto& reqs = mMockProducer->GetCompletedRequests();
+    APSARA_TEST_EQUAL(1U, reqs.size());
+    APSARA_TEST_EQUAL(std::string(R"([{"__time__":1234567890,"key":"line1\nline2"},)"
+                                  R"({"__time__":1234567890,"key":"line1\nline2"}])"),
+                      reqs[0].Value);
+}
+
+void FlusherKafkaUnittest::TestBatchProduceHashKeys() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+    config["PartitionerType"] = "hash";
+    Json::Value hashKeys(Json::arrayValue);
+    hashKeys.append("content.application");
+    config["HashKeys"] = hashKeys;
+
+    APSARA_TEST_TRUE(mFlusher->Init(config, optionalGoPipeline));
+    APSARA_TEST_TRUE(mFlusher->Start());
+
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    const char* apps[] = {"serviceA", "serviceB", "serviceA", "serviceA"};
+    for (const auto* app : apps) {
+        auto* event = group.AddLogEvent();
+        event->SetContent(StringView("application"), StringView(app));
+    }
+
+    APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
+    APSARA_TEST_EQUAL(2, mFlusher->mSendCnt->GetValue());
+
+    const auto& reqs = mMockProducer->GetCompletedRequests();
+    APSARA_TEST_EQUAL(2U, reqs.size());
+    for (const auto& r : reqs) {
+        size_t lines = std::count(r.Value.begin(), r.Value.end(), '\n');
+        if (r.Key == "serviceA") {
+            APSARA_TEST_EQUAL(3U, lines);
+        } else {
+            APSARA_TEST_EQUAL(std::string("serviceB"), r.Key);
+            APSARA_TEST_EQUAL(1U, lines);
+        }
+    }
+}
+
+void FlusherKafkaUnittest::TestBatchProduceSplitByMaxMessageBytes() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+    config["MaxMessageBytes"] = 2500;
+
+    APSARA_TEST_TRUE(mFlusher->Init(config, optionalGoPipeline));
+    APSARA_TEST_TRUE(mFlusher->Start());
+
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    std::string value(1000, 'a');
+    for (int i = 0; i < 5; ++i) {
+        auto* event = group.AddLogEvent();
+        event->SetContent(StringView("key"), StringView(value));
+    }
+
+    APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
+    APSARA_TEST_EQUAL(1U, mMockProducer->GetBatchCount());
+    APSARA_TEST_EQUAL(1, mFlusher->mSendCnt->GetValue());
+    const auto& reqs = mMockProducer->GetCompletedRequests();
+    APSARA_TEST_EQUAL(3U, reqs.size());
+    size_t total = 0;
+    for (const auto& r : reqs) {
+        APSARA_TEST_TRUE(r.Value.size() <= 2500U);
+        total += std::count(r.Value.begin(), r.Value.end(), '\n');
+    }
+    APSARA_TEST_EQUAL(5U, total);
+}
+
+void FlusherKafkaUnittest::TestBatchProduceSplitBySerializedSize() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+    config["MaxMessageBytes"] = 4000;
+
+    APSARA_TEST_TRUE(mFlusher->Init(config, optionalGoPipeline));
+    APSARA_TEST_TRUE(mFlusher->Start());
+
+    // keys, quotes and escaping make the serialized events far larger than their data size
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    for (int i = 0; i < 50; ++i) {
+        auto* event = group.AddLogEvent();
+        for (int j = 0; j < 20; ++j) {
+            event->SetContent("k" + std::to_string(j), std::string("v"));
+        }
+        event->SetContent(std::string("escaped"), std::string(60, '"') + std::string(60, '\\'));
+    }
+
+    APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
+    const auto& reqs = mMockProducer->GetCompletedRequests();
+    APSARA_TEST_TRUE(reqs.size() > 1U);
+    size_t total = 0;
+    for (const auto& r : reqs) {
+        APSARA_TEST_TRUE(r.Value.size() <= 4000U);
+        total += std::count(r.Value.begin(), r.Value.end(), '\n');
+    }
+    APSARA_TEST_EQUAL(50U, total);
+}
+
+void FlusherKafkaUnittest::TestBatchProduceEmptyEvents() {
+    Json::Value optionalGoPipeline;
+    Json::Value config = CreateKafkaTestConfig(mTopic);
+    config["EnableBatchProduce"] = true;
+    config["BatchFormat"] = "json_array";
+
+    APSARA_TEST_TRUE(mFlusher->Init(config, optionalGoPipeline));
+    APSARA_TEST_TRUE(mFlusher->Start());
+
+    // events with no content are serialized to nothing, which is skipped rather than discarded
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    for (int i = 0; i < 3; ++i) {
+        group.AddLogEvent();
+    }
+
+    APSARA_TEST_TRUE(mFlusher->Send(std::move(group)));
+    APSARA_TEST_EQUAL(0U, mMockProducer->GetCompletedRequests().size());
+    APSARA_TEST_EQUAL(0, mFlusher->mSendCnt->GetValue());
+    APSARA_TEST_EQUAL(0, mFlusher->mDiscardCnt->GetValue());
+}
+
 UNIT_TEST_CASE(FlusherKafkaUnittest, TestInitSuccess)
 UNIT_TEST_CASE(FlusherKafkaUnittest, TestInitMissingBrokers)
 UNIT_TEST_CASE(FlusherKafkaUnittest, TestInitMissingTopic)
@@ -570,6 +758,13 @@ UNIT_TEST_CASE(FlusherKafkaUnittest, TestPartitionerHashKeyInvalidPrefix)
 UNIT_TEST_CASE(FlusherKafkaUnittest, TestUnknownPartitionerType)
 UNIT_TEST_CASE(FlusherKafkaUnittest, TestGeneratePartitionKey_NotHash)
 UNIT_TEST_CASE(FlusherKafkaUnittest, TestGeneratePartitionKey_ShortKeyAndJoinAndNonLog)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestInitUnknownBatchFormat)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestBatchProduceNdjson)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestBatchProduceJsonArray)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestBatchProduceHashKeys)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestBatchProduceSplitByMaxMessageBytes)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestBatchProduceSplitBySerializedSize)
+UNIT_TEST_CASE(FlusherKafkaUnittest, TestBatchProduceEmptyEvents)
 
 } // namespace logtail
 
@@ -58,6 +58,15 @@ public:
         }
     }
 
+    void ProduceBatchAsync(const std::string& topic,
+                           std::vector<Message>& messages,
+                           const Callback& callback) override {
+        ++mBatchCount;
+        for (auto& message : messages) {
+            ProduceAsync(topic, std::move(message.value), callback, message.key);
+        }
+    }
+
     bool Flush(int timeoutMs) override {
         mFlushCalled = true;
 
@@ -112,6 +121,8 @@ public:
     const std::vector<ProduceRequest>& GetRequests() const { return mRequests; }
     const std::vector<ProduceRequest>& GetCompletedRequests() const { return mCompletedRequests; }
     size_t GetRequestCount() const { return mRequests.size() + mCompletedRequests.size(); }
+    size_t GetBatchCount() const { return mBatchCount; }
+    void ClearCompletedRequests() { mCompletedRequests.clear(); }
 
 private:
     bool mInitialized = false;
@@ -120,6 +131,7 @@ private:
     bool mInitSuccess = true;
     bool mFlushSuccess = true;
     bool mAutoComplete = true;
+    size_t mBatchCount = 0;
 
     KafkaConfig mConfig;
     std::vector<ProduceRequest> mRequests;
@@ -17,6 +17,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -36,6 +37,7 @@ public:
     void TestLoadStatParsing();
     void TestNetDevParsing();
     void TestFieldAccess();
+    void TestIndexedFieldAccess();
     void TestProcessCredParsing();
     void TestIPv6InterfaceParsing();
     void TestUptimeParsing();
@@ -370,7 +372,7 @@ void FastFieldParserBenchmark::TestNetDevParsing() {
     // Fast版本网络设备解析
     auto parseNetDevFast = [](const string& line) -> pair<string, vector<uint64_t>> {
         NetDevParser parser(line);
-        string_view deviceNameView;
+        StringView deviceNameView;
         vector<uint64_t> stats;
 
         if (parser.ParseDeviceStats(deviceNameView, stats)) {
@@ -450,7 +452,7 @@ void FastFieldParserBenchmark::TestFieldAccess() {
     };
 
     // Fast版本 - 直接访问
-    auto accessFast = [&](size_t index) -> string_view { return FastParse::GetField(testLine, index); };
+    auto accessFast = [&](size_t index) -> StringView { return FastParse::GetField(testLine, index); };
 
     // 验证正确性
     for (size_t i = 0; i < 10; ++i) {
@@ -499,6 +501,78 @@ void FastFieldParserBenchmark::TestFieldAccess() {
     APSARA_TEST_EQUAL(boostSum, fastSum);
 }
 
+void FastFieldParserBenchmark::TestIndexedFieldAccess() {
+    cout << "\n=== 字段索引访问性能测试 ===\n";
+
+    vector<string> lines = {cpuTestLines[0],
+                            "   8       0 sda 2918523 59120 188520186 1542712 29811282 14285366 898408880 33431400 0 "
+                            "11587620 35143000 0 0 0 0",
+                            "  eth0: 1234567890 123456 0 0 0 0 0 0 987654321 98765 0 0 0 0 0 0"};
+
+    // 原实现 - 每次访问字段都从行首顺序查找
+    auto sumSequential = [](const string& line) -> uint64_t {
+        StringView delimiter(" ");
+        StringViewSplitter splitter(line, delimiter, true);
+        size_t count = 0;
+        for (auto iter = splitter.begin(); iter != splitter.end(); ++iter) {
+            ++count;
+        }
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            auto iter = splitter.begin();
+            for (size_t j = 0; j < i; ++j) {
+                ++iter;
+            }
+            uint64_t value = 0;
+            sum += StringTo(*iter, value) ? value : 0;
+        }
+        return sum;
+    };
+
+    // 索引版本 - 一次遍历建立字段索引
+    auto sumIndexed = [](const string& line) -> uint64_t {
+        FastFieldParser parser(line);
+        size_t count = parser.GetFieldCount();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += parser.GetFieldAs<uint64_t>(i, 0);
+        }
+        return sum;
+    };
+
+    for (const auto& line : lines) {
+        APSARA_TEST_EQUAL(sumSequential(line), sumIndexed(line));
+    }
+    cout << "✅ 结果正确性验证通过\n";
+
+    auto start = chrono::high_resolution_clock::now();
+    volatile uint64_t sequentialSum = 0;
+    for (int iter = 0; iter < benchmarkIterations; ++iter) {
+        for (const auto& line : lines) {
+            sequentialSum += sumSequential(line);
+        }
+    }
+    auto sequentialEnd = chrono::high_resolution_clock::now();
+    volatile uint64_t indexedSum = 0;
+    for (int iter = 0; iter < benchmarkIterations; ++iter) {
+        for (const auto& line : lines) {
+            indexedSum += sumIndexed(line);
+        }
+    }
+    auto indexedEnd = chrono::high_resolution_clock::now();
+
+    auto sequentialTime = chrono::duration_cast<chrono::microseconds>(sequentialEnd - start);
+    auto indexedTime = chrono::duration_cast<chrono::microseconds>(indexedEnd - sequentialEnd);
+    double speedup = static_cast<double>(sequentialTime.count()) / indexedTime.count();
+
+    cout << "/proc/stat, /proc/diskstats, /proc/net/dev 全字段访问 (" << benchmarkIterations << " 次迭代):\n";
+    cout << "  顺序查找:        " << sequentialTime.count() << " μs\n";
+    cout << "  字段索引:        " << indexedTime.count() << " μs\n";
+    cout << "  加速比:          " << fixed << setprecision(2) << speedup << "x\n";
+
+    APSARA_TEST_EQUAL(sequentialSum, indexedSum);
+}
+
 void FastFieldParserBenchmark::TestProcessCredParsing() {
     cout << "\n=== 进程凭据解析性能测试 ===\n";
 
@@ -652,7 +726,7 @@ void FastFieldParserBenchmark::TestBatchFieldParsing() {
     const string testLine = "123 456 789 101112 131415 161718 192021 222324 252627 282930 313233 343536 373839 404142";
     const int numFields = 14; // 模拟磁盘状态的14个字段
 
-    // Fast版本 - 逐个调用（原方式）
+    // Fast版本 - 按索引逐个获取
     auto parseIndividual = [&]() -> vector<uint64_t> {
         vector<uint64_t> result;
         FastFieldParser parser(testLine);
@@ -662,10 +736,16 @@ void FastFieldParserBenchmark::TestBatchFieldParsing() {
         return result;
     };
 
-    // Fast版本 - 批量调用（新优化）
+    // Fast版本 - 迭代器顺序遍历
     auto parseBatch = [&]() -> vector<uint64_t> {
+        vector<uint64_t> result;
         FastFieldParser parser(testLine);
-        return parser.GetFieldsAs<uint64_t>(0, numFields, 0);
+        auto iter = parser.begin();
+        for (int i = 0; i < numFields && iter != parser.end(); ++i, ++iter) {
+            uint64_t value;
+            result.push_back(StringTo(*iter, value) ? value : 0);
+        }
+        return result;
     };
 
     // 验证正确性
@@ -709,11 +789,10 @@ void FastFieldParserBenchmark::TestBatchFieldParsing() {
     double speedup = static_cast<double>(individualTime.count()) / batchTime.count();
 
     cout << "批量字段解析 (" << benchmarkIterations << " 次迭代, " << numFields << " 字段):\n";
-    cout << "  逐个调用:        " << individualTime.count() << " μs (14次遍历)\n";
-    cout << "  批量调用:        " << batchTime.count() << " μs (1次遍历)\n";
+    cout << "  字段索引:        " << individualTime.count() << " μs\n";
+    cout << "  迭代器遍历:      " << batchTime.count() << " μs\n";
     cout << "  加速比:          " << fixed << setprecision(2) << speedup << "x\n";
     cout << "  校验和:          " << individualSum << " vs " << batchSum << "\n";
-    cout << "  遍历减少:        " << fixed << setprecision(1) << (14.0 / 1.0) << "x (从14次到1次)\n";
 
     APSARA_TEST_EQUAL(individualSum, batchSum);
 }
@@ -738,9 +817,13 @@ void FastFieldParserBenchmark::TestProcessMemoryParsing() {
         return {0, 0, 0};
     };
 
-    // Fast版本 - 批量解析
+    // Fast版本 - 按索引解析
     auto parseMemFast = [&]() -> tuple<uint64_t, uint64_t, uint64_t> {
-        auto memValues = FastParse::GetFieldsAs<uint64_t>(memLine, 0, 3, 0);
+        FastFieldParser parser(memLine);
+        vector<uint64_t> memValues;
+        for (size_t i = 0; i < 3; ++i) {
+            memValues.push_back(parser.GetFieldAs<uint64_t>(i, 0));
+        }
 
         if (memValues.size() >= 3) {
             uint64_t size = memValues[0] * PAGE_SIZE;
@@ -897,6 +980,10 @@ TEST_F(FastFieldParserBenchmark, FieldAccess) {
     TestFieldAccess();
 }
 
+TEST_F(FastFieldParserBenchmark, IndexedFieldAccess) {
+    TestIndexedFieldAccess();
+}
+
 TEST_F(FastFieldParserBenchmark, ProcessCredParsing) {
     TestProcessCredParsing();
 }
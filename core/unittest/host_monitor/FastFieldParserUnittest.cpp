@@ -30,6 +30,8 @@ public:
     void TestNetDevParser();
     void TestEdgeCases();
     void TestFastParseNamespace();
+    void TestFieldIndex();
+    void TestParseUnsigned();
 
 protected:
     void SetUp() override {
@@ -224,6 +226,54 @@ void FastFieldParserUnittest::TestFastParseNamespace() {
     APSARA_TEST_EQUAL("c", string(FastParse::GetField(csvLine, 2, ',')));
 }
 
+void FastFieldParserUnittest::TestFieldIndex() {
+    // 与 StringViewSplitter 的结果逐一对比，覆盖 16 字节块边界上的分隔符
+    vector<string> lines = {"",
+                            "a",
+                            "0123456789abcdef",
+                            "0123456789abcde 0123456789abcdef",
+                            "               a               b                ",
+                            "  8  0 sda 2918523 59120 188520186 1542712 29811282 14285366 898408880 33431400 0 11587620"};
+    for (const auto& line : lines) {
+        FastFieldParser parser(line);
+        StringViewSplitter splitter(line, " ", true);
+        size_t i = 0;
+        for (auto iter = splitter.begin(); iter != splitter.end(); ++iter, ++i) {
+            APSARA_TEST_EQUAL(string(*iter), string(parser.GetField(i)));
+        }
+        APSARA_TEST_EQUAL(i, parser.GetFieldCount());
+        APSARA_TEST_TRUE(parser.GetField(i).empty());
+    }
+
+    // 超过 kMaxIndexedFields 的字段退化为顺序查找
+    string longLine;
+    size_t fieldCount = FastFieldParser::kMaxIndexedFields * 2 + 3;
+    for (size_t i = 0; i < fieldCount; ++i) {
+        longLine += "  " + to_string(i);
+    }
+    FastFieldParser longParser(longLine);
+    APSARA_TEST_EQUAL(fieldCount, longParser.GetFieldCount());
+    for (size_t i = 0; i < fieldCount; ++i) {
+        APSARA_TEST_EQUAL(i, longParser.GetFieldAs<size_t>(i));
+    }
+    APSARA_TEST_TRUE(longParser.GetField(fieldCount).empty());
+}
+
+void FastFieldParserUnittest::TestParseUnsigned() {
+    // 与 StringTo (std::from_chars) 的语义保持一致
+    string line = "0 18446744073709551615 18446744073709551616 +1 -1 12a 0000000000000000000000042 4294967296";
+    FastFieldParser parser(line);
+    APSARA_TEST_EQUAL(0ULL, parser.GetFieldAs<uint64_t>(0, 7));
+    APSARA_TEST_EQUAL(18446744073709551615ULL, parser.GetFieldAs<uint64_t>(1, 7));
+    APSARA_TEST_EQUAL(7ULL, parser.GetFieldAs<uint64_t>(2, 7));
+    APSARA_TEST_EQUAL(7ULL, parser.GetFieldAs<uint64_t>(3, 7));
+    APSARA_TEST_EQUAL(7ULL, parser.GetFieldAs<uint64_t>(4, 7));
+    APSARA_TEST_EQUAL(7ULL, parser.GetFieldAs<uint64_t>(5, 7));
+    APSARA_TEST_EQUAL(42ULL, parser.GetFieldAs<uint64_t>(6, 7));
+    APSARA_TEST_EQUAL(7U, parser.GetFieldAs<uint32_t>(7, 7));
+    APSARA_TEST_EQUAL(4294967296.0, parser.GetFieldAs<double>(7));
+}
+
 // 注册测试用例
 TEST_F(FastFieldParserUnittest, BasicFieldAccess) {
     TestBasicFieldAccess();
@@ -249,6 +299,14 @@ TEST_F(FastFieldParserUnittest, FastParseNamespace) {
     TestFastParseNamespace();
 }
 
+TEST_F(FastFieldParserUnittest, FieldIndex) {
+    TestFieldIndex();
+}
+
+TEST_F(FastFieldParserUnittest, ParseUnsigned) {
+    TestParseUnsigned();
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <thread>
 
 #include "host_monitor/SystemInterface.h"
@@ -207,7 +208,7 @@ private:
     }
 
     int64_t mBlockTime = 0;
-    int64_t mMockCalledCount = 0;
+    std::atomic_int64_t mMockCalledCount = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class SystemInterfaceUnittest;
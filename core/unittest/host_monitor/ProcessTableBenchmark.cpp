@@ -0,0 +1,134 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "host_monitor/Constants.h"
+#include "host_monitor/SystemInterface.h"
+#include "host_monitor/common/ProcessTable.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr int kProcessCnt = 5000;
+constexpr int kRoundCnt = 20;
+constexpr size_t kTopN = 5;
+
+} // namespace
+
+class ProcessTableBenchmark : public testing::Test {
+public:
+    void TestListAndSort();
+    void TestProcessTable();
+
+protected:
+    void SetUp() override {
+        // fake /proc on tmpfs, so that the cost of syscalls rather than disk io is measured
+        mRoot = bfs::exists("/dev/shm") ? "/dev/shm/process_table_benchmark" : "./process_table_benchmark";
+        for (int i = 1; i <= kProcessCnt; ++i) {
+            bfs::create_directories(mRoot + "/" + to_string(i));
+            WriteStat(i, 0);
+        }
+        mOldProcessDir = PROCESS_DIR;
+        PROCESS_DIR = mRoot;
+    }
+
+    void TearDown() override {
+        PROCESS_DIR = mOldProcessDir;
+        bfs::remove_all(mRoot);
+    }
+
+    void WriteStat(pid_t pid, int round) const {
+        ofstream ofs(mRoot + "/" + to_string(pid) + "/stat", std::ios::trunc);
+        ofs << pid << " (worker-" << pid << ") S 1 1 1 0 -1 4194560 1110 0 0 0 " << pid * (round + 1) << " "
+            << pid % 100 * (round + 1) << " 0 0 20 0 1 0 18938584 4505600 171 18446744073709551615 4194304 4238788 "
+            << "140727020025920 0 0 0 0 0 0 0 0 0 17 3 0 0 0 0 0 6336016 6337300 21442560 140727020027760 "
+            << "140727020027777 140727020027777 140727020027887 0\n";
+    }
+
+    template <class Func>
+    void Run(const string& name, Func&& collect);
+
+    string mRoot;
+    std::filesystem::path mOldProcessDir;
+};
+
+template <class Func>
+void ProcessTableBenchmark::Run(const string& name, Func&& collect) {
+    chrono::duration<double> elapsed{0};
+    for (int round = 0; round < kRoundCnt; ++round) {
+        // only a few processes change between ticks
+        for (int i = 1; i <= kProcessCnt; i += 100) {
+            WriteStat(i, round);
+        }
+        auto start = chrono::high_resolution_clock::now();
+        vector<pair<pid_t, ProcessCpuInformation>> top = collect(round);
+        elapsed += chrono::high_resolution_clock::now() - start;
+    }
+    cout << "[" << name << "] processes: " << kProcessCnt << ", ticks: " << kRoundCnt
+         << ", avg: " << elapsed.count() * 1000 / kRoundCnt << " ms/tick" << endl;
+}
+
+void ProcessTableBenchmark::TestListAndSort() {
+    // what ProcessCollector did before: list all pids, read every stat file and sort all pids
+    time_t now = time(nullptr);
+    Run("list and sort", [&](int round) {
+        ProcessListInformation processListInfo;
+        SystemInterface::GetInstance()->GetProcessListInformation(now + round, processListInfo);
+        vector<pair<pid_t, ProcessCpuInformation>> cpuInfos;
+        for (auto pid : processListInfo.pids) {
+            ProcessInformation processInfo;
+            if (!SystemInterface::GetInstance()->GetProcessInformation(now + round, pid, processInfo)) {
+                continue;
+            }
+            ProcessCpuInformation info;
+            info.total = processInfo.stat.utimeTicks + processInfo.stat.stimeTicks + processInfo.stat.cutimeTicks
+                + processInfo.stat.cstimeTicks;
+            info.percent = static_cast<double>(info.total);
+            cpuInfos.emplace_back(pid, info);
+        }
+        sort(cpuInfos.begin(), cpuInfos.end(), [](const auto& a, const auto& b) {
+            return a.second.percent > b.second.percent;
+        });
+        cpuInfos.resize(min(kTopN, cpuInfos.size()));
+        return cpuInfos;
+    });
+}
+
+void ProcessTableBenchmark::TestProcessTable() {
+    ProcessTable table(kProcessCnt);
+    auto now = chrono::steady_clock::now();
+    Run("process table", [&](int round) {
+        table.Update(now + chrono::seconds(round));
+        vector<pair<pid_t, ProcessCpuInformation>> top;
+        table.GetTopN(kTopN, top);
+        return top;
+    });
+}
+
+UNIT_TEST_CASE(ProcessTableBenchmark, TestListAndSort);
+UNIT_TEST_CASE(ProcessTableBenchmark, TestProcessTable);
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
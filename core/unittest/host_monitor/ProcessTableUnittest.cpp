@@ -0,0 +1,183 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include "host_monitor/Constants.h"
+#include "host_monitor/common/ProcessTable.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ProcessTableUnittest : public testing::Test {
+public:
+    void TestUpdate() const;
+    void TestProcessExitAndReuse() const;
+    void TestGetTopN() const;
+    void TestGetTopNAcrossUpdates() const;
+    void TestMaxCachedFds() const;
+
+protected:
+    void SetUp() override {
+        bfs::create_directories(mRoot);
+        WriteStat(100, 1000, 100, 10);
+        WriteStat(200, 2000, 200, 20);
+        WriteStat(300, 3000, 300, 30);
+        mOldProcessDir = PROCESS_DIR;
+        PROCESS_DIR = mRoot;
+    }
+
+    void TearDown() override {
+        PROCESS_DIR = mOldProcessDir;
+        bfs::remove_all(mRoot);
+    }
+
+    void WriteStat(pid_t pid, uint64_t startTicks, uint64_t utime, uint64_t stime) const {
+        bfs::create_directories(mRoot + "/" + to_string(pid));
+        // 覆盖写，保持 inode 不变，与 /proc 下的文件行为一致
+        ofstream ofs(mRoot + "/" + to_string(pid) + "/stat", std::ios::trunc);
+        ofs << pid << " (proc " << pid << ") S 1 1 1 0 -1 4194560 100 0 0 0 " << utime << " " << stime
+            << " 0 0 20 0 1 0 " << startTicks << " 4505600 171 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 3 0 0 0 "
+            << "0 0 0 0 0 0 0 0 0 0\n";
+    }
+
+    const string mRoot = "./process_table_test";
+    std::filesystem::path mOldProcessDir;
+};
+
+void ProcessTableUnittest::TestUpdate() const {
+    ProcessTable table(16);
+    auto now = std::chrono::steady_clock::now();
+    APSARA_TEST_TRUE(table.Update(now));
+    APSARA_TEST_EQUAL(3U, table.Size());
+    APSARA_TEST_EQUAL(3U, table.CachedFdCount());
+    for (const auto& [pid, entry] : table.mEntries) {
+        APSARA_TEST_EQUAL(0.0, entry.cpu.percent);
+    }
+    APSARA_TEST_EQUAL(110U, table.mEntries.at(100).cpu.total);
+
+    // the kept fds are read again, nothing is reopened
+    WriteStat(100, 1000, 100 + SYSTEM_HERTZ / 2, 10);
+    APSARA_TEST_TRUE(table.Update(now + std::chrono::seconds(1)));
+    APSARA_TEST_EQUAL(3U, table.CachedFdCount());
+    const auto& cpu = table.mEntries.at(100).cpu;
+    APSARA_TEST_EQUAL(static_cast<uint64_t>(110 + SYSTEM_HERTZ / 2), cpu.total);
+    // same formula as before: ticks elapsed / milliseconds elapsed
+    EXPECT_NEAR(100.0 * (SYSTEM_HERTZ / 2) / 1000, cpu.percent, 1e-6);
+    APSARA_TEST_EQUAL(0.0, table.mEntries.at(200).cpu.percent);
+}
+
+void ProcessTableUnittest::TestProcessExitAndReuse() const {
+    ProcessTable table(16);
+    auto now = std::chrono::steady_clock::now();
+    APSARA_TEST_TRUE(table.Update(now));
+
+    bfs::remove_all(mRoot + "/200");
+    // pid 300 is reused by a new process with less cpu time
+    WriteStat(300, 5000, 1, 1);
+    WriteStat(400, 4000, 400, 40);
+    APSARA_TEST_TRUE(table.Update(now + std::chrono::seconds(1)));
+    APSARA_TEST_EQUAL(3U, table.Size());
+    APSARA_TEST_EQUAL(3U, table.CachedFdCount());
+    APSARA_TEST_TRUE(table.mEntries.find(200) == table.mEntries.end());
+    APSARA_TEST_EQUAL(0.0, table.mEntries.at(300).cpu.percent);
+    APSARA_TEST_EQUAL(5000, table.mEntries.at(300).cpu.startTime);
+    APSARA_TEST_EQUAL(0.0, table.mEntries.at(400).cpu.percent);
+}
+
+void ProcessTableUnittest::TestGetTopN() const {
+    ProcessTable table(16);
+    auto now = std::chrono::steady_clock::now();
+    APSARA_TEST_TRUE(table.Update(now));
+    WriteStat(100, 1000, 100 + 10, 10);
+    WriteStat(200, 2000, 200 + 30, 20);
+    WriteStat(300, 3000, 300 + 20, 30);
+    APSARA_TEST_TRUE(table.Update(now + std::chrono::seconds(1)));
+
+    std::vector<std::pair<pid_t, ProcessCpuInformation>> top;
+    table.GetTopN(2, top);
+    APSARA_TEST_EQUAL(2U, top.size());
+    APSARA_TEST_EQUAL(200, top[0].first);
+    APSARA_TEST_EQUAL(300, top[1].first);
+
+    table.GetTopN(10, top);
+    APSARA_TEST_EQUAL(3U, top.size());
+    APSARA_TEST_EQUAL(200, top[0].first);
+    APSARA_TEST_EQUAL(300, top[1].first);
+    APSARA_TEST_EQUAL(100, top[2].first);
+}
+
+void ProcessTableUnittest::TestGetTopNAcrossUpdates() const {
+    const size_t topN = 5;
+    for (int pid = 1; pid <= 50; ++pid) {
+        WriteStat(pid, pid, pid, pid);
+    }
+    ProcessTable table(64);
+    auto now = std::chrono::steady_clock::now();
+    APSARA_TEST_TRUE(table.Update(now));
+    // only a few processes change between ticks, the top ones are the same as sorting all of them
+    for (int round = 1; round <= 5; ++round) {
+        for (int pid = round; pid <= 50; pid += 7) {
+            WriteStat(pid, pid, pid + pid * round * 10, pid);
+        }
+        APSARA_TEST_TRUE(table.Update(now + std::chrono::seconds(round)));
+
+        std::vector<std::pair<pid_t, double>> expected;
+        for (const auto& [pid, entry] : table.mEntries) {
+            expected.emplace_back(pid, entry.cpu.percent);
+        }
+        std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        });
+        std::vector<std::pair<pid_t, ProcessCpuInformation>> top;
+        table.GetTopN(topN, top);
+        APSARA_TEST_EQUAL_FATAL(topN, top.size());
+        for (size_t i = 0; i < topN; ++i) {
+            APSARA_TEST_EQUAL(expected[i].second, top[i].second.percent);
+        }
+        APSARA_TEST_EQUAL(expected[0].first, top[0].first);
+    }
+}
+
+void ProcessTableUnittest::TestMaxCachedFds() const {
+    ProcessTable table(1);
+    auto now = std::chrono::steady_clock::now();
+    APSARA_TEST_TRUE(table.Update(now));
+    APSARA_TEST_EQUAL(3U, table.Size());
+    APSARA_TEST_EQUAL(1U, table.CachedFdCount());
+
+    // processes without kept fds are still updated
+    for (auto pid : {100, 200, 300}) {
+        WriteStat(pid, pid * 10, pid + 10, pid / 10);
+    }
+    APSARA_TEST_TRUE(table.Update(now + std::chrono::seconds(1)));
+    for (const auto& [pid, entry] : table.mEntries) {
+        APSARA_TEST_TRUE(entry.cpu.percent > 0.0);
+    }
+}
+
+UNIT_TEST_CASE(ProcessTableUnittest, TestUpdate);
+UNIT_TEST_CASE(ProcessTableUnittest, TestProcessExitAndReuse);
+UNIT_TEST_CASE(ProcessTableUnittest, TestGetTopN);
+UNIT_TEST_CASE(ProcessTableUnittest, TestGetTopNAcrossUpdates);
+UNIT_TEST_CASE(ProcessTableUnittest, TestMaxCachedFds);
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,87 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "host_monitor/SystemInterface.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr int kConfigCnt = 10;
+constexpr int kTickCnt = 5;
+// host-wide information requested by each config at every tick
+constexpr int kReadsPerTick = 5;
+
+} // namespace
+
+class SystemInterfaceBenchmark : public testing::Test {
+public:
+    void TestConcurrentConfigs();
+};
+
+void SystemInterfaceBenchmark::TestConcurrentConfigs() {
+    auto* systemInterface = SystemInterface::GetInstance();
+    auto readsBefore = systemInterface->mReadsTotal->GetValue();
+    auto savedBefore = systemInterface->mReadsSavedTotal->GetValue();
+
+    chrono::duration<double> elapsed{0};
+    for (int tick = 0; tick < kTickCnt; ++tick) {
+        // wait for the next second, just as collectors scheduled at the same interval do
+        // time() is coarse and lags behind system_clock for a few milliseconds
+        time_t now = time(nullptr) + 1;
+        this_thread::sleep_until(chrono::system_clock::from_time_t(now) + chrono::milliseconds(20));
+
+        auto start = chrono::high_resolution_clock::now();
+        vector<thread> configs;
+        for (int i = 0; i < kConfigCnt; ++i) {
+            configs.emplace_back([systemInterface, now]() {
+                CPUInformation cpuInfo;
+                MemoryInformation memInfo;
+                SystemLoadInformation loadInfo;
+                DiskStateInformation diskInfo;
+                SystemUptimeInformation uptimeInfo;
+                APSARA_TEST_TRUE(systemInterface->GetCPUInformation(now, cpuInfo));
+                APSARA_TEST_TRUE(systemInterface->GetHostMemInformationStat(now, memInfo));
+                APSARA_TEST_TRUE(systemInterface->GetSystemLoadInformation(now, loadInfo));
+                APSARA_TEST_TRUE(systemInterface->GetDiskStateInformation(now, diskInfo));
+                APSARA_TEST_TRUE(systemInterface->GetSystemUptimeInformation(now, uptimeInfo));
+            });
+        }
+        for (auto& config : configs) {
+            config.join();
+        }
+        elapsed += chrono::high_resolution_clock::now() - start;
+    }
+
+    auto reads = systemInterface->mReadsTotal->GetValue() - readsBefore;
+    auto saved = systemInterface->mReadsSavedTotal->GetValue() - savedBefore;
+    cout << "[concurrent configs] configs: " << kConfigCnt << ", ticks: " << kTickCnt
+         << ", avg: " << elapsed.count() * 1000 / kTickCnt << " ms/tick" << endl;
+    cout << "[concurrent configs] reads: " << reads << ", saved: " << saved
+         << ", reads without sharing: " << kConfigCnt * kTickCnt * kReadsPerTick << endl;
+}
+
+UNIT_TEST_CASE(SystemInterfaceBenchmark, TestConcurrentConfigs);
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
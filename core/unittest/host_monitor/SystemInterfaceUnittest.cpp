@@ -17,6 +17,7 @@
 #include <chrono>
 #include <future>
 #include <thread>
+#include <vector>
 
 #include "common/Flags.h"
 #include "host_monitor/SystemInterface.h"
@@ -380,6 +381,56 @@ void SystemInterfaceUnittest::TestMemoizedCall() const {
         mockSystemInterface.GetProcessInformation(now, 1, info);
         APSARA_TEST_EQUAL_FATAL(1, mockSystemInterface.mMockCalledCount);
     }
+    {
+        // configs collecting at the same tick share one read
+        MockSystemInterface mockSystemInterface;
+        mockSystemInterface.mBlockTime = 50;
+        mockSystemInterface.mMockCalledCount = 0;
+        auto now = time(nullptr);
+        std::vector<std::future<bool>> futures;
+        for (int i = 0; i < 10; ++i) {
+            futures.push_back(async(std::launch::async, [&]() {
+                CPUInformation info;
+                return mockSystemInterface.GetCPUInformation(now, info);
+            }));
+        }
+        for (auto& future : futures) {
+            APSARA_TEST_TRUE_FATAL(future.get());
+        }
+        APSARA_TEST_EQUAL_FATAL(1, mockSystemInterface.mMockCalledCount);
+        APSARA_TEST_EQUAL_FATAL(1U, mockSystemInterface.mReadsTotal->GetValue());
+        APSARA_TEST_EQUAL_FATAL(9U, mockSystemInterface.mReadsSavedTotal->GetValue());
+    }
+    {
+        // each host-wide type is read once per tick, no matter how many configs request it
+        MockSystemInterface mockSystemInterface;
+        mockSystemInterface.mBlockTime = 10;
+        mockSystemInterface.mMockCalledCount = 0;
+        auto now = time(nullptr);
+        const int configCnt = 10;
+        std::vector<std::future<bool>> futures;
+        for (int i = 0; i < configCnt; ++i) {
+            futures.push_back(async(std::launch::async, [&]() {
+                CPUInformation cpuInfo;
+                MemoryInformation memInfo;
+                SystemLoadInformation loadInfo;
+                DiskStateInformation diskInfo;
+                SystemUptimeInformation uptimeInfo;
+                return mockSystemInterface.GetCPUInformation(now, cpuInfo)
+                    && mockSystemInterface.GetHostMemInformationStat(now, memInfo)
+                    && mockSystemInterface.GetSystemLoadInformation(now, loadInfo)
+                    && mockSystemInterface.GetDiskStateInformation(now, diskInfo)
+                    && mockSystemInterface.GetSystemUptimeInformation(now, uptimeInfo);
+            }));
+        }
+        for (auto& future : futures) {
+            APSARA_TEST_TRUE_FATAL(future.get());
+        }
+        APSARA_TEST_EQUAL_FATAL(5, mockSystemInterface.mMockCalledCount);
+        APSARA_TEST_EQUAL_FATAL(5U, mockSystemInterface.mReadsTotal->GetValue());
+        APSARA_TEST_EQUAL_FATAL(static_cast<uint64_t>(configCnt * 5 - 5),
+                                mockSystemInterface.mReadsSavedTotal->GetValue());
+    }
 
     // restore flags
     INT32_FLAG(system_interface_cache_queue_size) = defaultCacheSize;
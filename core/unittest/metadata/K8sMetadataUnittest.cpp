@@ -12,16 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "common/http/HttpResponse.h"
 #include "metadata/K8sMetadata.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 
 using namespace std;
 
+DECLARE_FLAG_INT32(k8s_metadata_not_found_cid_ttl_sec);
+
 namespace logtail {
 class k8sMetadataUnittest : public ::testing::Test {
 protected:
@@ -308,6 +314,91 @@ public:
         APSARA_TEST_EQUAL(req->mMethod, "GET");
         APSARA_TEST_EQUAL(req->mUrl, "/metadata/host");
     }
+
+    void TestNotFoundContainerIdCache() {
+        auto& metadata = K8sMetadata::GetInstance();
+        const std::string foundCid = "found-cid-0001";
+        const std::string missingCid = "missing-cid-0001";
+        // response of the metadata server only contains the found one
+        HttpResponse response;
+        response.SetStatusCode(200);
+        response.SetBody(std::string(R"({")") + foundCid
+                         + R"(":{"namespace":"default","workloadName":"demo","workloadKind":"deployment",)"
+                         + R"("labels":{},"images":{}}})");
+        std::vector<std::string> resKey;
+        APSARA_TEST_TRUE(metadata.HandleResponse(response, PodInfoType::ContainerIdInfo, resKey));
+        metadata.UpdateNotFoundCidCache({foundCid, missingCid}, resKey);
+
+        APSARA_TEST_TRUE(metadata.GetInfoByContainerIdFromCache(foundCid) != nullptr);
+        APSARA_TEST_FALSE(metadata.IsNotFoundContainerId(foundCid));
+        APSARA_TEST_TRUE(metadata.IsNotFoundContainerId(missingCid));
+
+        // negative result is cached, so no new query is scheduled
+        metadata.AsyncQueryMetadata(PodInfoType::ContainerIdInfo, missingCid);
+        {
+            std::unique_lock<std::mutex> lock(metadata.mStateMux);
+            APSARA_TEST_EQUAL(0UL, metadata.mPendingKeys.count(missingCid));
+        }
+
+        // expired
+        INT32_FLAG(k8s_metadata_not_found_cid_ttl_sec) = 0;
+        APSARA_TEST_FALSE(metadata.IsNotFoundContainerId(missingCid));
+        INT32_FLAG(k8s_metadata_not_found_cid_ttl_sec) = 60;
+
+        // found later
+        metadata.UpdateNotFoundCidCache({missingCid}, {});
+        APSARA_TEST_TRUE(metadata.IsNotFoundContainerId(missingCid));
+        metadata.SetContainerCache(missingCid, std::make_shared<K8sPodInfo>());
+        APSARA_TEST_FALSE(metadata.IsNotFoundContainerId(missingCid));
+    }
+
+    void TestConcurrentLookup() {
+        auto& metadata = K8sMetadata::GetInstance();
+        const size_t kCidNum = 512;
+        const size_t kReaderNum = 16;
+        const size_t kLookupPerReader = 100000;
+        std::vector<std::string> cids;
+        for (size_t i = 0; i < kCidNum; ++i) {
+            cids.emplace_back("3f2b9c7e1d5a4b6c8e0f1a2b3c4d5e6f7a8b9c0d1e2f3a4b5c6d7e8f9a" + std::to_string(1000 + i));
+            auto info = std::make_shared<K8sPodInfo>();
+            info->mPodName = "pod-" + std::to_string(i);
+            metadata.SetContainerCache(cids.back(), info);
+        }
+
+        std::atomic_bool stop = false;
+        // a writer keeps refreshing entries, as the batch query thread does
+        std::thread writer([&]() {
+            size_t i = 0;
+            while (!stop) {
+                metadata.SetContainerCache(cids[i++ % kCidNum], std::make_shared<K8sPodInfo>());
+            }
+        });
+        std::atomic_size_t hits = 0;
+        std::vector<std::thread> readers;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < kReaderNum; ++r) {
+            readers.emplace_back([&, r]() {
+                size_t localHits = 0;
+                for (size_t i = 0; i < kLookupPerReader; ++i) {
+                    if (metadata.GetInfoByContainerIdFromCache(cids[(i + r) % kCidNum]) != nullptr) {
+                        ++localHits;
+                    }
+                }
+                hits += localHits;
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        stop = true;
+        writer.join();
+
+        APSARA_TEST_EQUAL(kReaderNum * kLookupPerReader, hits.load());
+        LOG_INFO(sLogger,
+                 ("reader threads", kReaderNum)("lookups", kReaderNum * kLookupPerReader)(
+                     "avg lookup latency ns", duration.count() * kReaderNum / (kReaderNum * kLookupPerReader)));
+    }
 };
 
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestGetByContainerIds, 0);
@@ -316,6 +407,8 @@ APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestExternalIpOperations, 2);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAsyncQueryMetadata, 3);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestNetworkCheck, 4);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestBuildAsyncQuery, 5);
+APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestNotFoundContainerIdCache, 6);
+APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestConcurrentLookup, 7);
 
 } // end of namespace logtail
 
@@ -51,6 +51,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(1U, config->mPriority);
     APSARA_TEST_FALSE(config->mEnableTimestampNanosecond);
     APSARA_TEST_FALSE(config->mUsingOldContentTag);
+    APSARA_TEST_FALSE(config->mEnableOrderedProcessing);
 
     // valid optional param
     configStr = R"(
@@ -59,7 +60,8 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
             "TopicFormat": "test_topic",
             "Priority": 1,
             "EnableTimestampNanosecond": true,
-            "UsingOldContentTag": true
+            "UsingOldContentTag": true,
+            "EnableOrderedProcessing": true
         }
     )";
     APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -71,6 +73,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(1U, config->mPriority);
     APSARA_TEST_TRUE(config->mEnableTimestampNanosecond);
     APSARA_TEST_TRUE(config->mUsingOldContentTag);
+    APSARA_TEST_TRUE(config->mEnableOrderedProcessing);
 
     // invalid optional param
     configStr = R"(
@@ -79,7 +82,8 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
             "TopicFormat": true,
             "Priority": "1",
             "EnableTimestampNanosecond": "true",
-            "UsingOldContentTag": "true"
+            "UsingOldContentTag": "true",
+            "EnableOrderedProcessing": "true"
         }
     )";
     APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -91,6 +95,7 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(1U, config->mPriority);
     APSARA_TEST_FALSE(config->mEnableTimestampNanosecond);
     APSARA_TEST_FALSE(config->mUsingOldContentTag);
+    APSARA_TEST_FALSE(config->mEnableOrderedProcessing);
 
     // topicFormat
     configStr = R"(
@@ -0,0 +1,114 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/ProcessReorderBuffer.h"
+#include "common/TimeUtil.h"
+#include "plugin/processor/ProcessorParseRegexNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+// Items of one queue are processed by several threads, and the results are sent either as soon as they are ready
+// or in the pop order through ProcessReorderBuffer.
+static void BM_OrderedProcess(uint32_t threadCnt, bool ordered, int itemCnt, int eventCntPerItem) {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Regex"] = R"""((\S+)\s(\S+)\s\[([^\]]+)\]\s"(\w+)\s(\S+)\s([^"]+)"\s(\d+)\s(\d+))""";
+    config["Keys"] = Json::arrayValue;
+    for (const auto& key : {"ip", "user", "time", "method", "url", "protocol", "status", "size"}) {
+        config["Keys"].append(key);
+    }
+    ProcessorParseRegexNative processor;
+    processor.SetContext(ctx);
+    processor.CreateMetricsRecordRef(ProcessorParseRegexNative::sName, "1");
+    if (!processor.Init(config)) {
+        std::cout << "init failed" << std::endl;
+        return;
+    }
+    processor.CommitMetricsRecordRef();
+
+    const std::string line
+        = R"(10.200.98.220 - [18/Oct/2026:10:00:00 +0800] "GET /index.html HTTP/1.1" 200 1024)";
+    ProcessReorderBuffer buffer;
+    std::mutex queueMux;
+    int poppedCnt = 0;
+    std::atomic_uint64_t sentEventCnt = 0;
+
+    auto worker = [&]() {
+        while (true) {
+            uint64_t seqNo = 0;
+            {
+                std::lock_guard<std::mutex> lock(queueMux);
+                if (poppedCnt++ >= itemCnt) {
+                    break;
+                }
+                if (ordered) {
+                    seqNo = buffer.NextSeqNo();
+                }
+            }
+            std::vector<PipelineEventGroup> groupList;
+            groupList.emplace_back(std::make_shared<SourceBuffer>());
+            for (int i = 0; i < eventCntPerItem; ++i) {
+                groupList[0].AddLogEvent()->SetContent(std::string("content"), line);
+            }
+            processor.Process(groupList[0]);
+            if (!ordered) {
+                sentEventCnt += groupList[0].GetEvents().size();
+                continue;
+            }
+            if (!buffer.Push(seqNo, std::move(groupList))) {
+                continue;
+            }
+            std::vector<PipelineEventGroup> readyGroupList;
+            while (buffer.PopReady(readyGroupList)) {
+                sentEventCnt += readyGroupList[0].GetEvents().size();
+                readyGroupList.clear();
+            }
+        }
+    };
+
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t durationTime = GetCurrentTimeInMicroSeconds() - startTime;
+    std::cout << "threads: " << threadCnt << "\tordered: " << ordered << "\tdurationTime: " << durationTime
+              << "\tevents/s: " << sentEventCnt * 1000000 / durationTime << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (uint32_t threadCnt : {1, 2, 4, 8, 16}) {
+        BM_OrderedProcess(threadCnt, false, 2000, 1000);
+        BM_OrderedProcess(threadCnt, true, 2000, 1000);
+    }
+    return 0;
+}
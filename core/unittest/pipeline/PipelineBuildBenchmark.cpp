@@ -0,0 +1,137 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/CollectionPipeline.h"
+#include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/plugin/PluginRegistry.h"
+#include "common/JsonUtil.h"
+#include "config/CollectionConfig.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(pipeline_build_thread_num);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr size_t kConfigCnt = 1000;
+
+// a typical file collection config: regex parsing, multiline and sls flushing
+const string kConfigTemplate = R"JSON(
+    {
+        "inputs": [
+            {
+                "Type": "input_file",
+                "FilePaths": [
+                    "/var/log/app_${idx}/**/*.log"
+                ],
+                "MaxDirSearchDepth": 3,
+                "Multiline": {
+                    "StartPattern": "\\d{4}-\\d{2}-\\d{2}\\s\\d{2}:\\d{2}:\\d{2}.*"
+                }
+            }
+        ],
+        "processors": [
+            {
+                "Type": "processor_parse_regex_native",
+                "SourceKey": "content",
+                "Regex": "(\\S+)\\s(\\S+)\\s\\[([^\\]]+)\\]\\s\"(\\w+)\\s(\\S+)\\s([^\"]+)\"\\s(\\d+)\\s(\\d+)",
+                "Keys": ["ip", "user", "time", "method", "url", "protocol", "status", "size"]
+            },
+            {
+                "Type": "processor_filter_regex_native",
+                "Include": {
+                    "status": "[2-5]\\d{2}"
+                }
+            }
+        ],
+        "flushers": [
+            {
+                "Type": "flusher_sls",
+                "Project": "test_project",
+                "Logstore": "test_logstore_${idx}",
+                "Region": "test_region",
+                "Endpoint": "test_endpoint"
+            }
+        ]
+    }
+)JSON";
+
+} // namespace
+
+class PipelineBuildBenchmark : public testing::Test {
+public:
+    void TestBuildPipelines() const;
+
+protected:
+    static void SetUpTestCase() { PluginRegistry::GetInstance()->LoadPlugins(); }
+
+    static void TearDownTestCase() { PluginRegistry::GetInstance()->UnloadPlugins(); }
+
+private:
+    static vector<CollectionConfig> GenerateConfigs() {
+        vector<CollectionConfig> configs;
+        configs.reserve(kConfigCnt);
+        for (size_t i = 0; i < kConfigCnt; ++i) {
+            string configStr = kConfigTemplate;
+            for (auto pos = configStr.find("${idx}"); pos != string::npos; pos = configStr.find("${idx}")) {
+                configStr.replace(pos, 6, to_string(i));
+            }
+            auto configJson = make_unique<Json::Value>();
+            string errorMsg;
+            APSARA_TEST_TRUE(ParseJsonTable(configStr, *configJson, errorMsg));
+            configs.emplace_back("benchmark_config_" + to_string(i), std::move(configJson), filesystem::path("."));
+            APSARA_TEST_TRUE(configs.back().Parse());
+        }
+        return configs;
+    }
+};
+
+void PipelineBuildBenchmark::TestBuildPipelines() const {
+    for (int32_t threadNum : {1, 2, 4, 8}) {
+        INT32_FLAG(pipeline_build_thread_num) = threadNum;
+        auto configs = GenerateConfigs();
+        vector<CollectionConfig*> configPtrs;
+        for (auto& config : configs) {
+            configPtrs.push_back(&config);
+        }
+
+        auto start = chrono::steady_clock::now();
+        auto pipelines = CollectionPipelineManager::GetInstance()->BuildPipelines(configPtrs);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        size_t builtCnt = 0;
+        for (const auto& p : pipelines) {
+            builtCnt += p != nullptr;
+        }
+        APSARA_TEST_EQUAL(kConfigCnt, builtCnt);
+        cout << "threads: " << threadNum << "\tconfigs: " << kConfigCnt << "\tbuild time: " << elapsed.count() * 1000
+             << " ms" << endl;
+    }
+}
+
+UNIT_TEST_CASE(PipelineBuildBenchmark, TestBuildPipelines)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,10 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "app_config/AppConfig.h"
 #include "collection_pipeline/CollectionPipeline.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/plugin/PluginRegistry.h"
+#include "common/JsonUtil.h"
+#include "config/CollectionConfig.h"
+#include "plugin/input/InputContainerStdio.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(pipeline_build_thread_num);
+
 using namespace std;
 
 namespace logtail {
@@ -23,6 +35,13 @@ namespace logtail {
 class PipelineManagerUnittest : public testing::Test {
 public:
     void TestPipelineManagement() const;
+    void TestBuildPipelines() const;
+    void TestBuildContainerStdioPipelines() const;
+
+protected:
+    static void SetUpTestCase() { PluginRegistry::GetInstance()->LoadPlugins(); }
+
+    static void TearDownTestCase() { PluginRegistry::GetInstance()->UnloadPlugins(); }
 };
 
 void PipelineManagerUnittest::TestPipelineManagement() const {
@@ -34,7 +53,145 @@ void PipelineManagerUnittest::TestPipelineManagement() const {
     APSARA_TEST_EQUAL(nullptr, CollectionPipelineManager::GetInstance()->FindConfigByName("test3"));
 }
 
+void PipelineManagerUnittest::TestBuildPipelines() const {
+    const string validConfig = R"JSON(
+        {
+            "inputs": [
+                {
+                    "Type": "input_file",
+                    "FilePaths": [
+                        "/home/*.log"
+                    ]
+                }
+            ],
+            "processors": [
+                {
+                    "Type": "processor_parse_regex_native",
+                    "SourceKey": "content",
+                    "Regex": "(\\S+)\\s(\\S+)",
+                    "Keys": ["key1", "key2"]
+                }
+            ],
+            "flushers": [
+                {
+                    "Type": "flusher_sls",
+                    "Project": "test_project",
+                    "Logstore": "test_logstore",
+                    "Region": "test_region",
+                    "Endpoint": "test_endpoint"
+                }
+            ]
+        }
+    )JSON";
+    // processor_parse_regex_native without Regex cannot be initialized
+    const string invalidConfig = R"(
+        {
+            "inputs": [
+                {
+                    "Type": "input_file",
+                    "FilePaths": [
+                        "/home/*.log"
+                    ]
+                }
+            ],
+            "processors": [
+                {
+                    "Type": "processor_parse_regex_native",
+                    "SourceKey": "content"
+                }
+            ],
+            "flushers": [
+                {
+                    "Type": "flusher_sls",
+                    "Project": "test_project",
+                    "Logstore": "test_logstore",
+                    "Region": "test_region",
+                    "Endpoint": "test_endpoint"
+                }
+            ]
+        }
+    )";
+    for (int32_t threadNum : {1, 4}) {
+        INT32_FLAG(pipeline_build_thread_num) = threadNum;
+        vector<CollectionConfig> configs;
+        for (size_t i = 0; i < 16; ++i) {
+            auto configJson = make_unique<Json::Value>();
+            string errorMsg;
+            APSARA_TEST_TRUE(ParseJsonTable(i == 5 ? invalidConfig : validConfig, *configJson, errorMsg));
+            configs.emplace_back("test_config_" + to_string(i), std::move(configJson), filesystem::path("."));
+            APSARA_TEST_TRUE(configs.back().Parse());
+        }
+        vector<CollectionConfig*> configPtrs;
+        for (auto& config : configs) {
+            configPtrs.push_back(&config);
+        }
+        auto pipelines = CollectionPipelineManager::GetInstance()->BuildPipelines(configPtrs);
+        APSARA_TEST_EQUAL(configs.size(), pipelines.size());
+        for (size_t i = 0; i < pipelines.size(); ++i) {
+            if (i == 5) {
+                APSARA_TEST_EQUAL(nullptr, pipelines[i]);
+                continue;
+            }
+            APSARA_TEST_NOT_EQUAL(nullptr, pipelines[i]);
+            APSARA_TEST_EQUAL("test_config_" + to_string(i), pipelines[i]->Name());
+        }
+    }
+}
+
+void PipelineManagerUnittest::TestBuildContainerStdioPipelines() const {
+    // options of one config must not leak into others built at the same time
+    const string configTemplate = R"JSON(
+        {
+            "inputs": [
+                {
+                    "Type": "input_container_stdio",
+                    "AllowingIncludedByMultiConfigs": ${allowing}
+                }
+            ],
+            "flushers": [
+                {
+                    "Type": "flusher_sls",
+                    "Project": "test_project",
+                    "Logstore": "test_logstore",
+                    "Region": "test_region",
+                    "Endpoint": "test_endpoint"
+                }
+            ]
+        }
+    )JSON";
+    AppConfig::GetInstance()->mPurageContainerMode = true;
+    INT32_FLAG(pipeline_build_thread_num) = 4;
+    for (size_t round = 0; round < 10; ++round) {
+        vector<CollectionConfig> configs;
+        for (size_t i = 0; i < 16; ++i) {
+            string configStr = configTemplate;
+            configStr.replace(configStr.find("${allowing}"), 11, i % 2 == 0 ? "true" : "false");
+            auto configJson = make_unique<Json::Value>();
+            string errorMsg;
+            APSARA_TEST_TRUE(ParseJsonTable(configStr, *configJson, errorMsg));
+            configs.emplace_back("test_config_" + to_string(i), std::move(configJson), filesystem::path("."));
+            APSARA_TEST_TRUE(configs.back().Parse());
+        }
+        vector<CollectionConfig*> configPtrs;
+        for (auto& config : configs) {
+            configPtrs.push_back(&config);
+        }
+        auto pipelines = CollectionPipelineManager::GetInstance()->BuildPipelines(configPtrs);
+        APSARA_TEST_EQUAL(configs.size(), pipelines.size());
+        for (size_t i = 0; i < pipelines.size(); ++i) {
+            APSARA_TEST_NOT_EQUAL_FATAL(nullptr, pipelines[i]);
+            const auto* input
+                = static_cast<const InputContainerStdio*>(pipelines[i]->GetInputs()[0]->GetPlugin());
+            APSARA_TEST_EQUAL(i % 2 == 0, input->mFileDiscovery.mAllowingIncludedByMultiConfigs);
+            APSARA_TEST_EQUAL(1U, input->mFileDiscovery.mFilePaths.size());
+        }
+    }
+    AppConfig::GetInstance()->mPurageContainerMode = false;
+}
+
 UNIT_TEST_CASE(PipelineManagerUnittest, TestPipelineManagement)
+UNIT_TEST_CASE(PipelineManagerUnittest, TestBuildPipelines)
+UNIT_TEST_CASE(PipelineManagerUnittest, TestBuildContainerStdioPipelines)
 
 } // namespace logtail
 
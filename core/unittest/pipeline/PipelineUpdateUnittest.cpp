@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -60,6 +63,45 @@ public:
 
 const std::string ProcessorMock2::sName = "processor_mock2";
 
+class ProcessorArrivalMock : public ProcessorMock {
+public:
+    static const std::string sName;
+    static std::atomic_bool sArrived;
+
+    const std::string& Name() const override { return sName; }
+    void Process(PipelineEventGroup& logGroup) override {
+        if (!logGroup.GetEvents().empty()) {
+            sArrived = true;
+        }
+        ProcessorMock::Process(logGroup);
+    }
+};
+
+const std::string ProcessorArrivalMock::sName = "processor_arrival_mock";
+std::atomic_bool ProcessorArrivalMock::sArrived = false;
+
+class ProcessorSlowInitMock : public ProcessorMock {
+public:
+    static const std::string sName;
+    static std::atomic_bool sInitStarted;
+    static std::atomic_bool sArrivedDuringInit;
+
+    const std::string& Name() const override { return sName; }
+    bool Init(const Json::Value& config) override {
+        sInitStarted = true;
+        // takes at least 1s, and waits at most 5s for events of other pipelines
+        for (int i = 0; i < 50 && (i < 10 || !ProcessorArrivalMock::sArrived); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        sArrivedDuringInit = ProcessorArrivalMock::sArrived.load();
+        return ProcessorMock::Init(config);
+    }
+};
+
+const std::string ProcessorSlowInitMock::sName = "processor_slow_init_mock";
+std::atomic_bool ProcessorSlowInitMock::sInitStarted = false;
+std::atomic_bool ProcessorSlowInitMock::sArrivedDuringInit = false;
+
 class FlusherSLSMock : public FlusherSLS {
 public:
     static const std::string sName;
@@ -106,6 +148,8 @@ const std::string FlusherSLSMock2::sName = "flusher_sls_mock2";
 class PipelineUpdateUnittest : public testing::Test {
 public:
     void TestFileServerStart();
+    void TestFileServerPartialReload() const;
+    void TestFileServerPartialReloadUnregisterDirs() const;
     void TestPipelineParamUpdateCase1() const;
     void TestPipelineParamUpdateCase2() const;
     void TestPipelineParamUpdateCase3() const;
@@ -150,6 +194,8 @@ protected:
         PluginRegistry::GetInstance()->RegisterContinuousInputCreator(new StaticInputCreator<InputFileMock>());
         PluginRegistry::GetInstance()->RegisterContinuousInputCreator(new StaticInputCreator<InputFileMock2>());
         PluginRegistry::GetInstance()->RegisterProcessorCreator(new StaticProcessorCreator<ProcessorMock2>());
+        PluginRegistry::GetInstance()->RegisterProcessorCreator(new StaticProcessorCreator<ProcessorArrivalMock>());
+        PluginRegistry::GetInstance()->RegisterProcessorCreator(new StaticProcessorCreator<ProcessorSlowInitMock>());
         PluginRegistry::GetInstance()->RegisterFlusherCreator(new StaticFlusherCreator<FlusherSLSMock>());
         PluginRegistry::GetInstance()->RegisterFlusherCreator(new StaticFlusherCreator<FlusherSLSMock2>());
 
@@ -212,7 +258,7 @@ private:
         {
             auto manager = ProcessQueueManager::GetInstance();
             manager->CreateOrUpdateBoundedQueue(key, 0, CollectionPipelineContext{});
-            lock_guard<mutex> lock(manager->mQueueMux);
+            lock_guard<shared_mutex> lock(manager->mQueueMux);
             auto iter = manager->mQueues.find(key);
             APSARA_TEST_NOT_EQUAL(iter, manager->mQueues.end());
             static_cast<BoundedProcessQueue*>((*iter->second.first).get())->mValidToPush = true;
@@ -298,6 +344,13 @@ private:
                 "/tmp/not_found.log"
             ]
         })";
+    string nativeInputFileConfig2 = R"(
+        {
+            "Type": "input_file",
+            "FilePaths": [
+                "/tmp/not_found_2.log"
+            ]
+        })";
     string nativeInputConfig = R"(
         {
             "Type": "input_file_mock",
@@ -332,6 +385,14 @@ private:
         {
             "Type": "processor_mock2"
         })";
+    string slowInitProcessorConfig = R"(
+        {
+            "Type": "processor_slow_init_mock"
+        })";
+    string arrivalProcessorConfig = R"(
+        {
+            "Type": "processor_arrival_mock"
+        })";
     string nativeFlusherConfig = R"(
         {
             "Type": "flusher_sls_mock",
@@ -430,6 +491,127 @@ void PipelineUpdateUnittest::TestFileServerStart() {
     APSARA_TEST_EQUAL_FATAL(false, LogInput::GetInstance()->mInteruptFlag);
 }
 
+void PipelineUpdateUnittest::TestFileServerPartialReload() const {
+    auto unaffectedDir = filesystem::absolute("partial_reload/unaffected");
+    auto updatedDir = filesystem::absolute("partial_reload/updated");
+    filesystem::create_directories(unaffectedDir);
+    filesystem::create_directories(updatedDir);
+    auto inputConfig = [](const filesystem::path& dir) {
+        return R"({"Type": "input_file", "FilePaths": [")" + (dir / "*.log").string() + R"("]})";
+    };
+
+    auto pipelineManager = CollectionPipelineManager::GetInstance();
+    CollectionConfigDiff diff;
+    CollectionConfig unaffectedConfigObj = CollectionConfig(
+        "test-file-unaffected",
+        make_unique<Json::Value>(
+            GeneratePipelineConfigJson(inputConfig(unaffectedDir), arrivalProcessorConfig, nativeFlusherConfig)),
+        filepath);
+    unaffectedConfigObj.Parse();
+    diff.mAdded.push_back(std::move(unaffectedConfigObj));
+    CollectionConfig updatedConfigObj = CollectionConfig(
+        "test-file-updated",
+        make_unique<Json::Value>(
+            GeneratePipelineConfigJson(inputConfig(updatedDir), nativeProcessorConfig, nativeFlusherConfig2)),
+        filepath);
+    updatedConfigObj.Parse();
+    diff.mAdded.push_back(std::move(updatedConfigObj));
+    pipelineManager->UpdatePipelines(diff);
+    APSARA_TEST_EQUAL_FATAL(2U, pipelineManager->GetAllPipelines().size());
+    auto unaffectedPipeline = pipelineManager->FindConfigByName("test-file-unaffected");
+
+    // LogInput takes the read lock before handling each batch of events, for readers of all configs alike
+    atomic_bool updated = false;
+    auto maxStall = async(launch::async, [&]() {
+        chrono::steady_clock::duration res{0};
+        while (!updated) {
+            auto start = chrono::steady_clock::now();
+            { ReadLock lock(LogInput::GetInstance()->mAccessMainThreadRWL); }
+            res = max(res, chrono::steady_clock::now() - start);
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        return res;
+    });
+    // the unaffected config is written while the new pipeline of the updated config is being built
+    ProcessorArrivalMock::sArrived = false;
+    ProcessorSlowInitMock::sInitStarted = false;
+    ProcessorSlowInitMock::sArrivedDuringInit = false;
+    auto writer = async(launch::async, [&]() {
+        for (int i = 0; i < 100 && !ProcessorSlowInitMock::sInitStarted; ++i) {
+            this_thread::sleep_for(chrono::milliseconds(100));
+        }
+        ofstream ofs(unaffectedDir / "a.log", ios::app);
+        ofs << "test-data-0\n";
+    });
+
+    // the new pipeline takes at least 1s to build, which must not stall the reading of the unaffected config
+    CollectionConfigDiff diffUpdate;
+    CollectionConfig updatedConfigObjUpdate = CollectionConfig(
+        "test-file-updated",
+        make_unique<Json::Value>(
+            GeneratePipelineConfigJson(inputConfig(updatedDir), slowInitProcessorConfig, nativeFlusherConfig2)),
+        filepath);
+    updatedConfigObjUpdate.Parse();
+    diffUpdate.mModified.push_back(std::move(updatedConfigObjUpdate));
+    auto start = chrono::steady_clock::now();
+    pipelineManager->UpdatePipelines(diffUpdate);
+    auto cost = chrono::steady_clock::now() - start;
+    updated = true;
+    writer.get();
+
+    APSARA_TEST_TRUE(cost >= chrono::milliseconds(1000));
+    // events of the unaffected config are processed before ResumeConfigs
+    APSARA_TEST_TRUE(ProcessorSlowInitMock::sArrivedDuringInit);
+    APSARA_TEST_TRUE(maxStall.get() < chrono::milliseconds(500));
+    APSARA_TEST_FALSE(LogInput::GetInstance()->mInteruptFlag);
+    APSARA_TEST_EQUAL(unaffectedPipeline, pipelineManager->FindConfigByName("test-file-unaffected"));
+    APSARA_TEST_EQUAL(2U, pipelineManager->GetAllPipelines().size());
+    filesystem::remove_all("partial_reload");
+}
+
+void PipelineUpdateUnittest::TestFileServerPartialReloadUnregisterDirs() const {
+    auto keptDir = filesystem::absolute("partial_reload_unregister/kept").string();
+    auto removedDir = filesystem::absolute("partial_reload_unregister/removed").string();
+    filesystem::create_directories(keptDir);
+    filesystem::create_directories(removedDir);
+    auto inputConfig = [](const string& dir) {
+        return R"({"Type": "input_file", "FilePaths": [")" + dir + R"(/*.log"]})";
+    };
+
+    auto pipelineManager = CollectionPipelineManager::GetInstance();
+    CollectionConfigDiff diff;
+    CollectionConfig keptConfigObj = CollectionConfig(
+        "test-file-kept",
+        make_unique<Json::Value>(
+            GeneratePipelineConfigJson(inputConfig(keptDir), nativeProcessorConfig, nativeFlusherConfig)),
+        filepath);
+    keptConfigObj.Parse();
+    diff.mAdded.push_back(std::move(keptConfigObj));
+    CollectionConfig removedConfigObj = CollectionConfig(
+        "test-file-removed",
+        make_unique<Json::Value>(
+            GeneratePipelineConfigJson(inputConfig(removedDir), nativeProcessorConfig, nativeFlusherConfig2)),
+        filepath);
+    removedConfigObj.Parse();
+    diff.mAdded.push_back(std::move(removedConfigObj));
+    pipelineManager->UpdatePipelines(diff);
+    APSARA_TEST_EQUAL_FATAL(2U, pipelineManager->GetAllPipelines().size());
+    auto dispatcher = EventDispatcher::GetInstance();
+    APSARA_TEST_TRUE_FATAL(dispatcher->IsRegistered(keptDir));
+    APSARA_TEST_TRUE_FATAL(dispatcher->IsRegistered(removedDir));
+    auto watchNum = dispatcher->mInotifyWatchNum;
+
+    // the dir of the removed config is no longer watched, while the dir of the kept config is untouched
+    CollectionConfigDiff diffRemove;
+    diffRemove.mRemoved.push_back("test-file-removed");
+    pipelineManager->UpdatePipelines(diffRemove);
+    APSARA_TEST_EQUAL(1U, pipelineManager->GetAllPipelines().size());
+    APSARA_TEST_EQUAL(watchNum - 1, dispatcher->mInotifyWatchNum);
+    APSARA_TEST_FALSE(dispatcher->IsRegistered(removedDir));
+    APSARA_TEST_TRUE(dispatcher->IsRegistered(keptDir));
+    filesystem::remove_all("partial_reload_unregister");
+}
+
 void PipelineUpdateUnittest::TestPipelineParamUpdateCase1() const {
     // C++ -> C++ -> C++
     const std::string configName = "test1";
@@ -2469,6 +2651,8 @@ void PipelineUpdateUnittest::TestPipelineRelease() const {
 }
 
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestFileServerStart)
+UNIT_TEST_CASE(PipelineUpdateUnittest, TestFileServerPartialReload)
+UNIT_TEST_CASE(PipelineUpdateUnittest, TestFileServerPartialReloadUnregisterDirs)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineParamUpdateCase1)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineParamUpdateCase2)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineParamUpdateCase3)
@@ -0,0 +1,138 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/ProcessReorderBuffer.h"
+#include "common/StringTools.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ProcessReorderBufferUnittest : public testing::Test {
+public:
+    void TestInOrder() const;
+    void TestOutOfOrder() const;
+    void TestConcurrentPush() const;
+
+private:
+    static vector<PipelineEventGroup> MakeGroupList(uint64_t seqNo) {
+        vector<PipelineEventGroup> groupList;
+        groupList.emplace_back(make_shared<SourceBuffer>());
+        groupList.back().SetTag(string("seq"), ToString(seqNo));
+        return groupList;
+    }
+};
+
+void ProcessReorderBufferUnittest::TestInOrder() const {
+    ProcessReorderBuffer buffer;
+    vector<PipelineEventGroup> groupList;
+    for (uint64_t i = 1; i <= 3; ++i) {
+        APSARA_TEST_EQUAL(i, buffer.NextSeqNo());
+        APSARA_TEST_TRUE(buffer.Push(i, MakeGroupList(i)));
+        APSARA_TEST_TRUE(buffer.PopReady(groupList));
+        APSARA_TEST_EQUAL(ToString(i), groupList[0].GetTag("seq").to_string());
+        APSARA_TEST_FALSE(buffer.PopReady(groupList));
+    }
+    APSARA_TEST_EQUAL(0U, buffer.PendingCnt());
+}
+
+void ProcessReorderBufferUnittest::TestOutOfOrder() const {
+    ProcessReorderBuffer buffer;
+    vector<PipelineEventGroup> groupList;
+    // results of item 2 and 3 must wait for item 1
+    APSARA_TEST_FALSE(buffer.Push(3, MakeGroupList(3)));
+    APSARA_TEST_FALSE(buffer.Push(2, MakeGroupList(2)));
+    APSARA_TEST_EQUAL(2U, buffer.PendingCnt());
+
+    APSARA_TEST_TRUE(buffer.Push(1, MakeGroupList(1)));
+    APSARA_TEST_FALSE(buffer.Push(5, MakeGroupList(5)));
+    for (uint64_t i = 1; i <= 3; ++i) {
+        APSARA_TEST_TRUE(buffer.PopReady(groupList));
+        APSARA_TEST_EQUAL(ToString(i), groupList[0].GetTag("seq").to_string());
+    }
+    APSARA_TEST_FALSE(buffer.PopReady(groupList));
+    APSARA_TEST_EQUAL(1U, buffer.PendingCnt());
+
+    // the owner of item 4 becomes the sender after the previous sender met the gap
+    APSARA_TEST_TRUE(buffer.Push(4, MakeGroupList(4)));
+    for (uint64_t i = 4; i <= 5; ++i) {
+        APSARA_TEST_TRUE(buffer.PopReady(groupList));
+        APSARA_TEST_EQUAL(ToString(i), groupList[0].GetTag("seq").to_string());
+    }
+    APSARA_TEST_FALSE(buffer.PopReady(groupList));
+}
+
+void ProcessReorderBufferUnittest::TestConcurrentPush() const {
+    ProcessReorderBuffer buffer;
+    mutex popMux;
+    atomic_int sendingThreadCnt = 0;
+    atomic_bool isExclusive = true;
+    atomic_bool inOrder = true;
+    uint64_t nextExpected = 1;
+    const uint64_t itemCnt = 100000;
+
+    auto worker = [&]() {
+        while (true) {
+            uint64_t seqNo = 0;
+            {
+                // mimic the lock of the process queue
+                lock_guard<mutex> lock(popMux);
+                seqNo = buffer.NextSeqNo();
+            }
+            if (seqNo > itemCnt) {
+                break;
+            }
+            if (!buffer.Push(seqNo, MakeGroupList(seqNo))) {
+                continue;
+            }
+            vector<PipelineEventGroup> groupList;
+            while (buffer.PopReady(groupList)) {
+                // only one thread can be sending at any time
+                if (sendingThreadCnt.fetch_add(1) != 0) {
+                    isExclusive = false;
+                }
+                if (groupList[0].GetTag("seq").to_string() != ToString(nextExpected)) {
+                    inOrder = false;
+                }
+                ++nextExpected;
+                sendingThreadCnt.fetch_sub(1);
+            }
+        }
+    };
+    vector<thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_TRUE(isExclusive.load());
+    APSARA_TEST_TRUE(inOrder.load());
+    APSARA_TEST_EQUAL(itemCnt + 1, nextExpected);
+    APSARA_TEST_EQUAL(0U, buffer.PendingCnt());
+}
+
+UNIT_TEST_CASE(ProcessReorderBufferUnittest, TestInOrder)
+UNIT_TEST_CASE(ProcessReorderBufferUnittest, TestOutOfOrder)
+UNIT_TEST_CASE(ProcessReorderBufferUnittest, TestConcurrentPush)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
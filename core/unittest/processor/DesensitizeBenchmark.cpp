@@ -0,0 +1,155 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "re2/re2.h"
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorDesensitizeNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// access logs, only one in @sensitiveEvery of them carries a password
+static std::vector<std::string> MakeLines(int size, int sensitiveEvery) {
+    std::vector<std::string> lines;
+    lines.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        std::string line = "2025-01-01 12:00:00.123 INFO [http-nio-8080-exec-" + std::to_string(i % 200)
+            + "] GET /api/v1/users/" + std::to_string(i) + "/orders?page=2&size=50 status=200 latency=12ms";
+        if (i % sensitiveEvery == 0) {
+            line += " body={\"account\":\"1812213231432969\",\"password\":\"04a23f38\"}";
+        }
+        lines.emplace_back(std::move(line));
+    }
+    return lines;
+}
+
+static Json::Value MakeConfig(const std::string& method) {
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Method"] = method;
+    config["ReplacingString"] = "******";
+    config["ContentPatternBeforeReplacedString"] = "password\":\"";
+    config["ReplacedContentPattern"] = "[^\"]+";
+    return config;
+}
+
+// what the processor did before: copy the value to a std::string, replace and copy it back
+static void BM_GlobalReplace(const std::vector<std::string>& lines, int batchSize) {
+    re2::RE2 regex("(password\":\")[^\"]+");
+    std::string rewrite = "\\1******";
+    uint64_t bytes = 0;
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (const auto& line : lines) {
+            eventGroup.AddLogEvent()->SetContent(std::string("content"), line);
+            bytes += line.size();
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (auto& e : eventGroup.MutableEvents()) {
+            auto& event = e.Cast<LogEvent>();
+            std::string value = event.GetContent("content").to_string();
+            RE2::GlobalReplace(&value, regex, rewrite);
+            StringBuffer valueBuffer = sourceBuffer->CopyString(value);
+            event.SetContentNoCopy(StringView("content"), StringView(valueBuffer.data, valueBuffer.size));
+        }
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "process: " << formatSize(bytes * 1000000 / durationTime) << std::endl;
+}
+
+static void BM_ProcessorDesensitize(const std::vector<std::string>& lines, int batchSize, const Json::Value& config) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+    ProcessorDesensitizeNative processor;
+    processor.SetContext(mContext);
+    processor.CreateMetricsRecordRef(ProcessorDesensitizeNative::sName, "1");
+    bool init = processor.Init(config);
+    processor.CommitMetricsRecordRef();
+    if (!init) {
+        std::cout << "init failed" << std::endl;
+        return;
+    }
+
+    uint64_t bytes = 0;
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (const auto& line : lines) {
+            eventGroup.AddLogEvent()->SetContent(std::string("content"), line);
+            bytes += line.size();
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "process: " << formatSize(bytes * 1000000 / durationTime) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (int sensitiveEvery : {100, 1}) {
+        auto lines = MakeLines(10000, sensitiveEvery);
+        std::cout << "1 of " << sensitiveEvery << " lines sensitive" << std::endl;
+        std::cout << "RE2::GlobalReplace" << std::endl;
+        BM_GlobalReplace(lines, 100);
+        std::cout << "processor_desensitize_native const" << std::endl;
+        BM_ProcessorDesensitize(lines, 100, MakeConfig("const"));
+        std::cout << "processor_desensitize_native md5" << std::endl;
+        BM_ProcessorDesensitize(lines, 100, MakeConfig("md5"));
+
+        Json::Value config = MakeConfig("const");
+        for (const auto& key : {"account", "token", "phone", "email"}) {
+            Json::Value rule;
+            rule["Method"] = "md5";
+            rule["ContentPatternBeforeReplacedString"] = std::string(key) + "\":\"";
+            rule["ReplacedContentPattern"] = "[^\"]+";
+            config["Rules"].append(rule);
+        }
+        std::cout << "processor_desensitize_native 5 rules" << std::endl;
+        BM_ProcessorDesensitize(lines, 100, config);
+    }
+    return 0;
+}
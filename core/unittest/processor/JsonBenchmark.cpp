@@ -53,7 +53,7 @@ Json::Value GetCastConfig(std::string spl) {
 }
 
 
-static void BM_RawJson(int size, int batchSize) {
+static void BM_RawJson(int size, int batchSize, const std::vector<std::string>& keys = {}) {
     logtail::Logger::Instance().InitGlobalLoggers();
 
     CollectionPipelineContext mContext;
@@ -66,6 +66,9 @@ static void BM_RawJson(int size, int batchSize) {
     config["KeepingSourceWhenParseSucceed"] = true;
     config["CopingRawLog"] = true;
     config["RenamedSourceKey"] = "rawLog";
+    for (const auto& key : keys) {
+        config["Keys"].append(key);
+    }
 
 
     std::string data
@@ -124,6 +127,7 @@ static void BM_RawJson(int size, int batchSize) {
             //     std::cout << "outJson: " << outJson << std::endl;
             // }
         }
+        std::cout << "use simdjson: " << processor.mUseSimdJson << ", keys: " << keys.size() << std::endl;
         std::cout << "raw json count: " << count << std::endl;
         std::cout << "durationTime: " << durationTime << std::endl;
         std::cout << "process: "
@@ -143,5 +147,7 @@ int main(int argc, char** argv) {
 
 
     BM_RawJson(1000, 100);
+    // most pipelines only keep a handful of fields
+    BM_RawJson(1000, 100, {"_time_", "level", "request", "status", "cost"});
     return 0;
 }
@@ -0,0 +1,109 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/LogtailCommonFlags.h"
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorParseApsaraNative.h"
+#include "unittest/Unittest.h"
+
+using namespace logtail;
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// apsara logs with 10 key:value fields, about 100 logs in each second
+static std::vector<std::string> MakeLines(int size, bool epochTime) {
+    std::vector<std::string> lines;
+    lines.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        std::string line;
+        if (epochTime) {
+            line = "[" + std::to_string(1735732800 + i / 100) + std::to_string(100000 + i % 100 * 1000) + "]";
+        } else {
+            line = "[2025-01-01 12:" + std::to_string(10 + i / 6000 % 50) + ":" + std::to_string(10 + i / 100 % 50)
+                + "." + std::to_string(100000 + i % 100 * 1000) + "]";
+        }
+        line += "\t[INFO]\t[" + std::to_string(1000 + i % 64) + "]\t[/apsara/pangu/ChunkServer.cpp:1024]";
+        line += "\trequest_id:" + std::to_string(i) + "\tmethod:GET\turl:http://127.0.0.1:8080/api/v1/chunks";
+        line += "\tstatus:200\tlatency:12ms\tbytes_in:4096\tbytes_out:65536\tclient:10.0.0.1:53000";
+        line += "\tserver:10.0.0.2:8080\tmessage:read chunk finished";
+        lines.emplace_back(std::move(line));
+    }
+    return lines;
+}
+
+static void BM_ProcessorParseApsara(const std::vector<std::string>& lines, int batchSize) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Timezone"] = "";
+    ProcessorParseApsaraNative processor;
+    processor.SetContext(mContext);
+    processor.CreateMetricsRecordRef(ProcessorParseApsaraNative::sName, "1");
+    bool init = processor.Init(config);
+    processor.CommitMetricsRecordRef();
+    if (!init) {
+        std::cout << "init failed" << std::endl;
+        return;
+    }
+
+    uint64_t bytes = 0;
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (const auto& line : lines) {
+            eventGroup.AddLogEvent()->SetContent(std::string("content"), line);
+            bytes += line.size();
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "process: " << formatSize(bytes * 1000000 / durationTime) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+    BOOL_FLAG(ilogtail_discard_old_data) = false;
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::cout << "processor_parse_apsara_native date time" << std::endl;
+    BM_ProcessorParseApsara(MakeLines(10000, false), 100);
+    std::cout << "processor_parse_apsara_native epoch time" << std::endl;
+    BM_ProcessorParseApsara(MakeLines(10000, true), 100);
+    return 0;
+}
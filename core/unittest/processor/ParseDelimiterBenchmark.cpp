@@ -0,0 +1,160 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "config/CollectionConfig.h"
+#include "models/LogEvent.h"
+#include "parser/DelimiterModeFsmParser.h"
+#include "plugin/processor/ProcessorParseDelimiterNative.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// 40 columns audit log, a few of them quoted and one with escaped quotes
+static std::string MakeAuditLine(int columnCount) {
+    std::string line;
+    for (int i = 0; i < columnCount; ++i) {
+        if (i > 0) {
+            line += ',';
+        }
+        if (i % 10 == 3) {
+            line += "\"GET /api/v1/namespaces/default/pods?limit=500, watch=false\"";
+        } else if (i == 17) {
+            line += "\"user agent \"\"kubectl/v1.28.2\"\" (linux/amd64)\"";
+        } else {
+            line += "value_of_column_" + std::to_string(i);
+        }
+    }
+    return line;
+}
+
+static void BM_FsmParser(int size, int batchSize) {
+    std::string line = MakeAuditLine(40);
+    DelimiterModeFsmParser parser('"', ',');
+
+    {
+        std::vector<std::string> columnValues;
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; i++) {
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            for (int j = 0; j < size; j++) {
+                columnValues.clear();
+                parser.ParseDelimiterLine(line.data(), 0, line.size(), columnValues);
+            }
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "std::string columns" << std::endl;
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "process: " << formatSize(line.size() * (uint64_t)batchSize * 1000000 * size / durationTime)
+                  << std::endl;
+    }
+    {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        LogEvent* event = eventGroup.AddLogEvent();
+        StringBuffer sb = sourceBuffer->CopyString(line);
+        StringView buffer(sb.data, sb.size);
+        std::vector<StringView> columnValues;
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; i++) {
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            for (int j = 0; j < size; j++) {
+                columnValues.clear();
+                parser.ParseDelimiterLine(buffer, 0, buffer.size(), columnValues, *event);
+            }
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "StringView columns" << std::endl;
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "process: " << formatSize(line.size() * (uint64_t)batchSize * 1000000 * size / durationTime)
+                  << std::endl;
+    }
+}
+
+static void BM_ProcessorParseDelimiter(int size, int batchSize) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+
+    std::string line = MakeAuditLine(40);
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Separator"] = ",";
+    config["Quote"] = "\"";
+    config["Keys"] = Json::arrayValue;
+    for (int i = 0; i < 40; ++i) {
+        config["Keys"].append("key_" + std::to_string(i));
+    }
+    ProcessorParseDelimiterNative processor;
+    processor.SetContext(mContext);
+    processor.CreateMetricsRecordRef(ProcessorParseDelimiterNative::sName, "1");
+    bool init = processor.Init(config);
+    processor.CommitMetricsRecordRef();
+    if (!init) {
+        std::cout << "init failed" << std::endl;
+        return;
+    }
+
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (int j = 0; j < size; j++) {
+            LogEvent* event = eventGroup.AddLogEvent();
+            event->SetContent(std::string("content"), line);
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "process: " << formatSize(line.size() * (uint64_t)batchSize * 1000000 * size / durationTime)
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::cout << "fsm parser" << std::endl;
+    BM_FsmParser(10000, 100);
+    std::cout << "processor_parse_delimiter_native" << std::endl;
+    BM_ProcessorParseDelimiter(10000, 100);
+    return 0;
+}
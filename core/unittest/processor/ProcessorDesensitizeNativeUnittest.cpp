@@ -34,6 +34,8 @@ public:
     void TestCastSensWordMulti();
     void TestMultipleLines();
     void TestMultipleLinesWithProcessorMergeMultilineLogNative();
+    void TestExtractRequiredLiteral();
+    void TestMultipleRules();
 
     CollectionPipelineContext mContext;
 };
@@ -54,6 +56,10 @@ UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleLines);
 
 UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleLinesWithProcessorMergeMultilineLogNative);
 
+UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestExtractRequiredLiteral);
+
+UNIT_TEST_CASE(ProcessorDesensitizeNativeUnittest, TestMultipleRules);
+
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
     return pluginMeta;
@@ -1522,6 +1528,117 @@ void ProcessorDesensitizeNativeUnittest::TestCastSensWordMulti() {
         APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
     }
 }
+
+void ProcessorDesensitizeNativeUnittest::TestExtractRequiredLiteral() {
+    APSARA_TEST_EQUAL("pwd=", ProcessorDesensitizeNative::ExtractRequiredLiteral("pwd="));
+    APSARA_TEST_EQUAL("password\":\"", ProcessorDesensitizeNative::ExtractRequiredLiteral("password\":\"\\s*"));
+    APSARA_TEST_EQUAL("ccess_token.", ProcessorDesensitizeNative::ExtractRequiredLiteral("[Aa]ccess_token\\.\\d+"));
+    APSARA_TEST_EQUAL("=", ProcessorDesensitizeNative::ExtractRequiredLiteral("(?:pwd|key)="));
+    APSARA_TEST_EQUAL("pwd", ProcessorDesensitizeNative::ExtractRequiredLiteral("pwds?=?"));
+    APSARA_TEST_EQUAL("密", ProcessorDesensitizeNative::ExtractRequiredLiteral("密码?"));
+    APSARA_TEST_EQUAL("", ProcessorDesensitizeNative::ExtractRequiredLiteral("pwd|key"));
+    APSARA_TEST_EQUAL("", ProcessorDesensitizeNative::ExtractRequiredLiteral("(?i)pwd="));
+    APSARA_TEST_EQUAL("", ProcessorDesensitizeNative::ExtractRequiredLiteral("\\d{2}"));
+}
+
+void ProcessorDesensitizeNativeUnittest::TestMultipleRules() {
+    Json::Value config = GetCastSensWordConfig("cast1", "const", "********", "pwd=", "[^,]+", true);
+    Json::Value rule;
+    rule["Method"] = "md5";
+    rule["ContentPatternBeforeReplacedString"] = "token=";
+    rule["ReplacedContentPattern"] = "[^,]+";
+    config["Rules"].append(rule);
+    rule = Json::Value();
+    rule["Method"] = "const";
+    rule["ReplacingString"] = "\\2@***";
+    rule["ContentPatternBeforeReplacedString"] = "mail=";
+    rule["ReplacedContentPattern"] = "(\\w+)@[\\w.]+";
+    config["Rules"].append(rule);
+    ProcessorDesensitizeNative& processor = *(new ProcessorDesensitizeNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+    APSARA_TEST_EQUAL(3U, processor.mRules.size());
+    APSARA_TEST_TRUE(processor.mRuleSet != nullptr);
+
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    std::string inJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "cast1" : "pwd=123,token=abc,mail=alice@example.com,pwd=456"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "cast1" : "token=abc"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "cast1" : "nothing sensitive"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    eventGroup.FromJsonString(inJson);
+    StringView cleanValue = eventGroup.GetEvents()[2].Cast<LogEvent>().GetContent("cast1");
+    std::vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.emplace_back(std::move(eventGroup));
+    processorInstance.Process(eventGroupList);
+
+    std::string expectJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "cast1" : "pwd=********,token=900150983CD24FB0D6963F7D28E17F72,mail=alice@***,pwd=********"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "cast1" : "token=900150983CD24FB0D6963F7D28E17F72"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "cast1" : "nothing sensitive"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            }
+        ]
+    })";
+    std::string outJson = eventGroupList[0].ToJsonString();
+    APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+    // values without sensitive content are not copied
+    APSARA_TEST_EQUAL(cleanValue.data(),
+                      eventGroupList[0].GetEvents()[2].Cast<LogEvent>().GetContent("cast1").data());
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -51,6 +51,7 @@ public:
     void TestProcessEventMicrosecondUnmatch();
     void TestApsaraEasyReadLogTimeParser();
     void TestApsaraLogLineParser();
+    void TestProcessLongFields();
 
     CollectionPipelineContext mContext;
 };
@@ -67,6 +68,7 @@ UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestMultipleLines);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestProcessEventMicrosecondUnmatch);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestApsaraEasyReadLogTimeParser);
 UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestApsaraLogLineParser);
+UNIT_TEST_CASE(ProcessorParseApsaraNativeUnittest, TestProcessLongFields);
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -152,6 +154,54 @@ void ProcessorParseApsaraNativeUnittest::TestApsaraEasyReadLogTimeParser() {
     APSARA_TEST_EQUAL(lastStr, "2013-09-12 22:18:29");
 }
 
+void ProcessorParseApsaraNativeUnittest::TestProcessLongFields() {
+    // make config
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["KeepingSourceWhenParseFail"] = false;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    config["CopingRawLog"] = false;
+    config["RenamedSourceKey"] = "rawLog";
+    config["Timezone"] = "";
+    ProcessorParseApsaraNative* processor = new ProcessorParseApsaraNative;
+    processor->SetContext(mContext);
+    ProcessorInstance processorInstance(processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+
+    // separators are found 16 bytes at a time, so make fields cross the chunk boundaries at different offsets
+    std::string longValue(37, 'v');
+    std::string line = "[1693833304862181]\t[INFO]\t[385658]\t[/ilogtail/AppConfigBase.cpp:100]\t";
+    line += "request_id:" + longValue + "\t";
+    line += "url:http://127.0.0.1:8080/api?a=b:c\t";
+    line += "no colon in this field at all\t\t";
+    line += "empty_value:\t";
+    line += "long_key_" + longValue + ":1";
+
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    eventGroup.AddLogEvent()->SetContent(std::string("content"), line);
+    std::vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.emplace_back(std::move(eventGroup));
+    processorInstance.Process(eventGroupList);
+
+    APSARA_TEST_EQUAL_FATAL(1U, eventGroupList[0].GetEvents().size());
+    const auto& event = eventGroupList[0].GetEvents()[0].Cast<LogEvent>();
+    APSARA_TEST_EQUAL(1693833304, event.GetTimestamp());
+    APSARA_TEST_EQUAL("1693833304862181", event.GetContent("microtime"));
+    APSARA_TEST_EQUAL("INFO", event.GetContent("__LEVEL__"));
+    APSARA_TEST_EQUAL("385658", event.GetContent("__THREAD__"));
+    APSARA_TEST_EQUAL("/ilogtail/AppConfigBase.cpp", event.GetContent("__FILE__"));
+    APSARA_TEST_EQUAL("100", event.GetContent("__LINE__"));
+    APSARA_TEST_EQUAL(longValue, event.GetContent("request_id").to_string());
+    APSARA_TEST_EQUAL("http://127.0.0.1:8080/api?a=b:c", event.GetContent("url"));
+    APSARA_TEST_TRUE(event.HasContent("empty_value"));
+    APSARA_TEST_EQUAL("", event.GetContent("empty_value"));
+    APSARA_TEST_EQUAL("1", event.GetContent("long_key_" + longValue));
+    APSARA_TEST_FALSE(event.HasContent("content"));
+    // 4 base fields, microtime and 4 fields with colons
+    APSARA_TEST_EQUAL(9U, event.Size());
+}
+
 void ProcessorParseApsaraNativeUnittest::TestApsaraLogLineParser() {
     const char* logLine[] = {
         "[2013-03-13 18:05:09.493309]\t[WARNING]\t[13000]\t[build/debug64/ilogtail/core/ilogtail.cpp:1753]", // 1
@@ -2247,6 +2247,24 @@ void ProcessorParseContainerLogNativeUnittest::TestParseDockerLog() {
         APSARA_TEST_EQUAL("2021-12-01T00:00:00.000Z", dockerLog.time);
         delete[] buffer;
     }
+    // Test with escaped surrogate pairs and invalid unicode escapes
+    {
+        DockerLog dockerLog;
+        std::string str
+            = R"({"log":"smile \ud83d\ude00 bad \u12zz end\n","stream":"stdout","time":"2021-12-01T00:00:00.000Z"})";
+        int32_t size = str.size();
+
+        char* buffer = new char[size + 1]();
+        strcpy(buffer, str.c_str());
+
+        bool result = ProcessorParseContainerLogNative::ParseDockerLog(buffer, size, dockerLog);
+
+        APSARA_TEST_TRUE(result);
+        APSARA_TEST_STREQ("smile \xF0\x9F\x98\x80 bad \\u12zz end\n", dockerLog.log.to_string().c_str());
+        APSARA_TEST_EQUAL("stdout", dockerLog.stream);
+        APSARA_TEST_EQUAL("2021-12-01T00:00:00.000Z", dockerLog.time);
+        delete[] buffer;
+    }
     // Test with a incomplete log
     {
         DockerLog dockerLog;
@@ -47,6 +47,7 @@ public:
     void TestAllowingShortenedFields();
     void TestExtend();
     void TestEmpty();
+    void TestFsmParserConsistency();
     CollectionPipelineContext mContext;
 };
 
@@ -64,6 +65,7 @@ UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestProcessEventDiscardUnm
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestAllowingShortenedFields);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestExtend);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestEmpty);
+UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestFsmParserConsistency);
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -2574,6 +2576,40 @@ void ProcessorParseDelimiterNativeUnittest::TestEmpty() {
     }
 }
 
+void ProcessorParseDelimiterNativeUnittest::TestFsmParserConsistency() {
+    // special chars are put at various offsets so that they fall both inside and across 16-byte SIMD blocks
+    std::vector<std::string> lines = {
+        "",
+        "a",
+        ",",
+        "\"\"",
+        "abcdefghijklmnopqrstuvwxyz,0123456789abcdefghijklmnopqrstuvwxyz",
+        "abcdefghijklmno,\"pqrstuvwxyz,0123456789abcdefghijklmnop\",qrstuvwxyz",
+        "\"abcdefghijklmn\"\"opqrstuvwxyz\"\"0123456789\",abcdefghijklmnopqrstuvwxyz,,,",
+        "abcdefghijklmnop\"qrstuvwxyz",
+        "\"abcdefghijklmnopqrstuvwxyz\"0123456789",
+        "\"abcdefghijklmnopqrstuvwxyz0123456789",
+        ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+        "\"\"\"abcdefghijklmnopqrstuvwxyz\"\"\",\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\",0123456789",
+    };
+    DelimiterModeFsmParser parser('"', ',');
+    for (const auto& line : lines) {
+        std::vector<std::string> expected;
+        bool expectedRes = parser.ParseDelimiterLine(line.data(), 0, line.size(), expected);
+
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        LogEvent* event = eventGroup.AddLogEvent();
+        std::vector<StringView> columnValues;
+        bool res = parser.ParseDelimiterLine(StringView(line), 0, line.size(), columnValues, *event);
+        APSARA_TEST_EQUAL_FATAL(expectedRes, res);
+        APSARA_TEST_EQUAL_FATAL(expected.size(), columnValues.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            APSARA_TEST_EQUAL_FATAL(expected[i], columnValues[i].to_string());
+        }
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
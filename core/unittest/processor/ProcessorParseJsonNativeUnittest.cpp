@@ -47,6 +47,7 @@ public:
     void TestJsonUnicodeCharacters();
     void TestJsonWithNullValues();
     void TestInvalidJsonFormats();
+    void TestKeys();
 
     CollectionPipelineContext mContext;
 };
@@ -91,6 +92,8 @@ UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestJsonWithNullValues);
 
 UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestInvalidJsonFormats);
 
+UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestKeys);
+
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
     return pluginMeta;
@@ -1293,6 +1296,81 @@ void ProcessorParseJsonNativeUnittest::TestInvalidJsonFormats() {
     APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
 }
 
+void ProcessorParseJsonNativeUnittest::TestKeys() {
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Keys"] = Json::arrayValue;
+    config["Keys"].append("level");
+    config["Keys"].append("msg\"quoted");
+    config["Keys"].append("detail");
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    std::string inJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "content" : "{\"time\":\"2025-01-01\",\"level\":\"INFO\",\"ignored\":{\"a\":[1,2,3]},\"msg\\\"quoted\":\"a\\\"b\",\"detail\":{\"k\":\"v\"},\"extra\":1}"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "content" : "{\"time\":\"2025-01-01\",\"level\":\"INFO\"}"
+                },
+                "timestampNanosecond" : 0,
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    eventGroup.FromJsonString(inJson);
+
+    ProcessorParseJsonNative& processor = *(new ProcessorParseJsonNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+    APSARA_TEST_EQUAL(3U, processor.mKeys.size());
+    std::vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.emplace_back(std::move(eventGroup));
+    processorInstance.Process(eventGroupList);
+
+    // only the configured keys are extracted
+    std::string expectJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "detail":"{\"k\":\"v\"}",
+                    "level":"INFO",
+                    "msg\"quoted":"a\"b"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "level":"INFO"
+                },
+                "timestamp" : 12345678901,
+                "timestampNanosecond" : 0,
+                "type" : 1
+            }
+        ]
+    })";
+    std::string outJson = eventGroupList[0].ToJsonString();
+    APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -13,15 +13,19 @@
 // limitations under the License.
 
 #include <memory>
+#include <thread>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "collection_pipeline/queue/BoundedProcessQueue.h"
+#include "collection_pipeline/queue/QueueMemoryBudget.h"
 #include "collection_pipeline/queue/SenderQueue.h"
 #include "common/FeedbackInterface.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 #include "unittest/queue/FeedbackInterfaceMock.h"
 
+DECLARE_FLAG_INT64(queue_memory_budget_bytes);
+
 using namespace std;
 
 namespace logtail {
@@ -31,6 +35,8 @@ public:
     void TestPush();
     void TestPop();
     void TestMetric();
+    void TestMemoryBudget();
+    void TestPushConcurrently();
 
 protected:
     static void SetUpTestCase() { sCtx.SetConfigName("test_config"); }
@@ -116,6 +122,82 @@ void BoundedProcessQueueUnittest::TestPop() {
     APSARA_TEST_TRUE(static_cast<FeedbackInterfaceMock*>(mFeedback2.get())->HasFeedback(sKey));
 }
 
+void BoundedProcessQueueUnittest::TestMemoryBudget() {
+    auto* budget = QueueMemoryBudget::GetInstance();
+    auto usedBytes = budget->GetUsedBytes();
+    INT64_FLAG(queue_memory_budget_bytes) = 3000;
+
+    // item count is below the high watermark, but the queue holds more than its share when the budget is exhausted
+    auto item = GenerateItem();
+    item->mEventGroup.AddLogEvent()->SetContent(string("key"), string(4000, 'a'));
+    auto dataSize = item->mEventGroup.DataSize();
+    APSARA_TEST_TRUE(mQueue->Push(std::move(item)));
+    APSARA_TEST_EQUAL(usedBytes + dataSize, budget->GetUsedBytes());
+    APSARA_TEST_FALSE(mQueue->IsValidToPush());
+    APSARA_TEST_FALSE(mQueue->Push(GenerateItem()));
+
+    // resumed once the bytes are released, and upstream is notified
+    APSARA_TEST_TRUE(mQueue->Pop(item));
+    APSARA_TEST_EQUAL(usedBytes, budget->GetUsedBytes());
+    APSARA_TEST_TRUE(mQueue->IsValidToPush());
+    APSARA_TEST_TRUE(static_cast<FeedbackInterfaceMock*>(mFeedback1.get())->HasFeedback(sKey));
+
+    // budget is enough, but the agent is under memory pressure
+    INT64_FLAG(queue_memory_budget_bytes) = 1024 * 1024 * 1024;
+    budget->SetMemoryPressure(true);
+    item = GenerateItem();
+    item->mEventGroup.AddLogEvent()->SetContent(string("key"), string(budget->GetQueueShare(), 'a'));
+    APSARA_TEST_TRUE(mQueue->Push(std::move(item)));
+    APSARA_TEST_FALSE(mQueue->IsValidToPush());
+    budget->SetMemoryPressure(false);
+    APSARA_TEST_TRUE(mQueue->Pop(item));
+    APSARA_TEST_TRUE(mQueue->IsValidToPush());
+
+    // items left in the queue are released on destruction
+    APSARA_TEST_TRUE(mQueue->Push(GenerateItem()));
+    mQueue.reset();
+    APSARA_TEST_EQUAL(usedBytes, budget->GetUsedBytes());
+    INT64_FLAG(queue_memory_budget_bytes) = 0;
+}
+
+void BoundedProcessQueueUnittest::TestPushConcurrently() {
+    vector<ProcessQueueItem*> pushed;
+    {
+        // the queue is in use, so items are handed off to the inbox, up to the capacity of the queue
+        lock_guard<mutex> lock(mQueue->mMux);
+        thread producer([&]() {
+            for (size_t i = 0; i < sCap; ++i) {
+                auto item = GenerateItem();
+                pushed.push_back(item.get());
+                APSARA_TEST_TRUE(mQueue->PushConcurrently(std::move(item)));
+            }
+            APSARA_TEST_FALSE(mQueue->PushConcurrently(GenerateItem()));
+        });
+        producer.join();
+        APSARA_TEST_TRUE(mQueue->Empty());
+        APSARA_TEST_TRUE(mQueue->IsValidToPush());
+    }
+    APSARA_TEST_FALSE(mQueue->EmptyConcurrently());
+
+    // items handed off are moved to the queue in order on the next access, and the watermarks take effect then
+    unique_ptr<ProcessQueueItem> item;
+    APSARA_TEST_TRUE(mQueue->PopConcurrently(item));
+    APSARA_TEST_EQUAL(pushed[0], item.get());
+    APSARA_TEST_EQUAL(sCap - 1, mQueue->Size());
+    APSARA_TEST_FALSE(mQueue->IsValidToPush());
+    APSARA_TEST_FALSE(mQueue->PushConcurrently(GenerateItem()));
+    for (size_t i = 1; i < sCap; ++i) {
+        APSARA_TEST_TRUE(mQueue->PopConcurrently(item));
+        APSARA_TEST_EQUAL(pushed[i], item.get());
+    }
+    APSARA_TEST_TRUE(mQueue->EmptyConcurrently());
+    APSARA_TEST_TRUE(mQueue->IsValidToPush());
+
+    // pushed directly when the queue is not in use
+    APSARA_TEST_TRUE(mQueue->PushConcurrently(GenerateItem()));
+    APSARA_TEST_EQUAL(1U, mQueue->Size());
+}
+
 void BoundedProcessQueueUnittest::TestMetric() {
     APSARA_TEST_EQUAL(4U, mQueue->mMetricsRecordRef->GetLabels()->size());
     APSARA_TEST_TRUE(mQueue->mMetricsRecordRef.HasLabel(METRIC_LABEL_KEY_PROJECT, ""));
@@ -146,6 +228,8 @@ void BoundedProcessQueueUnittest::TestMetric() {
 UNIT_TEST_CASE(BoundedProcessQueueUnittest, TestPush)
 UNIT_TEST_CASE(BoundedProcessQueueUnittest, TestPop)
 UNIT_TEST_CASE(BoundedProcessQueueUnittest, TestMetric)
+UNIT_TEST_CASE(BoundedProcessQueueUnittest, TestMemoryBudget)
+UNIT_TEST_CASE(BoundedProcessQueueUnittest, TestPushConcurrently)
 
 } // namespace logtail
 
@@ -0,0 +1,228 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/queue/CircularProcessQueue.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr size_t kItemCntPerProducer = 100000;
+constexpr size_t kConsumerCnt = 2;
+// large enough for no item to be discarded
+constexpr size_t kQueueCapacity = 1000000;
+
+unique_ptr<ProcessQueueItem> GenerateItem() {
+    PipelineEventGroup g(make_shared<SourceBuffer>());
+    g.AddLogEvent();
+    return make_unique<ProcessQueueItem>(std::move(g), 0);
+}
+
+} // namespace
+
+// multiple producers push to circular queues as non-ack inputs like prometheus, ebpf and forward do, while the
+// consumers keep popping
+class ProcessQueueManagerBenchmark : public testing::Test {
+public:
+    void TestPushWithGlobalLock();
+    void TestPushToSameQueue();
+    void TestPushToOwnQueue();
+
+protected:
+    void TearDown() override { DeleteQueues(); }
+
+private:
+    void CreateQueues(size_t cnt) {
+        for (size_t i = 0; i < cnt; ++i) {
+            string name = "benchmark_config_" + to_string(i);
+            QueueKey key = QueueKeyManager::GetInstance()->GetKey(name);
+            CollectionPipelineContext ctx;
+            ctx.SetConfigName(name);
+            ctx.SetProcessQueueKey(key);
+            ProcessQueueManager::GetInstance()->CreateOrUpdateCircularQueue(key, 0, kQueueCapacity, ctx);
+            ProcessQueueManager::GetInstance()->EnablePop(name);
+            mConfigNames.emplace_back(name);
+        }
+    }
+
+    void DeleteQueues() {
+        for (const auto& name : mConfigNames) {
+            ProcessQueueManager::GetInstance()->DeleteQueue(QueueKeyManager::GetInstance()->GetKey(name));
+        }
+        mConfigNames.clear();
+    }
+
+    template <class Push, class Pop>
+    static void Run(const string& name, size_t producerCnt, Push&& push, Pop&& pop);
+
+    vector<string> mConfigNames;
+};
+
+template <class Push, class Pop>
+void ProcessQueueManagerBenchmark::Run(const string& name, size_t producerCnt, Push&& push, Pop&& pop) {
+    atomic_size_t poppedCnt = 0;
+    size_t totalCnt = producerCnt * kItemCntPerProducer;
+    vector<thread> consumers;
+    for (size_t i = 0; i < kConsumerCnt; ++i) {
+        consumers.emplace_back([&, i] {
+            while (poppedCnt.load() < totalCnt) {
+                if (pop(i)) {
+                    ++poppedCnt;
+                }
+            }
+        });
+    }
+
+    vector<vector<unique_ptr<ProcessQueueItem>>> items(producerCnt);
+    for (size_t i = 0; i < producerCnt; ++i) {
+        items[i].reserve(kItemCntPerProducer);
+        for (size_t j = 0; j < kItemCntPerProducer; ++j) {
+            items[i].emplace_back(GenerateItem());
+        }
+    }
+    auto start = chrono::steady_clock::now();
+    vector<thread> producers;
+    for (size_t i = 0; i < producerCnt; ++i) {
+        producers.emplace_back([&, i] {
+            for (auto& item : items[i]) {
+                push(i, std::move(item));
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    for (auto& t : consumers) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(totalCnt, poppedCnt.load());
+    cout << "[" << name << "] producers: " << producerCnt << "\tpush: " << totalCnt / elapsed.count() / 1000000
+         << " M items/s" << endl;
+}
+
+void ProcessQueueManagerBenchmark::TestPushWithGlobalLock() {
+    // what ProcessQueueManager did before: one lock for all queues and a notification for every push
+    for (size_t producerCnt : {1, 2, 4, 8}) {
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName("benchmark_config");
+        CircularProcessQueue queue(kQueueCapacity, 0, 0, ctx);
+        queue.EnablePop();
+        mutex queueMux, stateMux;
+        condition_variable cond;
+        bool validToPop = false;
+        Run(
+            "global lock",
+            producerCnt,
+            [&](size_t, unique_ptr<ProcessQueueItem>&& item) {
+                {
+                    lock_guard<mutex> lock(queueMux);
+                    queue.Push(std::move(item));
+                }
+                {
+                    lock_guard<mutex> lock(stateMux);
+                    validToPop = true;
+                }
+                cond.notify_one();
+            },
+            [&](size_t) {
+                unique_ptr<ProcessQueueItem> item;
+                {
+                    lock_guard<mutex> lock(queueMux);
+                    if (queue.Pop(item)) {
+                        return true;
+                    }
+                }
+                unique_lock<mutex> lock(stateMux);
+                cond.wait_for(lock, chrono::milliseconds(1), [&] { return validToPop; });
+                validToPop = false;
+                return false;
+            });
+    }
+}
+
+void ProcessQueueManagerBenchmark::TestPushToSameQueue() {
+    for (size_t producerCnt : {1, 2, 4, 8}) {
+        CreateQueues(1);
+        QueueKey key = QueueKeyManager::GetInstance()->GetKey(mConfigNames[0]);
+        Run(
+            "same queue",
+            producerCnt,
+            [&](size_t, unique_ptr<ProcessQueueItem>&& item) {
+                APSARA_TEST_TRUE(ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item))
+                                 == QueueStatus::OK);
+            },
+            [&](size_t threadNo) {
+                unique_ptr<ProcessQueueItem> item;
+                string configName;
+                if (ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+                    return true;
+                }
+                ProcessQueueManager::GetInstance()->Wait(1);
+                return false;
+            });
+        DeleteQueues();
+    }
+}
+
+void ProcessQueueManagerBenchmark::TestPushToOwnQueue() {
+    for (size_t producerCnt : {1, 2, 4, 8}) {
+        CreateQueues(producerCnt);
+        vector<QueueKey> keys;
+        for (const auto& name : mConfigNames) {
+            keys.push_back(QueueKeyManager::GetInstance()->GetKey(name));
+        }
+        Run(
+            "own queue",
+            producerCnt,
+            [&](size_t producerNo, unique_ptr<ProcessQueueItem>&& item) {
+                APSARA_TEST_TRUE(ProcessQueueManager::GetInstance()->PushQueue(keys[producerNo], std::move(item))
+                                 == QueueStatus::OK);
+            },
+            [&](size_t threadNo) {
+                unique_ptr<ProcessQueueItem> item;
+                string configName;
+                if (ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+                    return true;
+                }
+                ProcessQueueManager::GetInstance()->Wait(1);
+                return false;
+            });
+        DeleteQueues();
+    }
+}
+
+UNIT_TEST_CASE(ProcessQueueManagerBenchmark, TestPushWithGlobalLock)
+UNIT_TEST_CASE(ProcessQueueManagerBenchmark, TestPushToSameQueue)
+UNIT_TEST_CASE(ProcessQueueManagerBenchmark, TestPushToOwnQueue)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
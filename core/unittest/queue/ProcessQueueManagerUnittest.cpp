@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <future>
 #include <memory>
+#include <thread>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
@@ -34,6 +37,7 @@ public:
     void TestSetQueueUpstreamAndDownStream();
     void TestPushQueue();
     void TestPopItem();
+    void TestPushDuringFailedPopItem();
     void TestIsAllQueueEmpty();
     void OnPipelineUpdate();
 
@@ -323,6 +327,38 @@ void ProcessQueueManagerUnittest::TestPopItem() {
     APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
 }
 
+void ProcessQueueManagerUnittest::TestPushDuringFailedPopItem() {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config_1");
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+    sProcessQueueManager->mValidToPop = false;
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    future<bool> res;
+    {
+        // the consumer blocks on exactly once queues after the normal queue of priority 0 is scanned
+        lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
+        res = async(launch::async, [&]() { return sProcessQueueManager->PopItem(0, item, configName); });
+        while (sProcessQueueManager->mPopMux.try_lock()) {
+            sProcessQueueManager->mPopMux.unlock();
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        this_thread::sleep_for(chrono::milliseconds(50));
+        APSARA_TEST_EQUAL(QueueStatus::OK, sProcessQueueManager->PushQueue(key, GenerateItem()));
+    }
+    if (!res.get()) {
+        // the notification of the push must survive the failed scan
+        auto start = chrono::steady_clock::now();
+        APSARA_TEST_TRUE(sProcessQueueManager->Wait(1000));
+        APSARA_TEST_TRUE(chrono::steady_clock::now() - start < chrono::milliseconds(500));
+        APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    }
+    APSARA_TEST_EQUAL("test_config_1", configName);
+}
+
 void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
     CollectionPipelineContext ctx;
     ctx.SetConfigName("test_config_1");
@@ -448,6 +484,7 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushDuringFailedPopItem)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
 
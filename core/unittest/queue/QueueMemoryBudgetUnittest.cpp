@@ -0,0 +1,112 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "app_config/AppConfig.h"
+#include "collection_pipeline/queue/QueueMemoryBudget.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(queue_memory_budget_bytes);
+
+using namespace std;
+
+namespace logtail {
+
+class QueueMemoryBudgetUnittest : public testing::Test {
+public:
+    void TestGetLimit();
+    void TestWatermark();
+    void TestQueueShare();
+
+protected:
+    void SetUp() override {
+        mBudget = QueueMemoryBudget::GetInstance();
+        mBudget->mUsedBytes = 0;
+        mBudget->mQueueCnt = 0;
+        INT64_FLAG(queue_memory_budget_bytes) = 3000;
+    }
+
+    void TearDown() override {
+        mBudget->mUsedBytes = 0;
+        mBudget->mQueueCnt = 0;
+        mBudget->SetMemoryPressure(false);
+        INT64_FLAG(queue_memory_budget_bytes) = 0;
+    }
+
+private:
+    QueueMemoryBudget* mBudget = nullptr;
+};
+
+void QueueMemoryBudgetUnittest::TestGetLimit() {
+    APSARA_TEST_EQUAL(3000U, mBudget->GetLimit());
+    // half of the memory limit of the agent by default
+    INT64_FLAG(queue_memory_budget_bytes) = 0;
+    APSARA_TEST_EQUAL(static_cast<size_t>(AppConfig::GetInstance()->GetMemUsageUpLimit()) * 1024 * 1024 / 2,
+                      mBudget->GetLimit());
+}
+
+void QueueMemoryBudgetUnittest::TestWatermark() {
+    APSARA_TEST_FALSE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_TRUE(mBudget->IsBelowLowWatermark());
+
+    mBudget->Add(2000);
+    APSARA_TEST_FALSE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_TRUE(mBudget->IsBelowLowWatermark());
+
+    // between the watermarks
+    mBudget->Add(1);
+    APSARA_TEST_FALSE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_FALSE(mBudget->IsBelowLowWatermark());
+
+    mBudget->Add(999);
+    APSARA_TEST_EQUAL(3000U, mBudget->GetUsedBytes());
+    APSARA_TEST_TRUE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_FALSE(mBudget->IsBelowLowWatermark());
+
+    mBudget->Sub(2500);
+    APSARA_TEST_FALSE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_TRUE(mBudget->IsBelowLowWatermark());
+
+    // memory pressure counts as over the budget, no matter how many bytes are used
+    mBudget->SetMemoryPressure(true);
+    APSARA_TEST_TRUE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_FALSE(mBudget->IsBelowLowWatermark());
+    mBudget->SetMemoryPressure(false);
+    APSARA_TEST_FALSE(mBudget->IsOverHighWatermark());
+    APSARA_TEST_TRUE(mBudget->IsBelowLowWatermark());
+}
+
+void QueueMemoryBudgetUnittest::TestQueueShare() {
+    // the whole budget when there is no queue
+    APSARA_TEST_EQUAL(3000U, mBudget->GetQueueShare());
+    APSARA_TEST_EQUAL(2000U, mBudget->GetQueueLowShare());
+
+    mBudget->AddQueue();
+    mBudget->AddQueue();
+    mBudget->AddQueue();
+    APSARA_TEST_EQUAL(1000U, mBudget->GetQueueShare());
+    APSARA_TEST_EQUAL(666U, mBudget->GetQueueLowShare());
+
+    mBudget->RemoveQueue();
+    APSARA_TEST_EQUAL(1500U, mBudget->GetQueueShare());
+    APSARA_TEST_EQUAL(1000U, mBudget->GetQueueLowShare());
+}
+
+UNIT_TEST_CASE(QueueMemoryBudgetUnittest, TestGetLimit)
+UNIT_TEST_CASE(QueueMemoryBudgetUnittest, TestWatermark)
+UNIT_TEST_CASE(QueueMemoryBudgetUnittest, TestQueueShare)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,149 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "collection_pipeline/serializer/JsonSerializer.h"
+#include "common/TimeUtil.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+using namespace logtail;
+
+static std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// the serialization of log events before the dedicated writer was introduced
+static void SerializeByRapidjson(const BatchedEvents& group, std::string& res) {
+    rapidjson::StringBuffer jsonBuffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(jsonBuffer);
+    for (const auto& item : group.mEvents) {
+        const auto& e = item.Cast<LogEvent>();
+        if (e.Empty()) {
+            continue;
+        }
+        jsonBuffer.Clear();
+        writer.Reset(jsonBuffer);
+        writer.StartObject();
+        for (const auto& tag : group.mTags.mInner) {
+            writer.Key(tag.first.to_string().c_str());
+            writer.String(tag.second.to_string().c_str());
+        }
+        writer.Key("__time__");
+        writer.Uint64(e.GetTimestamp());
+        for (const auto& kv : e) {
+            writer.Key(kv.first.to_string().c_str());
+            writer.String(kv.second.to_string().c_str());
+        }
+        writer.EndObject();
+        res.append(jsonBuffer.GetString());
+        res.append("\n");
+    }
+}
+
+static BatchedEvents CreateBatch(int eventCnt) {
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    group.SetTag(LOG_RESERVED_KEY_SOURCE, "172.16.0.1");
+    group.SetTag(LOG_RESERVED_KEY_MACHINE_UUID, "2c7d8e0a-5b8f-4b7e-9d3c-0a1b2c3d4e5f");
+    group.SetTag(std::string("__path__"), std::string("/var/log/nginx/access.log"));
+    for (int i = 0; i < eventCnt; ++i) {
+        LogEvent* e = group.AddLogEvent();
+        e->SetTimestamp(1700000000 + i);
+        e->SetContent(std::string("remote_addr"), std::string("10.200.98.220"));
+        e->SetContent(std::string("time_local"), std::string("18/Oct/2026:10:00:00 +0800"));
+        e->SetContent(std::string("request"), std::string("GET /api/v1/query?name=\"ilogtail\"&limit=100 HTTP/1.1"));
+        e->SetContent(std::string("status"), std::string("200"));
+        e->SetContent(std::string("body_bytes_sent"), std::string("2048"));
+        e->SetContent(std::string("http_user_agent"),
+                      std::string("Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko)"));
+    }
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                        std::move(group.GetExactlyOnceCheckpoint()));
+    for (const auto& e : batch.mEvents) {
+        batch.mSizeBytes += e->DataSize();
+    }
+    return batch;
+}
+
+static void BM_Serialize(int eventCnt, int batchSize) {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    FlusherMock flusher;
+    flusher.SetContext(ctx);
+    flusher.CreateMetricsRecordRef(FlusherMock::sName, "1");
+    flusher.CommitMetricsRecordRef();
+    JsonEventGroupSerializer serializer(&flusher);
+
+    size_t outputSize = 0;
+    {
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; ++i) {
+            auto batch = CreateBatch(eventCnt);
+            std::string res;
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            SerializeByRapidjson(batch, res);
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+            outputSize = res.size();
+        }
+        std::cout << "rapidjson" << std::endl;
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "output: " << formatSize(outputSize * (uint64_t)batchSize * 1000000 / durationTime) << "/s"
+                  << std::endl;
+    }
+    {
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; ++i) {
+            auto batch = CreateBatch(eventCnt);
+            std::string res, errorMsg;
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            serializer.DoSerialize(std::move(batch), res, errorMsg);
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+            outputSize = res.size();
+        }
+        std::cout << "json event group serializer" << std::endl;
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "output: " << formatSize(outputSize * (uint64_t)batchSize * 1000000 / durationTime) << "/s"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_Serialize(1000, 200);
+    return 0;
+}
@@ -26,6 +26,7 @@ namespace logtail {
 class JsonSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
+    void TestEscape();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -262,6 +263,29 @@ void JsonSerializerUnittest::TestSerializeEventGroup() {
     }
 }
 
+void JsonSerializerUnittest::TestEscape() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(string("tag\"key"), string("tag\\value"));
+    LogEvent* e = group.AddLogEvent();
+    e->SetTimestamp(1234567890);
+    // long enough to cover both the vectorized and the scalar scanning
+    e->SetContent(string("key"), string("0123456789abcdef\"quoted\"\t\n\r\b\f\x01\x1f\x7f中文0123456789abcdef\\"));
+    e->SetContent(string("empty"), string(""));
+    e->SetContent(string("nul"), string("a\0b", 3));
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                        std::move(group.GetExactlyOnceCheckpoint()));
+    string res;
+    string errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"tag\\\"key\":\"tag\\\\value\",\"__time__\":1234567890,"
+                      "\"key\":\"0123456789abcdef\\\"quoted\\\"\\t\\n\\r\\b\\f\\u0001\\u001F\x7f中文0123456789abcdef\\\\\","
+                      "\"empty\":\"\",\"nul\":\"a\\u0000b\"}\n",
+                      res);
+}
 
 BatchedEvents
 JsonSerializerUnittest::createBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
@@ -426,6 +450,7 @@ BatchedEvents JsonSerializerUnittest::createBatchedSpanEvents() {
 }
 
 UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeEventGroup)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestEscape)
 
 } // namespace logtail
 